@@ -0,0 +1,101 @@
+/*
+ *    Copyright (c) 2024 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *    @file
+ *      This file implements interfaces, strntou128 and strnto128, for
+ *      converting bounded, potentially non-null-terminated strings to
+ *      128-bit integers.
+ *
+ *      Other than in the power-of-two bases, digits are gathered into
+ *      64-bit chunks, 19 at a time for decimal, so that a 128-bit
+ *      multiply is needed only once per chunk rather than per digit.
+ *
+ */
+
+#include "strnto128.h"
+
+#include "strntoul/strntoul-core.h"
+
+#if defined(__SIZEOF_INT128__)
+
+/**
+ *  @brief
+ *    Convert a string to an unsigned 128-bit integer.
+ *
+ *  This function is identical to strntoul, except that the result is
+ *  an unsigned 128-bit integer.
+ *
+ *  @param[in]   aString  A pointer to the string to convert.
+ *  @param[in]   aLength  The maximum number of characters, in bytes,
+ *                        of @a aString to process.
+ *  @param[out]  aEnd     A pointer to storage for the first invalid
+ *                        or the last valid character in @a aString.
+ *  @param[in]   aBase    The base to use to interpret @a aString for
+ *                        the conversion in the range 2 to 36,
+ *                        inclusive.
+ *
+ *  @returns
+ *    Either the result of the conversion or, if there was a leading
+ *    minus sign, the negation of the result of the conversion
+ *    represented as an unsigned value, unless the original
+ *    (nonnegated) value would overflow; in the latter case, this
+ *    returns the largest unsigned 128-bit value and sets @a errno to
+ *    ERANGE.
+ *
+ *  @sa strntoul
+ *
+ */
+unsigned __int128
+strntou128(const char *aString, size_t aLength, char **aEnd, int aBase)
+{
+    return (StrNToUL::Core::ConvertUnsigned<unsigned __int128>(aString, aLength, aEnd, aBase));
+}
+
+/**
+ *  @brief
+ *    Convert a string to a signed 128-bit integer.
+ *
+ *  This function is identical to strntol, except that the result is a
+ *  signed 128-bit integer.
+ *
+ *  @param[in]   aString  A pointer to the string to convert.
+ *  @param[in]   aLength  The maximum number of characters, in bytes,
+ *                        of @a aString to process.
+ *  @param[out]  aEnd     A pointer to storage for the first invalid
+ *                        or the last valid character in @a aString.
+ *  @param[in]   aBase    The base to use to interpret @a aString for
+ *                        the conversion in the range 2 to 36,
+ *                        inclusive.
+ *
+ *  @returns
+ *    The result of the conversion, unless the value would underflow
+ *    or overflow. If an underflow occurs, this returns the smallest
+ *    signed 128-bit value. If an overflow occurs, this returns the
+ *    largest. In both cases, errno is set to ERANGE.
+ *
+ *  @sa strntol
+ *
+ */
+__int128
+strnto128(const char *aString, size_t aLength, char **aEnd, int aBase)
+{
+    return (StrNToUL::Core::ConvertSigned<__int128, unsigned __int128>(aString, aLength, aEnd, aBase));
+}
+
+#endif // defined(__SIZEOF_INT128__)
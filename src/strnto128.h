@@ -0,0 +1,51 @@
+/*
+ *    Copyright (c) 2024 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *    @file
+ *      This file defines interfaces, strntou128 and strnto128, for
+ *      converting bounded, potentially non-null-terminated strings to
+ *      128-bit integers, where the compiler supports them.
+ *
+ */
+
+#ifndef STRNTO128_H
+#define STRNTO128_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(__SIZEOF_INT128__)
+/**
+ *  Defined when the 128-bit interfaces are available.
+ *
+ */
+#define STRNTOUL_HAVE_INT128 1
+
+extern unsigned __int128 strntou128(const char *aString, size_t aLength, char **aEnd, int aBase);
+extern __int128 strnto128(const char *aString, size_t aLength, char **aEnd, int aBase);
+#endif /* defined(__SIZEOF_INT128__) */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STRNTO128_H */
@@ -0,0 +1,749 @@
+/*
+ *    Copyright (c) 2024 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *    @file
+ *      This file implements an interface, strntobig, for converting
+ *      bounded, potentially non-null-terminated strings of arbitrary
+ *      length into multi-limb unsigned integers.
+ *
+ *      For power-of-two bases, each digit maps to a fixed number of
+ *      bits, which are packed directly into the limbs in a single
+ *      linear pass.
+ *
+ *      For other bases, the digits are first converted in chunks of as
+ *      many digits as fit in a limb (19 for decimal), using the decimal
+ *      kernel where possible. Up to a modest number of chunks, these
+ *      are accumulated with one limb-by-multi-limb multiply each. Past
+ *      that, the chunks are split in two, each half is converted
+ *      recursively, and the halves are combined with one multiply by a
+ *      precomputed power of the chunk radix, using Karatsuba
+ *      multiplication for large operands, so that the conversion is no
+ *      longer quadratic in the number of digits.
+ *
+ */
+
+#include "strntobig.h"
+
+#include <ctype.h>
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "strntoul/strntoul-kernel.h"
+
+namespace
+{
+
+typedef uint64_t Limb;
+
+/**
+ *  The number of chunks up to which accumulation, rather than
+ *  divide-and-conquer, is used.
+ *
+ */
+const size_t kLinearChunks   = 64;
+
+/**
+ *  The operand size, in limbs, from which Karatsuba, rather than
+ *  schoolbook, multiplication is used.
+ *
+ */
+const size_t kKaratsubaLimbs = 32;
+
+/**
+ *  The state shared by each level of divide-and-conquer conversion.
+ *
+ */
+struct Context
+{
+    const Limb *   mChunks;
+    Limb           mRadix;
+    const Limb **  mPowers;
+    const size_t * mPowerLengths;
+};
+
+}; // namespace
+
+/**
+ *  Return the low limb of @a aFirst * @a aSecond + @a aAddend +
+ *  @a aCarry, storing the high limb in @a aCarry, which cannot
+ *  overflow.
+ *
+ */
+static inline Limb
+MultiplyAdd(const Limb &aFirst, const Limb &aSecond, const Limb &aAddend, Limb &aCarry)
+{
+#if defined(__SIZEOF_INT128__)
+    const unsigned __int128 lProduct = (static_cast<unsigned __int128>(aFirst) * aSecond) + aAddend + aCarry;
+
+    aCarry = static_cast<Limb>(lProduct >> 64);
+
+    return (static_cast<Limb>(lProduct));
+#else
+    const Limb lFirstLow   = aFirst & 0xFFFFFFFF;
+    const Limb lFirstHigh  = aFirst >> 32;
+    const Limb lSecondLow  = aSecond & 0xFFFFFFFF;
+    const Limb lSecondHigh = aSecond >> 32;
+    const Limb lLowLow     = lFirstLow * lSecondLow;
+    const Limb lLowHigh    = lFirstLow * lSecondHigh;
+    const Limb lHighLow    = lFirstHigh * lSecondLow;
+    const Limb lMiddle     = (lLowLow >> 32) + (lLowHigh & 0xFFFFFFFF) + (lHighLow & 0xFFFFFFFF);
+    Limb       lLow        = (lLowLow & 0xFFFFFFFF) | (lMiddle << 32);
+    Limb       lHigh       = (lFirstHigh * lSecondHigh) + (lLowHigh >> 32) + (lHighLow >> 32) + (lMiddle >> 32);
+
+    lLow  += aAddend;
+    lHigh += (lLow < aAddend);
+    lLow  += aCarry;
+    lHigh += (lLow < aCarry);
+
+    aCarry = lHigh;
+
+    return (lLow);
+#endif // defined(__SIZEOF_INT128__)
+}
+
+static size_t
+Normalize(const Limb *aLimbs, size_t aLength)
+{
+    while ((aLength > 0) && (aLimbs[aLength - 1] == 0))
+    {
+        aLength--;
+    }
+
+    return (aLength);
+}
+
+/**
+ *  Multiply the @a aLength limbs at @a aLimbs by @a aMultiplier and
+ *  add @a aAddend, in place, returning the carry out.
+ *
+ */
+static Limb
+MultiplyAddSmall(Limb *aLimbs, const size_t &aLength, const Limb &aMultiplier, const Limb &aAddend)
+{
+    Limb lCarry = aAddend;
+
+    for (size_t i = 0; i < aLength; i++)
+    {
+        aLimbs[i] = MultiplyAdd(aLimbs[i], aMultiplier, 0, lCarry);
+    }
+
+    return (lCarry);
+}
+
+/**
+ *  Add the @a aLength limbs at @a aAddend into those at @a aSum,
+ *  propagating any carry no further than @a aSumLength limbs.
+ *
+ */
+static void
+AddInto(Limb *aSum, const size_t &aSumLength, const Limb *aAddend, size_t aLength)
+{
+    Limb   lCarry = 0;
+    size_t i;
+
+    aLength = ((aLength < aSumLength) ? aLength : aSumLength);
+
+    for (i = 0; i < aLength; i++)
+    {
+        const Limb lSum = aSum[i] + aAddend[i];
+        const Limb lOut = lSum + lCarry;
+
+        lCarry  = ((lSum < aSum[i]) || (lOut < lSum));
+        aSum[i] = lOut;
+    }
+
+    for (; (lCarry != 0) && (i < aSumLength); i++)
+    {
+        lCarry = (++aSum[i] == 0);
+    }
+}
+
+/**
+ *  Subtract the @a aLength limbs at @a aSubtrahend from those at
+ *  @a aDifference, which must be no less, in place.
+ *
+ */
+static void
+SubtractFrom(Limb *aDifference, const size_t &aDifferenceLength, const Limb *aSubtrahend, const size_t &aLength)
+{
+    Limb   lBorrow = 0;
+    size_t i;
+
+    for (i = 0; i < aLength; i++)
+    {
+        const Limb lDifference = aDifference[i] - aSubtrahend[i];
+        const Limb lOut        = lDifference - lBorrow;
+
+        lBorrow        = ((aDifference[i] < aSubtrahend[i]) || (lDifference < lBorrow));
+        aDifference[i] = lOut;
+    }
+
+    for (; (lBorrow != 0) && (i < aDifferenceLength); i++)
+    {
+        lBorrow = (aDifference[i]-- == 0);
+    }
+}
+
+static void
+MultiplySchoolbook(const Limb *aFirst, const size_t &aFirstLength, const Limb *aSecond, const size_t &aSecondLength, Limb *aProduct)
+{
+    memset(aProduct, 0, (aFirstLength + aSecondLength) * sizeof (Limb));
+
+    for (size_t i = 0; i < aFirstLength; i++)
+    {
+        Limb lCarry = 0;
+
+        for (size_t j = 0; j < aSecondLength; j++)
+        {
+            aProduct[i + j] = MultiplyAdd(aFirst[i], aSecond[j], aProduct[i + j], lCarry);
+        }
+
+        aProduct[i + aSecondLength] = lCarry;
+    }
+}
+
+/**
+ *  Multiply the limbs at @a aFirst and @a aSecond into the
+ *  @a aFirstLength + @a aSecondLength limbs at @a aProduct, which must
+ *  not overlap either.
+ *
+ *  @returns
+ *    True if successful; otherwise, false, if memory could not be
+ *    allocated.
+ *
+ */
+static bool
+Multiply(const Limb *aFirst, size_t aFirstLength, const Limb *aSecond, size_t aSecondLength, Limb *aProduct)
+{
+    size_t lSplit;
+    size_t lHalvesLength;
+    Limb * lScratch;
+    Limb * lFirstSum;
+    Limb * lSecondSum;
+    Limb * lMiddle;
+    bool   lRetval;
+
+    if (aFirstLength < aSecondLength)
+    {
+        return (Multiply(aSecond, aSecondLength, aFirst, aFirstLength, aProduct));
+    }
+
+    lSplit = (aFirstLength + 1) / 2;
+
+    // Karatsuba only pays off for large operands of similar size;
+    // otherwise, multiply directly.
+
+    if ((aSecondLength < kKaratsubaLimbs) || (aSecondLength <= lSplit))
+    {
+        MultiplySchoolbook(aFirst, aFirstLength, aSecond, aSecondLength, aProduct);
+
+        return (true);
+    }
+
+    // With each operand split into low and high halves at lSplit
+    // limbs, the product is the low product, plus the high product
+    // shifted by 2 * lSplit, plus the middle term, (low + high) *
+    // (low + high) less the other two, shifted by lSplit.
+
+    lHalvesLength = lSplit + 1;
+
+    lScratch = static_cast<Limb *>(malloc(((2 * lHalvesLength) + (2 * lHalvesLength)) * sizeof (Limb)));
+
+    if (lScratch == nullptr)
+    {
+        return (false);
+    }
+
+    lFirstSum  = lScratch;
+    lSecondSum = lFirstSum + lHalvesLength;
+    lMiddle    = lSecondSum + lHalvesLength;
+
+    memcpy(lFirstSum, aFirst, lSplit * sizeof (Limb));
+    lFirstSum[lSplit] = 0;
+    AddInto(lFirstSum, lHalvesLength, aFirst + lSplit, aFirstLength - lSplit);
+
+    memcpy(lSecondSum, aSecond, lSplit * sizeof (Limb));
+    lSecondSum[lSplit] = 0;
+    AddInto(lSecondSum, lHalvesLength, aSecond + lSplit, aSecondLength - lSplit);
+
+    lRetval = (Multiply(aFirst, lSplit, aSecond, lSplit, aProduct) &&
+               Multiply(aFirst + lSplit, aFirstLength - lSplit, aSecond + lSplit, aSecondLength - lSplit, aProduct + (2 * lSplit)) &&
+               Multiply(lFirstSum, lHalvesLength, lSecondSum, lHalvesLength, lMiddle));
+
+    if (lRetval)
+    {
+        SubtractFrom(lMiddle, 2 * lHalvesLength, aProduct, 2 * lSplit);
+        SubtractFrom(lMiddle, 2 * lHalvesLength, aProduct + (2 * lSplit), aFirstLength + aSecondLength - (2 * lSplit));
+
+        AddInto(aProduct + lSplit, aFirstLength + aSecondLength - lSplit, lMiddle, 2 * lHalvesLength);
+    }
+
+    free(lScratch);
+
+    return (lRetval);
+}
+
+/**
+ *  Combine @a aCount chunks, starting from @a aFirst, most significant
+ *  first, into at most @a aCount + 2 limbs at @a aLimbs.
+ *
+ *  @returns
+ *    True if successful; otherwise, false, if memory could not be
+ *    allocated.
+ *
+ */
+static bool
+Combine(const Context &aContext, const size_t &aFirst, const size_t &aCount, Limb *aLimbs, size_t &aLength)
+{
+    size_t lPower = 0;
+    size_t lLowCount;
+    size_t lHighLength;
+    size_t lLowLength;
+    Limb * lHigh;
+    Limb * lLow;
+    bool   lRetval;
+
+    if (aCount <= kLinearChunks)
+    {
+        aLength = 0;
+
+        for (size_t i = aFirst; i < (aFirst + aCount); i++)
+        {
+            const Limb lCarry = MultiplyAddSmall(aLimbs, aLength, aContext.mRadix, aContext.mChunks[i]);
+
+            if (lCarry != 0)
+            {
+                aLimbs[aLength++] = lCarry;
+            }
+        }
+
+        return (true);
+    }
+
+    // Split off the largest power-of-two count of low chunks such that
+    // at least one high chunk remains, so that the radix power by which
+    // to shift the high chunks is always one of those precomputed.
+
+    while ((static_cast<size_t>(2) << lPower) < aCount)
+    {
+        lPower++;
+    }
+
+    lLowCount = (static_cast<size_t>(1) << lPower);
+
+    lHigh = static_cast<Limb *>(malloc(((aCount - lLowCount + 2) + (lLowCount + 2)) * sizeof (Limb)));
+
+    if (lHigh == nullptr)
+    {
+        return (false);
+    }
+
+    lLow = lHigh + (aCount - lLowCount + 2);
+
+    lRetval = (Combine(aContext, aFirst, aCount - lLowCount, lHigh, lHighLength) &&
+               Combine(aContext, aFirst + aCount - lLowCount, lLowCount, lLow, lLowLength));
+
+    if (lRetval)
+    {
+        if (lHighLength == 0)
+        {
+            memcpy(aLimbs, lLow, lLowLength * sizeof (Limb));
+
+            aLength = lLowLength;
+        }
+        else
+        {
+            aLength = lHighLength + aContext.mPowerLengths[lPower];
+
+            lRetval = Multiply(lHigh, lHighLength, aContext.mPowers[lPower], aContext.mPowerLengths[lPower], aLimbs);
+
+            if (lRetval)
+            {
+                AddInto(aLimbs, aLength, lLow, lLowLength);
+
+                aLength = Normalize(aLimbs, aLength);
+            }
+        }
+    }
+
+    free(lHigh);
+
+    return (lRetval);
+}
+
+/**
+ *  Convert @a aCount digits, all valid in @a aBase, of which there are
+ *  few enough that their value fits in a limb.
+ *
+ */
+static Limb
+ConvertChunk(const char *aDigits, const size_t &aCount, const unsigned int &aBase)
+{
+    Limb   lRetval = 0;
+    size_t i       = 0;
+
+#if STRNTOUL_USE_DECIMAL_KERNEL
+    if (aBase == 10)
+    {
+        i = StrNToUL::Kernel::ConvertDecimal(aDigits, aCount, lRetval);
+    }
+#endif // STRNTOUL_USE_DECIMAL_KERNEL
+
+    for (; i < aCount; i++)
+    {
+        lRetval = (lRetval * aBase) + StrNToUL::Kernel::DigitValue(aDigits[i]);
+    }
+
+    return (lRetval);
+}
+
+/**
+ *  Pack @a aCount digits of @a aBits bits each, the first of which is
+ *  non-zero, into the limbs, returning the number of significant limbs.
+ *
+ */
+static size_t
+Pack(const char *aDigits, const size_t &aCount, const unsigned int &aBits, Limb *aLimbs, const size_t &aCapacity)
+{
+    const unsigned int lLeading = StrNToUL::Kernel::DigitValue(aDigits[0]);
+    const size_t       lBits    = ((aCount - 1) * aBits) + static_cast<size_t>(64 - __builtin_clzll(lLeading));
+    size_t             lOffset  = 0;
+
+    memset(aLimbs, 0, aCapacity * sizeof (Limb));
+
+    for (size_t i = aCount; i > 0; i--, lOffset += aBits)
+    {
+        const Limb   lDigit = StrNToUL::Kernel::DigitValue(aDigits[i - 1]);
+        const size_t lLimb  = lOffset / 64;
+        const size_t lShift = lOffset % 64;
+
+        if (lLimb >= aCapacity)
+        {
+            break;
+        }
+
+        aLimbs[lLimb] |= (lDigit << lShift);
+
+        if (((lShift + aBits) > 64) && ((lLimb + 1) < aCapacity))
+        {
+            aLimbs[lLimb + 1] |= (lDigit >> (64 - lShift));
+        }
+    }
+
+    return ((lBits + 63) / 64);
+}
+
+/**
+ *  Convert @a aCount digits, the first of which is non-zero, in a base
+ *  other than a power of two, returning the number of significant
+ *  limbs or zero with @a errno set to ENOMEM.
+ *
+ */
+static size_t
+Convert(const char *aDigits, const size_t &aCount, const unsigned int &aBase, Limb *aLimbs, const size_t &aCapacity)
+{
+    Limb      lRadix     = 1;
+    size_t    lChunkSize = 0;
+    size_t    lChunks;
+    size_t    lPowers    = 1;
+    size_t    lLength    = 0;
+    Limb      lLinear[kLinearChunks + 2];
+    Limb *    lStorage;
+    Limb *    lChunkValues;
+    Limb *    lResult;
+    Limb **   lPowerValues;
+    size_t *  lPowerLengths;
+    Limb *    lPower;
+    Context   lContext;
+    bool      lStatus;
+
+    while (lRadix <= (UINT64_MAX / aBase))
+    {
+        lRadix *= aBase;
+        lChunkSize++;
+    }
+
+    lChunks = (aCount + lChunkSize - 1) / lChunkSize;
+
+    // The most significant chunk takes the digits left over.
+
+    if (lChunks <= kLinearChunks)
+    {
+        size_t lOffset = 0;
+
+        for (size_t i = 0; i < lChunks; i++)
+        {
+            const size_t lSize  = ((i == 0) ? (aCount - ((lChunks - 1) * lChunkSize)) : lChunkSize);
+            const Limb   lCarry = MultiplyAddSmall(lLinear, lLength, lRadix, ConvertChunk(aDigits + lOffset, lSize, aBase));
+
+            if (lCarry != 0)
+            {
+                lLinear[lLength++] = lCarry;
+            }
+
+            lOffset += lSize;
+        }
+
+        memcpy(aLimbs, lLinear, ((lLength < aCapacity) ? lLength : aCapacity) * sizeof (Limb));
+
+        return (lLength);
+    }
+
+    while ((static_cast<size_t>(1) << lPowers) < lChunks)
+    {
+        lPowers++;
+    }
+
+    // Allocate the chunks, the result, and each power of the radix,
+    // the Nth of which, radix^(2^N), needs at most 2^N + 1 limbs.
+
+    lStorage = static_cast<Limb *>(malloc(((lChunks) + (lChunks + 2) + (static_cast<size_t>(2) << lPowers) + lPowers) * sizeof (Limb) +
+                                          (lPowers * (sizeof (Limb *) + sizeof (size_t)))));
+
+    if (lStorage == nullptr)
+    {
+        errno = ENOMEM;
+
+        return (0);
+    }
+
+    lChunkValues  = lStorage;
+    lResult       = lChunkValues + lChunks;
+    lPower        = lResult + lChunks + 2;
+    lPowerValues  = reinterpret_cast<Limb **>(lPower + (static_cast<size_t>(2) << lPowers) + lPowers);
+    lPowerLengths = reinterpret_cast<size_t *>(lPowerValues + lPowers);
+
+    for (size_t i = 0, lOffset = 0; i < lChunks; i++)
+    {
+        const size_t lSize = ((i == 0) ? (aCount - ((lChunks - 1) * lChunkSize)) : lChunkSize);
+
+        lChunkValues[i] = ConvertChunk(aDigits + lOffset, lSize, aBase);
+
+        lOffset += lSize;
+    }
+
+    lStatus = true;
+
+    lPowerValues[0]  = lPower;
+    lPowerLengths[0] = 1;
+    lPower[0]        = lRadix;
+
+    for (size_t i = 1; lStatus && (i < lPowers); i++)
+    {
+        lPowerValues[i] = lPowerValues[i - 1] + lPowerLengths[i - 1];
+
+        lStatus = Multiply(lPowerValues[i - 1], lPowerLengths[i - 1], lPowerValues[i - 1], lPowerLengths[i - 1], lPowerValues[i]);
+
+        lPowerLengths[i] = Normalize(lPowerValues[i], 2 * lPowerLengths[i - 1]);
+    }
+
+    if (lStatus)
+    {
+        lContext.mChunks       = lChunkValues;
+        lContext.mRadix        = lRadix;
+        lContext.mPowers       = const_cast<const Limb **>(lPowerValues);
+        lContext.mPowerLengths = lPowerLengths;
+
+        lStatus = Combine(lContext, 0, lChunks, lResult, lLength);
+    }
+
+    if (lStatus)
+    {
+        memcpy(aLimbs, lResult, ((lLength < aCapacity) ? lLength : aCapacity) * sizeof (Limb));
+    }
+    else
+    {
+        errno   = ENOMEM;
+        lLength = 0;
+    }
+
+    free(lStorage);
+
+    return (lLength);
+}
+
+/**
+ *  @brief
+ *    Return an upper bound on the number of limbs required for a
+ *    value with the specified number of digits.
+ *
+ *  @param[in]  aDigits  The number of digits.
+ *  @param[in]  aBase    The base of the digits, in the range 2 to 36,
+ *                       inclusive.
+ *
+ *  @returns
+ *    The upper bound, suitable for the capacity of a buffer passed to
+ *    strntobig, or zero if @a aBase was unsupported.
+ *
+ *  @sa strntobig
+ *
+ */
+size_t
+strntobig_limbs(size_t aDigits, int aBase)
+{
+    size_t lBits = 0;
+
+    if ((aBase < 2) || (aBase > 36))
+    {
+        return (0);
+    }
+
+    // Round the bits per digit up to the next whole bit.
+
+    while ((1 << lBits) < aBase)
+    {
+        lBits++;
+    }
+
+    return (((aDigits * lBits) + 63) / 64);
+}
+
+/**
+ *  @brief
+ *    Convert a bounded string of arbitrary length into a multi-limb
+ *    unsigned integer.
+ *
+ *  This converts @a aString as strntoul would, with the same handling
+ *  of white space, an optional '+' sign, and, for a base of zero or
+ *  16, a "0x" or "0X" prefix, except that the value may have any
+ *  number of digits. A '-' sign is not accepted.
+ *
+ *  The value is stored at @a aLimbs as 64-bit limbs, least significant
+ *  first, in host byte order.
+ *
+ *  On error, @a errno may be set as follows:
+ *
+ *    - EINVAL   @a aBase was an unsupported value.
+ *    - ERANGE   The value has more significant limbs than @a aCapacity.
+ *    - ENOMEM   Memory for a very long conversion could not be
+ *               allocated.
+ *
+ *  @param[in]   aString    A pointer to the string to convert.
+ *  @param[in]   aLength    The maximum number of characters, in bytes,
+ *                          of @a aString to process.
+ *  @param[out]  aEnd       A pointer to storage for the first invalid
+ *                          or the last valid character in @a aString.
+ *  @param[in]   aBase      The base to use to interpret @a aString for
+ *                          the conversion, as for strntoul.
+ *  @param[out]  aLimbs     A pointer to storage for at least @a
+ *                          aCapacity limbs.
+ *  @param[in]   aCapacity  The number of limbs of storage at @a aLimbs.
+ *
+ *  @returns
+ *    The number of significant limbs of the value, which is zero for a
+ *    value of zero. If this exceeds @a aCapacity, @a errno is set to
+ *    ERANGE and @a aLimbs holds only the least significant @a
+ *    aCapacity limbs of the value.
+ *
+ *  @sa strntoul
+ *  @sa strntobig_limbs
+ *
+ */
+size_t
+strntobig(const char *aString, size_t aLength, char **aEnd, int aBase, uint64_t *aLimbs, size_t aCapacity)
+{
+    const char * const lLimit = aString + aLength;
+    const char *       p      = aString;
+    const char *       lDigits;
+    const char *       lSignificant;
+    unsigned int       lBase;
+    unsigned int       lBits  = 0;
+    size_t             lRetval;
+
+    if ((aBase != 0) && ((aBase < 2) || (aBase > 36)))
+    {
+        errno = EINVAL;
+
+        if (aEnd != nullptr)
+        {
+            *aEnd = const_cast<char *>(aString);
+        }
+
+        return (0);
+    }
+
+    while ((p < lLimit) && isspace(*p))
+    {
+        p++;
+    }
+
+    if ((p < lLimit) && (*p == '+'))
+    {
+        p++;
+    }
+
+    lBase = static_cast<unsigned int>(aBase);
+
+    // Only consume a "0x" prefix if a hexadecimal digit follows it;
+    // otherwise, the "0" is the value.
+
+    if (((aBase == 0) || (aBase == 16)) && ((lLimit - p) > 2) && (p[0] == '0') && ((p[1] | 0x20) == 'x') &&
+        (StrNToUL::Kernel::DigitValue(p[2]) < 16))
+    {
+        p += 2;
+        lBase = 16;
+    }
+    else if (aBase == 0)
+    {
+        lBase = (((p < lLimit) && (*p == '0')) ? 8 : 10);
+    }
+
+    lDigits = p;
+
+    while ((p < lLimit) && (*p == '0'))
+    {
+        p++;
+    }
+
+    lSignificant = p;
+
+    while ((p < lLimit) && (StrNToUL::Kernel::DigitValue(*p) < lBase))
+    {
+        p++;
+    }
+
+    if (aEnd != nullptr)
+    {
+        *aEnd = const_cast<char *>((p == lDigits) ? aString : p);
+    }
+
+    if (p == lSignificant)
+    {
+        return (0);
+    }
+
+    if ((lBase & (lBase - 1)) == 0)
+    {
+        lBits = static_cast<unsigned int>(__builtin_ctz(lBase));
+
+        lRetval = Pack(lSignificant, static_cast<size_t>(p - lSignificant), lBits, aLimbs, aCapacity);
+    }
+    else
+    {
+        lRetval = Convert(lSignificant, static_cast<size_t>(p - lSignificant), lBase, aLimbs, aCapacity);
+    }
+
+    if (lRetval > aCapacity)
+    {
+        errno = ERANGE;
+    }
+
+    return (lRetval);
+}
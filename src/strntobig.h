@@ -0,0 +1,44 @@
+/*
+ *    Copyright (c) 2024 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *    @file
+ *      This file defines an interface, strntobig, for converting
+ *      bounded, potentially non-null-terminated strings of arbitrary
+ *      length into multi-limb unsigned integers.
+ *
+ */
+
+#ifndef STRNTOBIG_H
+#define STRNTOBIG_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern size_t strntobig(const char *aString, size_t aLength, char **aEnd, int aBase, uint64_t *aLimbs, size_t aCapacity);
+extern size_t strntobig_limbs(size_t aDigits, int aBase);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STRNTOBIG_H */
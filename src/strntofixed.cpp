@@ -0,0 +1,351 @@
+/*
+ *    Copyright (c) 2024 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *    @file
+ *      This file implements an interface, strntofixed, for converting
+ *      bounded, potentially non-null-terminated decimal strings with
+ *      a fractional part directly into scaled, fixed-point integers,
+ *      without an intermediate, and inexact, floating-point value.
+ *
+ *      Both the integer and the fractional digits are converted with
+ *      the decimal kernel. Since at most 19 significant integer digits
+ *      and 18 fractional digits can contribute to an int64_t, each part
+ *      is a single, bounded run and the only multi-precision step is
+ *      the final scale-and-add, which is checked for overflow.
+ *
+ */
+
+#include "strntofixed.h"
+
+#include <ctype.h>
+#include <errno.h>
+#include <limits.h>
+
+#include "strntoul/strntoul-kernel.h"
+
+namespace
+{
+
+/**
+ *  The most decimal digits that always fit in a uint64_t.
+ *
+ */
+const size_t kMaximumDigits = 19;
+
+const uint64_t kPowersOfTen[STRNTOFIXED_SCALE_MAX + 1] = {
+    UINT64_C(1),
+    UINT64_C(10),
+    UINT64_C(100),
+    UINT64_C(1000),
+    UINT64_C(10000),
+    UINT64_C(100000),
+    UINT64_C(1000000),
+    UINT64_C(10000000),
+    UINT64_C(100000000),
+    UINT64_C(1000000000),
+    UINT64_C(10000000000),
+    UINT64_C(100000000000),
+    UINT64_C(1000000000000),
+    UINT64_C(10000000000000),
+    UINT64_C(100000000000000),
+    UINT64_C(1000000000000000),
+    UINT64_C(10000000000000000),
+    UINT64_C(100000000000000000),
+    UINT64_C(1000000000000000000)
+};
+
+}; // namespace
+
+/**
+ *  Return the value of @a aCharacter as a decimal digit, or a value
+ *  of ten or more if it is not one.
+ *
+ */
+static inline unsigned int
+DecimalValue(const char &aCharacter)
+{
+    return (static_cast<unsigned int>(static_cast<unsigned char>(aCharacter)) - '0');
+}
+
+/**
+ *  Return the number of leading decimal digits in the at most @a
+ *  aLength bytes at @a aString.
+ *
+ */
+static size_t
+SkipDigits(const char *aString, const size_t &aLength, bool &aNonZero)
+{
+    size_t i;
+
+    for (i = 0; i < aLength; i++)
+    {
+        const unsigned int lDigit = DecimalValue(aString[i]);
+
+        if (lDigit >= 10)
+            break;
+
+        aNonZero |= (lDigit != 0);
+    }
+
+    return (i);
+}
+
+/**
+ *  Convert the leading run of decimal digits, up to @a aLength, which
+ *  must be no more than kMaximumDigits, at @a aString.
+ *
+ *  @returns
+ *    The number of digits converted.
+ *
+ */
+static size_t
+ConvertRun(const char *aString, const size_t &aLength, uint64_t &aValue)
+{
+    uint64_t lValue = 0;
+    size_t   i      = 0;
+
+#if STRNTOUL_USE_DECIMAL_KERNEL
+    // A radix point at the end of the input, or a scale of zero,
+    // leaves no fraction digits to convert and aString possibly one
+    // past the end of the caller's buffer, where the kernel must not
+    // load.
+
+    if (aLength > 0)
+    {
+        i = StrNToUL::Kernel::ConvertDecimal(aString, aLength, lValue);
+    }
+#endif // STRNTOUL_USE_DECIMAL_KERNEL
+
+    for (; i < aLength; i++)
+    {
+        const unsigned int lDigit = DecimalValue(aString[i]);
+
+        if (lDigit >= 10)
+            break;
+
+        lValue = (lValue * 10) + lDigit;
+    }
+
+    aValue = lValue;
+
+    return (i);
+}
+
+static int64_t
+_strntofixed(const char *aString, const size_t &aLength, char **aEnd, const unsigned int &aScale, const strntofixed_policy_t &aPolicy)
+{
+    const char * const lLast           = aString + aLength;
+    const char *       p               = aString;
+    bool               isNegative      = false;
+    bool               wouldOverflow   = false;
+    bool               excessNonZero   = false;
+    size_t             lIntegerDigits  = 0;
+    size_t             lFractionDigits = 0;
+    uint64_t           lInteger        = 0;
+    uint64_t           lFraction       = 0;
+    uint64_t           lMagnitude      = 0;
+    uint64_t           lLimit;
+    int64_t            lRetval         = 0;
+
+
+    if ((aScale > STRNTOFIXED_SCALE_MAX) ||
+        ((aPolicy != STRNTOFIXED_TRUNCATE) &&
+         (aPolicy != STRNTOFIXED_ROUND)    &&
+         (aPolicy != STRNTOFIXED_REJECT)))
+    {
+        errno = EINVAL;
+        goto none;
+    }
+
+    // Skip any leading space and determine the sign, if any, exactly
+    // as strntol does.
+
+    while ((p < lLast) && isspace(*p))
+    {
+        p++;
+    }
+
+    if ((p < lLast) && ((*p == '-') || (*p == '+')))
+    {
+        isNegative = (*p == '-');
+
+        p++;
+    }
+
+    // Integer part: leading zeroes contribute nothing, beyond which
+    // more than kMaximumDigits significant digits cannot fit.
+
+    while ((p < lLast) && (*p == '0'))
+    {
+        lIntegerDigits++;
+
+        p++;
+    }
+
+    if (p < lLast)
+    {
+        const size_t lAvailable = static_cast<size_t>(lLast - p);
+        const size_t lDigits    = ConvertRun(p, ((lAvailable < kMaximumDigits) ? lAvailable : kMaximumDigits), lInteger);
+        bool         lIgnored   = false;
+
+        p              += lDigits;
+        lIntegerDigits += lDigits;
+
+        if (lDigits == kMaximumDigits)
+        {
+            const size_t lExcess = SkipDigits(p, static_cast<size_t>(lLast - p), lIgnored);
+
+            wouldOverflow   = (lExcess > 0);
+            p              += lExcess;
+            lIntegerDigits += lExcess;
+        }
+    }
+
+    // Fractional part: the first aScale digits are significant and the
+    // first beyond those decides any rounding.
+
+    if ((p < lLast) && (*p == '.'))
+    {
+        const char * const lFraction0 = p + 1;
+        const size_t       lAvailable = static_cast<size_t>(lLast - lFraction0);
+        const size_t       lDigits    = ConvertRun(lFraction0, ((lAvailable < aScale) ? lAvailable : aScale), lFraction);
+
+        lFractionDigits = lDigits;
+
+        if (lDigits == aScale)
+        {
+            const char * const lExcess0 = lFraction0 + lDigits;
+            const size_t       lExcess  = SkipDigits(lExcess0, static_cast<size_t>(lLast - lExcess0), excessNonZero);
+
+            if ((aPolicy == STRNTOFIXED_ROUND) && (lExcess > 0) && (DecimalValue(*lExcess0) >= 5))
+            {
+                lFraction++;
+            }
+
+            lFractionDigits += lExcess;
+        }
+        else
+        {
+            lFraction *= kPowersOfTen[aScale - lDigits];
+        }
+
+        // A lone radix point, without any digits on either side, is
+        // not a number; one following integer digits is consumed.
+
+        if ((lIntegerDigits > 0) || (lFractionDigits > 0))
+        {
+            p = lFraction0 + lFractionDigits;
+        }
+    }
+
+    if ((lIntegerDigits == 0) && (lFractionDigits == 0))
+    {
+        goto none;
+    }
+
+    if ((aPolicy == STRNTOFIXED_REJECT) && excessNonZero)
+    {
+        errno = EINVAL;
+        goto none;
+    }
+
+    // Scale and combine the parts, which for the largest scales may
+    // carry, by way of rounding, into the integer part.
+
+    lLimit = (isNegative) ? (static_cast<uint64_t>(INT64_MAX) + 1) : static_cast<uint64_t>(INT64_MAX);
+
+    wouldOverflow = (wouldOverflow ||
+                     __builtin_mul_overflow(lInteger, kPowersOfTen[aScale], &lMagnitude) ||
+                     __builtin_add_overflow(lMagnitude, lFraction, &lMagnitude) ||
+                     (lMagnitude > lLimit));
+
+    if (wouldOverflow)
+    {
+        errno   = ERANGE;
+        lRetval = (isNegative) ? INT64_MIN : INT64_MAX;
+    }
+    else
+    {
+        lRetval = (isNegative) ? static_cast<int64_t>(0 - lMagnitude) : static_cast<int64_t>(lMagnitude);
+    }
+
+    if (aEnd != nullptr)
+    {
+        *aEnd = const_cast<char *>(p);
+    }
+
+    return (lRetval);
+
+ none:
+    // If no digits were converted, then, as with strntol, aEnd, if
+    // non-null, must be equal to aString.
+
+    if (aEnd != nullptr)
+    {
+        *aEnd = const_cast<char *>(aString);
+    }
+
+    return (0);
+}
+
+/**
+ *  @brief
+ *    Convert a decimal string to a scaled, fixed-point integer.
+ *
+ *  This attempts to convert the initial part of the string in @a
+ *  aString, a decimal number with an optional fractional part, such
+ *  as "-12.345", to its value multiplied by 10^@a aScale, such as
+ *  -12345 for a scale of three. Leading white space and sign are
+ *  handled as by strntol. At least one digit, on either side of an
+ *  optional radix point, is required.
+ *
+ *  Fractional digits beyond @a aScale are always consumed and are
+ *  then handled according to @a aPolicy: discarded, rounded half away
+ *  from zero, or, unless they are all zero, rejected.
+ *
+ *  The conversion continues up to @a aLength, a terminating null, or
+ *  until an invalid character is encountered, whichever is less.
+ *
+ *  @param[in]   aString  A pointer to the string to convert.
+ *  @param[in]   aLength  The maximum number of characters, in bytes,
+ *                        of @a aString to process.
+ *  @param[out]  aEnd     A pointer to storage for the first invalid
+ *                        or the last valid character in @a aString.
+ *  @param[in]   aScale   The number of fractional decimal digits in
+ *                        the result, up to STRNTOFIXED_SCALE_MAX.
+ *  @param[in]   aPolicy  The policy for fractional digits beyond @a
+ *                        aScale.
+ *
+ *  @returns
+ *    The scaled result of the conversion, unless the value would
+ *    underflow or overflow. If an underflow occurs, this returns
+ *    INT64_MIN. If an overflow occurs, this returns INT64_MAX. In
+ *    both cases, errno is set to ERANGE. If @a aScale or @a aPolicy
+ *    is invalid, or if @a aPolicy is STRNTOFIXED_REJECT and there are
+ *    non-zero digits beyond @a aScale, this returns zero (0), sets @a
+ *    aEnd to @a aString, and sets errno to EINVAL.
+ *
+ *  @sa strntol
+ *
+ */
+int64_t
+strntofixed(const char *aString, size_t aLength, char **aEnd, unsigned int aScale, strntofixed_policy_t aPolicy)
+{
+    return (_strntofixed(aString, aLength, aEnd, aScale, aPolicy));
+}
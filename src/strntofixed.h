@@ -0,0 +1,62 @@
+/*
+ *    Copyright (c) 2024 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *    @file
+ *      This file defines an interface, strntofixed, for converting
+ *      bounded, potentially non-null-terminated decimal strings with
+ *      a fractional part directly into scaled, fixed-point integers.
+ *
+ */
+
+#ifndef STRNTOFIXED_H
+#define STRNTOFIXED_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ *  The largest supported scale, for which 10^scale still fits in an
+ *  int64_t.
+ *
+ */
+#define STRNTOFIXED_SCALE_MAX 18
+
+/**
+ *  The policies for fractional digits beyond the scale.
+ *
+ */
+typedef enum strntofixed_policy
+{
+    STRNTOFIXED_TRUNCATE = 0,    //!< Discard them, rounding toward zero.
+    STRNTOFIXED_ROUND    = 1,    //!< Round half away from zero.
+    STRNTOFIXED_REJECT   = 2     //!< Fail the conversion unless they are
+                                 //!< all zero.
+} strntofixed_policy_t;
+
+extern int64_t strntofixed(const char *aString, size_t aLength, char **aEnd, unsigned int aScale, strntofixed_policy_t aPolicy);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STRNTOFIXED_H */
@@ -25,87 +25,8 @@
 
 #include "strntol.h"
 
-#include <ctype.h>
-#include <errno.h>
-#include <limits.h>
-
-#include "strntoul.h"
-
-static long
-_strntol(const char *aString, const size_t &aLength, char **aEnd, const int &aBase)
-{
-    const char *  p             = aString;
-    bool          calledStrtoul = false;
-    bool          isNegative    = false;
-    signed long   lRetval       = 0;
-
-
-    if (aLength == 0)
-    {
-        goto done;
-    }
-
-    // Skip any leading space and determine the sign, if any.
-
-    while ((p < (aString + aLength)) && isspace(*p))
-    {
-        p++;
-    }
-
-    if (p < (aString + aLength))
-    {
-        unsigned long lResult;
-
-        if (*p == '-')
-        {
-            isNegative = true;
-
-            p++;
-
-            lResult = strntoul(p,
-                               aLength - static_cast<size_t>(p - aString),
-                               aEnd,
-                               aBase);
-            lRetval = static_cast<long>(-lResult);
-        }
-        else
-        {
-            if (*p == '+')
-            {
-                p++;
-            }
-
-            lResult = strntoul(p,
-                               aLength - static_cast<size_t>(p - aString),
-                               aEnd,
-                               aBase);
-            lRetval = static_cast<long>(lResult);
-        }
-
-        calledStrtoul = true;
-    }
-
- done:
-    // If no digits were converted, then the standard says that aEnd,
-    // if non-null, must be equal to aString.
-
-    if ((lRetval == 0) && ((aEnd != nullptr) && (!calledStrtoul || (p == *aEnd))))
-    {
-        *aEnd = const_cast<char *>(aString);
-    }
-
-    // If the correct value is outside the range of representable
-    // values, the standards says LONG_MIN or LONG_MAX shall be
-    // returned (according to the sign of the value), and errno set to
-    // ERANGE (which was set from strtoul).
-
-    if (errno == ERANGE)
-    {
-        lRetval = (isNegative) ? LONG_MIN : LONG_MAX;
-    }
-
-    return (lRetval);
-}
+#include "strntoul/strntoul-core.h"
+#include "strntoul-latency.h"
 
 /**
  *  @brief
@@ -147,5 +68,9 @@ _strntol(const char *aString, const size_t &aLength, char **aEnd, const int &aBa
 long
 strntol(const char *aString, size_t aLength, char **aEnd, int aBase)
 {
-    return (_strntol(aString, aLength, aEnd, aBase));
+#if STRNTOUL_USE_LATENCY_HISTOGRAMS
+    const StrNToUL::Latency::Sample lSample(aLength, aBase);
+
+#endif // STRNTOUL_USE_LATENCY_HISTOGRAMS
+    return (StrNToUL::Core::ConvertSigned<long, unsigned long>(aString, aLength, aEnd, aBase));
 }
@@ -0,0 +1,61 @@
+/*
+ *    Copyright (c) 2024 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *    @file
+ *      This file implements a "missing" C99 interface for strntoll
+ *      which adds a length parameter to the standard strtoll.
+ *
+ */
+
+#include "strntoll.h"
+
+#include "strntoul/strntoul-core.h"
+
+/**
+ *  @brief
+ *    Convert a string to a long long integer.
+ *
+ *  This function is identical to strntol, except that the result is
+ *  a long long, which is at least 64 bits wide on every target,
+ *  including those on which long is 32 bits wide.
+ *
+ *  @param[in]   aString  A pointer to the string to convert.
+ *  @param[in]   aLength  The maximum number of characters, in bytes,
+ *                        of @a aString to process.
+ *  @param[out]  aEnd     A pointer to storage for the first invalid
+ *                        or the last valid character in @a aString.
+ *  @param[in]   aBase    The base to use to interpret @a aString for
+ *                        the conversion in the range 2 to 36,
+ *                        inclusive.
+ *
+ *  @returns
+ *    The result of the conversion, unless the value would underflow
+ *    or overflow. If an underflow occurs, this returns LLONG_MIN. If
+ *    an overflow occurs, this returns LLONG_MAX. In both cases, errno
+ *    is set to ERANGE.
+ *
+ *  @sa strtoll
+ *  @sa strntol
+ *
+ */
+long long
+strntoll(const char *aString, size_t aLength, char **aEnd, int aBase)
+{
+    return (StrNToUL::Core::ConvertSigned<long long, unsigned long long>(aString, aLength, aEnd, aBase));
+}
@@ -0,0 +1,237 @@
+/*
+ *    Copyright (c) 2024 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+
+/**
+ *    @file
+ *      This file defines the private, incremental conversion of
+ *      delimited fields shared by the ingestion and follow interfaces,
+ *      which receive their input one buffer at a time and so must
+ *      carry a field split across two buffers from one to the next.
+ *
+ */
+
+#ifndef STRNTOUL_FIELDS_H
+#define STRNTOUL_FIELDS_H
+
+#include <ctype.h>
+#include <errno.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "strntoul.h"
+#include "strntoul/strntoul-kernel.h"
+
+namespace StrNToUL
+{
+
+namespace Fields
+{
+
+/**
+ *  The maximum length, in bytes, of a field carried from one buffer to
+ *  the next. A longer field is invalid.
+ *
+ */
+static constexpr size_t kCarryMax = 4096;
+
+/**
+ *  The conversion state, including any field carried from one buffer
+ *  to the next.
+ *
+ */
+struct Converter
+{
+    char            mDelimiter;
+    int             mBase;
+    unsigned long * mValues;
+    size_t          mCount;
+    size_t          mValid;
+    size_t          mInvalid;
+    bool            mOutOfRange;
+    char            mCarry[kCarryMax];
+    size_t          mCarryLength;
+    bool            mCarrying;
+    bool            mCarryOverlong;
+};
+
+/**
+ *  Convert a single field, which must consist of a value, optionally
+ *  surrounded by white space, and nothing else.
+ *
+ *  @returns
+ *    True if the field was valid and in range; otherwise, false.
+ *
+ */
+static inline bool
+ConvertField(const char *aField, const size_t &aLength, const int &aBase, unsigned long &aValue, bool &aOutOfRange)
+{
+    const int lSavedErrno = errno;
+    char *    lEnd;
+    bool      lRetval;
+
+#if STRNTOUL_USE_DECIMAL_KERNEL
+    // Most fields are short, bare decimal values, which the kernel
+    // converts entirely without any of the setup strntoul requires.
+
+    if ((aBase == 10) && (aLength <= StrNToUL::Kernel::kWindowSize))
+    {
+        if (StrNToUL::Kernel::ConvertDecimal(aField, aLength, aValue) == aLength)
+        {
+            return (true);
+        }
+    }
+#endif // STRNTOUL_USE_DECIMAL_KERNEL
+
+    errno = 0;
+
+    aValue = strntoul(aField, aLength, &lEnd, aBase);
+
+    if (errno == ERANGE)
+    {
+        aOutOfRange = true;
+        lRetval     = false;
+    }
+    else if (lEnd == aField)
+    {
+        lRetval = false;
+    }
+    else
+    {
+        while ((lEnd < (aField + aLength)) && isspace(*lEnd))
+        {
+            lEnd++;
+        }
+
+        lRetval = (lEnd == (aField + aLength));
+    }
+
+    errno = lSavedErrno;
+
+    return (lRetval);
+}
+
+static inline void
+Field(Converter &aConverter, const char *aField, const size_t &aLength)
+{
+    unsigned long lValue = 0;
+
+    if (aLength == 0)
+    {
+        return;
+    }
+
+    if (ConvertField(aField, aLength, aConverter.mBase, lValue, aConverter.mOutOfRange))
+    {
+        aConverter.mValues[aConverter.mCount++] = lValue;
+        aConverter.mValid++;
+    }
+    else
+    {
+        aConverter.mInvalid++;
+    }
+}
+
+static inline void
+Carry(Converter &aConverter, const char *aData, const size_t &aLength)
+{
+    // A field too long to be carried could not have been a valid
+    // value anyway, so it need only be remembered as invalid.
+
+    if (aLength > (kCarryMax - aConverter.mCarryLength))
+    {
+        aConverter.mCarryOverlong = true;
+    }
+    else
+    {
+        memcpy(&aConverter.mCarry[aConverter.mCarryLength], aData, aLength);
+
+        aConverter.mCarryLength += aLength;
+    }
+
+    aConverter.mCarrying = true;
+}
+
+static inline void
+Flush(Converter &aConverter)
+{
+    if (aConverter.mCarryOverlong)
+    {
+        aConverter.mInvalid++;
+    }
+    else
+    {
+        Field(aConverter, aConverter.mCarry, aConverter.mCarryLength);
+    }
+
+    aConverter.mCarryLength   = 0;
+    aConverter.mCarrying      = false;
+    aConverter.mCarryOverlong = false;
+}
+
+/**
+ *  Convert the fields of one buffer into the converter's values,
+ *  completing any field carried from the last buffer and carrying any
+ *  incomplete one at the end of this buffer to the next.
+ *
+ */
+static inline void
+Convert(Converter &aConverter, const char *aData, const size_t &aLength)
+{
+    const char * const lLast = aData + aLength;
+    const char *       p     = aData;
+
+    aConverter.mCount = 0;
+
+    if (aConverter.mCarrying)
+    {
+        const char * lDelimiter = static_cast<const char *>(memchr(p, aConverter.mDelimiter, aLength));
+
+        Carry(aConverter, p, static_cast<size_t>(((lDelimiter != nullptr) ? lDelimiter : lLast) - p));
+
+        if (lDelimiter == nullptr)
+        {
+            return;
+        }
+
+        Flush(aConverter);
+
+        p = lDelimiter + 1;
+    }
+
+    while (p < lLast)
+    {
+        const char * lDelimiter = static_cast<const char *>(memchr(p, aConverter.mDelimiter, static_cast<size_t>(lLast - p)));
+
+        if (lDelimiter == nullptr)
+        {
+            Carry(aConverter, p, static_cast<size_t>(lLast - p));
+            break;
+        }
+
+        Field(aConverter, p, static_cast<size_t>(lDelimiter - p));
+
+        p = lDelimiter + 1;
+    }
+}
+
+}; // namespace Fields
+
+}; // namespace StrNToUL
+
+#endif // STRNTOUL_FIELDS_H
@@ -0,0 +1,179 @@
+/*
+ *    Copyright (c) 2024 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+
+/**
+ *    @file
+ *      This file defines private, inline interfaces for sampling the
+ *      latency of conversions into per-thread histograms, when the
+ *      package is configured with --enable-latency-histograms.
+ *
+ *      Each thread counts down to its next sample, so an unsampled
+ *      call costs one thread-local decrement. A sampled call is timed
+ *      with the time-stamp counter, serialized on either side, where
+ *      one is available, and with the monotonic clock otherwise.
+ *
+ */
+
+#ifndef STRNTOUL_LATENCY_PRIVATE_H
+#define STRNTOUL_LATENCY_PRIVATE_H
+
+#if HAVE_CONFIG_H && !defined(STRNTOUL_INLINE)
+#include "strntoul-config.h"
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(STRNTOUL_ENABLE_LATENCY_HISTOGRAMS) && !defined(STRNTOUL_INLINE)
+#define STRNTOUL_USE_LATENCY_HISTOGRAMS 1
+#else
+#define STRNTOUL_USE_LATENCY_HISTOGRAMS 0
+#endif
+
+#if STRNTOUL_USE_LATENCY_HISTOGRAMS
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define STRNTOUL_LATENCY_USE_TSC 1
+#else
+#include <time.h>
+#define STRNTOUL_LATENCY_USE_TSC 0
+#endif
+
+// Within a shared library, the default thread-local storage model
+// calls into the dynamic linker on each access, which would dwarf
+// the cost of an unsampled call.
+
+#if defined(__GNUC__) || defined(__clang__)
+#define STRNTOUL_LATENCY_TLS_MODEL __attribute__((tls_model("initial-exec")))
+#else
+#define STRNTOUL_LATENCY_TLS_MODEL
+#endif
+
+namespace StrNToUL
+{
+
+namespace Latency
+{
+
+extern thread_local unsigned int tCountdown STRNTOUL_LATENCY_TLS_MODEL;
+
+extern bool Begin(void);
+extern void End(size_t aLength, int aBase, uint64_t aTicks);
+
+/**
+ *  @brief
+ *    Return the current tick, at the start of a sample.
+ *
+ *  The fence ensures that earlier instructions have completed before
+ *  the time-stamp counter is read.
+ *
+ */
+static inline uint64_t
+StartTick(void)
+{
+#if STRNTOUL_LATENCY_USE_TSC
+    _mm_lfence();
+
+    return (__rdtsc());
+#else
+    struct timespec lNow;
+
+    clock_gettime(CLOCK_MONOTONIC, &lNow);
+
+    return ((static_cast<uint64_t>(lNow.tv_sec) * 1000000000U) + static_cast<uint64_t>(lNow.tv_nsec));
+#endif
+}
+
+/**
+ *  @brief
+ *    Return the current tick, at the end of a sample.
+ *
+ *  The time-stamp counter is read with rdtscp, which waits for the
+ *  conversion to complete, and the fence keeps later instructions
+ *  from starting before it is read.
+ *
+ */
+static inline uint64_t
+StopTick(void)
+{
+#if STRNTOUL_LATENCY_USE_TSC
+    unsigned int lProcessor;
+    uint64_t     lRetval;
+
+    lRetval = __rdtscp(&lProcessor);
+
+    _mm_lfence();
+
+    return (lRetval);
+#else
+    return (StartTick());
+#endif
+}
+
+/**
+ *  A scoped sample of the latency of one conversion, which records
+ *  nothing unless the calling thread's countdown has expired.
+ *
+ */
+class Sample
+{
+public:
+    Sample(const size_t &aLength, const int &aBase) :
+        mLength(aLength),
+        mBase(aBase),
+        mSampling(false),
+        mStart(0)
+    {
+        if (__builtin_expect(--tCountdown == 0, 0))
+        {
+            mSampling = Begin();
+
+            if (mSampling)
+            {
+                mStart = StartTick();
+            }
+        }
+    }
+
+    ~Sample(void)
+    {
+        if (__builtin_expect(mSampling, 0))
+        {
+            End(mLength, mBase, StopTick() - mStart);
+        }
+    }
+
+private:
+    Sample(const Sample &) = delete;
+    Sample &operator =(const Sample &) = delete;
+
+    const size_t mLength;
+    const int    mBase;
+    bool         mSampling;
+    uint64_t     mStart;
+};
+
+}; // namespace Latency
+
+}; // namespace StrNToUL
+
+#endif // STRNTOUL_USE_LATENCY_HISTOGRAMS
+
+#endif // STRNTOUL_LATENCY_PRIVATE_H
@@ -0,0 +1,328 @@
+/*
+ *    Copyright (c) 2021-2024 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *    @file
+ *      This file defines the private narrowing step shared by the wide
+ *      character variants of the strntoul family of interfaces.
+ *
+ *      Rather than transcoding an entire wide string, leading white
+ *      space and zeroes are skipped in place and only the run of code
+ *      units that follows and could be part of a number (ASCII white
+ *      space, signs, digits, and letters) is narrowed, 16 units at a
+ *      time with SSE2 saturating packs, into a fixed stack buffer and
+ *      converted there by the narrow conversion core. Any other code
+ *      unit, including any outside of ASCII, ends the run and, so, the
+ *      conversion, exactly as an invalid byte would. Significant
+ *      digits beyond the buffer overflow any result and are only
+ *      counted.
+ *
+ */
+
+#ifndef STRNTOUL_NARROW_H
+#define STRNTOUL_NARROW_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "strntoul/strntoul-kernel.h"
+
+namespace StrNToUL
+{
+
+namespace Narrow
+{
+
+// The number of code units narrowed onto the stack. After a sign, a
+// prefix, and at most two leading zeroes, this leaves room for far
+// more significant digits than any result, of up to 128 bits, holds
+// in any base.
+
+static constexpr size_t kBufferSize = 256;
+
+// The number of code units narrowed at once.
+
+static constexpr size_t kBlockSize  = 16;
+
+/**
+ *  Return whether the code unit @a aUnit is ASCII white space.
+ *
+ */
+static inline bool
+IsSpaceUnit(const uint32_t &aUnit)
+{
+    return (((aUnit >= '\t') && (aUnit <= '\r')) || (aUnit == ' '));
+}
+
+/**
+ *  Return whether the code unit @a aUnit could be part of a number.
+ *
+ */
+static inline bool
+IsNumberUnit(const uint32_t &aUnit)
+{
+    const uint32_t lLower = (aUnit | 0x20);
+
+    return (((aUnit >= '0') && (aUnit <= '9'))   ||
+            ((lLower >= 'a') && (lLower <= 'z')) ||
+            ((aUnit >= '\t') && (aUnit <= '\r')) ||
+            (aUnit == ' ')                       ||
+            (aUnit == '+')                       ||
+            (aUnit == '-'));
+}
+
+#if defined(__SSE2__)
+/**
+ *  Return, for each of 16 bytes, all ones if the byte is within @a
+ *  aFirst to @a aLast, inclusive; otherwise, zero.
+ *
+ */
+static inline __m128i
+InRange(const __m128i &aBytes, const char &aFirst, const char &aLast)
+{
+    const __m128i lOffsets = _mm_sub_epi8(aBytes, _mm_set1_epi8(aFirst));
+
+    return (_mm_cmpeq_epi8(_mm_min_epu8(lOffsets, _mm_set1_epi8(static_cast<char>(aLast - aFirst))), lOffsets));
+}
+
+/**
+ *  Return a mask with bit i set if byte i of @a aBytes is not one that
+ *  could be part of a number.
+ *
+ */
+static inline unsigned int
+NonNumberMask(const __m128i &aBytes)
+{
+    __m128i lValid;
+
+    lValid = InRange(aBytes, '0', '9');
+    lValid = _mm_or_si128(lValid, InRange(_mm_or_si128(aBytes, _mm_set1_epi8(0x20)), 'a', 'z'));
+    lValid = _mm_or_si128(lValid, InRange(aBytes, '\t', '\r'));
+    lValid = _mm_or_si128(lValid, _mm_cmpeq_epi8(aBytes, _mm_set1_epi8(' ')));
+    lValid = _mm_or_si128(lValid, _mm_cmpeq_epi8(aBytes, _mm_set1_epi8('+')));
+    lValid = _mm_or_si128(lValid, _mm_cmpeq_epi8(aBytes, _mm_set1_epi8('-')));
+
+    return (~static_cast<unsigned int>(_mm_movemask_epi8(lValid)) & 0xFFFF);
+}
+
+/**
+ *  Narrow 16 code units of @a kUnitSize bytes each to bytes.
+ *
+ *  The packs saturate, so every code unit outside of ASCII becomes
+ *  either 0x00 or a byte of at least 0x80, neither of which could be
+ *  part of a number, rather than aliasing an ASCII byte.
+ *
+ */
+template <size_t kUnitSize>
+static inline __m128i
+Pack(const void *aUnits)
+{
+    const __m128i *lUnits = static_cast<const __m128i *>(aUnits);
+
+    static_assert((kUnitSize == 2) || (kUnitSize == 4), "Only 16- and 32-bit code units are supported");
+
+    if (kUnitSize == 2)
+    {
+        return (_mm_packus_epi16(_mm_loadu_si128(&lUnits[0]),
+                                 _mm_loadu_si128(&lUnits[1])));
+    }
+
+    return (_mm_packus_epi16(_mm_packs_epi32(_mm_loadu_si128(&lUnits[0]),
+                                             _mm_loadu_si128(&lUnits[1])),
+                             _mm_packs_epi32(_mm_loadu_si128(&lUnits[2]),
+                                             _mm_loadu_si128(&lUnits[3]))));
+}
+#endif // defined(__SSE2__)
+
+/**
+ *  Narrow the leading run of code units at @a aString, up to @a
+ *  aLength, that could be part of a number into @a aBuffer, which
+ *  must have room for @a aLength bytes.
+ *
+ *  @returns
+ *    The number of code units narrowed.
+ *
+ */
+template <typename CharT>
+static inline size_t
+NarrowUnits(const CharT *aString, const size_t &aLength, char *aBuffer)
+{
+    size_t i = 0;
+
+#if defined(__SSE2__)
+    while ((aLength - i) >= kBlockSize)
+    {
+        const __m128i      lBytes = Pack<sizeof (CharT)>(aString + i);
+        const unsigned int lStops = NonNumberMask(lBytes);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(aBuffer + i), lBytes);
+
+        if (lStops != 0)
+        {
+            return (i + static_cast<size_t>(__builtin_ctz(lStops)));
+        }
+
+        i += kBlockSize;
+    }
+#endif // defined(__SSE2__)
+
+    while (i < aLength)
+    {
+        const uint32_t lUnit = static_cast<uint32_t>(aString[i]);
+
+        if (!IsNumberUnit(lUnit))
+            break;
+
+        aBuffer[i] = static_cast<char>(lUnit);
+
+        i++;
+    }
+
+    return (i);
+}
+
+/**
+ *  Convert the wide string @a aString, up to @a aLength code units, in
+ *  @a aBase by narrowing it and converting it with @a aConverter,
+ *  which has the signature of strntoul, with the base bound, and
+ *  returns a @a T.
+ *
+ */
+template <typename T, typename CharT, typename Converter>
+static inline T
+Convert(const CharT *aString, const size_t &aLength, CharT **aEnd, const int &aBase, Converter aConverter)
+{
+    size_t i         = 0;
+    size_t lFirst;
+    bool   lPrefixed = false;
+    char   lBuffer[kBufferSize];
+    size_t lCount    = 0;
+    size_t lZeroes   = 0;
+    size_t lKept;
+    size_t lHead;
+    char * lEnd;
+    size_t lOffset;
+    T      lRetval;
+
+    // Leading white space, however long, is skipped in place rather
+    // than narrowed. Positions are kept as indices, rather than as
+    // pointers, as a null-terminated string may be passed with a
+    // length, such as SIZE_MAX, that is no bound at all.
+
+    while ((i < aLength) && IsSpaceUnit(static_cast<uint32_t>(aString[i])))
+    {
+        i++;
+    }
+
+    lFirst = i;
+
+    if ((i < aLength) && ((aString[i] == '+') || (aString[i] == '-')))
+    {
+        lBuffer[lCount++] = static_cast<char>(aString[i++]);
+    }
+
+    // A zero followed by 'x' or 'X' is a prefix in a deduced base or
+    // base 16, after which any zeroes are leading zeroes of the value.
+    // Otherwise, any zeroes here are. A run of them is narrowed to at
+    // most one zero after a prefix or two without one, which keeps
+    // both the value and whether a prefix follows, and the rest are
+    // only counted.
+
+    if (((aBase == 0) || (aBase == 16)) &&
+        ((aLength - i) > 1) && (aString[i] == '0') && ((aString[i + 1] == 'x') || (aString[i + 1] == 'X')))
+    {
+        lBuffer[lCount++] = static_cast<char>(aString[i++]);
+        lBuffer[lCount++] = static_cast<char>(aString[i++]);
+
+        lPrefixed = true;
+    }
+
+    while (((i + lZeroes) < aLength) && (aString[i + lZeroes] == '0'))
+    {
+        lZeroes++;
+    }
+
+    lKept = (lPrefixed ? 1 : 2);
+    lKept = ((lZeroes < lKept) ? lZeroes : lKept);
+
+    for (size_t j = 0; j < lKept; j++)
+    {
+        lBuffer[lCount++] = '0';
+    }
+
+    lHead  = lCount;
+    i     += lZeroes;
+
+    lCount += NarrowUnits(aString + i,
+                          (((aLength - i) < (kBufferSize - lCount)) ? (aLength - i) : (kBufferSize - lCount)),
+                          lBuffer + lCount);
+
+    lRetval = aConverter(lBuffer, lCount, &lEnd);
+
+    // Map the end of the conversion back to the wide string, in which
+    // any skipped white space lies before the narrowed sign and any
+    // skipped zeroes lie after the narrowed zeroes.
+
+    lOffset = static_cast<size_t>(lEnd - lBuffer);
+
+    if (lOffset == 0)
+    {
+        i = 0;
+    }
+    else
+    {
+        i = lFirst + lOffset + ((lOffset < lHead) ? 0 : (lZeroes - lKept));
+    }
+
+    // A buffer filled with significant digits, all of them converted,
+    // overflowed any result, so any further digits are only consumed.
+
+    if (lOffset == kBufferSize)
+    {
+        unsigned int lBase = static_cast<unsigned int>(aBase);
+
+        if (lBase == 0)
+        {
+            lBase = (lPrefixed ? 16 : ((lKept > 0) ? 8 : 10));
+        }
+
+        while ((i < aLength) &&
+               (static_cast<uint32_t>(aString[i]) < 0x80) &&
+               (StrNToUL::Kernel::DigitValue(static_cast<char>(aString[i])) < lBase))
+        {
+            i++;
+        }
+    }
+
+    if (aEnd != nullptr)
+    {
+        *aEnd = const_cast<CharT *>(aString + i);
+    }
+
+    return (lRetval);
+}
+
+}; // namespace Narrow
+
+}; // namespace StrNToUL
+
+#endif // STRNTOUL_NARROW_H
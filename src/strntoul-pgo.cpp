@@ -0,0 +1,119 @@
+/*
+ *    Copyright (c) 2024 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+
+/**
+ *    @file
+ *      This file implements the training workload for a
+ *      profile-guided build of the library, which converts each line
+ *      of a representative corpus, as strntoul, strntol, strntoull,
+ *      and strntoll callers would, in each of the common bases.
+ *
+ *      It is built and run only by the --enable-pgo build and is not
+ *      installed.
+ *
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+#include "strntol.h"
+#include "strntoll.h"
+#include "strntoul.h"
+#include "strntoull.h"
+
+// The number of passes over the corpus, which need only be enough for
+// the profile to separate hot paths from cold ones.
+
+static const unsigned int kRounds = 64;
+
+static const int          kBases[] = { 0, 10, 16, 8 };
+
+int
+main(int argc, char *argv[])
+{
+    std::string         lText;
+    std::vector<size_t> lOffsets;
+    std::vector<size_t> lLengths;
+    FILE *              lFile;
+    char *              lLine = nullptr;
+    size_t              lSize = 0;
+    ssize_t             lLength;
+    unsigned long long  lSum  = 0;
+
+    if (argc != 2)
+    {
+        fprintf(stderr, "Usage: %s CORPUS\n", argv[0]);
+        return (EXIT_FAILURE);
+    }
+
+    lFile = fopen(argv[1], "r");
+
+    if (lFile == nullptr)
+    {
+        fprintf(stderr, "Could not open %s: %s\n", argv[1], strerror(errno));
+        return (EXIT_FAILURE);
+    }
+
+    // Store the lines back to back, without their terminators, so
+    // that each conversion is bounded by its length, as for a field
+    // in a larger record.
+
+    while ((lLength = getline(&lLine, &lSize, lFile)) >= 0)
+    {
+        if ((lLength > 0) && (lLine[lLength - 1] == '\n'))
+        {
+            lLength--;
+        }
+
+        lOffsets.push_back(lText.size());
+        lLengths.push_back(static_cast<size_t>(lLength));
+
+        lText.append(lLine, static_cast<size_t>(lLength));
+    }
+
+    free(lLine);
+    fclose(lFile);
+
+    for (unsigned int lRound = 0; lRound < kRounds; lRound++)
+    {
+        for (int lBase : kBases)
+        {
+            for (size_t i = 0; i < lOffsets.size(); i++)
+            {
+                const char * const lString = lText.data() + lOffsets[i];
+                char *             lEnd;
+
+                lSum += strntoul(lString, lLengths[i], &lEnd, lBase);
+                lSum += static_cast<unsigned long long>(lEnd - lString);
+                lSum += static_cast<unsigned long long>(strntol(lString, lLengths[i], &lEnd, lBase));
+                lSum += strntoull(lString, lLengths[i], nullptr, lBase);
+                lSum += static_cast<unsigned long long>(strntoll(lString, lLengths[i], nullptr, lBase));
+            }
+        }
+    }
+
+    printf("Trained on %zu lines, %u rounds (checksum %llx).\n", lOffsets.size(), kRounds, lSum);
+
+    return (EXIT_SUCCESS);
+}
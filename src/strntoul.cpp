@@ -25,254 +25,8 @@
 
 #include "strntoul.h"
 
-#include <ctype.h>
-#include <errno.h>
-#include <limits.h>
-
-
-static int
-HandleBase(const char *&aString, const size_t &aLength, const int &aBase)
-{
-    int lRetval = 0;
-
-    if (aLength > 0)
-    {
-        if (aBase == 0)
-        {
-            // If the caller indicated a base of zero (0), then we
-            // automatically deduce the base from the content.
-
-            if (*aString == '0')
-            {
-                // There is a leading zero (0). The content might be octal
-                // or hexadecimal.
-
-                aString++;
-
-                // Determine if it is hexadecimal or should be assumed
-                // octal.
-
-                if ((aLength > 1) && ((*aString == 'x') || (*aString == 'X')))
-                {
-                    aString++;
-                    lRetval = 16;
-                }
-                else
-                {
-                    lRetval = 8;
-                }
-            }
-            else
-            {
-                lRetval = 10;
-            }
-        }
-        else if (aBase == 16)
-        {
-            lRetval = aBase;
-
-            // If the caller indicated the content is hexadecimal, then
-            // skip any leading '0[xX]', if present.
-
-            if (((aLength > 0) && (aString[0] == '0')) &&
-                ((aLength > 1) && ((aString[1] == 'x') || aString[1] == 'X')))
-            {
-                aString += 2;
-            }
-        }
-        else if ((aBase >=2) && (aBase <= 36))
-        {
-            lRetval = aBase;
-        }
-        else
-        {
-            lRetval = -EINVAL;
-        }
-    }
-
-    return (lRetval);
-}
-
-static unsigned int
-GetDigit(const char &aCharacter)
-{
-    unsigned int lRetval;
-
-    if (isdigit(aCharacter))
-    {
-        lRetval = static_cast<unsigned int>(aCharacter - '0');
-    }
-    else if (isalpha(aCharacter))
-    {
-        if (isupper(aCharacter))
-            lRetval = static_cast<unsigned int>((aCharacter - 'A') + 10);
-        else if (islower(aCharacter))
-            lRetval = static_cast<unsigned int>((aCharacter - 'a') + 10);
-        else
-            lRetval = INT_MAX;
-    }
-    else
-    {
-        lRetval = INT_MAX;
-    }
-
-    return (lRetval);
-}
-
-static unsigned long
-_strntoul(const char *aString, const size_t &aLength, char **aEnd, const int &aBase)
-{
-    const char *  p               = aString;
-    bool          isNegative      = false;
-    bool          wouldOverflow   = false;
-    bool          convertedDigits = false;
-    int           lBase;
-    unsigned long lRetval = 0;
-
-    if (aLength == 0)
-    {
-        goto done;
-    }
-
-    // Skip any leading space and determine the sign, if any.
-
-    while ((p < (aString + aLength)) && isspace(*p))
-    {
-        p++;
-    }
-
-    if (p < (aString + aLength))
-    {
-        if (*p == '-')
-        {
-            isNegative = true;
-            p++;
-        }
-        else if (*p == '+')
-        {
-            p++;
-        }
-    }
-
-    // Handle computing and sanity-checking the base.
-
-    lBase = HandleBase(p, aLength - static_cast<size_t>(p - aString), aBase);
-    if (lBase < 0)
-    {
-        errno   = -lBase;
-        lRetval = 0;
-
-        goto done;
-    }
-
-    // Begin the conversion, based on the base and the available
-    // characters to convert.
-    //
-    // Special case a few, common power-of-two cases in which the
-    // shifts are substantially more efficient than the divides and
-    // multiplies required for the shift-and-accumulate conversion
-    // algorithm.
-
-    if ((lBase == 2) || (lBase == 8) || (lBase == 16))
-    {
-        const unsigned      kShift        = ((lBase == 2) ? 1 :
-                                             ((lBase == 8) ? 3 : 4));
-        const unsigned long lOverflowSentinel = ULONG_MAX >> kShift;
-
-        while (p < (aString + aLength))
-        {
-            const unsigned int lDigit = GetDigit(*p);
-
-            if (lDigit >= static_cast<unsigned int>(lBase))
-                break;
-
-            // Check-and-shift, checking first if the shift would
-            // cause an overflow.
-
-            if (lRetval > lOverflowSentinel)
-            {
-                wouldOverflow = true;
-            }
-
-            lRetval <<= kShift;
-
-            // Check-and-accumulate, checking first if the accumulate
-            // would cause an overflow.
-
-            if (lDigit > (ULONG_MAX - lRetval))
-            {
-                wouldOverflow = true;
-            }
-
-            lRetval += lDigit;
-
-            convertedDigits = true;
-
-            p++;
-        }
-    }
-    else if ((lBase >= 2) && (lBase <= 36))
-    {
-        const unsigned long lOverflowSentinel = ULONG_MAX / static_cast<unsigned int>(lBase);
-
-        while (p < (aString + aLength))
-        {
-            const unsigned int lDigit = GetDigit(*p);
-
-            if (lDigit >= static_cast<unsigned int>(lBase))
-                break;
-
-            // Check-and-shift, checking first if the shift would
-            // cause an overflow.
-
-            if (lRetval > lOverflowSentinel)
-            {
-                wouldOverflow = true;
-            }
-
-            lRetval *= static_cast<unsigned int>(lBase);
-
-            // Check-and-accumulate, checking first if the accumulate
-            // would cause an overflow.
-
-            if (lDigit > (ULONG_MAX - lRetval))
-            {
-                wouldOverflow = true;
-            }
-
-            lRetval += lDigit;
-
-            convertedDigits = true;
-
-            p++;
-        }
-    }
-
- done:
-    // If no digits were converted, then the standard says that aEnd,
-    // if non-null, must be equal to aString.
-
-    if (!convertedDigits)
-    {
-        p = aString;
-    }
-
-    if (aEnd != nullptr)
-    {
-        *aEnd = const_cast<char *>(p);
-    }
-
-    if (wouldOverflow) {
-        errno   = ERANGE;
-        lRetval = ULONG_MAX;
-    }
-
-    if (isNegative) {
-        lRetval = -lRetval;
-    }
-
-    return (lRetval);
-}
+#include "strntoul/strntoul-core.h"
+#include "strntoul-latency.h"
 
 /**
  *  @brief
@@ -336,5 +90,9 @@ _strntoul(const char *aString, const size_t &aLength, char **aEnd, const int &aB
 unsigned long
 strntoul(const char *aString, size_t aLength, char **aEnd, int aBase)
 {
-    return (_strntoul(aString, aLength, aEnd, aBase));
+#if STRNTOUL_USE_LATENCY_HISTOGRAMS
+    const StrNToUL::Latency::Sample lSample(aLength, aBase);
+
+#endif // STRNTOUL_USE_LATENCY_HISTOGRAMS
+    return (StrNToUL::Core::ConvertUnsigned<unsigned long>(aString, aLength, aEnd, aBase));
 }
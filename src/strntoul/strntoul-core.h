@@ -0,0 +1,589 @@
+/*
+ *    Copyright (c) 2021-2024 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *    @file
+ *      This file defines the private conversion core shared by the
+ *      strntoul family of interfaces, specialized at compile time for
+ *      each result width.
+ *
+ *      Short decimal fields, of one to three digits, are converted
+ *      directly, ahead of any white space, sign, or base handling.
+ *      Otherwise, results no wider than 64 bits accumulate one digit at
+ *      a time, with the decimal kernel handling the leading run of
+ *      decimal digits. Wider results would need a multi-word multiply per
+ *      digit, so, outside of the power-of-two bases, their digits are
+ *      instead gathered into 64-bit chunks of as many digits as fit (19
+ *      for decimal), and only each chunk is folded into the result.
+ *
+ */
+
+#ifndef STRNTOUL_CORE_H
+#define STRNTOUL_CORE_H
+
+#include <ctype.h>
+#include <errno.h>
+#include <limits.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "strntoul-kernel.h"
+
+namespace StrNToUL
+{
+
+namespace Core
+{
+
+/**
+ *  Return the largest value representable by the unsigned type @a T.
+ *
+ */
+template <typename T>
+static constexpr T
+Maximum(void)
+{
+    return (static_cast<T>(~static_cast<T>(0)));
+}
+
+/**
+ *  Options for Parse, each of which narrows what it would otherwise
+ *  accept, as strntoul does.
+ *
+ */
+static constexpr unsigned int kNoWhitespace = 0x01; //!< Do not skip leading white space.
+static constexpr unsigned int kNoSign       = 0x02; //!< Do not accept a leading '+' or '-' sign.
+static constexpr unsigned int kNoPrefix     = 0x04; //!< Do not skip a "0x" or "0X" prefix in base 16.
+
+// The base argument to Parse for a base that is not fixed at compile
+// time.
+
+static constexpr int kAnyBase = -1;
+
+static inline int
+HandleBase(const char *&aString, const size_t &aLength, const int &aBase, const unsigned int &aOptions)
+{
+    int lRetval = 0;
+
+    if (aLength > 0)
+    {
+        if (aBase == 0)
+        {
+            // If the caller indicated a base of zero (0), then we
+            // automatically deduce the base from the content.
+
+            if (*aString == '0')
+            {
+                // There is a leading zero (0). The content might be octal
+                // or hexadecimal.
+
+                aString++;
+
+                // Determine if it is hexadecimal or should be assumed
+                // octal.
+
+                if ((aLength > 1) && ((*aString == 'x') || (*aString == 'X')))
+                {
+                    aString++;
+                    lRetval = 16;
+                }
+                else
+                {
+                    lRetval = 8;
+                }
+            }
+            else
+            {
+                lRetval = 10;
+            }
+        }
+        else if (aBase == 16)
+        {
+            lRetval = aBase;
+
+            // If the caller indicated the content is hexadecimal, then
+            // skip any leading '0[xX]', if present and permitted.
+
+            if (((aOptions & kNoPrefix) == 0) &&
+                ((aLength > 0) && (aString[0] == '0')) &&
+                ((aLength > 1) && ((aString[1] == 'x') || aString[1] == 'X')))
+            {
+                aString += 2;
+            }
+        }
+        else if ((aBase >=2) && (aBase <= 36))
+        {
+            lRetval = aBase;
+        }
+        else
+        {
+            lRetval = -EINVAL;
+        }
+    }
+
+    return (lRetval);
+}
+
+static inline unsigned int
+GetDigit(const char &aCharacter)
+{
+    unsigned int lRetval;
+
+    if (isdigit(aCharacter))
+    {
+        lRetval = static_cast<unsigned int>(aCharacter - '0');
+    }
+    else if (isalpha(aCharacter))
+    {
+        if (isupper(aCharacter))
+            lRetval = static_cast<unsigned int>((aCharacter - 'A') + 10);
+        else if (islower(aCharacter))
+            lRetval = static_cast<unsigned int>((aCharacter - 'a') + 10);
+        else
+            lRetval = INT_MAX;
+    }
+    else
+    {
+        lRetval = INT_MAX;
+    }
+
+    return (lRetval);
+}
+
+/**
+ *  Gather the digits valid in @a aBase at @a aCurrent, up to @a aLast,
+ *  into a single 64-bit chunk of as many digits as always fit.
+ *
+ *  @returns
+ *    The number of digits gathered, zero (0) if there were none, with
+ *    the chunk's value in @a aChunk and @a aBase raised to that number
+ *    in @a aScale.
+ *
+ */
+static inline unsigned int
+GatherChunk(const char *aCurrent, const char *aLast, const unsigned int &aBase, uint64_t &aChunk, uint64_t &aScale)
+{
+    static const uint64_t kPowersOfTen[] = {
+        UINT64_C(1),
+        UINT64_C(10),
+        UINT64_C(100),
+        UINT64_C(1000),
+        UINT64_C(10000),
+        UINT64_C(100000),
+        UINT64_C(1000000),
+        UINT64_C(10000000),
+        UINT64_C(100000000),
+        UINT64_C(1000000000),
+        UINT64_C(10000000000),
+        UINT64_C(100000000000),
+        UINT64_C(1000000000000),
+        UINT64_C(10000000000000),
+        UINT64_C(100000000000000),
+        UINT64_C(1000000000000000),
+        UINT64_C(10000000000000000)
+    };
+    const uint64_t    kScaleSentinel = UINT64_MAX / aBase;
+    uint64_t          lChunk         = 0;
+    uint64_t          lScale         = 1;
+    unsigned int      lDigits        = 0;
+
+#if STRNTOUL_USE_DECIMAL_KERNEL
+    if (aBase == 10)
+    {
+        lDigits = StrNToUL::Kernel::ConvertDecimal(aCurrent,
+                                                   static_cast<size_t>(aLast - aCurrent),
+                                                   lChunk);
+        lScale  = kPowersOfTen[lDigits];
+    }
+#endif // STRNTOUL_USE_DECIMAL_KERNEL
+
+    while (((aCurrent + lDigits) < aLast) && (lScale <= kScaleSentinel))
+    {
+        const unsigned int lDigit = GetDigit(aCurrent[lDigits]);
+
+        if (lDigit >= aBase)
+            break;
+
+        lChunk  = (lChunk * aBase) + lDigit;
+        lScale *= aBase;
+
+        lDigits++;
+    }
+
+    aChunk = lChunk;
+    aScale = lScale;
+
+    return (lDigits);
+}
+
+/**
+ *  Convert the initial part of @a aString, as strntoul would, into an
+ *  unsigned magnitude of type @a T and a sign, except as narrowed by
+ *  @a kOptions, a bitwise combination of zero or more of kNoWhitespace,
+ *  kNoSign, and kNoPrefix. A deduced base always accepts a prefix.
+ *
+ *  The base is @a kBase or, if that is kAnyBase, @a aBase. A base
+ *  fixed at compile time resolves the base handling and the choice of
+ *  conversion below once, for the instantiation, rather than on each
+ *  call.
+ *
+ *  @returns
+ *    The magnitude, with @a aNegative set if there was a leading minus
+ *    sign and @a aOverflowed set if the magnitude was not representable
+ *    by @a T.
+ *
+ */
+template <typename T, int kBase = kAnyBase, unsigned int kOptions = 0>
+static inline T
+Parse(const char *aString, const size_t &aLength, char **aEnd, const int &aBase, bool &aNegative, bool &aOverflowed)
+{
+    static constexpr T kMaximum       = Maximum<T>();
+    const int          lRequested      = ((kBase == kAnyBase) ? aBase : kBase);
+    const char *       p               = aString;
+    bool               convertedDigits = false;
+    int                lBase;
+    T                  lRetval         = 0;
+
+    aNegative   = false;
+    aOverflowed = false;
+
+    if (aLength == 0)
+    {
+        goto done;
+    }
+
+#if STRNTOUL_USE_DECIMAL_KERNEL
+    // Short decimal fields, such as status codes, ports, and
+    // percentages, are common enough, and cheap enough to convert,
+    // that the white space, sign, and base handling below would
+    // dominate. Take them directly, when nothing but one to three
+    // digits precedes the end of the string or a non-digit. A leading
+    // zero, for a deduced base, is an octal prefix, so is left to the
+    // general conversion.
+
+    if ((lRequested == 10) || ((lRequested == 0) && (*aString != '0')))
+    {
+        unsigned int       lValue;
+        const unsigned int lDigits = StrNToUL::Kernel::ConvertShortDecimal(aString, aLength, lValue);
+
+        if (lDigits > 0)
+        {
+            if (aEnd != nullptr)
+            {
+                *aEnd = const_cast<char *>(aString + lDigits);
+            }
+
+            return (static_cast<T>(lValue));
+        }
+    }
+#endif // STRNTOUL_USE_DECIMAL_KERNEL
+
+    // Skip any leading space and determine the sign, if any. Padded
+    // columns may lead with many spaces, so the C locale white space
+    // is skipped a vector at a time, leaving isspace only for the
+    // first byte that is not, in case the locale considers it white
+    // space nonetheless.
+
+    if ((kOptions & kNoWhitespace) == 0)
+    {
+        p = StrNToUL::Kernel::SkipSpace(p, aString + aLength);
+
+        while ((p < (aString + aLength)) && isspace(*p))
+        {
+            p++;
+        }
+    }
+
+    if (((kOptions & kNoSign) == 0) && (p < (aString + aLength)))
+    {
+        if (*p == '-')
+        {
+            aNegative = true;
+            p++;
+        }
+        else if (*p == '+')
+        {
+            p++;
+        }
+    }
+
+    // Handle computing and sanity-checking the base. A valid base
+    // fixed at compile time needs only any prefix skipped.
+
+    if ((kBase >= 2) && (kBase <= 36))
+    {
+        lBase = kBase;
+
+        if (kBase == 16)
+        {
+            HandleBase(p, aLength - static_cast<size_t>(p - aString), kBase, kOptions);
+        }
+    }
+    else
+    {
+        lBase = HandleBase(p, aLength - static_cast<size_t>(p - aString), lRequested, kOptions);
+        if (lBase < 0)
+        {
+            errno   = -lBase;
+            lRetval = 0;
+
+            goto done;
+        }
+    }
+
+    // Begin the conversion, based on the base and the available
+    // characters to convert.
+    //
+    // Special case a few, common power-of-two cases in which the
+    // shifts are substantially more efficient than the divides and
+    // multiplies required for the shift-and-accumulate conversion
+    // algorithm.
+
+    if ((lBase == 2) || (lBase == 8) || (lBase == 16))
+    {
+        const unsigned      kShift        = ((lBase == 2) ? 1 :
+                                             ((lBase == 8) ? 3 : 4));
+        const T             lOverflowSentinel = kMaximum >> kShift;
+
+#if STRNTOUL_USE_RADIX_KERNELS
+        // Convert as much of the leading run of binary or octal
+        // digits as cannot overflow, a window at a time, with the
+        // radix kernels and leave any remainder, along with overflow
+        // detection, to the loop below.
+
+        if ((lBase == 2) || (lBase == 8))
+        {
+            const size_t       lLength = aLength - static_cast<size_t>(p - aString);
+            const unsigned int lDigits = ((lBase == 2) ?
+                                          StrNToUL::Kernel::ConvertRadix<2>(p, lLength, lRetval) :
+                                          StrNToUL::Kernel::ConvertRadix<8>(p, lLength, lRetval));
+
+            if (lDigits > 0)
+            {
+                convertedDigits = true;
+
+                p += lDigits;
+            }
+        }
+#endif // STRNTOUL_USE_RADIX_KERNELS
+
+        while (p < (aString + aLength))
+        {
+            const unsigned int lDigit = GetDigit(*p);
+
+            if (lDigit >= static_cast<unsigned int>(lBase))
+                break;
+
+            // Check-and-shift, checking first if the shift would
+            // cause an overflow.
+
+            if (lRetval > lOverflowSentinel)
+            {
+                aOverflowed = true;
+            }
+
+            lRetval <<= kShift;
+
+            // Check-and-accumulate, checking first if the accumulate
+            // would cause an overflow.
+
+            if (lDigit > (kMaximum - lRetval))
+            {
+                aOverflowed = true;
+            }
+
+            lRetval += lDigit;
+
+            convertedDigits = true;
+
+            p++;
+        }
+    }
+    else if ((lBase >= 2) && (lBase <= 36) && (sizeof (T) > sizeof (uint64_t)))
+    {
+        // Fold each 64-bit chunk in with one wide multiply and add,
+        // rather than with one per digit.
+
+        while (p < (aString + aLength))
+        {
+            uint64_t           lChunk;
+            uint64_t           lScale;
+            const unsigned int lDigits = GatherChunk(p,
+                                                     aString + aLength,
+                                                     static_cast<unsigned int>(lBase),
+                                                     lChunk,
+                                                     lScale);
+
+            if (lDigits == 0)
+                break;
+
+            if (__builtin_mul_overflow(lRetval, static_cast<T>(lScale), &lRetval) ||
+                __builtin_add_overflow(lRetval, static_cast<T>(lChunk), &lRetval))
+            {
+                aOverflowed = true;
+            }
+
+            convertedDigits = true;
+
+            p += lDigits;
+        }
+    }
+    else if ((lBase >= 2) && (lBase <= 36))
+    {
+        const T lOverflowSentinel = kMaximum / static_cast<unsigned int>(lBase);
+
+#if STRNTOUL_USE_DECIMAL_KERNEL
+        // Decimal is, by far, the most common base. Convert as much
+        // of the leading run of digits as cannot overflow with the
+        // decimal kernel and leave any remainder, along with overflow
+        // detection, to the loop below.
+
+        if (lBase == 10)
+        {
+            const unsigned int lDigits =
+                StrNToUL::Kernel::ConvertDecimal(p,
+                                                 aLength - static_cast<size_t>(p - aString),
+                                                 lRetval);
+
+            if (lDigits > 0)
+            {
+                convertedDigits = true;
+
+                p += lDigits;
+            }
+        }
+#endif // STRNTOUL_USE_DECIMAL_KERNEL
+
+        while (p < (aString + aLength))
+        {
+            const unsigned int lDigit = GetDigit(*p);
+
+            if (lDigit >= static_cast<unsigned int>(lBase))
+                break;
+
+            // Check-and-shift, checking first if the shift would
+            // cause an overflow.
+
+            if (lRetval > lOverflowSentinel)
+            {
+                aOverflowed = true;
+            }
+
+            lRetval *= static_cast<unsigned int>(lBase);
+
+            // Check-and-accumulate, checking first if the accumulate
+            // would cause an overflow.
+
+            if (lDigit > (kMaximum - lRetval))
+            {
+                aOverflowed = true;
+            }
+
+            lRetval += lDigit;
+
+            convertedDigits = true;
+
+            p++;
+        }
+    }
+
+ done:
+    // If no digits were converted, then the standard says that aEnd,
+    // if non-null, must be equal to aString.
+
+    if (!convertedDigits)
+    {
+        p = aString;
+    }
+
+    if (aEnd != nullptr)
+    {
+        *aEnd = const_cast<char *>(p);
+    }
+
+    return (lRetval);
+}
+
+/**
+ *  Convert the initial part of @a aString to the unsigned type @a T,
+ *  as strntoul does for unsigned long, with the base and options as
+ *  for Parse.
+ *
+ */
+template <typename T, int kBase = kAnyBase, unsigned int kOptions = 0>
+static inline T
+ConvertUnsigned(const char *aString, const size_t &aLength, char **aEnd, const int &aBase)
+{
+    bool isNegative;
+    bool wouldOverflow;
+    T    lRetval;
+
+    lRetval = Parse<T, kBase, kOptions>(aString, aLength, aEnd, aBase, isNegative, wouldOverflow);
+
+    // As for strtoul, an out-of-range magnitude is the maximum value,
+    // whatever the sign.
+
+    if (wouldOverflow)
+    {
+        errno   = ERANGE;
+        lRetval = Maximum<T>();
+    }
+    else if (isNegative)
+    {
+        lRetval = static_cast<T>(-lRetval);
+    }
+
+    return (lRetval);
+}
+
+/**
+ *  Convert the initial part of @a aString to the signed type @a S, by
+ *  way of its unsigned counterpart @a U, as strntol does for long.
+ *
+ */
+template <typename S, typename U>
+static inline S
+ConvertSigned(const char *aString, const size_t &aLength, char **aEnd, const int &aBase)
+{
+    static constexpr U kMaximum = (Maximum<U>() >> 1);
+    bool               isNegative;
+    bool               wouldOverflow;
+    U                  lMagnitude;
+
+    lMagnitude = Parse<U>(aString, aLength, aEnd, aBase, isNegative, wouldOverflow);
+
+    // If the correct value is outside the range of representable
+    // values, the standards says the minimum or maximum shall be
+    // returned (according to the sign of the value), and errno set to
+    // ERANGE.
+
+    if (wouldOverflow || (lMagnitude > (kMaximum + (isNegative ? 1 : 0))))
+    {
+        errno = ERANGE;
+
+        return ((isNegative) ? static_cast<S>(-static_cast<S>(kMaximum) - 1) : static_cast<S>(kMaximum));
+    }
+
+    return ((isNegative) ? static_cast<S>(0 - lMagnitude) : static_cast<S>(lMagnitude));
+}
+
+}; // namespace Core
+
+}; // namespace StrNToUL
+
+#endif // STRNTOUL_CORE_H
@@ -0,0 +1,855 @@
+/*
+ *    Copyright (c) 2024 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *    @file
+ *      This file defines private, inline conversion kernels shared
+ *      by the strntoul family of interfaces.
+ *
+ *      The decimal kernel classifies a 16-byte window of input with
+ *      SSE2 (or, on other little-endian targets, with SWAR
+ *      arithmetic on two 64-bit words) and converts the leading run
+ *      of digits without a per-digit loop. When configured with
+ *      --enable-vector-kernel, it instead uses compiler generic vector
+ *      types, which lower to the target's own vector unit, wherever
+ *      SSE2 is not available for classification and for conversion.
+ *
+ *      Leading white space, as in space-padded columns, is likewise
+ *      skipped 16 bytes at a time with SSE2.
+ *
+ *      When fewer than 16 bytes remain, the window is still loaded
+ *      in one wide read provided that read cannot cross a 4 KiB page
+ *      boundary and, therefore, cannot fault. Bytes past the caller's
+ *      length are masked off before classification. Because such an
+ *      over-read is reported by address sanitizers and valgrind, it
+ *      is disabled in sanitizer builds and when the package is
+ *      configured with --disable-overread, in which case a bounded
+ *      copy is used instead.
+ *
+ */
+
+#ifndef STRNTOUL_KERNEL_H
+#define STRNTOUL_KERNEL_H
+
+#if HAVE_CONFIG_H && !defined(STRNTOUL_INLINE)
+#include "strntoul-config.h"
+#endif
+
+#include <limits>
+
+#include <limits.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Determine whether or not this is a sanitizer build, in which case
+// an intentional over-read would be reported as an error.
+
+#if defined(__SANITIZE_ADDRESS__)
+#define STRNTOUL_SANITIZER_BUILD 1
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer) || __has_feature(memory_sanitizer)
+#define STRNTOUL_SANITIZER_BUILD 1
+#endif
+#endif
+
+#if defined(STRNTOUL_SANITIZER_BUILD) || defined(STRNTOUL_DISABLE_OVERREAD)
+#define STRNTOUL_USE_OVERREAD 0
+#else
+#define STRNTOUL_USE_OVERREAD 1
+#endif
+
+// The SWAR portions of the kernels assume that the first byte of a
+// loaded word lands in its least significant byte.
+
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#define STRNTOUL_USE_DECIMAL_KERNEL 1
+#else
+#define STRNTOUL_USE_DECIMAL_KERNEL 0
+#endif
+
+// The binary and octal kernels make the same assumption.
+
+#define STRNTOUL_USE_RADIX_KERNELS STRNTOUL_USE_DECIMAL_KERNEL
+
+// Determine whether the decimal kernel classifies and converts with
+// GCC and Clang generic vector types, which the compiler lowers to
+// whatever vector unit the target has, rather than with SWAR
+// arithmetic. Where hand-written SSE2 classification is available,
+// it is still preferred.
+
+#if defined(STRNTOUL_ENABLE_VECTOR_KERNEL) && STRNTOUL_USE_DECIMAL_KERNEL && (defined(__GNUC__) || defined(__clang__))
+#define STRNTOUL_USE_VECTOR_KERNEL 1
+#else
+#define STRNTOUL_USE_VECTOR_KERNEL 0
+#endif
+
+namespace StrNToUL
+{
+
+namespace Kernel
+{
+
+// The smallest page size of any supported target. Larger page sizes
+// are multiples of this, so it is a conservative bound everywhere.
+
+static constexpr uintptr_t kPageSize   = 4096;
+
+static constexpr size_t    kWindowSize = 16;
+
+/**
+ *  Determine whether a read of @a aWidth bytes at @a aPointer stays
+ *  within the page on which @a aPointer lies.
+ *
+ */
+static inline bool
+CanOverread(const void *aPointer, const size_t &aWidth)
+{
+    const uintptr_t lOffset = reinterpret_cast<uintptr_t>(aPointer) & (kPageSize - 1);
+
+    return (lOffset <= (kPageSize - aWidth));
+}
+
+// The value DigitValue returns for a character that is not a digit
+// in any supported base.
+
+static constexpr unsigned int kInvalidDigit = 0xFF;
+
+/**
+ *  Return the value of @a aCharacter as a digit in bases up to 36,
+ *  or kInvalidDigit if it is not a digit in any such base.
+ *
+ */
+static inline unsigned int
+DigitValue(const char &aCharacter)
+{
+    const unsigned int lCharacter = static_cast<unsigned char>(aCharacter);
+
+    if ((lCharacter - '0') < 10)
+    {
+        return (lCharacter - '0');
+    }
+    else if (((lCharacter | 0x20) - 'a') < 26)
+    {
+        return (((lCharacter | 0x20) - 'a') + 10);
+    }
+
+    return (kInvalidDigit);
+}
+
+#if STRNTOUL_USE_OVERREAD
+// The over-read deliberately touches bytes beyond the caller's
+// object, all of which lie on an already-mapped page. Tell any
+// instrumentation that might still be present not to check it.
+
+__attribute__((no_sanitize_address))
+static inline void
+Overread(const char *aString, uint8_t (&aWindow)[kWindowSize])
+{
+    memcpy(&aWindow[0], aString, kWindowSize);
+}
+#endif // STRNTOUL_USE_OVERREAD
+
+/**
+ *  Load up to a window of bytes from @a aString, zeroing any bytes
+ *  at or beyond @a aLength.
+ *
+ */
+static inline void
+LoadWindow(const char *aString, const size_t &aLength, uint8_t (&aWindow)[kWindowSize])
+{
+    if (aLength >= kWindowSize)
+    {
+        memcpy(&aWindow[0], aString, kWindowSize);
+    }
+#if STRNTOUL_USE_OVERREAD
+    // With nothing to load, aString may be one past the end of the
+    // caller's buffer and, therefore, on a page that is not mapped.
+
+    else if ((aLength > 0) && CanOverread(aString, kWindowSize))
+    {
+        Overread(aString, aWindow);
+
+        memset(&aWindow[aLength], 0, kWindowSize - aLength);
+    }
+#endif // STRNTOUL_USE_OVERREAD
+    else
+    {
+        memcpy(&aWindow[0], aString, aLength);
+        memset(&aWindow[aLength], 0, kWindowSize - aLength);
+    }
+}
+
+/**
+ *  Return the number of leading ASCII decimal digits in @a aWord,
+ *  treated as eight bytes in memory order.
+ *
+ */
+static inline unsigned int
+CountDigitsSWAR(const uint64_t &aWord)
+{
+    // A byte is a digit if and only if both it and it plus six have
+    // a high nibble of three. A carry out of a byte of 0xFA or more
+    // only perturbs later bytes, which are already past the first
+    // non-digit.
+
+    const uint64_t kHighNibbles = UINT64_C(0xF0F0F0F0F0F0F0F0);
+    const uint64_t kThrees      = UINT64_C(0x3030303030303030);
+    const uint64_t kSixes       = UINT64_C(0x0606060606060606);
+    const uint64_t lNonDigits   = (((aWord & kHighNibbles) ^ kThrees) |
+                                   (((aWord + kSixes) & kHighNibbles) ^ kThrees));
+
+    return ((lNonDigits == 0) ? 8 : static_cast<unsigned int>(__builtin_ctzll(lNonDigits) / 8));
+}
+
+/**
+ *  Convert eight ASCII decimal digits, treated as bytes in memory
+ *  order, into their value. Leading zero-valued bytes are treated as
+ *  leading zeroes.
+ *
+ */
+static inline uint64_t
+ConvertEightDigitsSWAR(uint64_t aWord)
+{
+    aWord = ((aWord & UINT64_C(0x0F0F0F0F0F0F0F0F)) * 2561) >> 8;
+    aWord = ((aWord & UINT64_C(0x00FF00FF00FF00FF)) * 6553601) >> 16;
+    aWord = ((aWord & UINT64_C(0x0000FFFF0000FFFF)) * UINT64_C(42949672960001)) >> 32;
+
+    return (aWord);
+}
+
+/**
+ *  Convert the right-most @a aDigits (1 to 8) digits in @a aWord.
+ *
+ */
+static inline uint64_t
+ConvertDigitsSWAR(const uint64_t &aWord, const unsigned int &aDigits)
+{
+    return (ConvertEightDigitsSWAR(aWord << (8 * (8 - aDigits))));
+}
+
+#if STRNTOUL_USE_VECTOR_KERNEL
+typedef uint8_t  VectorU8  __attribute__((vector_size(kWindowSize)));
+typedef uint16_t VectorU16 __attribute__((vector_size(kWindowSize)));
+typedef uint32_t VectorU32 __attribute__((vector_size(kWindowSize)));
+typedef uint64_t VectorU64 __attribute__((vector_size(kWindowSize)));
+
+/**
+ *  Return the number of leading ASCII decimal digits in a window,
+ *  with generic vectors.
+ *
+ */
+static inline unsigned int
+CountDigitsVector(const uint8_t (&aWindow)[kWindowSize])
+{
+    VectorU8  lBytes;
+    VectorU64 lNonDigits;
+
+    memcpy(&lBytes, &aWindow[0], sizeof (lBytes));
+
+    // The comparison yields all ones in each non-digit lane which,
+    // viewed as two 64-bit lanes, locates the first of them without
+    // a movemask, which not every target has.
+
+    lNonDigits = reinterpret_cast<VectorU64>((lBytes - '0') > 9);
+
+    if (lNonDigits[0] != 0)
+    {
+        return (static_cast<unsigned int>(__builtin_ctzll(lNonDigits[0]) / 8));
+    }
+    else if (lNonDigits[1] != 0)
+    {
+        return (8 + static_cast<unsigned int>(__builtin_ctzll(lNonDigits[1]) / 8));
+    }
+
+    return (kWindowSize);
+}
+
+/**
+ *  Convert the leading @a aDigits (1 to 16) digits of a window with
+ *  generic vectors.
+ *
+ */
+static inline uint64_t
+ConvertDigitsVector(const uint8_t (&aWindow)[kWindowSize], const unsigned int &aDigits)
+{
+    // The multiplicative inverses, modulo 2^64, of five raised to
+    // zero through 15.
+
+    static const uint64_t     kInverseFivePowers[] = {
+        UINT64_C(0x0000000000000001),
+        UINT64_C(0xCCCCCCCCCCCCCCCD),
+        UINT64_C(0x8F5C28F5C28F5C29),
+        UINT64_C(0x1CAC083126E978D5),
+        UINT64_C(0xD288CE703AFB7E91),
+        UINT64_C(0x5D4E8FB00BCBE61D),
+        UINT64_C(0x790FB65668C26139),
+        UINT64_C(0xE5032477AE8D46A5),
+        UINT64_C(0xC767074B22E90E21),
+        UINT64_C(0x8E47CE423A2E9C6D),
+        UINT64_C(0x4FA7F60D3ED61F49),
+        UINT64_C(0x0FEE64690C913975),
+        UINT64_C(0x3662E0E1CF503EB1),
+        UINT64_C(0xA47A2CF9F6433FBD),
+        UINT64_C(0x54186F653140A659),
+        UINT64_C(0x7738164770402145)
+    };
+    static constexpr VectorU8 kLanes = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 };
+    const unsigned int        lTrailing = (kWindowSize - aDigits);
+    VectorU8                  lBytes;
+    VectorU16                 lPairs;
+    VectorU32                 lQuads;
+    VectorU64                 lOctets;
+    uint64_t                  lValue;
+
+    memcpy(&lBytes, &aWindow[0], sizeof (lBytes));
+
+    // Clear any lanes past the digits, which leaves the digits left-
+    // aligned, as if followed by trailing zeroes. Right-aligning them
+    // instead would need a variable, cross-lane shift, which generic
+    // vectors cannot express portably.
+
+    lBytes  = ((lBytes - '0') & reinterpret_cast<VectorU8>(kLanes < static_cast<uint8_t>(aDigits)));
+
+    // Combine adjacent lanes, doubling their width each time, with
+    // constant multipliers only.
+
+    lPairs  = reinterpret_cast<VectorU16>(lBytes);
+    lPairs  = ((lPairs & 0xFF) * 10) + (lPairs >> 8);
+
+    lQuads  = reinterpret_cast<VectorU32>(lPairs);
+    lQuads  = ((lQuads & 0xFFFF) * 100) + (lQuads >> 16);
+
+    lOctets = reinterpret_cast<VectorU64>(lQuads);
+    lOctets = ((lOctets & 0xFFFFFFFF) * 10000) + (lOctets >> 32);
+
+    // Finally, remove the trailing zeroes. The value is an exact
+    // multiple of ten raised to their number, so dividing by it is a
+    // shift, for the powers of two, and a multiply by an inverse, for
+    // the powers of five.
+
+    lValue  = ((lOctets[0] * UINT64_C(100000000)) + lOctets[1]);
+
+    return ((lValue >> lTrailing) * kInverseFivePowers[lTrailing]);
+}
+#endif // STRNTOUL_USE_VECTOR_KERNEL
+
+/**
+ *  Return the number of leading ASCII decimal digits in a window.
+ *
+ */
+static inline unsigned int
+CountDigits(const uint8_t (&aWindow)[kWindowSize])
+{
+    unsigned int lRetval;
+
+#if defined(__SSE2__)
+    const __m128i lBytes    = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&aWindow[0]));
+    const __m128i lAboveLow = _mm_cmpgt_epi8(lBytes, _mm_set1_epi8('0' - 1));
+    const __m128i lBelowHi  = _mm_cmplt_epi8(lBytes, _mm_set1_epi8('9' + 1));
+    const int     lMask     = _mm_movemask_epi8(_mm_and_si128(lAboveLow, lBelowHi));
+
+    lRetval = static_cast<unsigned int>(__builtin_ctz(~static_cast<unsigned int>(lMask)));
+#elif STRNTOUL_USE_VECTOR_KERNEL
+    lRetval = CountDigitsVector(aWindow);
+#else
+    uint64_t lWord;
+
+    memcpy(&lWord, &aWindow[0], sizeof (lWord));
+
+    lRetval = CountDigitsSWAR(lWord);
+
+    if (lRetval == 8)
+    {
+        memcpy(&lWord, &aWindow[8], sizeof (lWord));
+
+        lRetval += CountDigitsSWAR(lWord);
+    }
+#endif // defined(__SSE2__)
+
+    return (lRetval);
+}
+
+/**
+ *  Convert the leading run of ASCII decimal digits, up to 16 and no
+ *  more than can always be represented by @a T, in the at most @a
+ *  aLength bytes at @a aString.
+ *
+ *  @returns
+ *    The number of digits converted, zero (0) if there were none, in
+ *    which case @a aValue is unmodified.
+ *
+ */
+template <typename T>
+static inline unsigned int
+ConvertDecimal(const char *aString, const size_t &aLength, T &aValue)
+{
+    static constexpr unsigned int kMaximumDigits =
+        ((std::numeric_limits<T>::digits10 < 16) ? std::numeric_limits<T>::digits10 : 16);
+#if !STRNTOUL_USE_VECTOR_KERNEL
+    static const uint64_t         kPowersOfTen[] = {
+        UINT64_C(1),
+        UINT64_C(10),
+        UINT64_C(100),
+        UINT64_C(1000),
+        UINT64_C(10000),
+        UINT64_C(100000),
+        UINT64_C(1000000),
+        UINT64_C(10000000),
+        UINT64_C(100000000)
+    };
+    uint64_t                      lWords[2];
+#endif // !STRNTOUL_USE_VECTOR_KERNEL
+    uint8_t      lWindow[kWindowSize];
+    uint64_t     lValue;
+    unsigned int lDigits;
+
+    LoadWindow(aString, aLength, lWindow);
+
+    lDigits = CountDigits(lWindow);
+
+    if (lDigits > kMaximumDigits)
+    {
+        lDigits = kMaximumDigits;
+    }
+
+    if (lDigits == 0)
+    {
+        return (0);
+    }
+
+#if STRNTOUL_USE_VECTOR_KERNEL
+    lValue = ConvertDigitsVector(lWindow, lDigits);
+#else
+    memcpy(&lWords[0], &lWindow[0], sizeof (lWords));
+
+    if (lDigits <= 8)
+    {
+        lValue = ConvertDigitsSWAR(lWords[0], lDigits);
+    }
+    else
+    {
+        lValue = ((ConvertEightDigitsSWAR(lWords[0]) * kPowersOfTen[lDigits - 8]) +
+                  ConvertDigitsSWAR(lWords[1], lDigits - 8));
+    }
+#endif // STRNTOUL_USE_VECTOR_KERNEL
+
+    aValue = static_cast<T>(lValue);
+
+    return (lDigits);
+}
+
+#if STRNTOUL_USE_OVERREAD
+__attribute__((no_sanitize_address))
+static inline uint32_t
+OverreadShort(const char *aString)
+{
+    uint32_t lWord;
+
+    memcpy(&lWord, aString, sizeof (lWord));
+
+    return (lWord);
+}
+#endif // STRNTOUL_USE_OVERREAD
+
+/**
+ *  Convert a short decimal field: one to three ASCII decimal digits,
+ *  in the at most @a aLength (at least one) bytes at @a aString,
+ *  ended by @a aLength or by a non-digit.
+ *
+ *  This loads the field as a single word, without the window setup of
+ *  ConvertDecimal, and converts it with one multiply-and-add to pair
+ *  the digits and one multiply to combine the pairs.
+ *
+ *  @returns
+ *    The number of digits converted or zero (0) if the field did not
+ *    start with a digit or had more than three, in which case @a
+ *    aValue is unmodified.
+ *
+ */
+static inline unsigned int
+ConvertShortDecimal(const char *aString, const size_t &aLength, unsigned int &aValue)
+{
+    uint32_t     lWord = 0;
+    uint32_t     lNonDigits;
+    unsigned int lDigits;
+
+    if (aLength >= sizeof (lWord))
+    {
+        memcpy(&lWord, aString, sizeof (lWord));
+    }
+#if STRNTOUL_USE_OVERREAD
+    else if ((aLength > 0) && CanOverread(aString, sizeof (lWord)))
+    {
+        lWord = OverreadShort(aString) & ((UINT32_C(1) << (8 * aLength)) - 1);
+    }
+#endif // STRNTOUL_USE_OVERREAD
+    else
+    {
+        memcpy(&lWord, aString, aLength);
+    }
+
+    // As for CountDigitsSWAR, though a word at a time, with bytes
+    // beyond aLength, being zero, counted as non-digits.
+
+    lNonDigits = (((lWord & UINT32_C(0xF0F0F0F0)) ^ UINT32_C(0x30303030)) |
+                  (((lWord + UINT32_C(0x06060606)) & UINT32_C(0xF0F0F0F0)) ^ UINT32_C(0x30303030)));
+
+    if ((lNonDigits & 0xFF) != 0)
+    {
+        return (0);
+    }
+
+    lDigits = ((lNonDigits == 0) ? 4 : static_cast<unsigned int>(__builtin_ctz(lNonDigits) / 8));
+
+    if (lDigits > 3)
+    {
+        return (0);
+    }
+
+    // Right-align the digits, as values, in the word, such that it
+    // holds four digits with leading zeroes, then fold each adjacent
+    // pair into the lower byte of the pair and combine the two pairs.
+
+    lWord = ((lWord - UINT32_C(0x30303030)) & ((UINT32_C(1) << (8 * lDigits)) - 1)) << (8 * (4 - lDigits));
+    lWord = (lWord * 10) + (lWord >> 8);
+
+    aValue = ((lWord & 0xFF) * 100) + ((lWord >> 16) & 0xFF);
+
+    return (lDigits);
+}
+
+/**
+ *  Return the number of leading bytes in @a aWord, treated as eight
+ *  bytes in memory order, that are '0' through one less than '0' plus
+ *  @a aRadix, for a radix of two or eight.
+ *
+ */
+static inline unsigned int
+CountRadixDigitsSWAR(const uint64_t &aWord, const unsigned int &aRadix)
+{
+    // A byte is such a digit if and only if, with its low bits for a
+    // digit cleared, it is '0'.
+
+    const uint64_t kHighBits   = UINT64_C(0x0101010101010101) * static_cast<uint8_t>(~(aRadix - 1));
+    const uint64_t kZeroes     = UINT64_C(0x3030303030303030);
+    const uint64_t lNonDigits  = ((aWord & kHighBits) ^ kZeroes);
+
+    return ((lNonDigits == 0) ? 8 : static_cast<unsigned int>(__builtin_ctzll(lNonDigits) / 8));
+}
+
+/**
+ *  Return the number of leading binary, or octal, digits in a window.
+ *
+ */
+static inline unsigned int
+CountRadixDigits(const uint8_t (&aWindow)[kWindowSize], const unsigned int &aRadix)
+{
+    unsigned int lRetval;
+
+#if defined(__SSE2__)
+    const __m128i lBytes  = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&aWindow[0]));
+    const __m128i lHigh   = _mm_and_si128(lBytes, _mm_set1_epi8(static_cast<char>(~(aRadix - 1))));
+    const int     lMask   = _mm_movemask_epi8(_mm_cmpeq_epi8(lHigh, _mm_set1_epi8('0')));
+
+    lRetval = static_cast<unsigned int>(__builtin_ctz(~static_cast<unsigned int>(lMask)));
+#else
+    uint64_t lWord;
+
+    memcpy(&lWord, &aWindow[0], sizeof (lWord));
+
+    lRetval = CountRadixDigitsSWAR(lWord, aRadix);
+
+    if (lRetval == 8)
+    {
+        memcpy(&lWord, &aWindow[8], sizeof (lWord));
+
+        lRetval += CountRadixDigitsSWAR(lWord, aRadix);
+    }
+#endif // defined(__SSE2__)
+
+    return (lRetval);
+}
+
+/**
+ *  Gather the low bit of each of the eight bytes in @a aWord, treated
+ *  as bytes in memory order, such that the first byte's is the most
+ *  significant of the eight bits.
+ *
+ */
+static inline uint64_t
+GatherBitsSWAR(const uint64_t &aWord)
+{
+    return (((aWord & UINT64_C(0x0101010101010101)) * UINT64_C(0x8040201008040201)) >> 56);
+}
+
+/**
+ *  Convert the leading @a aDigits (0 to 16) binary digits of a window.
+ *
+ */
+static inline uint64_t
+ConvertBinaryWindow(const uint8_t (&aWindow)[kWindowSize], const unsigned int &aDigits)
+{
+    uint64_t lRetval;
+
+    if (aDigits == 0)
+    {
+        return (0);
+    }
+
+#if defined(__SSE2__)
+    // Reverse the bytes so that, after one compare and movemask, the
+    // first digit is the most significant bit of the mask.
+
+    __m128i lBytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&aWindow[0]));
+
+    lBytes = _mm_shuffle_epi32(lBytes, _MM_SHUFFLE(0, 1, 2, 3));
+    lBytes = _mm_shufflelo_epi16(lBytes, _MM_SHUFFLE(2, 3, 0, 1));
+    lBytes = _mm_shufflehi_epi16(lBytes, _MM_SHUFFLE(2, 3, 0, 1));
+    lBytes = _mm_or_si128(_mm_slli_epi16(lBytes, 8), _mm_srli_epi16(lBytes, 8));
+
+    lRetval = static_cast<uint64_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(lBytes, _mm_set1_epi8('1'))));
+    lRetval >>= (kWindowSize - aDigits);
+#else
+    uint64_t lWords[2];
+
+    memcpy(&lWords[0], &aWindow[0], sizeof (lWords));
+
+    lRetval = ((GatherBitsSWAR(lWords[0]) << 8) | GatherBitsSWAR(lWords[1])) >> (kWindowSize - aDigits);
+#endif // defined(__SSE2__)
+
+    return (lRetval);
+}
+
+/**
+ *  Convert eight ASCII octal digits, treated as bytes in memory
+ *  order, into their value. Leading zero-valued bytes are treated as
+ *  leading zeroes.
+ *
+ */
+static inline uint64_t
+ConvertEightOctalDigitsSWAR(uint64_t aWord)
+{
+    aWord = ((aWord & UINT64_C(0x0707070707070707)) * ((8 << 8) + 1)) >> 8;
+    aWord = ((aWord & UINT64_C(0x00FF00FF00FF00FF)) * ((64 << 16) + 1)) >> 16;
+    aWord = ((aWord & UINT64_C(0x0000FFFF0000FFFF)) * ((UINT64_C(4096) << 32) + 1)) >> 32;
+
+    return (aWord);
+}
+
+/**
+ *  Convert the leading @a aDigits (0 to 16) octal digits of a window.
+ *
+ */
+static inline uint64_t
+ConvertOctalWindow(const uint8_t (&aWindow)[kWindowSize], const unsigned int &aDigits)
+{
+    uint64_t lWords[2];
+
+    if (aDigits == 0)
+    {
+        return (0);
+    }
+
+    memcpy(&lWords[0], &aWindow[0], sizeof (lWords));
+
+    if (aDigits <= 8)
+    {
+        return (ConvertEightOctalDigitsSWAR(lWords[0] << (8 * (8 - aDigits))));
+    }
+
+    return ((ConvertEightOctalDigitsSWAR(lWords[0]) << (3 * (aDigits - 8))) |
+            ConvertEightOctalDigitsSWAR(lWords[1] << (8 * (16 - aDigits))));
+}
+
+/**
+ *  Convert the leading run of binary (@a kRadix of 2) or octal (@a
+ *  kRadix of 8) digits, up to as many as can always be represented
+ *  by @a T, in the at most @a aLength bytes at @a aString, a window
+ *  of up to 16 digits at a time.
+ *
+ *  @returns
+ *    The number of digits converted, zero (0) if there were none or if
+ *    @a aLength was too short to benefit, in which case @a aValue is
+ *    unmodified.
+ *
+ */
+template <unsigned int kRadix, typename T>
+static inline unsigned int
+ConvertRadix(const char *aString, const size_t &aLength, T &aValue)
+{
+    static constexpr unsigned int kBits          = ((kRadix == 2) ? 1 : 3);
+    static constexpr unsigned int kWidth         = (((sizeof (T) * CHAR_BIT) < 64) ? (sizeof (T) * CHAR_BIT) : 64);
+    static constexpr unsigned int kMaximumDigits = (kWidth / kBits);
+    uint64_t                      lValue         = 0;
+    unsigned int                  lDigits        = 0;
+
+    static_assert((kRadix == 2) || (kRadix == 8), "Only binary and octal are supported");
+
+    // Below half a window, loading and reversing it costs more than
+    // the few digits a caller could otherwise convert one at a time.
+
+    if (aLength < (kWindowSize / 2))
+    {
+        return (0);
+    }
+
+    while (lDigits < kMaximumDigits)
+    {
+        uint8_t      lWindow[kWindowSize];
+        unsigned int lCount;
+
+        LoadWindow(aString + lDigits, aLength - lDigits, lWindow);
+
+        lCount = CountRadixDigits(lWindow, kRadix);
+
+        if (lCount > (kMaximumDigits - lDigits))
+        {
+            lCount = kMaximumDigits - lDigits;
+        }
+
+        if (lCount > 0)
+        {
+            const uint64_t lWindowValue = ((kRadix == 2) ?
+                                           ConvertBinaryWindow(lWindow, lCount) :
+                                           ConvertOctalWindow(lWindow, lCount));
+
+            lValue   = (lValue << (kBits * lCount)) | lWindowValue;
+            lDigits += lCount;
+        }
+
+        // Stop at a window that ended the run or that ended the
+        // input; in the latter case, there is nothing left to load.
+
+        if ((lCount < kWindowSize) || (lDigits == aLength))
+        {
+            break;
+        }
+    }
+
+    if (lDigits > 0)
+    {
+        aValue = static_cast<T>(lValue);
+    }
+
+    return (lDigits);
+}
+
+/**
+ *  Determine whether @a aCharacter is one of the six white space
+ *  characters of the C locale, which every locale also treats as
+ *  white space.
+ *
+ */
+static inline bool
+IsSpace(const char &aCharacter)
+{
+    const unsigned int lCharacter = static_cast<unsigned char>(aCharacter);
+
+    return ((lCharacter == ' ') || ((lCharacter - '\t') < 5));
+}
+
+#if defined(__SSE2__) && STRNTOUL_USE_OVERREAD
+__attribute__((no_sanitize_address))
+static inline __m128i
+OverreadVector(const char *aString)
+{
+    return (_mm_loadu_si128(reinterpret_cast<const __m128i *>(aString)));
+}
+#endif // defined(__SSE2__) && STRNTOUL_USE_OVERREAD
+
+/**
+ *  Skip the leading run of C locale white space at @a aString, before
+ *  @a aLast, a vector at a time where SSE2 is available.
+ *
+ *  @returns
+ *    A pointer to the first byte that is not C locale white space or
+ *    @a aLast. A locale may treat that byte as white space too, so
+ *    callers must still check it, and any that follow, with isspace.
+ *
+ */
+static inline const char *
+SkipSpace(const char *aString, const char *aLast)
+{
+    // Most strings have no leading white space at all, for which a
+    // single scalar test suffices.
+
+    if ((aString >= aLast) || !IsSpace(*aString))
+    {
+        return (aString);
+    }
+
+#if defined(__SSE2__)
+    while (aString < aLast)
+    {
+        const size_t lLength = static_cast<size_t>(aLast - aString);
+        __m128i      lBytes;
+        unsigned int lMask;
+
+        if (lLength >= kWindowSize)
+        {
+            lBytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(aString));
+        }
+#if STRNTOUL_USE_OVERREAD
+        else if (CanOverread(aString, kWindowSize))
+        {
+            lBytes = OverreadVector(aString);
+        }
+#endif // STRNTOUL_USE_OVERREAD
+        else
+        {
+            break;
+        }
+
+        // A byte is white space if it is a space or, as a signed
+        // byte, lies between a tab and a carriage return, inclusive.
+
+        lMask = static_cast<unsigned int>(_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(lBytes, _mm_set1_epi8(' ')),
+                                                                         _mm_and_si128(_mm_cmpgt_epi8(lBytes, _mm_set1_epi8('\t' - 1)),
+                                                                                       _mm_cmplt_epi8(lBytes, _mm_set1_epi8('\r' + 1))))));
+
+        // Treat any over-read bytes as not white space.
+
+        lMask = ~lMask & ((lLength >= kWindowSize) ? 0xFFFFU : ((1U << lLength) - 1));
+
+        if (lMask != 0)
+        {
+            return (aString + __builtin_ctz(lMask));
+        }
+
+        aString += ((lLength >= kWindowSize) ? kWindowSize : lLength);
+    }
+#endif // defined(__SSE2__)
+
+    while ((aString < aLast) && IsSpace(*aString))
+    {
+        aString++;
+    }
+
+    return (aString);
+}
+
+}; // namespace Kernel
+
+}; // namespace StrNToUL
+
+#endif // STRNTOUL_KERNEL_H
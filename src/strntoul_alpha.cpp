@@ -0,0 +1,476 @@
+/*
+ *    Copyright (c) 2024 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *    @file
+ *      This file implements interfaces for converting strings of digits
+ *      drawn from an arbitrary alphabet, such as the base 58 and base
+ *      62 alphabets common to identifiers and addresses, to unsigned
+ *      long integers.
+ *
+ *      Each alphabet is compiled, at build time for those built in,
+ *      into a 256-entry table mapping each byte to its digit value. A
+ *      conversion then gathers digits, with one lookup and one
+ *      multiply-add each, into 64-bit chunks of as many digits as
+ *      always fit (10 for base 58 or 62), and only each chunk is
+ *      checked for overflow as it is folded into the result.
+ *
+ */
+
+#include "strntoul_alpha.h"
+
+#include <ctype.h>
+#include <errno.h>
+#include <limits.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "strntoul/strntoul-kernel.h"
+
+struct strntoul_alphabet
+{
+    uint8_t      mValues[UCHAR_MAX + 1];  //!< The digit value of each
+                                          //!< byte, or kInvalidDigit.
+    unsigned int mRadix;                  //!< The number of digits.
+    unsigned int mChunkDigits;            //!< The most digits whose
+                                          //!< value always fits in 64
+                                          //!< bits.
+    uint64_t     mPowers[64];             //!< The radix raised to zero
+                                          //!< through mChunkDigits.
+};
+
+static constexpr char kBase58Digits[] = "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
+static constexpr char kBase62Digits[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz";
+
+namespace
+{
+
+/**
+ *  A sequence of indices, with which the tables of an alphabet are
+ *  initialized one element per index.
+ *
+ */
+template <size_t... kIndices>
+struct Indices
+{
+};
+
+template <size_t kCount, size_t... kIndices>
+struct MakeIndices : MakeIndices<kCount - 1, kCount - 1, kIndices...>
+{
+};
+
+template <size_t... kIndices>
+struct MakeIndices<0, kIndices...>
+{
+    typedef Indices<kIndices...> Type;
+};
+
+/**
+ *  Return the number of digits in the null-terminated alphabet @a
+ *  aDigits at or beyond @a aIndex.
+ *
+ */
+constexpr unsigned int
+Radix(const char *aDigits, const unsigned int aIndex = 0)
+{
+    return ((aDigits[aIndex] == '\0') ? aIndex : Radix(aDigits, aIndex + 1));
+}
+
+/**
+ *  Return the value of @a aByte as a digit of the null-terminated
+ *  alphabet @a aDigits, searching from @a aIndex, or kInvalidDigit if
+ *  it is not one.
+ *
+ */
+constexpr uint8_t
+Value(const char *aDigits, const size_t aByte, const unsigned int aIndex = 0)
+{
+    return ((aDigits[aIndex] == '\0')                     ? static_cast<uint8_t>(StrNToUL::Kernel::kInvalidDigit) :
+            (static_cast<uint8_t>(aDigits[aIndex]) == aByte) ? static_cast<uint8_t>(aIndex) :
+                                                               Value(aDigits, aByte, aIndex + 1));
+}
+
+/**
+ *  Return the most digits in @a aRadix, beyond the @a aDigits whose
+ *  place value is @a aPower, whose value always fits in 64 bits.
+ *
+ */
+constexpr unsigned int
+ChunkDigits(const unsigned int aRadix, const uint64_t aPower = 1, const unsigned int aDigits = 0)
+{
+    return ((aPower <= (UINT64_MAX / aRadix)) ? ChunkDigits(aRadix, aPower * aRadix, aDigits + 1) : aDigits);
+}
+
+/**
+ *  Return @a aRadix raised to @a aExponent, if that is at most @a
+ *  aChunkDigits, and zero otherwise.
+ *
+ */
+constexpr uint64_t
+Power(const unsigned int aRadix, const unsigned int aChunkDigits, const size_t aExponent)
+{
+    return ((aExponent > aChunkDigits) ? 0 :
+            (aExponent == 0)           ? 1 :
+                                         (aRadix * Power(aRadix, aChunkDigits, aExponent - 1)));
+}
+
+/**
+ *  Compile the alphabet @a aDigits, of @a aRadix digits, initializing
+ *  its reverse table one byte, and its chunk powers one exponent, per
+ *  index.
+ *
+ */
+template <size_t... kBytes, size_t... kExponents>
+constexpr strntoul_alphabet
+Compile(const char *aDigits, const unsigned int aRadix, Indices<kBytes...>, Indices<kExponents...>)
+{
+    return (strntoul_alphabet {
+                { Value(aDigits, kBytes)... },
+                aRadix,
+                ChunkDigits(aRadix),
+                { Power(aRadix, ChunkDigits(aRadix), kExponents)... }
+            });
+}
+
+}; // namespace
+
+/**
+ *  Compile the null-terminated, validated alphabet @a aDigits into its
+ *  reverse table and chunk powers.
+ *
+ *  This is written, as a single expression per table element, such
+ *  that the built-in alphabets are constant initialized, even under
+ *  C++11.
+ *
+ */
+static constexpr strntoul_alphabet
+Compile(const char *aDigits)
+{
+    return (Compile(aDigits,
+                    Radix(aDigits),
+                    MakeIndices<UCHAR_MAX + 1>::Type(),
+                    MakeIndices<64>::Type()));
+}
+
+const strntoul_alphabet_t strntoul_alphabet_base58 = Compile(kBase58Digits);
+const strntoul_alphabet_t strntoul_alphabet_base62 = Compile(kBase62Digits);
+
+/**
+ *  Convert @a aString, as strntoul would but with the digits of @a
+ *  aAlphabet, into an unsigned long integer.
+ *
+ */
+static inline unsigned long
+Convert(const char *aString, const size_t &aLength, char **aEnd, const strntoul_alphabet &aAlphabet)
+{
+    const char * const lLast           = aString + aLength;
+    const char *       p               = aString;
+    bool               isNegative      = false;
+    bool               wouldOverflow   = false;
+    bool               convertedDigits = false;
+    unsigned long      lRetval         = 0;
+
+    // Skip any leading space and determine the sign, if any, unless
+    // the alphabet claims those characters as digits.
+
+    while ((p < lLast) &&
+           (aAlphabet.mValues[static_cast<uint8_t>(*p)] == StrNToUL::Kernel::kInvalidDigit) &&
+           isspace(*p))
+    {
+        p++;
+    }
+
+    if ((p < lLast) && (aAlphabet.mValues[static_cast<uint8_t>(*p)] == StrNToUL::Kernel::kInvalidDigit))
+    {
+        if (*p == '-')
+        {
+            isNegative = true;
+            p++;
+        }
+        else if (*p == '+')
+        {
+            p++;
+        }
+    }
+
+    // Gather and fold in a chunk at a time. As with strntoul, every
+    // digit is consumed, even once the value has overflowed.
+
+    while (p < lLast)
+    {
+        const size_t       lAvailable = static_cast<size_t>(lLast - p);
+        const unsigned int lLimit     = ((lAvailable < aAlphabet.mChunkDigits) ?
+                                         static_cast<unsigned int>(lAvailable) :
+                                         aAlphabet.mChunkDigits);
+        uint64_t           lChunk     = 0;
+        unsigned int       lDigits    = 0;
+
+        while (lDigits < lLimit)
+        {
+            const uint8_t lDigit = aAlphabet.mValues[static_cast<uint8_t>(p[lDigits])];
+
+            if (lDigit == StrNToUL::Kernel::kInvalidDigit)
+                break;
+
+            lChunk = (lChunk * aAlphabet.mRadix) + lDigit;
+
+            lDigits++;
+        }
+
+        if (lDigits == 0)
+            break;
+
+        if (__builtin_mul_overflow(lRetval, aAlphabet.mPowers[lDigits], &lRetval) ||
+            __builtin_add_overflow(lRetval, lChunk, &lRetval))
+        {
+            wouldOverflow = true;
+        }
+
+        convertedDigits = true;
+
+        p += lDigits;
+
+        if (lDigits < lLimit)
+            break;
+    }
+
+    // If no digits were converted, then, as with strntoul, aEnd, if
+    // non-null, must be equal to aString.
+
+    if (!convertedDigits)
+    {
+        p = aString;
+    }
+
+    if (aEnd != nullptr)
+    {
+        *aEnd = const_cast<char *>(p);
+    }
+
+    if (wouldOverflow)
+    {
+        errno   = ERANGE;
+        lRetval = ULONG_MAX;
+    }
+    else if (isNegative)
+    {
+        lRetval = -lRetval;
+    }
+
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    Create a compiled alphabet.
+ *
+ *  @param[in]   aDigits    A pointer to a null-terminated string of
+ *                          between 2 and STRNTOUL_ALPHABET_MAX
+ *                          distinct bytes, inclusive, the first of
+ *                          which has the value zero (0), the second
+ *                          one (1), and so on.
+ *  @param[out]  aAlphabet  A pointer to storage for the alphabet,
+ *                          which the caller must destroy with
+ *                          strntoul_alphabet_destroy.
+ *
+ *  @retval  0        If successful.
+ *  @retval  -EINVAL  If @a aDigits or @a aAlphabet was null, or if @a
+ *                    aDigits had too few or too many bytes or a
+ *                    repeated byte.
+ *  @retval  -ENOMEM  If memory could not be allocated.
+ *
+ *  @sa strntoul_alpha
+ *  @sa strntoul_alphabet_destroy
+ *
+ */
+int
+strntoul_alphabet_create(const char *aDigits, strntoul_alphabet_t **aAlphabet)
+{
+    strntoul_alphabet_t * lAlphabet;
+    bool                  lSeen[UCHAR_MAX + 1] = { };
+    size_t                lLength;
+
+    if ((aDigits == nullptr) || (aAlphabet == nullptr))
+    {
+        return (-EINVAL);
+    }
+
+    lLength = strnlen(aDigits, STRNTOUL_ALPHABET_MAX + 1);
+
+    if ((lLength < 2) || (lLength > STRNTOUL_ALPHABET_MAX))
+    {
+        return (-EINVAL);
+    }
+
+    for (size_t i = 0; i < lLength; i++)
+    {
+        const uint8_t lByte = static_cast<uint8_t>(aDigits[i]);
+
+        if (lSeen[lByte])
+        {
+            return (-EINVAL);
+        }
+
+        lSeen[lByte] = true;
+    }
+
+    lAlphabet = static_cast<strntoul_alphabet_t *>(calloc(1, sizeof (strntoul_alphabet_t)));
+
+    if (lAlphabet == nullptr)
+    {
+        return (-ENOMEM);
+    }
+
+    *lAlphabet = Compile(aDigits);
+
+    *aAlphabet = lAlphabet;
+
+    return (0);
+}
+
+/**
+ *  @brief
+ *    Destroy an alphabet created with strntoul_alphabet_create.
+ *
+ *  @param[in]  aAlphabet  A pointer to the alphabet to destroy. A null
+ *                         pointer is ignored.
+ *
+ */
+void
+strntoul_alphabet_destroy(strntoul_alphabet_t *aAlphabet)
+{
+    free(aAlphabet);
+}
+
+/**
+ *  @brief
+ *    Convert a string of digits from an alphabet to an unsigned long
+ *    integer.
+ *
+ *  This is identical to strntoul, except that the digits, and so the
+ *  base, are those of @a aAlphabet and that there is no prefix. Leading
+ *  white space and a sign are only recognized as such if they are not
+ *  also digits of @a aAlphabet.
+ *
+ *  On error, @a errno may be set as follows:
+ *
+ *    - EINVAL   @a aAlphabet was null, in which case this returns 0
+ *               and stores @a aString in *@a aEnd.
+ *    - ERANGE   The resulting conversion was out of range.
+ *
+ *  @param[in]   aString    A pointer to the string to convert.
+ *  @param[in]   aLength    The maximum number of characters, in
+ *                          bytes, of @a aString to process.
+ *  @param[out]  aEnd       A pointer to storage for the first invalid
+ *                          or the last valid character in @a aString.
+ *  @param[in]   aAlphabet  A pointer to the alphabet with which to
+ *                          interpret @a aString, such as
+ *                          &strntoul_alphabet_base58 or
+ *                          &strntoul_alphabet_base62.
+ *
+ *  @returns
+ *    The result of the conversion, as for strntoul.
+ *
+ *  @sa strntoul
+ *  @sa strntoul_alpha_batch
+ *
+ */
+unsigned long
+strntoul_alpha(const char *aString, size_t aLength, char **aEnd, const strntoul_alphabet_t *aAlphabet)
+{
+    if (aAlphabet == nullptr)
+    {
+        errno = EINVAL;
+
+        if (aEnd != nullptr)
+        {
+            *aEnd = const_cast<char *>(aString);
+        }
+
+        return (0);
+    }
+
+    return (Convert(aString, aLength, aEnd, *aAlphabet));
+}
+
+/**
+ *  @brief
+ *    Convert an array of strings of digits from an alphabet to
+ *    unsigned long integers.
+ *
+ *  This converts each of the @a aCount spans in @a aSpans exactly as
+ *  strntoul_alpha would, storing the results in the corresponding
+ *  entries of @a aValues and, if @a aEnds is not null, @a aEnds.
+ *
+ *  On error, @a errno may be set as for strntoul_alpha. Because errno
+ *  is shared by all spans, it is only set, never cleared.
+ *
+ *  @param[in]   aSpans     A pointer to the spans to convert.
+ *  @param[in]   aCount     The number of spans in @a aSpans.
+ *  @param[out]  aValues    A pointer to storage for @a aCount
+ *                          conversion results.
+ *  @param[out]  aEnds      An optional pointer to storage for @a
+ *                          aCount pointers to the first invalid or
+ *                          the last valid character in each span.
+ *  @param[in]   aAlphabet  A pointer to the alphabet with which to
+ *                          interpret the spans.
+ *
+ *  @returns
+ *    The number of spans whose every byte was converted.
+ *
+ *  @sa strntoul_alpha
+ *  @sa strntoul_batch
+ *
+ */
+size_t
+strntoul_alpha_batch(const strntoul_span_t *aSpans, size_t aCount, unsigned long *aValues, char **aEnds, const strntoul_alphabet_t *aAlphabet)
+{
+    size_t lConverted = 0;
+
+    if (aAlphabet == nullptr)
+    {
+        for (size_t i = 0; i < aCount; i++)
+        {
+            aValues[i] = strntoul_alpha(aSpans[i].mString, aSpans[i].mLength, ((aEnds != nullptr) ? &aEnds[i] : nullptr), aAlphabet);
+        }
+
+        return (0);
+    }
+
+    for (size_t i = 0; i < aCount; i++)
+    {
+        const strntoul_span_t &lSpan = aSpans[i];
+        char *                 lEnd;
+
+        aValues[i] = Convert(lSpan.mString, lSpan.mLength, &lEnd, *aAlphabet);
+
+        if (aEnds != nullptr)
+        {
+            aEnds[i] = lEnd;
+        }
+
+        if ((lSpan.mLength > 0) && (lEnd == (lSpan.mString + lSpan.mLength)))
+        {
+            lConverted++;
+        }
+    }
+
+    return (lConverted);
+}
@@ -0,0 +1,75 @@
+/*
+ *    Copyright (c) 2024 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *    @file
+ *      This file defines interfaces for converting strings of digits
+ *      drawn from an arbitrary alphabet, such as the base 58 and base
+ *      62 alphabets common to identifiers and addresses, to unsigned
+ *      long integers.
+ *
+ */
+
+#ifndef STRNTOUL_ALPHA_H
+#define STRNTOUL_ALPHA_H
+
+#include <stddef.h>
+
+#include <strntoul_batch.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ *  The largest number of digits an alphabet may have.
+ *
+ */
+#define STRNTOUL_ALPHABET_MAX 255
+
+/**
+ *  An immutable, compiled alphabet, which maps each byte to its digit
+ *  value, and which may be shared among threads.
+ *
+ */
+typedef struct strntoul_alphabet strntoul_alphabet_t;
+
+/**
+ *  The Bitcoin base 58 alphabet,
+ *  "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz".
+ *
+ */
+extern const strntoul_alphabet_t strntoul_alphabet_base58;
+
+/**
+ *  The base 62 alphabet,
+ *  "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz".
+ *
+ */
+extern const strntoul_alphabet_t strntoul_alphabet_base62;
+
+extern int strntoul_alphabet_create(const char *aDigits, strntoul_alphabet_t **aAlphabet);
+extern void strntoul_alphabet_destroy(strntoul_alphabet_t *aAlphabet);
+extern unsigned long strntoul_alpha(const char *aString, size_t aLength, char **aEnd, const strntoul_alphabet_t *aAlphabet);
+extern size_t strntoul_alpha_batch(const strntoul_span_t *aSpans, size_t aCount, unsigned long *aValues, char **aEnds, const strntoul_alphabet_t *aAlphabet);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STRNTOUL_ALPHA_H */
@@ -0,0 +1,53 @@
+/*
+ *    Copyright (c) 2024 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *    @file
+ *      This file defines an interface for converting many bounded,
+ *      potentially non-null-terminated strings to unsigned long
+ *      integers in a single call.
+ *
+ */
+
+#ifndef STRNTOUL_BATCH_H
+#define STRNTOUL_BATCH_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ *  A bounded, potentially non-null-terminated string to convert.
+ *
+ */
+typedef struct strntoul_span
+{
+    const char * mString; //!< A pointer to the string to convert.
+    size_t       mLength; //!< The maximum number of characters, in
+                          //!< bytes, of @a mString to process.
+} strntoul_span_t;
+
+extern size_t strntoul_batch(const strntoul_span_t *aSpans, size_t aCount, unsigned long *aValues, char **aEnds, int aBase);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STRNTOUL_BATCH_H */
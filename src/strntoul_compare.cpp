@@ -0,0 +1,340 @@
+/*
+ *    Copyright (c) 2024 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *    @file
+ *      This file implements interfaces for comparing bounded,
+ *      potentially non-null-terminated strings against an unsigned
+ *      long threshold without, in most cases, converting them.
+ *
+ *      Once leading zeroes are skipped, a value with more significant
+ *      digits than the threshold is greater and one with fewer is
+ *      less. Only when the digit counts match are the digits
+ *      themselves compared, most significant first, and the first
+ *      difference decides. No multiplication is ever required.
+ *
+ */
+
+#include "strntoul_compare.h"
+
+#include <ctype.h>
+#include <errno.h>
+#include <limits.h>
+#include <string.h>
+
+#include "strntoul.h"
+#include "strntoul/strntoul-kernel.h"
+
+static int
+CompareValues(const unsigned long &aFirst, const unsigned long &aSecond)
+{
+    return ((aFirst < aSecond) ? -1 : ((aFirst > aSecond) ? 1 : 0));
+}
+
+/**
+ *  Compare by full conversion, for those inputs, such as negated
+ *  values, whose comparison cannot be decided from their digits.
+ *
+ */
+static int
+CompareConverted(const char *aString, const size_t &aLength, char **aEnd, const strntoul_threshold_t &aThreshold)
+{
+    const int     lSavedErrno = errno;
+    unsigned long lValue;
+
+    lValue = strntoul(aString, aLength, aEnd, aThreshold.mBase);
+
+    errno = lSavedErrno;
+
+    return (CompareValues(lValue, aThreshold.mValue));
+}
+
+static bool
+Satisfies(const int &aComparison, const strntoul_predicate_t &aPredicate)
+{
+    bool lRetval = false;
+
+    switch (aPredicate)
+    {
+
+    case STRNTOUL_PREDICATE_LT:
+        lRetval = (aComparison < 0);
+        break;
+
+    case STRNTOUL_PREDICATE_LE:
+        lRetval = (aComparison <= 0);
+        break;
+
+    case STRNTOUL_PREDICATE_EQ:
+        lRetval = (aComparison == 0);
+        break;
+
+    case STRNTOUL_PREDICATE_NE:
+        lRetval = (aComparison != 0);
+        break;
+
+    case STRNTOUL_PREDICATE_GE:
+        lRetval = (aComparison >= 0);
+        break;
+
+    case STRNTOUL_PREDICATE_GT:
+        lRetval = (aComparison > 0);
+        break;
+
+    }
+
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    Initialize a threshold for comparison.
+ *
+ *  This pre-encodes @a aValue, as the digits of its representation in
+ *  @a aBase, for use with strntoul_compare and strntoul_filter.
+ *
+ *  @param[out]  aThreshold  A pointer to the threshold to initialize.
+ *  @param[in]   aValue      The threshold value.
+ *  @param[in]   aBase       The base, in the range 2 to 36,
+ *                           inclusive, of the strings that will be
+ *                           compared against the threshold.
+ *
+ *  @retval  0        If successful.
+ *  @retval  -EINVAL  If @a aThreshold was null or @a aBase was
+ *                    unsupported.
+ *
+ */
+int
+strntoul_threshold_init(strntoul_threshold_t *aThreshold, unsigned long aValue, int aBase)
+{
+    unsigned char lDigits[sizeof (aThreshold->mDigits)];
+    unsigned int  lDigitCount = 0;
+
+    if ((aThreshold == nullptr) || (aBase < 2) || (aBase > 36))
+    {
+        return (-EINVAL);
+    }
+
+    aThreshold->mValue = aValue;
+    aThreshold->mBase  = aBase;
+
+    // Zero has no significant digits, matching any run of zeroes once
+    // those are skipped.
+
+    while (aValue != 0)
+    {
+        lDigits[lDigitCount++] = static_cast<unsigned char>(aValue % static_cast<unsigned int>(aBase));
+
+        aValue /= static_cast<unsigned int>(aBase);
+    }
+
+    aThreshold->mDigitCount = lDigitCount;
+
+    for (unsigned int i = 0; i < lDigitCount; i++)
+    {
+        aThreshold->mDigits[i] = lDigits[lDigitCount - 1 - i];
+    }
+
+    return (0);
+}
+
+/**
+ *  @brief
+ *    Compare a string against a threshold.
+ *
+ *  This compares the value strntoul would return for @a aString, @a
+ *  aLength, and the threshold's base against the threshold, but
+ *  without converting that value, except in the rare case of a
+ *  leading minus sign.
+ *
+ *  Values out of range compare as ULONG_MAX, as strntoul would return.
+ *  Unlike strntoul, this never modifies errno.
+ *
+ *  @param[in]   aString     A pointer to the string to compare.
+ *  @param[in]   aLength     The maximum number of characters, in
+ *                           bytes, of @a aString to process.
+ *  @param[out]  aEnd        A pointer to storage for the first invalid
+ *                           or the last valid character in @a
+ *                           aString, exactly as strntoul would store.
+ *  @param[in]   aThreshold  A pointer to the initialized threshold to
+ *                           compare against.
+ *
+ *  @returns
+ *    A value less than, equal to, or greater than zero if the value
+ *    of @a aString is less than, equal to, or greater than the
+ *    threshold, respectively.
+ *
+ *  @sa strntoul
+ *  @sa strntoul_threshold_init
+ *
+ */
+int
+strntoul_compare(const char *aString, size_t aLength, char **aEnd, const strntoul_threshold_t *aThreshold)
+{
+    const char * const lLimit          = aString + aLength;
+    const unsigned int lBase           = static_cast<unsigned int>(aThreshold->mBase);
+    const char *       p               = aString;
+    const char *       lSignificant;
+    size_t             lDigitCount;
+    bool               convertedDigits = false;
+    int                lRetval         = 0;
+
+    // Skip any leading space and determine the sign, if any.
+
+    while ((p < lLimit) && isspace(*p))
+    {
+        p++;
+    }
+
+    if (p < lLimit)
+    {
+        if (*p == '-')
+        {
+            return (CompareConverted(aString, aLength, aEnd, *aThreshold));
+        }
+        else if (*p == '+')
+        {
+            p++;
+        }
+    }
+
+    if ((lBase == 16) && ((lLimit - p) > 1) && (p[0] == '0') && ((p[1] == 'x') || (p[1] == 'X')))
+    {
+        p += 2;
+    }
+
+    // Skip leading zeroes and count the significant digits.
+
+    while ((p < lLimit) && (*p == '0'))
+    {
+        convertedDigits = true;
+
+        p++;
+    }
+
+    lSignificant = p;
+
+    while ((p < lLimit) && (StrNToUL::Kernel::DigitValue(*p) < lBase))
+    {
+        p++;
+    }
+
+    lDigitCount = static_cast<size_t>(p - lSignificant);
+
+    if (lDigitCount > 0)
+    {
+        convertedDigits = true;
+    }
+
+    if (lDigitCount != aThreshold->mDigitCount)
+    {
+        lRetval = ((lDigitCount < aThreshold->mDigitCount) ? -1 : 1);
+    }
+    else
+    {
+        for (size_t i = 0; i < lDigitCount; i++)
+        {
+            const unsigned int lDigit = StrNToUL::Kernel::DigitValue(lSignificant[i]);
+
+            if (lDigit != aThreshold->mDigits[i])
+            {
+                lRetval = ((lDigit < aThreshold->mDigits[i]) ? -1 : 1);
+                break;
+            }
+        }
+    }
+
+    // Any value greater than ULONG_MAX is out of range and strntoul
+    // would return ULONG_MAX for it.
+
+    if ((lRetval > 0) && (aThreshold->mValue == ULONG_MAX))
+    {
+        lRetval = 0;
+    }
+
+    if (aEnd != nullptr)
+    {
+        *aEnd = const_cast<char *>(convertedDigits ? p : aString);
+    }
+
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    Compare each field of a delimited buffer against a threshold,
+ *    producing a bitmap of those satisfying a predicate.
+ *
+ *  This splits the @a aLength bytes at @a aBuffer into fields at each
+ *  @a aDelimiter and, for each of up to @a aCapacity fields, sets
+ *  the corresponding bit of @a aBitmap, least significant bit of the
+ *  first byte first, if the field's value satisfies @a aPredicate
+ *  against @a aThreshold, and clears it otherwise. Fields without
+ *  any digits never satisfy a predicate.
+ *
+ *  @param[in]   aBuffer      A pointer to the buffer to filter.
+ *  @param[in]   aLength      The number of bytes of @a aBuffer to
+ *                            process.
+ *  @param[in]   aDelimiter   The character separating fields.
+ *  @param[in]   aThreshold   A pointer to the initialized threshold
+ *                            to compare against.
+ *  @param[in]   aPredicate   The predicate each field must satisfy.
+ *  @param[out]  aBitmap      A pointer to storage for at least @a
+ *                            aCapacity bits.
+ *  @param[in]   aCapacity    The maximum number of fields to filter.
+ *
+ *  @returns
+ *    The number of fields filtered.
+ *
+ *  @sa strntoul_compare
+ *
+ */
+size_t
+strntoul_filter(const char *aBuffer, size_t aLength, char aDelimiter, const strntoul_threshold_t *aThreshold, strntoul_predicate_t aPredicate, unsigned char *aBitmap, size_t aCapacity)
+{
+    size_t lOffset = 0;
+    size_t lFields = 0;
+
+    while ((lOffset < aLength) && (lFields < aCapacity))
+    {
+        const char *   lField       = aBuffer + lOffset;
+        const void *   lDelimiter   = memchr(lField, aDelimiter, aLength - lOffset);
+        const size_t   lFieldLength = ((lDelimiter != nullptr) ?
+                                       static_cast<size_t>(static_cast<const char *>(lDelimiter) - lField) :
+                                       (aLength - lOffset));
+        const unsigned lBit         = (1U << (lFields % 8));
+        char *         lEnd;
+        int            lComparison;
+
+        lComparison = strntoul_compare(lField, lFieldLength, &lEnd, aThreshold);
+
+        if ((lEnd != lField) && Satisfies(lComparison, aPredicate))
+        {
+            aBitmap[lFields / 8] = static_cast<unsigned char>(aBitmap[lFields / 8] | lBit);
+        }
+        else
+        {
+            aBitmap[lFields / 8] = static_cast<unsigned char>(aBitmap[lFields / 8] & ~lBit);
+        }
+
+        lOffset += lFieldLength + 1;
+        lFields++;
+    }
+
+    return (lFields);
+}
@@ -0,0 +1,76 @@
+/*
+ *    Copyright (c) 2024 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *    @file
+ *      This file defines interfaces for comparing bounded,
+ *      potentially non-null-terminated strings against an unsigned
+ *      long threshold without, in most cases, converting them.
+ *
+ */
+
+#ifndef STRNTOUL_COMPARE_H
+#define STRNTOUL_COMPARE_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ *  A threshold, pre-encoded for comparison by strntoul_compare and
+ *  strntoul_filter. Initialize with strntoul_threshold_init.
+ *
+ */
+typedef struct strntoul_threshold
+{
+    unsigned long mValue;        //!< The threshold value.
+    int           mBase;         //!< The base of the strings to
+                                 //!< compare against.
+    unsigned int  mDigitCount;   //!< The number of significant
+                                 //!< digits of @a mValue in @a
+                                 //!< mBase.
+    unsigned char mDigits[sizeof (unsigned long) * 8];
+                                 //!< The values of those digits,
+                                 //!< most significant first.
+} strntoul_threshold_t;
+
+/**
+ *  The predicates that strntoul_filter may apply.
+ *
+ */
+typedef enum strntoul_predicate
+{
+    STRNTOUL_PREDICATE_LT,       //!< Less than the threshold.
+    STRNTOUL_PREDICATE_LE,       //!< Less than or equal to the threshold.
+    STRNTOUL_PREDICATE_EQ,       //!< Equal to the threshold.
+    STRNTOUL_PREDICATE_NE,       //!< Not equal to the threshold.
+    STRNTOUL_PREDICATE_GE,       //!< Greater than or equal to the threshold.
+    STRNTOUL_PREDICATE_GT        //!< Greater than the threshold.
+} strntoul_predicate_t;
+
+extern int strntoul_threshold_init(strntoul_threshold_t *aThreshold, unsigned long aValue, int aBase);
+extern int strntoul_compare(const char *aString, size_t aLength, char **aEnd, const strntoul_threshold_t *aThreshold);
+extern size_t strntoul_filter(const char *aBuffer, size_t aLength, char aDelimiter, const strntoul_threshold_t *aThreshold, strntoul_predicate_t aPredicate, unsigned char *aBitmap, size_t aCapacity);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STRNTOUL_COMPARE_H */
@@ -0,0 +1,976 @@
+/*
+ *    Copyright (c) 2024 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+
+/**
+ *    @file
+ *      This file implements interfaces for following an append-only
+ *      file of delimited unsigned long integers, converting only what
+ *      has been appended since the last update, from a checkpoint that
+ *      may be persisted across runs.
+ *
+ *      Each update compares the size of the followed file against the
+ *      checkpoint offset, to detect truncation, converts any bytes
+ *      beyond it, and then compares the device and inode that the
+ *      path names against those of the followed file, to detect
+ *      rotation. Where inotify is available, waiting for an update
+ *      watches the directory containing the file for changes to its
+ *      name; otherwise, it polls.
+ *
+ */
+
+#include "strntoul_follow.h"
+
+#if HAVE_CONFIG_H
+#include "strntoul-config.h"
+#endif
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <sys/stat.h>
+
+#if HAVE_SYS_INOTIFY_H
+#include <sys/inotify.h>
+#endif
+
+#include <string>
+
+#include "strntoul-fields.h"
+
+using namespace StrNToUL::Fields;
+
+static_assert(STRNTOUL_INGEST_CARRY_MAX == kCarryMax, "Checkpoint partial fields must fit the carry they are restored to.");
+
+namespace
+{
+
+const char     kMagic[8]     = { 's', 't', 'r', 'n', 't', 'o', 'u', 'f' };
+const uint32_t kVersion      = 1;
+const uint32_t kByteOrder    = 0x01020304;
+const int      kPollInterval = 100;
+
+struct Header
+{
+    char     mMagic[8];
+    uint32_t mVersion;
+    uint32_t mByteOrder;
+    uint64_t mDevice;
+    uint64_t mInode;
+    uint64_t mOffset;
+    uint32_t mPartialLength;
+    uint32_t mPartialOverlong;
+};
+
+}; // namespace
+
+struct strntoul_follow
+{
+    char *       mPath;
+    const char * mName;
+    int          mDescriptor;
+    int          mNotify;
+    uint64_t     mDevice;
+    uint64_t     mInode;
+    uint64_t     mOffset;
+    unsigned int mPending;
+    char *       mBuffer;
+    size_t       mBufferSize;
+    Converter    mConverter;
+};
+
+static void
+Reset(Converter &aConverter)
+{
+    aConverter.mCarryLength   = 0;
+    aConverter.mCarrying      = false;
+    aConverter.mCarryOverlong = false;
+}
+
+/**
+ *  Watch the directory containing the followed path for changes to
+ *  the files within it, if inotify is available. Failing to do so is
+ *  not an error: waiting then polls instead.
+ *
+ */
+static void
+Watch(strntoul_follow_t &aFollow)
+{
+    aFollow.mNotify = -1;
+
+#if HAVE_SYS_INOTIFY_H
+    const std::string lPath(aFollow.mPath);
+    const size_t      lSlash     = lPath.rfind('/');
+    const std::string lDirectory = ((lSlash == std::string::npos) ? "." :
+                                    (lSlash == 0)                 ? "/" :
+                                                                    lPath.substr(0, lSlash));
+
+    aFollow.mNotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+
+    if (aFollow.mNotify < 0)
+    {
+        aFollow.mNotify = -1;
+        return;
+    }
+
+    if (inotify_add_watch(aFollow.mNotify,
+                          lDirectory.c_str(),
+                          (IN_MODIFY | IN_ATTRIB | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO)) < 0)
+    {
+        close(aFollow.mNotify);
+
+        aFollow.mNotify = -1;
+    }
+#endif // HAVE_SYS_INOTIFY_H
+}
+
+/**
+ *  Determine whether the followed file has grown or shrunk from the
+ *  checkpoint or the path has come to name another file.
+ *
+ */
+static bool
+HasChanged(const strntoul_follow_t &aFollow)
+{
+    struct stat lStat;
+
+    if (aFollow.mPending != 0)
+    {
+        return (true);
+    }
+
+    if ((fstat(aFollow.mDescriptor, &lStat) == 0) &&
+        (static_cast<uint64_t>(lStat.st_size) != aFollow.mOffset))
+    {
+        return (true);
+    }
+
+    return ((stat(aFollow.mPath, &lStat) == 0) &&
+            ((static_cast<uint64_t>(lStat.st_dev) != aFollow.mDevice) ||
+             (static_cast<uint64_t>(lStat.st_ino) != aFollow.mInode)));
+}
+
+/**
+ *  Convert everything from the checkpoint offset to the end of the
+ *  followed file, passing the values to @a aCallback and advancing the
+ *  offset one buffer at a time.
+ *
+ */
+static int
+Drain(strntoul_follow_t &aFollow, strntoul_ingest_callback_t aCallback, void *aContext, uint64_t &aBytes)
+{
+    while (true)
+    {
+        const ssize_t lStatus = pread(aFollow.mDescriptor, aFollow.mBuffer, aFollow.mBufferSize, static_cast<off_t>(aFollow.mOffset));
+
+        if (lStatus < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            return (-errno);
+        }
+        else if (lStatus == 0)
+        {
+            break;
+        }
+
+        Convert(aFollow.mConverter, aFollow.mBuffer, static_cast<size_t>(lStatus));
+
+        aFollow.mOffset += static_cast<uint64_t>(lStatus);
+        aBytes          += static_cast<uint64_t>(lStatus);
+
+        if ((aCallback != nullptr) && (aFollow.mConverter.mCount > 0))
+        {
+            const int lRetval = aCallback(aFollow.mConverter.mValues, aFollow.mConverter.mCount, aContext);
+
+            if (lRetval != 0)
+            {
+                return (lRetval);
+            }
+        }
+    }
+
+    return (0);
+}
+
+/**
+ *  @brief
+ *    Start following a file.
+ *
+ *  This opens @a aPath and, if @a aCheckpoint is non-null and names
+ *  the same file, resumes from its offset and incomplete field, such
+ *  that the next update converts only what was appended since the
+ *  checkpoint was taken. If the file has since shrunk below the
+ *  checkpoint offset, or @a aPath now names a different file, the next
+ *  update converts the file from its start and reports
+ *  STRNTOUL_FOLLOW_TRUNCATED or STRNTOUL_FOLLOW_ROTATED, respectively.
+ *  Any incomplete field of a file no longer named by @a aPath is lost.
+ *
+ *  @param[in]   aPath        A pointer to the null-terminated path of
+ *                            the file to follow.
+ *  @param[in]   aOptions     A pointer to the buffer size, delimiter,
+ *                            and base options, as for strntoul_ingest,
+ *                            or null for a buffer of
+ *                            STRNTOUL_FOLLOW_BUFFER_SIZE and decimal
+ *                            values, one per line. The number of
+ *                            buffers is ignored.
+ *  @param[in]   aCheckpoint  An optional pointer to the checkpoint from
+ *                            which to resume.
+ *  @param[out]  aFollow      A pointer to storage for the follower,
+ *                            which the caller must close with
+ *                            strntoul_follow_close.
+ *
+ *  @retval  0        If successful.
+ *  @retval  -EINVAL  If @a aPath or @a aFollow were null, if the base
+ *                    was unsupported, or if @a aCheckpoint was
+ *                    malformed.
+ *  @retval  -ENOMEM  If memory could not be allocated.
+ *  @retval  -errno   If @a aPath could not be opened.
+ *
+ *  @sa strntoul_follow_update
+ *  @sa strntoul_follow_close
+ *
+ */
+int
+strntoul_follow_open(const char *aPath, const strntoul_ingest_options_t *aOptions, const strntoul_follow_checkpoint_t *aCheckpoint, strntoul_follow_t **aFollow)
+{
+    strntoul_ingest_options_t lOptions = { 0, 0, '\n', 10 };
+    strntoul_follow_t *       lFollow;
+    const char *              lSlash;
+    struct stat               lStat;
+
+    if (aOptions != nullptr)
+    {
+        lOptions = *aOptions;
+    }
+
+    if (lOptions.mBufferSize == 0)
+    {
+        lOptions.mBufferSize = STRNTOUL_FOLLOW_BUFFER_SIZE;
+    }
+
+    if ((aPath == nullptr) || (aFollow == nullptr) ||
+        ((lOptions.mBase != 0) && ((lOptions.mBase < 2) || (lOptions.mBase > 36))) ||
+        (lOptions.mBufferSize > SSIZE_MAX) ||
+        ((aCheckpoint != nullptr) && (aCheckpoint->mPartialLength > STRNTOUL_INGEST_CARRY_MAX)))
+    {
+        return (-EINVAL);
+    }
+
+    lFollow = static_cast<strntoul_follow_t *>(calloc(1, sizeof (strntoul_follow_t)));
+
+    if (lFollow == nullptr)
+    {
+        return (-ENOMEM);
+    }
+
+    lFollow->mDescriptor = -1;
+    lFollow->mNotify     = -1;
+    lFollow->mPath       = strdup(aPath);
+    lFollow->mBuffer     = static_cast<char *>(malloc(lOptions.mBufferSize));
+    lFollow->mBufferSize = lOptions.mBufferSize;
+
+    lFollow->mConverter.mDelimiter = lOptions.mDelimiter;
+    lFollow->mConverter.mBase      = lOptions.mBase;
+    lFollow->mConverter.mValues    = static_cast<unsigned long *>(calloc((lOptions.mBufferSize / 2) + 2, sizeof (unsigned long)));
+
+    if ((lFollow->mPath == nullptr) || (lFollow->mBuffer == nullptr) || (lFollow->mConverter.mValues == nullptr))
+    {
+        strntoul_follow_close(lFollow);
+
+        return (-ENOMEM);
+    }
+
+    lSlash         = strrchr(lFollow->mPath, '/');
+    lFollow->mName = ((lSlash != nullptr) ? (lSlash + 1) : lFollow->mPath);
+
+    lFollow->mDescriptor = open(aPath, O_RDONLY | O_CLOEXEC);
+
+    if ((lFollow->mDescriptor < 0) || (fstat(lFollow->mDescriptor, &lStat) != 0))
+    {
+        const int lRetval = -errno;
+
+        strntoul_follow_close(lFollow);
+
+        return (lRetval);
+    }
+
+    lFollow->mDevice = static_cast<uint64_t>(lStat.st_dev);
+    lFollow->mInode  = static_cast<uint64_t>(lStat.st_ino);
+
+    if (aCheckpoint != nullptr)
+    {
+        if ((aCheckpoint->mDevice != lFollow->mDevice) || (aCheckpoint->mInode != lFollow->mInode))
+        {
+            lFollow->mPending = STRNTOUL_FOLLOW_ROTATED;
+        }
+        else if (aCheckpoint->mOffset > static_cast<uint64_t>(lStat.st_size))
+        {
+            lFollow->mPending = STRNTOUL_FOLLOW_TRUNCATED;
+        }
+        else
+        {
+            Converter & lConverter = lFollow->mConverter;
+
+            lFollow->mOffset = aCheckpoint->mOffset;
+
+            memcpy(lConverter.mCarry, aCheckpoint->mPartial, aCheckpoint->mPartialLength);
+
+            lConverter.mCarryLength   = aCheckpoint->mPartialLength;
+            lConverter.mCarryOverlong = (aCheckpoint->mPartialOverlong != 0);
+            lConverter.mCarrying      = ((lConverter.mCarryLength > 0) || lConverter.mCarryOverlong);
+        }
+    }
+
+    Watch(*lFollow);
+
+    *aFollow = lFollow;
+
+    return (0);
+}
+
+/**
+ *  @brief
+ *    Stop following a file.
+ *
+ *  @param[in]  aFollow  A pointer to the follower to close. A null
+ *                       pointer is ignored.
+ *
+ */
+void
+strntoul_follow_close(strntoul_follow_t *aFollow)
+{
+    if (aFollow == nullptr)
+    {
+        return;
+    }
+
+    if (aFollow->mNotify >= 0)
+    {
+        close(aFollow->mNotify);
+    }
+
+    if (aFollow->mDescriptor >= 0)
+    {
+        close(aFollow->mDescriptor);
+    }
+
+    free(aFollow->mConverter.mValues);
+    free(aFollow->mBuffer);
+    free(aFollow->mPath);
+    free(aFollow);
+}
+
+/**
+ *  @brief
+ *    Convert whatever has been appended to a followed file.
+ *
+ *  This converts the bytes of the followed file beyond its checkpoint
+ *  offset, as strntoul_ingest does, passing the valid values to @a
+ *  aCallback, one buffer at a time, and advances the checkpoint. The
+ *  work done is proportional to the data appended, not to the size of
+ *  the file. A field left incomplete at the end of the file is
+ *  carried, in the checkpoint, until its delimiter is appended.
+ *
+ *  If the file has shrunk below the checkpoint, it is converted again
+ *  from its start. If the path names a different file, the followed
+ *  file is converted to its end, including any final, undelimited
+ *  field, and the new file is then followed, from its start. If @a
+ *  aCallback stops that, the followed file is kept, and the rotation
+ *  is reported by the update that completes it.
+ *
+ *  On error, @a errno may be set as follows:
+ *
+ *    - ERANGE   At least one field was out of range. Such fields are
+ *               counted as invalid.
+ *
+ *  @param[in]   aFollow    A pointer to the follower to update.
+ *  @param[in]   aCallback  The function to call with the values of
+ *                          each buffer, or null to only count them.
+ *  @param[in]   aContext   The context to pass to @a aCallback.
+ *  @param[out]  aStats     An optional pointer to storage for the
+ *                          value and byte counts of this update.
+ *
+ *  @returns
+ *    A bitwise combination of zero or more STRNTOUL_FOLLOW_* events if
+ *    successful; -EINVAL if @a aFollow was null; a negative errno if
+ *    the file could not be read; or the non-zero value returned by @a
+ *    aCallback, in which case the checkpoint includes the buffer for
+ *    which it was returned.
+ *
+ *  @sa strntoul_follow_wait
+ *  @sa strntoul_follow_get_checkpoint
+ *
+ */
+int
+strntoul_follow_update(strntoul_follow_t *aFollow, strntoul_ingest_callback_t aCallback, void *aContext, strntoul_ingest_stats_t *aStats)
+{
+    unsigned int lEvents;
+    uint64_t     lBytes = 0;
+    size_t       lValid;
+    size_t       lInvalid;
+    int          lRetval;
+
+    if (aFollow == nullptr)
+    {
+        return (-EINVAL);
+    }
+
+    Converter & lConverter = aFollow->mConverter;
+
+    lEvents                = aFollow->mPending;
+    aFollow->mPending      = 0;
+    lValid                 = lConverter.mValid;
+    lInvalid               = lConverter.mInvalid;
+    lConverter.mOutOfRange = false;
+
+    while (true)
+    {
+        struct stat lStat;
+        int         lDescriptor;
+
+        if (fstat(aFollow->mDescriptor, &lStat) != 0)
+        {
+            lRetval = -errno;
+            break;
+        }
+
+        if (static_cast<uint64_t>(lStat.st_size) < aFollow->mOffset)
+        {
+            lEvents          |= STRNTOUL_FOLLOW_TRUNCATED;
+            aFollow->mOffset  = 0;
+
+            Reset(lConverter);
+        }
+
+        lRetval = Drain(*aFollow, aCallback, aContext, lBytes);
+
+        if (lRetval != 0)
+        {
+            break;
+        }
+
+        // If the path no longer names the followed file and names
+        // another, the followed file was rotated away. Since it was
+        // drained before the path was checked, a final drain catches
+        // anything appended to it in between.
+
+        if ((stat(aFollow->mPath, &lStat) != 0) ||
+            ((static_cast<uint64_t>(lStat.st_dev) == aFollow->mDevice) &&
+             (static_cast<uint64_t>(lStat.st_ino) == aFollow->mInode)))
+        {
+            break;
+        }
+
+        lDescriptor = open(aFollow->mPath, O_RDONLY | O_CLOEXEC);
+
+        if ((lDescriptor < 0) || (fstat(lDescriptor, &lStat) != 0))
+        {
+            if (lDescriptor >= 0)
+            {
+                close(lDescriptor);
+            }
+
+            break;
+        }
+
+        // The new file is switched to only once the rotated-away one
+        // has been converted to its end, including its final,
+        // undelimited field. If either stops short, whether on a read
+        // error or by the callback, the rotated-away file is kept,
+        // with its offset and any incomplete field, and the next
+        // update finishes it before switching.
+
+        lRetval = Drain(*aFollow, aCallback, aContext, lBytes);
+
+        if (lRetval == 0)
+        {
+            lConverter.mCount = 0;
+
+            if (lConverter.mCarrying)
+            {
+                Flush(lConverter);
+            }
+
+            if ((aCallback != nullptr) && (lConverter.mCount > 0))
+            {
+                lRetval = aCallback(lConverter.mValues, lConverter.mCount, aContext);
+            }
+        }
+
+        if (lRetval != 0)
+        {
+            close(lDescriptor);
+
+            aFollow->mPending |= STRNTOUL_FOLLOW_ROTATED;
+            break;
+        }
+
+        close(aFollow->mDescriptor);
+
+        aFollow->mDescriptor = lDescriptor;
+        aFollow->mDevice     = static_cast<uint64_t>(lStat.st_dev);
+        aFollow->mInode      = static_cast<uint64_t>(lStat.st_ino);
+        aFollow->mOffset     = 0;
+        lEvents             |= STRNTOUL_FOLLOW_ROTATED;
+
+        Reset(lConverter);
+    }
+
+    if (aStats != nullptr)
+    {
+        aStats->mBytes       = lBytes;
+        aStats->mCount       = lConverter.mValid - lValid;
+        aStats->mInvalid     = lConverter.mInvalid - lInvalid;
+        aStats->mReaderWaits = 0;
+        aStats->mParserWaits = 0;
+    }
+
+    if (lConverter.mOutOfRange)
+    {
+        errno = ERANGE;
+    }
+
+    return ((lRetval != 0) ? lRetval : static_cast<int>(lEvents));
+}
+
+/**
+ *  @brief
+ *    Wait for a followed file to change.
+ *
+ *  This waits until the followed file may have been appended to,
+ *  truncated, or rotated, such that strntoul_follow_update has work to
+ *  do. Where inotify is available, this sleeps until the directory
+ *  containing the file reports a change to it; otherwise, this polls
+ *  the file.
+ *
+ *  @param[in]  aFollow   A pointer to the follower to wait on.
+ *  @param[in]  aTimeout  The maximum time to wait, in milliseconds, or
+ *                        a negative value to wait indefinitely.
+ *
+ *  @retval  1        If the file changed.
+ *  @retval  0        If the timeout elapsed first.
+ *  @retval  -EINVAL  If @a aFollow was null.
+ *  @retval  -errno   If waiting failed.
+ *
+ *  @sa strntoul_follow_descriptor
+ *
+ */
+int
+strntoul_follow_wait(strntoul_follow_t *aFollow, int aTimeout)
+{
+    struct timespec lNow;
+    int64_t         lDeadline;
+
+    if (aFollow == nullptr)
+    {
+        return (-EINVAL);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &lNow);
+
+    lDeadline = (static_cast<int64_t>(lNow.tv_sec) * 1000) + (lNow.tv_nsec / 1000000) + aTimeout;
+
+    while (true)
+    {
+        int lRemaining = -1;
+        int lStatus;
+
+        if (HasChanged(*aFollow))
+        {
+            return (1);
+        }
+
+        if (aTimeout >= 0)
+        {
+            clock_gettime(CLOCK_MONOTONIC, &lNow);
+
+            const int64_t lLeft = lDeadline - ((static_cast<int64_t>(lNow.tv_sec) * 1000) + (lNow.tv_nsec / 1000000));
+
+            if (lLeft <= 0)
+            {
+                return (0);
+            }
+
+            lRemaining = static_cast<int>(lLeft);
+        }
+
+        if (aFollow->mNotify < 0)
+        {
+            lStatus = poll(nullptr, 0, (((lRemaining < 0) || (lRemaining > kPollInterval)) ? kPollInterval : lRemaining));
+        }
+        else
+        {
+            struct pollfd lPoll = { aFollow->mNotify, POLLIN, 0 };
+
+            lStatus = poll(&lPoll, 1, lRemaining);
+        }
+
+        if ((lStatus < 0) && (errno != EINTR))
+        {
+            return (-errno);
+        }
+
+#if HAVE_SYS_INOTIFY_H
+        // Discard the events: which file changed, and how, is
+        // determined by comparison with the checkpoint, above, such
+        // that changes to other files in the directory are ignored.
+
+        if ((lStatus > 0) && (aFollow->mNotify >= 0))
+        {
+            char lEvents[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+
+            while (read(aFollow->mNotify, lEvents, sizeof (lEvents)) > 0)
+            {
+                continue;
+            }
+        }
+#endif // HAVE_SYS_INOTIFY_H
+    }
+}
+
+/**
+ *  @brief
+ *    Return a descriptor that becomes readable when a followed file
+ *    may have changed.
+ *
+ *  This allows the follower to be waited on in an event loop along
+ *  with other descriptors. When the descriptor becomes readable, call
+ *  strntoul_follow_wait with a zero timeout, which drains it, and then,
+ *  if that indicates a change, strntoul_follow_update.
+ *
+ *  @param[in]  aFollow  A pointer to the follower.
+ *
+ *  @returns
+ *    The descriptor; -EINVAL if @a aFollow was null; or -ENOTSUP if
+ *    inotify is not available, in which case the follower must be
+ *    polled.
+ *
+ */
+int
+strntoul_follow_descriptor(const strntoul_follow_t *aFollow)
+{
+    if (aFollow == nullptr)
+    {
+        return (-EINVAL);
+    }
+
+    return ((aFollow->mNotify >= 0) ? aFollow->mNotify : -ENOTSUP);
+}
+
+/**
+ *  @brief
+ *    Take a checkpoint of a follower.
+ *
+ *  @param[in]   aFollow      A pointer to the follower.
+ *  @param[out]  aCheckpoint  A pointer to storage for the checkpoint,
+ *                            from which strntoul_follow_open may later
+ *                            resume.
+ *
+ *  @retval  0        If successful.
+ *  @retval  -EINVAL  If @a aFollow or @a aCheckpoint were null.
+ *
+ *  @sa strntoul_follow_checkpoint_save
+ *
+ */
+int
+strntoul_follow_get_checkpoint(const strntoul_follow_t *aFollow, strntoul_follow_checkpoint_t *aCheckpoint)
+{
+    if ((aFollow == nullptr) || (aCheckpoint == nullptr))
+    {
+        return (-EINVAL);
+    }
+
+    memset(aCheckpoint, 0, sizeof (*aCheckpoint));
+
+    aCheckpoint->mDevice          = aFollow->mDevice;
+    aCheckpoint->mInode           = aFollow->mInode;
+    aCheckpoint->mOffset          = aFollow->mOffset;
+    aCheckpoint->mPartialLength   = aFollow->mConverter.mCarryLength;
+    aCheckpoint->mPartialOverlong = aFollow->mConverter.mCarryOverlong;
+
+    memcpy(aCheckpoint->mPartial, aFollow->mConverter.mCarry, aFollow->mConverter.mCarryLength);
+
+    return (0);
+}
+
+static int
+WriteAll(const int &aDescriptor, const void *aData, size_t aSize)
+{
+    const uint8_t * p = static_cast<const uint8_t *>(aData);
+
+    while (aSize > 0)
+    {
+        const ssize_t lWritten = write(aDescriptor, p, aSize);
+
+        if (lWritten < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            return (-errno);
+        }
+
+        p     += lWritten;
+        aSize -= static_cast<size_t>(lWritten);
+    }
+
+    return (0);
+}
+
+static int
+ReadAll(const int &aDescriptor, void *aData, size_t aSize)
+{
+    uint8_t * p = static_cast<uint8_t *>(aData);
+
+    while (aSize > 0)
+    {
+        const ssize_t lRead = read(aDescriptor, p, aSize);
+
+        if (lRead < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            return (-errno);
+        }
+        else if (lRead == 0)
+        {
+            return (-EINVAL);
+        }
+
+        p     += lRead;
+        aSize -= static_cast<size_t>(lRead);
+    }
+
+    return (0);
+}
+
+/**
+ *  Synchronize the directory containing @a aPath, such that a rename
+ *  into it survives a crash.
+ *
+ */
+static int
+SyncDirectory(const std::string &aPath)
+{
+    const size_t lSlash = aPath.rfind('/');
+    std::string  lDirectory;
+    int          lDescriptor;
+    int          lRetval = 0;
+
+    if (lSlash == std::string::npos)
+    {
+        lDirectory = ".";
+    }
+    else if (lSlash == 0)
+    {
+        lDirectory = "/";
+    }
+    else
+    {
+        lDirectory = aPath.substr(0, lSlash);
+    }
+
+    lDescriptor = open(lDirectory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+
+    if (lDescriptor < 0)
+    {
+        return (-errno);
+    }
+
+    if (fsync(lDescriptor) != 0)
+    {
+        lRetval = -errno;
+    }
+
+    close(lDescriptor);
+
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    Persist a checkpoint to a file.
+ *
+ *  The checkpoint is written to a temporary file alongside @a aPath,
+ *  synchronized, and renamed into place, such that @a aPath always
+ *  holds either the previous checkpoint or this one, in full. The
+ *  containing directory is then synchronized, such that, once this
+ *  returns successfully, the new checkpoint survives a crash.
+ *
+ *  @param[in]  aCheckpoint  A pointer to the checkpoint to persist.
+ *  @param[in]  aPath        A pointer to the null-terminated path of
+ *                           the file to persist it to.
+ *
+ *  @retval  0        If successful.
+ *  @retval  -EINVAL  If @a aCheckpoint or @a aPath were null or @a
+ *                    aCheckpoint was malformed.
+ *  @retval  -errno   If the file could not be written or its
+ *                    directory could not be synchronized.
+ *
+ *  @sa strntoul_follow_checkpoint_load
+ *
+ */
+int
+strntoul_follow_checkpoint_save(const strntoul_follow_checkpoint_t *aCheckpoint, const char *aPath)
+{
+    std::string lPath;
+    Header      lHeader;
+    int         lDescriptor;
+    int         lStatus;
+
+    if ((aCheckpoint == nullptr) || (aPath == nullptr) ||
+        (aCheckpoint->mPartialLength > STRNTOUL_INGEST_CARRY_MAX))
+    {
+        return (-EINVAL);
+    }
+
+    memset(&lHeader, 0, sizeof (lHeader));
+
+    memcpy(lHeader.mMagic, kMagic, sizeof (kMagic));
+
+    lHeader.mVersion         = kVersion;
+    lHeader.mByteOrder       = kByteOrder;
+    lHeader.mDevice          = aCheckpoint->mDevice;
+    lHeader.mInode           = aCheckpoint->mInode;
+    lHeader.mOffset          = aCheckpoint->mOffset;
+    lHeader.mPartialLength   = static_cast<uint32_t>(aCheckpoint->mPartialLength);
+    lHeader.mPartialOverlong = (aCheckpoint->mPartialOverlong != 0);
+
+    lPath  = aPath;
+    lPath += ".XXXXXX";
+
+    lDescriptor = mkstemp(&lPath[0]);
+
+    if (lDescriptor < 0)
+    {
+        return (-errno);
+    }
+
+    lStatus = WriteAll(lDescriptor, &lHeader, sizeof (lHeader));
+
+    if (lStatus == 0)
+    {
+        lStatus = WriteAll(lDescriptor, aCheckpoint->mPartial, aCheckpoint->mPartialLength);
+    }
+
+    if ((lStatus == 0) && (fsync(lDescriptor) != 0))
+    {
+        lStatus = -errno;
+    }
+
+    if ((close(lDescriptor) != 0) && (lStatus == 0))
+    {
+        lStatus = -errno;
+    }
+
+    if ((lStatus == 0) && (rename(lPath.c_str(), aPath) != 0))
+    {
+        lStatus = -errno;
+    }
+
+    if (lStatus != 0)
+    {
+        unlink(lPath.c_str());
+
+        return (lStatus);
+    }
+
+    return (SyncDirectory(aPath));
+}
+
+/**
+ *  @brief
+ *    Load a checkpoint persisted to a file.
+ *
+ *  @param[in]   aPath        A pointer to the null-terminated path of
+ *                            the file to load the checkpoint from.
+ *  @param[out]  aCheckpoint  A pointer to storage for the checkpoint.
+ *
+ *  @retval  0        If successful.
+ *  @retval  -EINVAL  If @a aPath or @a aCheckpoint were null or the
+ *                    file was not a checkpoint written by this host.
+ *  @retval  -errno   If the file could not be read, for example,
+ *                    -ENOENT if no checkpoint had been saved.
+ *
+ *  @sa strntoul_follow_checkpoint_save
+ *
+ */
+int
+strntoul_follow_checkpoint_load(const char *aPath, strntoul_follow_checkpoint_t *aCheckpoint)
+{
+    Header lHeader;
+    int    lDescriptor;
+    int    lStatus;
+
+    if ((aPath == nullptr) || (aCheckpoint == nullptr))
+    {
+        return (-EINVAL);
+    }
+
+    lDescriptor = open(aPath, O_RDONLY | O_CLOEXEC);
+
+    if (lDescriptor < 0)
+    {
+        return (-errno);
+    }
+
+    memset(aCheckpoint, 0, sizeof (*aCheckpoint));
+
+    lStatus = ReadAll(lDescriptor, &lHeader, sizeof (lHeader));
+
+    if ((lStatus == 0) &&
+        ((memcmp(lHeader.mMagic, kMagic, sizeof (kMagic)) != 0) ||
+         (lHeader.mVersion != kVersion)                         ||
+         (lHeader.mByteOrder != kByteOrder)                     ||
+         (lHeader.mPartialLength > STRNTOUL_INGEST_CARRY_MAX)))
+    {
+        lStatus = -EINVAL;
+    }
+
+    if (lStatus == 0)
+    {
+        lStatus = ReadAll(lDescriptor, aCheckpoint->mPartial, lHeader.mPartialLength);
+    }
+
+    close(lDescriptor);
+
+    if (lStatus == 0)
+    {
+        aCheckpoint->mDevice          = lHeader.mDevice;
+        aCheckpoint->mInode           = lHeader.mInode;
+        aCheckpoint->mOffset          = lHeader.mOffset;
+        aCheckpoint->mPartialLength   = lHeader.mPartialLength;
+        aCheckpoint->mPartialOverlong = (lHeader.mPartialOverlong != 0);
+    }
+
+    return (lStatus);
+}
@@ -0,0 +1,98 @@
+/*
+ *    Copyright (c) 2024 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+
+/**
+ *    @file
+ *      This file defines interfaces for following an append-only file
+ *      of delimited unsigned long integers, converting only what has
+ *      been appended since the last update, from a checkpoint that may
+ *      be persisted across runs.
+ *
+ */
+
+#ifndef STRNTOUL_FOLLOW_H
+#define STRNTOUL_FOLLOW_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <strntoul_ingest.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ *  The default size, in bytes, of the buffer each update reads into.
+ *
+ */
+#define STRNTOUL_FOLLOW_BUFFER_SIZE (64 * 1024)
+
+/**
+ *  The events that strntoul_follow_update may report, in addition to
+ *  converting any appended data.
+ *
+ */
+enum
+{
+    STRNTOUL_FOLLOW_TRUNCATED = 0x01, //!< The file shrank below the
+                                      //!< checkpoint and was converted
+                                      //!< again from its start.
+    STRNTOUL_FOLLOW_ROTATED   = 0x02  //!< The path now names a
+                                      //!< different file, which was
+                                      //!< converted from its start.
+};
+
+/**
+ *  The position of a follower: the file it was following, how much of
+ *  that file it had converted, and the field, if any, left incomplete
+ *  at that point.
+ *
+ */
+typedef struct strntoul_follow_checkpoint
+{
+    uint64_t mDevice;          //!< The device of the followed file.
+    uint64_t mInode;           //!< The inode of the followed file.
+    uint64_t mOffset;          //!< The number of bytes of the file
+                               //!< converted or carried.
+    size_t   mPartialLength;   //!< The length, in bytes, of @a
+                               //!< mPartial.
+    int      mPartialOverlong; //!< Non-zero if the incomplete field
+                               //!< was already too long to be valid.
+    char     mPartial[STRNTOUL_INGEST_CARRY_MAX];
+                               //!< The bytes of the incomplete field
+                               //!< at the end of the file.
+} strntoul_follow_checkpoint_t;
+
+typedef struct strntoul_follow strntoul_follow_t;
+
+extern int strntoul_follow_open(const char *aPath, const strntoul_ingest_options_t *aOptions, const strntoul_follow_checkpoint_t *aCheckpoint, strntoul_follow_t **aFollow);
+extern void strntoul_follow_close(strntoul_follow_t *aFollow);
+extern int strntoul_follow_update(strntoul_follow_t *aFollow, strntoul_ingest_callback_t aCallback, void *aContext, strntoul_ingest_stats_t *aStats);
+extern int strntoul_follow_wait(strntoul_follow_t *aFollow, int aTimeout);
+extern int strntoul_follow_descriptor(const strntoul_follow_t *aFollow);
+extern int strntoul_follow_get_checkpoint(const strntoul_follow_t *aFollow, strntoul_follow_checkpoint_t *aCheckpoint);
+extern int strntoul_follow_checkpoint_save(const strntoul_follow_checkpoint_t *aCheckpoint, const char *aPath);
+extern int strntoul_follow_checkpoint_load(const char *aPath, strntoul_follow_checkpoint_t *aCheckpoint);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STRNTOUL_FOLLOW_H */
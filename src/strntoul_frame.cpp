@@ -0,0 +1,725 @@
+/*
+ *    Copyright (c) 2024 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+
+/**
+ *    @file
+ *      This file implements interfaces for parsing the length-prefixed
+ *      headers of common text protocols: RESP (Redis), memcached
+ *      "VALUE" responses, and HTTP/1.1 chunked transfer coding.
+ *
+ *      Rather than first searching for the CRLF and then converting
+ *      the digits before it, each converts the digits with the
+ *      windowed decimal kernel, or, for hexadecimal chunk sizes, a
+ *      bounded digit loop, and then expects the terminator exactly
+ *      where the digits end. Each header is bounded, so that a peer
+ *      cannot keep a parser waiting for more bytes indefinitely.
+ *
+ */
+
+#include "strntoul_frame.h"
+
+#include <errno.h>
+#include <limits.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "strntoul/strntoul-kernel.h"
+
+// The most digits accepted in any length or count, including any
+// leading zeros, beyond which a header is malformed rather than
+// merely incomplete.
+
+static constexpr size_t kMaximumDigits       = 20;
+
+// The most bytes accepted in a chunk-size line, including any chunk
+// extensions.
+
+static constexpr size_t kMaximumChunkHeader  = 4096;
+
+// The most bytes in a memcached key.
+
+static constexpr size_t kMaximumKey          = 250;
+
+static const char       kMemcachedValue[]    = "VALUE ";
+static const char       kMemcachedEnd[]      = "END\r\n";
+
+/**
+ *  Expect a CRLF at @a aOffset in @a aBuffer and, if present, store
+ *  the offset just past it in @a aHeaderLength.
+ *
+ */
+static int
+ExpectTerminator(const char *aBuffer, const size_t &aLength, const size_t &aOffset, size_t &aHeaderLength)
+{
+    if (aOffset >= aLength)
+    {
+        return (-EAGAIN);
+    }
+    else if (aBuffer[aOffset] != '\r')
+    {
+        return (-EBADMSG);
+    }
+    else if ((aOffset + 1) >= aLength)
+    {
+        return (-EAGAIN);
+    }
+    else if (aBuffer[aOffset + 1] != '\n')
+    {
+        return (-EBADMSG);
+    }
+
+    aHeaderLength = aOffset + 2;
+
+    return (0);
+}
+
+/**
+ *  Convert the decimal digits at @a aOffset in @a aBuffer, no greater
+ *  than @a aLimit, advancing @a aOffset past them.
+ *
+ *  @retval  0         If the digits were followed by a non-digit.
+ *  @retval  -EAGAIN   If the digits ran to the end of @a aBuffer.
+ *  @retval  -EBADMSG  If there were no digits or too many.
+ *  @retval  -ERANGE   If the value exceeded @a aLimit.
+ *
+ */
+static int
+ConvertDecimalField(const char *aBuffer, const size_t &aLength, size_t &aOffset, const uint64_t &aLimit, uint64_t &aValue)
+{
+    const size_t lFirst = aOffset;
+    uint64_t     lValue = 0;
+
+    // A header that ends just before its field is incomplete. Leave
+    // before the kernel, which would otherwise load at one past the
+    // end of the buffer.
+
+    if (aOffset == aLength)
+    {
+        return (-EAGAIN);
+    }
+
+#if STRNTOUL_USE_DECIMAL_KERNEL
+    aOffset += StrNToUL::Kernel::ConvertDecimal(aBuffer + aOffset, aLength - aOffset, lValue);
+#endif
+
+    if (lValue > aLimit)
+    {
+        return (-ERANGE);
+    }
+
+    // Only the longest values, or a target without the kernel, get
+    // here with digits remaining.
+
+    while (aOffset < aLength)
+    {
+        const unsigned int lDigit = static_cast<unsigned int>(static_cast<unsigned char>(aBuffer[aOffset]) - '0');
+
+        if (lDigit > 9)
+        {
+            break;
+        }
+
+        if (__builtin_mul_overflow(lValue, 10, &lValue) ||
+            __builtin_add_overflow(lValue, lDigit, &lValue) ||
+            (lValue > aLimit))
+        {
+            return (-ERANGE);
+        }
+
+        aOffset++;
+
+        if ((aOffset - lFirst) > kMaximumDigits)
+        {
+            return (-EBADMSG);
+        }
+    }
+
+    if (aOffset == aLength)
+    {
+        return (((aOffset - lFirst) > kMaximumDigits) ? -EBADMSG : -EAGAIN);
+    }
+    else if (aOffset == lFirst)
+    {
+        return (-EBADMSG);
+    }
+
+    aValue = lValue;
+
+    return (0);
+}
+
+/**
+ *  Compute the length of a frame whose header, of @a aHeaderLength
+ *  bytes, announces a payload of @a aPayload bytes followed by a
+ *  CRLF.
+ *
+ */
+static int
+FrameLength(const size_t &aHeaderLength, const uint64_t &aPayload, size_t &aFrameLength)
+{
+    size_t lRetval;
+
+    if ((aPayload > SIZE_MAX) ||
+        __builtin_add_overflow(aHeaderLength, static_cast<size_t>(aPayload), &lRetval) ||
+        __builtin_add_overflow(lRetval, static_cast<size_t>(2), &lRetval))
+    {
+        return (-ERANGE);
+    }
+
+    aFrameLength = lRetval;
+
+    return (0);
+}
+
+/**
+ *  @brief
+ *    Parse a RESP header.
+ *
+ *  This parses the header at the start of @a aBuffer, classified by
+ *  its leading type byte:
+ *
+ *    - '$', '!', and '=' announce a payload of the given length, which
+ *      is included in the frame length, or, for "$-1", a null.
+ *    - '*', '%', '~', '>', and '|' announce the given count of
+ *      elements, which follow the frame, or, for "*-1", a null.
+ *    - ':' carries a signed, 64-bit integer.
+ *    - '+', '-', '_', '#', ',', and '(' carry a line, whose value is
+ *      zero (0).
+ *
+ *  Lengths, counts, and integers must be terminated by CRLF
+ *  immediately after their digits.
+ *
+ *  @param[in]   aBuffer  A pointer to the buffered bytes, which need
+ *                        not be null-terminated.
+ *  @param[in]   aLength  The length, in bytes, of @a aBuffer.
+ *  @param[out]  aType    An optional pointer to storage for the type
+ *                        byte.
+ *  @param[out]  aFrame   A pointer to storage for the header and
+ *                        frame.
+ *
+ *  @retval  0         If successful.
+ *  @retval  -EAGAIN   If more bytes are needed to complete the header.
+ *  @retval  -EBADMSG  If the header was malformed or of an unknown
+ *                     type.
+ *  @retval  -EINVAL   If an argument was null.
+ *  @retval  -ERANGE   If a length, count, or integer was out of
+ *                     range.
+ *
+ */
+int
+strntoul_frame_resp(const char *aBuffer, size_t aLength, char *aType, strntoul_frame_t *aFrame)
+{
+    size_t   lOffset = 1;
+    size_t   lHeaderLength;
+    size_t   lFrameLength;
+    uint64_t lValue;
+    bool     lNegative = false;
+    int      lRetval;
+
+    if (((aBuffer == nullptr) && (aLength > 0)) || (aFrame == nullptr))
+    {
+        return (-EINVAL);
+    }
+
+    if (aLength == 0)
+    {
+        return (-EAGAIN);
+    }
+
+    switch (aBuffer[0])
+    {
+
+    case '$':
+    case '*':
+        // A null, in RESP2.
+
+        if ((aLength > 1) && (aBuffer[1] == '-'))
+        {
+            if (aLength == 2)
+            {
+                return (-EAGAIN);
+            }
+            else if (aBuffer[2] != '1')
+            {
+                return (-EBADMSG);
+            }
+
+            lRetval = ExpectTerminator(aBuffer, aLength, 3, lHeaderLength);
+
+            if (lRetval == 0)
+            {
+                aFrame->mValue        = -1;
+                aFrame->mHeaderLength = lHeaderLength;
+                aFrame->mFrameLength  = lHeaderLength;
+            }
+
+            break;
+        }
+
+        // Otherwise, a length or count follows.
+        //
+        // Fall through.
+
+    case '!':
+    case '=':
+    case '%':
+    case '~':
+    case '>':
+    case '|':
+        lRetval = ConvertDecimalField(aBuffer, aLength, lOffset, LLONG_MAX, lValue);
+
+        if (lRetval == 0)
+        {
+            lRetval = ExpectTerminator(aBuffer, aLength, lOffset, lHeaderLength);
+        }
+
+        if (lRetval != 0)
+        {
+            break;
+        }
+
+        lFrameLength = lHeaderLength;
+
+        if ((aBuffer[0] == '$') || (aBuffer[0] == '!') || (aBuffer[0] == '='))
+        {
+            lRetval = FrameLength(lHeaderLength, lValue, lFrameLength);
+
+            if (lRetval != 0)
+            {
+                break;
+            }
+        }
+
+        aFrame->mValue        = static_cast<long long>(lValue);
+        aFrame->mHeaderLength = lHeaderLength;
+        aFrame->mFrameLength  = lFrameLength;
+        break;
+
+    case ':':
+        if ((aLength > 1) && ((aBuffer[1] == '-') || (aBuffer[1] == '+')))
+        {
+            lNegative = (aBuffer[1] == '-');
+            lOffset++;
+        }
+
+        lRetval = ConvertDecimalField(aBuffer,
+                                      aLength,
+                                      lOffset,
+                                      (lNegative ?
+                                       (static_cast<uint64_t>(LLONG_MAX) + 1) :
+                                       static_cast<uint64_t>(LLONG_MAX)),
+                                      lValue);
+
+        if (lRetval == 0)
+        {
+            lRetval = ExpectTerminator(aBuffer, aLength, lOffset, lHeaderLength);
+        }
+
+        if (lRetval == 0)
+        {
+            aFrame->mValue        = (lNegative ?
+                                     static_cast<long long>(0 - lValue) :
+                                     static_cast<long long>(lValue));
+            aFrame->mHeaderLength = lHeaderLength;
+            aFrame->mFrameLength  = lHeaderLength;
+        }
+        break;
+
+    case '+':
+    case '-':
+    case '_':
+    case '#':
+    case ',':
+    case '(':
+        {
+            const char * lCarriageReturn = static_cast<const char *>(memchr(aBuffer + 1, '\r', aLength - 1));
+
+            if (lCarriageReturn == nullptr)
+            {
+                return (-EAGAIN);
+            }
+
+            lRetval = ExpectTerminator(aBuffer, aLength, static_cast<size_t>(lCarriageReturn - aBuffer), lHeaderLength);
+
+            if (lRetval == 0)
+            {
+                aFrame->mValue        = 0;
+                aFrame->mHeaderLength = lHeaderLength;
+                aFrame->mFrameLength  = lHeaderLength;
+            }
+        }
+        break;
+
+    default:
+        return (-EBADMSG);
+
+    }
+
+    if ((lRetval == 0) && (aType != nullptr))
+    {
+        *aType = aBuffer[0];
+    }
+
+    return (lRetval);
+}
+
+/**
+ *  Match @a aLength bytes of @a aBuffer against the literal @a
+ *  aLiteral, of @a aLiteralLength bytes.
+ *
+ *  @retval  0         If the whole literal matched.
+ *  @retval  -EAGAIN   If all of @a aBuffer matched, but it was
+ *                     shorter than the literal.
+ *  @retval  -EBADMSG  Otherwise.
+ *
+ */
+static int
+MatchLiteral(const char *aBuffer, const size_t &aLength, const char *aLiteral, const size_t &aLiteralLength)
+{
+    const size_t lLength = ((aLength < aLiteralLength) ? aLength : aLiteralLength);
+
+    if (memcmp(aBuffer, aLiteral, lLength) != 0)
+    {
+        return (-EBADMSG);
+    }
+
+    return ((lLength < aLiteralLength) ? -EAGAIN : 0);
+}
+
+/**
+ *  @brief
+ *    Parse a memcached "VALUE" response header.
+ *
+ *  This parses a header of the form:
+ *
+ *    VALUE <key> <flags> <bytes> [<cas unique>]\r\n
+ *
+ *  at the start of @a aBuffer, whose frame includes the data block
+ *  and its CRLF, or the "END\r\n" that ends a retrieval response.
+ *
+ *  @param[in]   aBuffer  A pointer to the buffered bytes, which need
+ *                        not be null-terminated.
+ *  @param[in]   aLength  The length, in bytes, of @a aBuffer.
+ *  @param[out]  aValue   A pointer to storage for the header, whose
+ *                        key refers into @a aBuffer, or, for "END",
+ *                        whose frame alone is set.
+ *
+ *  @retval  1         If a "VALUE" header was parsed.
+ *  @retval  0         If "END" was parsed.
+ *  @retval  -EAGAIN   If more bytes are needed to complete the header.
+ *  @retval  -EBADMSG  If the header was malformed or was neither
+ *                     "VALUE" nor "END".
+ *  @retval  -EINVAL   If an argument was null.
+ *  @retval  -ERANGE   If the flags, length, or CAS value was out of
+ *                     range.
+ *
+ */
+int
+strntoul_frame_memcached(const char *aBuffer, size_t aLength, strntoul_memcached_value_t *aValue)
+{
+    static constexpr size_t kValueLength = sizeof (kMemcachedValue) - 1;
+    static constexpr size_t kEndLength   = sizeof (kMemcachedEnd) - 1;
+    const char *            lSpace;
+    size_t                  lOffset;
+    size_t                  lKeyLength;
+    size_t                  lHeaderLength;
+    size_t                  lFrameLength;
+    uint64_t                lFlags;
+    uint64_t                lBytes;
+    uint64_t                lCas    = 0;
+    bool                    lHasCas = false;
+    int                     lRetval;
+
+    if (((aBuffer == nullptr) && (aLength > 0)) || (aValue == nullptr))
+    {
+        return (-EINVAL);
+    }
+
+    if (aLength == 0)
+    {
+        return (-EAGAIN);
+    }
+
+    if (aBuffer[0] == 'E')
+    {
+        lRetval = MatchLiteral(aBuffer, aLength, kMemcachedEnd, kEndLength);
+
+        if (lRetval == 0)
+        {
+            memset(aValue, 0, sizeof (*aValue));
+
+            aValue->mFrame.mHeaderLength = kEndLength;
+            aValue->mFrame.mFrameLength  = kEndLength;
+        }
+
+        return (lRetval);
+    }
+
+    lRetval = MatchLiteral(aBuffer, aLength, kMemcachedValue, kValueLength);
+
+    if (lRetval != 0)
+    {
+        return (lRetval);
+    }
+
+    // The key, which may contain neither white space nor control
+    // characters, ends at the next space.
+
+    lOffset = kValueLength;
+    lSpace  = static_cast<const char *>(memchr(aBuffer + lOffset,
+                                               ' ',
+                                               ((aLength - lOffset) < (kMaximumKey + 1)) ?
+                                               (aLength - lOffset) :
+                                               (kMaximumKey + 1)));
+
+    if (lSpace == nullptr)
+    {
+        return (((aLength - lOffset) > kMaximumKey) ? -EBADMSG : -EAGAIN);
+    }
+
+    lKeyLength = static_cast<size_t>(lSpace - (aBuffer + lOffset));
+
+    if (lKeyLength == 0)
+    {
+        return (-EBADMSG);
+    }
+
+    for (size_t i = lOffset; i < (lOffset + lKeyLength); i++)
+    {
+        if (static_cast<unsigned char>(aBuffer[i]) <= ' ')
+        {
+            return (-EBADMSG);
+        }
+    }
+
+    lOffset += lKeyLength + 1;
+
+    // The flags, which are 32 bits.
+
+    lRetval = ConvertDecimalField(aBuffer, aLength, lOffset, UINT32_MAX, lFlags);
+
+    if (lRetval != 0)
+    {
+        return (lRetval);
+    }
+    else if (aBuffer[lOffset] != ' ')
+    {
+        return (-EBADMSG);
+    }
+
+    lOffset++;
+
+    // The length of the data block.
+
+    lRetval = ConvertDecimalField(aBuffer, aLength, lOffset, SIZE_MAX, lBytes);
+
+    if (lRetval != 0)
+    {
+        return (lRetval);
+    }
+
+    // An optional CAS value.
+
+    if (aBuffer[lOffset] == ' ')
+    {
+        lOffset++;
+
+        lRetval = ConvertDecimalField(aBuffer, aLength, lOffset, UINT64_MAX, lCas);
+
+        if (lRetval != 0)
+        {
+            return (lRetval);
+        }
+
+        lHasCas = true;
+    }
+
+    lRetval = ExpectTerminator(aBuffer, aLength, lOffset, lHeaderLength);
+
+    if (lRetval != 0)
+    {
+        return (lRetval);
+    }
+
+    lRetval = FrameLength(lHeaderLength, lBytes, lFrameLength);
+
+    if (lRetval != 0)
+    {
+        return (lRetval);
+    }
+
+    if (lBytes > static_cast<uint64_t>(LLONG_MAX))
+    {
+        return (-ERANGE);
+    }
+
+    aValue->mFrame.mValue        = static_cast<long long>(lBytes);
+    aValue->mFrame.mHeaderLength = lHeaderLength;
+    aValue->mFrame.mFrameLength  = lFrameLength;
+    aValue->mKey                 = aBuffer + kValueLength;
+    aValue->mKeyLength           = lKeyLength;
+    aValue->mFlags               = static_cast<unsigned long>(lFlags);
+    aValue->mCas                 = lCas;
+    aValue->mHasCas              = lHasCas;
+
+    return (1);
+}
+
+/**
+ *  @brief
+ *    Parse an HTTP/1.1 chunk-size line.
+ *
+ *  This parses a line of the form:
+ *
+ *    chunk-size [ chunk-ext ] CRLF
+ *
+ *  at the start of @a aBuffer, as defined by RFC 9112, section 7.1,
+ *  where the chunk size is hexadecimal and any chunk extensions are
+ *  skipped. A bare LF is rejected, rather than tolerated, so that the
+ *  framing cannot be interpreted differently by another hop.
+ *
+ *  For a non-zero chunk size, the frame includes the chunk data and
+ *  its CRLF. For the last chunk, whose size is zero (0), the frame is
+ *  the line alone, and the trailer section follows it.
+ *
+ *  @param[in]   aBuffer  A pointer to the buffered bytes, which need
+ *                        not be null-terminated.
+ *  @param[in]   aLength  The length, in bytes, of @a aBuffer.
+ *  @param[out]  aFrame   A pointer to storage for the header and
+ *                        frame.
+ *
+ *  @retval  0         If successful.
+ *  @retval  -EAGAIN   If more bytes are needed to complete the line.
+ *  @retval  -EBADMSG  If the line was malformed or longer than 4096
+ *                     bytes.
+ *  @retval  -EINVAL   If an argument was null.
+ *  @retval  -ERANGE   If the chunk size was out of range.
+ *
+ */
+int
+strntoul_frame_chunk(const char *aBuffer, size_t aLength, strntoul_frame_t *aFrame)
+{
+    size_t   lOffset = 0;
+    size_t   lHeaderLength;
+    size_t   lFrameLength;
+    uint64_t lValue  = 0;
+    int      lRetval;
+
+    if (((aBuffer == nullptr) && (aLength > 0)) || (aFrame == nullptr))
+    {
+        return (-EINVAL);
+    }
+
+    while (lOffset < aLength)
+    {
+        const unsigned int lDigit = StrNToUL::Kernel::DigitValue(aBuffer[lOffset]);
+
+        if (lDigit >= 16)
+        {
+            break;
+        }
+
+        if (lValue > ((static_cast<uint64_t>(LLONG_MAX) - lDigit) >> 4))
+        {
+            return (-ERANGE);
+        }
+
+        lValue = (lValue << 4) | lDigit;
+
+        lOffset++;
+
+        if (lOffset > kMaximumDigits)
+        {
+            return (-EBADMSG);
+        }
+    }
+
+    if (lOffset == aLength)
+    {
+        return (-EAGAIN);
+    }
+    else if (lOffset == 0)
+    {
+        return (-EBADMSG);
+    }
+
+    // Skip any chunk extensions, which may only begin with optional
+    // white space and a ';'.
+
+    if (aBuffer[lOffset] != '\r')
+    {
+        size_t lExtension = lOffset;
+
+        while ((lExtension < aLength) && ((aBuffer[lExtension] == ' ') || (aBuffer[lExtension] == '\t')))
+        {
+            lExtension++;
+        }
+
+        if (lExtension == aLength)
+        {
+            return ((lExtension >= kMaximumChunkHeader) ? -EBADMSG : -EAGAIN);
+        }
+        else if (aBuffer[lExtension] != ';')
+        {
+            return (-EBADMSG);
+        }
+
+        while ((lExtension < aLength) && (aBuffer[lExtension] != '\r'))
+        {
+            if (aBuffer[lExtension] == '\n')
+            {
+                return (-EBADMSG);
+            }
+
+            lExtension++;
+
+            if (lExtension >= kMaximumChunkHeader)
+            {
+                return (-EBADMSG);
+            }
+        }
+
+        lOffset = lExtension;
+    }
+
+    lRetval = ExpectTerminator(aBuffer, aLength, lOffset, lHeaderLength);
+
+    if (lRetval != 0)
+    {
+        return (lRetval);
+    }
+
+    lFrameLength = lHeaderLength;
+
+    if (lValue > 0)
+    {
+        lRetval = FrameLength(lHeaderLength, lValue, lFrameLength);
+
+        if (lRetval != 0)
+        {
+            return (lRetval);
+        }
+    }
+
+    aFrame->mValue        = static_cast<long long>(lValue);
+    aFrame->mHeaderLength = lHeaderLength;
+    aFrame->mFrameLength  = lFrameLength;
+
+    return (0);
+}
@@ -0,0 +1,84 @@
+/*
+ *    Copyright (c) 2024 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+
+/**
+ *    @file
+ *      This file defines interfaces for parsing the length-prefixed
+ *      headers of common text protocols: RESP (Redis), memcached
+ *      "VALUE" responses, and HTTP/1.1 chunked transfer coding.
+ *
+ *      Each locates the terminating CRLF and converts the announced
+ *      length in a single, bounded scan, reporting both the length of
+ *      the header and of the whole frame that it introduces, or that
+ *      more bytes are needed to decide either.
+ *
+ */
+
+#ifndef STRNTOUL_FRAME_H
+#define STRNTOUL_FRAME_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ *  A parsed header and the frame that it introduces.
+ *
+ */
+typedef struct strntoul_frame
+{
+    long long     mValue;         //!< The length or count announced
+                                  //!< by the header, or -1 for a RESP
+                                  //!< null.
+    size_t        mHeaderLength;  //!< The length, in bytes, of the
+                                  //!< header, through its CRLF.
+    size_t        mFrameLength;   //!< The length, in bytes, of the
+                                  //!< header, any payload that it
+                                  //!< announces, and that payload's
+                                  //!< CRLF.
+} strntoul_frame_t;
+
+/**
+ *  A parsed memcached "VALUE" response header.
+ *
+ */
+typedef struct strntoul_memcached_value
+{
+    strntoul_frame_t   mFrame;      //!< The header and frame, whose
+                                    //!< value is the payload length.
+    const char *       mKey;        //!< Within the parsed buffer and
+                                    //!< not null-terminated.
+    size_t             mKeyLength;
+    unsigned long      mFlags;
+    unsigned long long mCas;        //!< Zero (0) if not present.
+    int                mHasCas;     //!< Non-zero if a CAS value was
+                                    //!< present.
+} strntoul_memcached_value_t;
+
+extern int strntoul_frame_resp(const char *aBuffer, size_t aLength, char *aType, strntoul_frame_t *aFrame);
+extern int strntoul_frame_memcached(const char *aBuffer, size_t aLength, strntoul_memcached_value_t *aValue);
+extern int strntoul_frame_chunk(const char *aBuffer, size_t aLength, strntoul_frame_t *aFrame);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STRNTOUL_FRAME_H */
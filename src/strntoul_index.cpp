@@ -0,0 +1,475 @@
+/*
+ *    Copyright (c) 2024 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *    @file
+ *      This file implements interfaces for building a structural index
+ *      of the decimal digit runs and lines of a text buffer.
+ *
+ *      The buffer is classified 64 bytes at a time into a digit mask
+ *      and a newline mask, one bit per byte, from which the starts and
+ *      ends of digit runs and the starts of lines follow with a few
+ *      shifts, carrying the last bit of each block into the next. The
+ *      bitmaps are then flattened into arrays of offsets, such that
+ *      each lookup is constant time and the numbers may be converted
+ *      independently, in any order or on any thread.
+ *
+ */
+
+#include "strntoul_index.h"
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "strntoul.h"
+#include "strntoul/strntoul-kernel.h"
+
+struct strntoul_index
+{
+    const char * mBuffer;
+    size_t       mLength;
+    size_t       mWords;
+    uint64_t *   mBitmaps[3];
+    size_t       mNumbers;
+    size_t *     mStarts;
+    size_t *     mEnds;
+    size_t       mLines;
+    size_t *     mLineStarts;
+    size_t *     mLineNumbers;
+};
+
+static constexpr size_t kBlockSize = 64;
+
+/**
+ *  Classify the bytes of a block, setting a bit in @a aDigits for each
+ *  decimal digit and in @a aNewlines for each newline.
+ *
+ */
+static void
+Classify(const char *aBlock, uint64_t &aDigits, uint64_t &aNewlines)
+{
+#if defined(__SSE2__)
+    const __m128i lZero    = _mm_set1_epi8('0' - 1);
+    const __m128i lNine    = _mm_set1_epi8('9' + 1);
+    const __m128i lNewline = _mm_set1_epi8('\n');
+
+    aDigits   = 0;
+    aNewlines = 0;
+
+    for (size_t i = 0; i < kBlockSize; i += sizeof (__m128i))
+    {
+        const __m128i lBytes  = _mm_loadu_si128(reinterpret_cast<const __m128i *>(aBlock + i));
+        const __m128i lDigits = _mm_and_si128(_mm_cmpgt_epi8(lBytes, lZero), _mm_cmplt_epi8(lBytes, lNine));
+
+        aDigits   |= (static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(lDigits))) << i);
+        aNewlines |= (static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(lBytes, lNewline)))) << i);
+    }
+#else
+    aDigits   = 0;
+    aNewlines = 0;
+
+    for (size_t i = 0; i < kBlockSize; i++)
+    {
+        aDigits   |= (static_cast<uint64_t>((aBlock[i] >= '0') && (aBlock[i] <= '9')) << i);
+        aNewlines |= (static_cast<uint64_t>(aBlock[i] == '\n') << i);
+    }
+#endif // defined(__SSE2__)
+}
+
+/**
+ *  Append the offsets of each set bit of @a aWord, which starts at
+ *  buffer offset @a aBase, to @a aOffsets.
+ *
+ */
+static void
+Flatten(uint64_t aWord, const size_t &aBase, size_t *&aOffsets)
+{
+    while (aWord != 0)
+    {
+        *aOffsets++ = aBase + static_cast<size_t>(__builtin_ctzll(aWord));
+
+        aWord &= (aWord - 1);
+    }
+}
+
+static size_t
+Count(const uint64_t *aBitmap, const size_t &aWords)
+{
+    size_t lRetval = 0;
+
+    for (size_t i = 0; i < aWords; i++)
+    {
+        lRetval += static_cast<size_t>(__builtin_popcountll(aBitmap[i]));
+    }
+
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    Build a structural index of a buffer.
+ *
+ *  This makes one linear pass over the @a aLength bytes at @a aBuffer,
+ *  locating each run of decimal digits and each line, after which the
+ *  location of any number, or of the Nth number of any line, is a
+ *  constant-time lookup and its value may be converted on demand.
+ *
+ *  The buffer is referenced, not copied, and must outlive the index.
+ *
+ *  @param[in]   aBuffer  A pointer to the buffer to index.
+ *  @param[in]   aLength  The number of bytes of @a aBuffer to index.
+ *  @param[out]  aIndex   A pointer to storage for the index, which the
+ *                        caller must destroy with
+ *                        strntoul_index_destroy.
+ *
+ *  @retval  0        If successful.
+ *  @retval  -EINVAL  If @a aIndex was null or if @a aBuffer was null
+ *                    and @a aLength was not zero.
+ *  @retval  -ENOMEM  If memory could not be allocated.
+ *
+ *  @sa strntoul_index_destroy
+ *
+ */
+int
+strntoul_index_build(const char *aBuffer, size_t aLength, strntoul_index_t **aIndex)
+{
+    strntoul_index_t * lIndex;
+    uint64_t           lDigitCarry   = 0;
+    uint64_t           lNewlineCarry = 1;
+    size_t *           lStarts;
+    size_t *           lEnds;
+    size_t *           lLineStarts;
+    size_t             lNumber       = 0;
+
+    if ((aIndex == nullptr) || ((aBuffer == nullptr) && (aLength != 0)))
+    {
+        return (-EINVAL);
+    }
+
+    lIndex = static_cast<strntoul_index_t *>(calloc(1, sizeof (strntoul_index_t)));
+
+    if (lIndex == nullptr)
+    {
+        return (-ENOMEM);
+    }
+
+    lIndex->mBuffer = aBuffer;
+    lIndex->mLength = aLength;
+
+    // One extra bit, and so possibly one extra word, is required for
+    // the end of a run ending the buffer.
+
+    lIndex->mWords  = (aLength / kBlockSize) + 1;
+
+    for (size_t i = 0; i < 3; i++)
+    {
+        lIndex->mBitmaps[i] = static_cast<uint64_t *>(malloc(lIndex->mWords * sizeof (uint64_t)));
+
+        if (lIndex->mBitmaps[i] == nullptr)
+        {
+            goto fail;
+        }
+    }
+
+    for (size_t lWord = 0; lWord < lIndex->mWords; lWord++)
+    {
+        const size_t lOffset = lWord * kBlockSize;
+        const size_t lCount  = ((aLength - lOffset) < kBlockSize) ? (aLength - lOffset) : kBlockSize;
+        const char * lBlock  = aBuffer + lOffset;
+        char         lPartial[kBlockSize];
+        uint64_t     lDigits;
+        uint64_t     lNewlines;
+        uint64_t     lValid;
+        uint64_t     lPrevious;
+
+        if (lCount < kBlockSize)
+        {
+            memset(lPartial, 0, sizeof (lPartial));
+
+            if (lCount > 0)
+            {
+                memcpy(lPartial, lBlock, lCount);
+            }
+
+            lBlock = lPartial;
+        }
+
+        Classify(lBlock, lDigits, lNewlines);
+
+        lValid    = ((lCount == kBlockSize) ? ~static_cast<uint64_t>(0) : ((static_cast<uint64_t>(1) << lCount) - 1));
+        lPrevious = ((lDigits << 1) | lDigitCarry);
+
+        lIndex->mBitmaps[STRNTOUL_INDEX_BITMAP_STARTS][lWord] = (lDigits & ~lPrevious);
+        lIndex->mBitmaps[STRNTOUL_INDEX_BITMAP_ENDS][lWord]   = (~lDigits & lPrevious);
+        lIndex->mBitmaps[STRNTOUL_INDEX_BITMAP_LINES][lWord]  = (((lNewlines << 1) | lNewlineCarry) & lValid);
+
+        lDigitCarry   = (lDigits >> 63);
+        lNewlineCarry = (lNewlines >> 63);
+    }
+
+    lIndex->mNumbers = Count(lIndex->mBitmaps[STRNTOUL_INDEX_BITMAP_STARTS], lIndex->mWords);
+    lIndex->mLines   = Count(lIndex->mBitmaps[STRNTOUL_INDEX_BITMAP_LINES], lIndex->mWords);
+
+    lIndex->mStarts      = static_cast<size_t *>(malloc((lIndex->mNumbers + 1) * sizeof (size_t)));
+    lIndex->mEnds        = static_cast<size_t *>(malloc((lIndex->mNumbers + 1) * sizeof (size_t)));
+    lIndex->mLineStarts  = static_cast<size_t *>(malloc((lIndex->mLines + 1) * sizeof (size_t)));
+    lIndex->mLineNumbers = static_cast<size_t *>(malloc((lIndex->mLines + 1) * sizeof (size_t)));
+
+    if ((lIndex->mStarts == nullptr) || (lIndex->mEnds == nullptr) ||
+        (lIndex->mLineStarts == nullptr) || (lIndex->mLineNumbers == nullptr))
+    {
+        goto fail;
+    }
+
+    lStarts     = lIndex->mStarts;
+    lEnds       = lIndex->mEnds;
+    lLineStarts = lIndex->mLineStarts;
+
+    for (size_t lWord = 0; lWord < lIndex->mWords; lWord++)
+    {
+        Flatten(lIndex->mBitmaps[STRNTOUL_INDEX_BITMAP_STARTS][lWord], lWord * kBlockSize, lStarts);
+        Flatten(lIndex->mBitmaps[STRNTOUL_INDEX_BITMAP_ENDS][lWord],   lWord * kBlockSize, lEnds);
+        Flatten(lIndex->mBitmaps[STRNTOUL_INDEX_BITMAP_LINES][lWord],  lWord * kBlockSize, lLineStarts);
+    }
+
+    // Record, for each line, the index of its first number, which
+    // both arrays being in order makes a single merge.
+
+    for (size_t lLine = 0; lLine < lIndex->mLines; lLine++)
+    {
+        while ((lNumber < lIndex->mNumbers) && (lIndex->mStarts[lNumber] < lIndex->mLineStarts[lLine]))
+        {
+            lNumber++;
+        }
+
+        lIndex->mLineNumbers[lLine] = lNumber;
+    }
+
+    lIndex->mLineNumbers[lIndex->mLines] = lIndex->mNumbers;
+
+    *aIndex = lIndex;
+
+    return (0);
+
+ fail:
+    strntoul_index_destroy(lIndex);
+
+    return (-ENOMEM);
+}
+
+/**
+ *  @brief
+ *    Destroy a structural index.
+ *
+ *  @param[in]  aIndex  A pointer to the index to destroy. A null
+ *                      pointer is ignored.
+ *
+ */
+void
+strntoul_index_destroy(strntoul_index_t *aIndex)
+{
+    if (aIndex != nullptr)
+    {
+        for (size_t i = 0; i < 3; i++)
+        {
+            free(aIndex->mBitmaps[i]);
+        }
+
+        free(aIndex->mStarts);
+        free(aIndex->mEnds);
+        free(aIndex->mLineStarts);
+        free(aIndex->mLineNumbers);
+        free(aIndex);
+    }
+}
+
+/**
+ *  @brief
+ *    Return the number of decimal digit runs in an indexed buffer.
+ *
+ *  @param[in]  aIndex  A pointer to the index.
+ *
+ */
+size_t
+strntoul_index_numbers(const strntoul_index_t *aIndex)
+{
+    return (aIndex->mNumbers);
+}
+
+/**
+ *  @brief
+ *    Return the number of lines in an indexed buffer.
+ *
+ *  A trailing newline does not begin a line.
+ *
+ *  @param[in]  aIndex  A pointer to the index.
+ *
+ */
+size_t
+strntoul_index_lines(const strntoul_index_t *aIndex)
+{
+    return (aIndex->mLines);
+}
+
+/**
+ *  @brief
+ *    Return one of the bitmaps of an index.
+ *
+ *  These allow callers to partition further passes over the buffer,
+ *  for example across threads, at word granularity.
+ *
+ *  @param[in]   aIndex   A pointer to the index.
+ *  @param[in]   aBitmap  The bitmap to return.
+ *  @param[out]  aWords   An optional pointer to storage for the number
+ *                        of words in the bitmap.
+ *
+ *  @returns
+ *    A pointer to the bitmap, valid until the index is destroyed, or
+ *    null if @a aBitmap was invalid.
+ *
+ */
+const uint64_t *
+strntoul_index_bitmap(const strntoul_index_t *aIndex, strntoul_index_bitmap_t aBitmap, size_t *aWords)
+{
+    if (aBitmap > STRNTOUL_INDEX_BITMAP_LINES)
+    {
+        return (nullptr);
+    }
+
+    if (aWords != nullptr)
+    {
+        *aWords = aIndex->mWords;
+    }
+
+    return (aIndex->mBitmaps[aBitmap]);
+}
+
+/**
+ *  @brief
+ *    Locate a decimal digit run in an indexed buffer.
+ *
+ *  @param[in]   aIndex   A pointer to the index.
+ *  @param[in]   aNumber  The zero-based index of the run.
+ *  @param[out]  aLength  An optional pointer to storage for the length,
+ *                        in bytes, of the run.
+ *
+ *  @returns
+ *    A pointer to the first digit of the run, or null if there is no
+ *    such run.
+ *
+ */
+const char *
+strntoul_index_number(const strntoul_index_t *aIndex, size_t aNumber, size_t *aLength)
+{
+    if (aNumber >= aIndex->mNumbers)
+    {
+        return (nullptr);
+    }
+
+    if (aLength != nullptr)
+    {
+        *aLength = aIndex->mEnds[aNumber] - aIndex->mStarts[aNumber];
+    }
+
+    return (aIndex->mBuffer + aIndex->mStarts[aNumber]);
+}
+
+/**
+ *  @brief
+ *    Return the index of the Nth decimal digit run of a line.
+ *
+ *  @param[in]  aIndex  A pointer to the index.
+ *  @param[in]  aLine   The zero-based index of the line.
+ *  @param[in]  aNth    The zero-based index of the run within the
+ *                      line.
+ *
+ *  @returns
+ *    The index of the run, suitable for strntoul_index_number or
+ *    strntoul_index_value, or STRNTOUL_INDEX_NONE if there is no such
+ *    line or run.
+ *
+ */
+size_t
+strntoul_index_line_number(const strntoul_index_t *aIndex, size_t aLine, size_t aNth)
+{
+    if (aLine >= aIndex->mLines)
+    {
+        return (STRNTOUL_INDEX_NONE);
+    }
+
+    if (aNth >= (aIndex->mLineNumbers[aLine + 1] - aIndex->mLineNumbers[aLine]))
+    {
+        return (STRNTOUL_INDEX_NONE);
+    }
+
+    return (aIndex->mLineNumbers[aLine] + aNth);
+}
+
+/**
+ *  @brief
+ *    Convert a decimal digit run of an indexed buffer.
+ *
+ *  Only the digits are converted; any sign preceding them is not
+ *  considered.
+ *
+ *  On error, @a errno may be set as follows:
+ *
+ *    - EINVAL   There is no such run.
+ *    - ERANGE   The value is out of range, as for strntoul.
+ *
+ *  @param[in]  aIndex   A pointer to the index.
+ *  @param[in]  aNumber  The zero-based index of the run.
+ *
+ *  @returns
+ *    The value of the run, ULONG_MAX if it was out of range, or zero if
+ *    there is no such run.
+ *
+ *  @sa strntoul
+ *
+ */
+unsigned long
+strntoul_index_value(const strntoul_index_t *aIndex, size_t aNumber)
+{
+    const char *  lNumber;
+    size_t        lLength;
+    unsigned long lRetval = 0;
+
+    lNumber = strntoul_index_number(aIndex, aNumber, &lLength);
+
+    if (lNumber == nullptr)
+    {
+        errno = EINVAL;
+
+        return (0);
+    }
+
+#if STRNTOUL_USE_DECIMAL_KERNEL
+    if (lLength <= StrNToUL::Kernel::kWindowSize)
+    {
+        if (StrNToUL::Kernel::ConvertDecimal(lNumber, lLength, lRetval) == lLength)
+        {
+            return (lRetval);
+        }
+    }
+#endif // STRNTOUL_USE_DECIMAL_KERNEL
+
+    lRetval = strntoul(lNumber, lLength, nullptr, 10);
+
+    return (lRetval);
+}
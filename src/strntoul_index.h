@@ -0,0 +1,77 @@
+/*
+ *    Copyright (c) 2024 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *    @file
+ *      This file defines interfaces for building a structural index of
+ *      the decimal digit runs and lines of a text buffer, allowing
+ *      random access to, and on-demand conversion of, its numbers.
+ *
+ */
+
+#ifndef STRNTOUL_INDEX_H
+#define STRNTOUL_INDEX_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ *  The value returned by strntoul_index_line_number when a line has
+ *  no such number.
+ *
+ */
+#define STRNTOUL_INDEX_NONE ((size_t)-1)
+
+/**
+ *  The bitmaps of an index, each with one bit per buffer byte, least
+ *  significant bit of the first word first.
+ *
+ */
+typedef enum strntoul_index_bitmap
+{
+    STRNTOUL_INDEX_BITMAP_STARTS = 0,  //!< The first digit of each run.
+    STRNTOUL_INDEX_BITMAP_ENDS   = 1,  //!< The byte just past each run,
+                                       //!< with one extra bit for a run
+                                       //!< ending the buffer.
+    STRNTOUL_INDEX_BITMAP_LINES  = 2   //!< The first byte of each line.
+} strntoul_index_bitmap_t;
+
+/**
+ *  A structural index of a buffer.
+ *
+ */
+typedef struct strntoul_index strntoul_index_t;
+
+extern int strntoul_index_build(const char *aBuffer, size_t aLength, strntoul_index_t **aIndex);
+extern void strntoul_index_destroy(strntoul_index_t *aIndex);
+extern size_t strntoul_index_numbers(const strntoul_index_t *aIndex);
+extern size_t strntoul_index_lines(const strntoul_index_t *aIndex);
+extern const uint64_t *strntoul_index_bitmap(const strntoul_index_t *aIndex, strntoul_index_bitmap_t aBitmap, size_t *aWords);
+extern const char *strntoul_index_number(const strntoul_index_t *aIndex, size_t aNumber, size_t *aLength);
+extern size_t strntoul_index_line_number(const strntoul_index_t *aIndex, size_t aLine, size_t aNth);
+extern unsigned long strntoul_index_value(const strntoul_index_t *aIndex, size_t aNumber);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STRNTOUL_INDEX_H */
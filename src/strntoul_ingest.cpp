@@ -0,0 +1,525 @@
+/*
+ *    Copyright (c) 2024 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+
+/**
+ *    @file
+ *      This file implements an interface for converting the delimited
+ *      unsigned long integers of a file, or of any other descriptor,
+ *      with reads overlapped against conversion.
+ *
+ *      A reader thread fills a ring of page-aligned buffers, in order,
+ *      with large sequential reads while the calling thread converts
+ *      those already filled. A field split across two buffers is
+ *      carried, in a bounded copy, from one to the next.
+ *
+ */
+
+#include "strntoul_ingest.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "strntoul-fields.h"
+
+using namespace StrNToUL::Fields;
+
+static_assert(STRNTOUL_INGEST_CARRY_MAX == kCarryMax, "The documented ingestion carry bound must be the one enforced.");
+
+namespace
+{
+
+const size_t kAlignment = 4096;
+
+struct Buffer
+{
+    char * mData;
+    size_t mLength;
+};
+
+/**
+ *  The ring of buffers shared by the reader thread, which fills them,
+ *  and the converting thread, which drains them, each in order.
+ *
+ */
+struct Ring
+{
+    Ring(void) :
+        mBuffers(nullptr),
+        mCapacity(0),
+        mSize(0),
+        mHead(0),
+        mTail(0),
+        mFilled(0),
+        mEnd(false),
+        mStop(false),
+        mError(0),
+        mDescriptor(-1),
+        mSeekable(false),
+        mOffset(0),
+        mReaderWaits(0)
+    {
+        pthread_mutex_init(&mMutex, nullptr);
+        pthread_cond_init(&mFilledCondition, nullptr);
+        pthread_cond_init(&mDrainedCondition, nullptr);
+    }
+
+    ~Ring(void)
+    {
+        if (mBuffers != nullptr)
+        {
+            for (size_t i = 0; i < mCapacity; i++)
+            {
+                free(mBuffers[i].mData);
+            }
+
+            free(mBuffers);
+        }
+
+        pthread_cond_destroy(&mDrainedCondition);
+        pthread_cond_destroy(&mFilledCondition);
+        pthread_mutex_destroy(&mMutex);
+    }
+
+    pthread_mutex_t mMutex;
+    pthread_cond_t  mFilledCondition;
+    pthread_cond_t  mDrainedCondition;
+    Buffer *        mBuffers;
+    size_t          mCapacity;
+    size_t          mSize;
+    size_t          mHead;
+    size_t          mTail;
+    size_t          mFilled;
+    bool            mEnd;
+    bool            mStop;
+    int             mError;
+    int             mDescriptor;
+    bool            mSeekable;
+    off_t           mOffset;
+    size_t          mReaderWaits;
+};
+
+}; // namespace
+
+/**
+ *  Fill @a aData with up to one buffer of the descriptor: from a
+ *  seekable descriptor, with positioned reads until the buffer is full
+ *  or the end is reached; otherwise, with a single read.
+ *
+ *  @returns
+ *    The number of bytes read, which is short for a seekable
+ *    descriptor only at its end, or a negative errno on error.
+ *
+ */
+static ssize_t
+Fill(Ring &aRing, char *aData)
+{
+    size_t lLength = 0;
+
+    while (lLength < aRing.mSize)
+    {
+        const ssize_t lStatus = (aRing.mSeekable ?
+                                 pread(aRing.mDescriptor, aData + lLength, aRing.mSize - lLength, aRing.mOffset) :
+                                 read(aRing.mDescriptor, aData + lLength, aRing.mSize - lLength));
+
+        if (lStatus < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            return (-errno);
+        }
+        else if (lStatus == 0)
+        {
+            break;
+        }
+
+        lLength += static_cast<size_t>(lStatus);
+
+        if (!aRing.mSeekable)
+        {
+            break;
+        }
+
+        aRing.mOffset += lStatus;
+    }
+
+    return (static_cast<ssize_t>(lLength));
+}
+
+static void *
+Reader(void *aContext)
+{
+    Ring & lRing = *static_cast<Ring *>(aContext);
+
+    pthread_mutex_lock(&lRing.mMutex);
+
+    while (!lRing.mStop)
+    {
+        Buffer & lBuffer = lRing.mBuffers[lRing.mHead];
+        ssize_t  lStatus;
+
+        if (lRing.mFilled == lRing.mCapacity)
+        {
+            lRing.mReaderWaits++;
+
+            pthread_cond_wait(&lRing.mDrainedCondition, &lRing.mMutex);
+            continue;
+        }
+
+        // The buffer at the head is not visible to the converting
+        // thread until it is counted as filled, so it may be read
+        // into without holding the lock.
+
+        pthread_mutex_unlock(&lRing.mMutex);
+
+        lStatus = Fill(lRing, lBuffer.mData);
+
+        pthread_mutex_lock(&lRing.mMutex);
+
+        if (lStatus < 0)
+        {
+            lRing.mError = static_cast<int>(lStatus);
+            break;
+        }
+
+        if (lStatus > 0)
+        {
+            lBuffer.mLength = static_cast<size_t>(lStatus);
+
+            lRing.mHead = (lRing.mHead + 1) % lRing.mCapacity;
+            lRing.mFilled++;
+
+            pthread_cond_signal(&lRing.mFilledCondition);
+        }
+
+        if ((lStatus == 0) || (lRing.mSeekable && (static_cast<size_t>(lStatus) < lRing.mSize)))
+        {
+            break;
+        }
+    }
+
+    lRing.mEnd = true;
+
+    pthread_cond_signal(&lRing.mFilledCondition);
+
+    pthread_mutex_unlock(&lRing.mMutex);
+
+    return (nullptr);
+}
+
+/**
+ *  @brief
+ *    Convert the delimited unsigned long integers read from a
+ *    descriptor, with reads overlapped against conversion.
+ *
+ *  This reads @a aDescriptor, from its current offset to its end, on
+ *  a separate thread into a ring of buffers while the calling thread
+ *  splits each buffer, once read, into fields at each delimiter and
+ *  converts them as strntoul_reduce does, passing the valid values of
+ *  each buffer to @a aCallback.
+ *
+ *  A seekable descriptor is read with positioned reads, each filling
+ *  an entire buffer, and is left positioned after the last byte
+ *  converted. Any other descriptor, such as a pipe, is read with
+ *  ordinary reads, each buffer converted as soon as anything has been
+ *  read into it.
+ *
+ *  On error, @a errno may be set as follows:
+ *
+ *    - ERANGE   At least one field was out of range. Such fields are
+ *               counted as invalid.
+ *
+ *  @param[in]   aDescriptor  The descriptor to read.
+ *  @param[in]   aOptions     A pointer to the buffer, delimiter, and
+ *                            base options or null for buffers of the
+ *                            default size and number and for decimal
+ *                            values, one per line.
+ *  @param[in]   aCallback    The function to call with the values of
+ *                            each buffer, or null to only count them.
+ *  @param[in]   aContext     The context to pass to @a aCallback.
+ *  @param[out]  aStats       An optional pointer to storage for the
+ *                            value, byte, and wait counts.
+ *
+ *  @retval  0        If successful.
+ *  @retval  -EINVAL  If the base was unsupported, if there were fewer
+ *                    than two buffers, or if the buffer size was too
+ *                    large.
+ *  @retval  -ENOMEM  If memory could not be allocated.
+ *  @retval  -errno   If the reader thread could not be created or
+ *                    the descriptor could not be read.
+ *  @retval  other    The non-zero value returned by @a aCallback.
+ *
+ *  @sa strntoul_reduce
+ *
+ */
+int
+strntoul_ingest(int aDescriptor, const strntoul_ingest_options_t *aOptions, strntoul_ingest_callback_t aCallback, void *aContext, strntoul_ingest_stats_t *aStats)
+{
+    strntoul_ingest_options_t lOptions     = { 0, 0, '\n', 10 };
+    Ring                      lRing;
+    Converter *               lConverter;
+    off_t                     lStart;
+    uint64_t                  lBytes       = 0;
+    size_t                    lParserWaits = 0;
+    pthread_t                 lThread;
+    int                       lRetval      = 0;
+
+    if (aOptions != nullptr)
+    {
+        lOptions = *aOptions;
+    }
+
+    if (lOptions.mBufferSize == 0)
+    {
+        lOptions.mBufferSize = STRNTOUL_INGEST_BUFFER_SIZE;
+    }
+
+    if (lOptions.mBuffers == 0)
+    {
+        lOptions.mBuffers = STRNTOUL_INGEST_BUFFERS;
+    }
+
+    if (((lOptions.mBase != 0) && ((lOptions.mBase < 2) || (lOptions.mBase > 36))) ||
+        (lOptions.mBuffers < 2) ||
+        (lOptions.mBufferSize > (SSIZE_MAX - kAlignment)))
+    {
+        return (-EINVAL);
+    }
+
+    lRing.mSize       = (lOptions.mBufferSize + kAlignment - 1) & ~(kAlignment - 1);
+    lRing.mDescriptor = aDescriptor;
+
+    lRing.mBuffers = static_cast<Buffer *>(calloc(lOptions.mBuffers, sizeof (Buffer)));
+
+    if (lRing.mBuffers == nullptr)
+    {
+        return (-ENOMEM);
+    }
+
+    lRing.mCapacity = lOptions.mBuffers;
+
+    for (size_t i = 0; i < lRing.mCapacity; i++)
+    {
+        void * lData;
+
+        if (posix_memalign(&lData, kAlignment, lRing.mSize) != 0)
+        {
+            return (-ENOMEM);
+        }
+
+        lRing.mBuffers[i].mData = static_cast<char *>(lData);
+    }
+
+    lConverter = static_cast<Converter *>(calloc(1, sizeof (Converter)));
+
+    if (lConverter == nullptr)
+    {
+        return (-ENOMEM);
+    }
+
+    lConverter->mDelimiter = lOptions.mDelimiter;
+    lConverter->mBase      = lOptions.mBase;
+
+    // Each non-empty field but the one carried into a buffer takes at
+    // least two bytes of it, including its delimiter.
+
+    lConverter->mValues    = static_cast<unsigned long *>(calloc((lRing.mSize / 2) + 2, sizeof (unsigned long)));
+
+    if (lConverter->mValues == nullptr)
+    {
+        free(lConverter);
+
+        return (-ENOMEM);
+    }
+
+    lStart = lseek(aDescriptor, 0, SEEK_CUR);
+
+    if (lStart >= 0)
+    {
+        lRing.mSeekable = true;
+        lRing.mOffset   = lStart;
+
+        (void)posix_fadvise(aDescriptor, lStart, 0, POSIX_FADV_SEQUENTIAL);
+    }
+
+    lRetval = pthread_create(&lThread, nullptr, Reader, &lRing);
+
+    if (lRetval != 0)
+    {
+        free(lConverter->mValues);
+        free(lConverter);
+
+        return (-lRetval);
+    }
+
+    pthread_mutex_lock(&lRing.mMutex);
+
+    while (true)
+    {
+        const Buffer * lBuffer;
+
+        if (lRing.mFilled == 0)
+        {
+            if (lRing.mEnd)
+            {
+                break;
+            }
+
+            lParserWaits++;
+
+            pthread_cond_wait(&lRing.mFilledCondition, &lRing.mMutex);
+            continue;
+        }
+
+        lBuffer = &lRing.mBuffers[lRing.mTail];
+
+        pthread_mutex_unlock(&lRing.mMutex);
+
+        Convert(*lConverter, lBuffer->mData, lBuffer->mLength);
+
+        lBytes += lBuffer->mLength;
+
+        if ((aCallback != nullptr) && (lConverter->mCount > 0))
+        {
+            lRetval = aCallback(lConverter->mValues, lConverter->mCount, aContext);
+        }
+
+        pthread_mutex_lock(&lRing.mMutex);
+
+        lRing.mTail = (lRing.mTail + 1) % lRing.mCapacity;
+        lRing.mFilled--;
+
+        if (lRetval != 0)
+        {
+            lRing.mStop = true;
+        }
+
+        pthread_cond_signal(&lRing.mDrainedCondition);
+
+        if (lRetval != 0)
+        {
+            break;
+        }
+    }
+
+    pthread_mutex_unlock(&lRing.mMutex);
+
+    pthread_join(lThread, nullptr);
+
+    if ((lRetval == 0) && (lRing.mError != 0))
+    {
+        lRetval = lRing.mError;
+    }
+
+    // The last field need not be followed by a delimiter.
+
+    if ((lRetval == 0) && lConverter->mCarrying)
+    {
+        lConverter->mCount = 0;
+
+        Flush(*lConverter);
+
+        if ((aCallback != nullptr) && (lConverter->mCount > 0))
+        {
+            lRetval = aCallback(lConverter->mValues, lConverter->mCount, aContext);
+        }
+    }
+
+    if (lRing.mSeekable)
+    {
+        (void)lseek(aDescriptor, lStart + static_cast<off_t>(lBytes), SEEK_SET);
+    }
+
+    if (aStats != nullptr)
+    {
+        aStats->mBytes       = lBytes;
+        aStats->mCount       = lConverter->mValid;
+        aStats->mInvalid     = lConverter->mInvalid;
+        aStats->mReaderWaits = lRing.mReaderWaits;
+        aStats->mParserWaits = lParserWaits;
+    }
+
+    if (lConverter->mOutOfRange)
+    {
+        errno = ERANGE;
+    }
+
+    free(lConverter->mValues);
+    free(lConverter);
+
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    Convert the delimited unsigned long integers of a file, with
+ *    reads overlapped against conversion.
+ *
+ *  This is identical to strntoul_ingest, on a descriptor opened from,
+ *  and closed after, @a aPath.
+ *
+ *  @param[in]   aPath      A pointer to the null-terminated path of
+ *                          the file to read.
+ *  @param[in]   aOptions   A pointer to the buffer, delimiter, and base
+ *                          options or null for the defaults.
+ *  @param[in]   aCallback  The function to call with the values of
+ *                          each buffer, or null to only count them.
+ *  @param[in]   aContext   The context to pass to @a aCallback.
+ *  @param[out]  aStats     An optional pointer to storage for the
+ *                          value, byte, and wait counts.
+ *
+ *  @retval  0        If successful.
+ *  @retval  -EINVAL  If @a aPath was null or the options were invalid.
+ *  @retval  -errno   If the file could not be opened or read, or as
+ *                    for strntoul_ingest.
+ *
+ *  @sa strntoul_ingest
+ *
+ */
+int
+strntoul_ingest_path(const char *aPath, const strntoul_ingest_options_t *aOptions, strntoul_ingest_callback_t aCallback, void *aContext, strntoul_ingest_stats_t *aStats)
+{
+    int lDescriptor;
+    int lRetval;
+
+    if (aPath == nullptr)
+    {
+        return (-EINVAL);
+    }
+
+    lDescriptor = open(aPath, O_RDONLY | O_CLOEXEC);
+
+    if (lDescriptor < 0)
+    {
+        return (-errno);
+    }
+
+    lRetval = strntoul_ingest(lDescriptor, aOptions, aCallback, aContext, aStats);
+
+    close(lDescriptor);
+
+    return (lRetval);
+}
@@ -0,0 +1,107 @@
+/*
+ *    Copyright (c) 2024 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+
+/**
+ *    @file
+ *      This file defines an interface for converting the delimited
+ *      unsigned long integers of a file, or of any other descriptor,
+ *      with reads overlapped against conversion.
+ *
+ */
+
+#ifndef STRNTOUL_INGEST_H
+#define STRNTOUL_INGEST_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ *  The default size, in bytes, of each buffer in the read ring.
+ *
+ */
+#define STRNTOUL_INGEST_BUFFER_SIZE (1024 * 1024)
+
+/**
+ *  The default number of buffers in the read ring.
+ *
+ */
+#define STRNTOUL_INGEST_BUFFERS     4
+
+/**
+ *  The maximum length, in bytes, of a field split across two buffers.
+ *  A longer field is invalid.
+ *
+ */
+#define STRNTOUL_INGEST_CARRY_MAX   4096
+
+/**
+ *  The configuration for strntoul_ingest.
+ *
+ */
+typedef struct strntoul_ingest_options
+{
+    size_t mBufferSize; //!< The size, in bytes, of each buffer,
+                        //!< rounded up to a multiple of the page
+                        //!< size, or zero (0) for
+                        //!< STRNTOUL_INGEST_BUFFER_SIZE.
+    size_t mBuffers;    //!< The number of buffers, at least two (2),
+                        //!< or zero (0) for STRNTOUL_INGEST_BUFFERS.
+    char   mDelimiter;  //!< The character separating fields.
+    int    mBase;       //!< The base to use to interpret each field,
+                        //!< as for strntoul.
+} strntoul_ingest_options_t;
+
+/**
+ *  The results of strntoul_ingest.
+ *
+ */
+typedef struct strntoul_ingest_stats
+{
+    uint64_t mBytes;       //!< The number of bytes converted.
+    size_t   mCount;       //!< The number of valid values.
+    size_t   mInvalid;     //!< The number of non-empty fields that
+                           //!< did not fully convert or were out of
+                           //!< range.
+    size_t   mReaderWaits; //!< The number of times reading waited
+                           //!< for a buffer to be converted.
+    size_t   mParserWaits; //!< The number of times conversion waited
+                           //!< for a buffer to be read.
+} strntoul_ingest_stats_t;
+
+/**
+ *  Receive the @a aCount values converted from one buffer.
+ *
+ *  Return zero (0) to continue or any other value to stop, which
+ *  strntoul_ingest then returns.
+ *
+ */
+typedef int (*strntoul_ingest_callback_t)(const unsigned long *aValues, size_t aCount, void *aContext);
+
+extern int strntoul_ingest(int aDescriptor, const strntoul_ingest_options_t *aOptions, strntoul_ingest_callback_t aCallback, void *aContext, strntoul_ingest_stats_t *aStats);
+extern int strntoul_ingest_path(const char *aPath, const strntoul_ingest_options_t *aOptions, strntoul_ingest_callback_t aCallback, void *aContext, strntoul_ingest_stats_t *aStats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STRNTOUL_INGEST_H */
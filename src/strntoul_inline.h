@@ -0,0 +1,113 @@
+/*
+ *    Copyright (c) 2024 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *    @file
+ *      This file defines header-only, inline definitions of strntoul
+ *      and strntol for C++ callers.
+ *
+ *      Because the library's definitions are out-of-line, every call
+ *      to them is an indirect call through the procedure linkage table
+ *      and the compiler cannot specialize them for a literal base or
+ *      length. For short fields, that call is a large fraction of the
+ *      cost of the conversion.
+ *
+ *      This file defines strntoul_inline and strntol_inline, static
+ *      inline definitions built from the same conversion core as the
+ *      library's, which the compiler may inline into, and specialize
+ *      for, the caller. They behave exactly as strntoul and strntol
+ *      do, and coexist with the library's declarations of them, so
+ *      that callers opt in, one call at a time, by calling them by
+ *      name.
+ *
+ *      The conversion core is configured for this mode from the
+ *      predefined macros of the compiler alone. Defining
+ *      STRNTOUL_DISABLE_OVERREAD or STRNTOUL_ENABLE_VECTOR_KERNEL
+ *      selects the corresponding configure options.
+ *
+ */
+
+#ifndef STRNTOUL_INLINE_H
+#define STRNTOUL_INLINE_H
+
+#ifndef __cplusplus
+#error "strntoul_inline.h requires C++."
+#endif
+
+// Configure the conversion core for this header-only mode, rather
+// than from the library's build configuration.
+
+#ifndef STRNTOUL_INLINE
+#define STRNTOUL_INLINE 1
+#endif
+
+#include <stddef.h>
+
+#include <strntoul/strntoul-core.h>
+
+/**
+ *  @brief
+ *    Convert a string to an unsigned long integer.
+ *
+ *  This is an inline definition of, and is identical to, strntoul.
+ *
+ *  @param[in]   aString  A pointer to the string to convert.
+ *  @param[in]   aLength  The maximum number of characters, in bytes,
+ *                        of @a aString to process.
+ *  @param[out]  aEnd     A pointer to storage for the first invalid
+ *                        or the last valid character in @a aString.
+ *  @param[in]   aBase    The base to use to interpret @a aString for
+ *                        the conversion in the range 2 to 36,
+ *                        inclusive.
+ *
+ *  @returns
+ *    The result of the conversion, as for strntoul.
+ *
+ */
+static inline unsigned long
+strntoul_inline(const char *aString, size_t aLength, char **aEnd, int aBase)
+{
+    return (StrNToUL::Core::ConvertUnsigned<unsigned long>(aString, aLength, aEnd, aBase));
+}
+
+/**
+ *  @brief
+ *    Convert a string to a long integer.
+ *
+ *  This is an inline definition of, and is identical to, strntol.
+ *
+ *  @param[in]   aString  A pointer to the string to convert.
+ *  @param[in]   aLength  The maximum number of characters, in bytes,
+ *                        of @a aString to process.
+ *  @param[out]  aEnd     A pointer to storage for the first invalid
+ *                        or the last valid character in @a aString.
+ *  @param[in]   aBase    The base to use to interpret @a aString for
+ *                        the conversion in the range 2 to 36,
+ *                        inclusive.
+ *
+ *  @returns
+ *    The result of the conversion, as for strntol.
+ *
+ */
+static inline long
+strntol_inline(const char *aString, size_t aLength, char **aEnd, int aBase)
+{
+    return (StrNToUL::Core::ConvertSigned<long, unsigned long>(aString, aLength, aEnd, aBase));
+}
+
+#endif /* STRNTOUL_INLINE_H */
@@ -0,0 +1,616 @@
+/*
+ *    Copyright (c) 2024 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+
+/**
+ *    @file
+ *      This file implements interfaces for inspecting the sampled
+ *      latency of strntoul and strntol calls.
+ *
+ *      Each thread records its samples into its own set of
+ *      histograms, allocated at its first sample and linked into a
+ *      process-wide list, such that recording takes no lock and
+ *      shares no cache line with other threads. The histograms
+ *      outlive their thread, so that its samples are still reported.
+ *
+ *      Each histogram is log-linear: a latency is bucketed by its
+ *      most significant bit and then by the three bits below it, so
+ *      that any recorded latency is within 12.5% of the value
+ *      reported for it.
+ *
+ */
+
+#include "strntoul_latency.h"
+
+#include <errno.h>
+#include <limits.h>
+#include <stdlib.h>
+
+#include <atomic>
+#include <mutex>
+#include <new>
+
+#include "strntoul-latency.h"
+
+#if STRNTOUL_USE_LATENCY_HISTOGRAMS
+
+namespace StrNToUL
+{
+
+namespace Latency
+{
+
+static constexpr unsigned int kDefaultInterval = 1024;
+
+// Bases 0, 2, 8, 10, and 16 each have their own histograms; all
+// others share one.
+
+static constexpr size_t       kBaseClasses     = 6;
+
+// Lengths 0, 1, 2-3, 4-7, ..., 32-63, and 64 or more.
+
+static constexpr size_t       kLengthBuckets   = 8;
+
+static constexpr unsigned int kSubBucketBits   = 3;
+static constexpr size_t       kSubBuckets      = (1U << kSubBucketBits);
+
+// Enough buckets for latencies up to 2^34 ticks, beyond which all
+// latencies share the last bucket.
+
+static constexpr size_t       kBuckets         = 256;
+
+static const char * const     kBaseNames[kBaseClasses] = {
+    "0", "2", "8", "10", "16", "other"
+};
+
+static const char * const     kLengthNames[kLengthBuckets] = {
+    "0", "1", "2-3", "4-7", "8-15", "16-31", "32-63", "64-"
+};
+
+/**
+ *  A thread's histograms. Each count is written only by the owning
+ *  thread, but may be read or reset by any other.
+ *
+ */
+struct Histograms
+{
+    Histograms *          mNext;
+    std::atomic<uint64_t> mCounts[kBaseClasses][kLengthBuckets][kBuckets];
+};
+
+thread_local unsigned int          tCountdown STRNTOUL_LATENCY_TLS_MODEL  = 1;
+static thread_local bool           tStarted STRNTOUL_LATENCY_TLS_MODEL    = false;
+static thread_local Histograms *   tHistograms STRNTOUL_LATENCY_TLS_MODEL = nullptr;
+
+static std::atomic<unsigned int>   sInterval(kDefaultInterval);
+static std::mutex                  sLock;
+static Histograms *                sHistograms = nullptr;
+
+static size_t
+BaseClass(const int &aBase)
+{
+    switch (aBase)
+    {
+
+    case 0:
+        return (0);
+
+    case 2:
+        return (1);
+
+    case 8:
+        return (2);
+
+    case 10:
+        return (3);
+
+    case 16:
+        return (4);
+
+    default:
+        return (5);
+
+    }
+}
+
+static size_t
+LengthBucket(const size_t &aLength)
+{
+    size_t lRetval = 0;
+
+    if (aLength > 0)
+    {
+        lRetval = static_cast<size_t>(64 - __builtin_clzll(static_cast<unsigned long long>(aLength)));
+
+        if (lRetval >= kLengthBuckets)
+        {
+            lRetval = kLengthBuckets - 1;
+        }
+    }
+
+    return (lRetval);
+}
+
+static size_t
+TickBucket(const uint64_t &aTicks)
+{
+    size_t lRetval;
+
+    if (aTicks < kSubBuckets)
+    {
+        lRetval = static_cast<size_t>(aTicks);
+    }
+    else
+    {
+        const unsigned int lExponent = static_cast<unsigned int>(63 - __builtin_clzll(aTicks));
+        const size_t       lSub      = static_cast<size_t>((aTicks >> (lExponent - kSubBucketBits)) & (kSubBuckets - 1));
+
+        lRetval = ((lExponent - kSubBucketBits + 1) * kSubBuckets) + lSub;
+
+        if (lRetval >= kBuckets)
+        {
+            lRetval = kBuckets - 1;
+        }
+    }
+
+    return (lRetval);
+}
+
+/**
+ *  Return the greatest latency that would be recorded in the bucket
+ *  at @a aBucket.
+ *
+ */
+static uint64_t
+BucketHighest(const size_t &aBucket)
+{
+    uint64_t lRetval;
+
+    if (aBucket < kSubBuckets)
+    {
+        lRetval = aBucket;
+    }
+    else
+    {
+        const unsigned int lShift = static_cast<unsigned int>((aBucket / kSubBuckets) - 1);
+        const uint64_t     lLow   = (kSubBuckets + (aBucket % kSubBuckets)) << lShift;
+
+        lRetval = lLow + ((static_cast<uint64_t>(1) << lShift) - 1);
+    }
+
+    return (lRetval);
+}
+
+/**
+ *  Sum, over all threads, the histograms for the base class @a
+ *  aBaseClass and the length bucket @a aLengthBucket, either of
+ *  which may be SIZE_MAX to sum over all of them.
+ *
+ */
+static uint64_t
+Collect(const size_t &aBaseClass, const size_t &aLengthBucket, uint64_t (&aCounts)[kBuckets])
+{
+    std::lock_guard<std::mutex> lGuard(sLock);
+    uint64_t                    lRetval = 0;
+
+    for (size_t i = 0; i < kBuckets; i++)
+    {
+        aCounts[i] = 0;
+    }
+
+    for (const Histograms *lHistograms = sHistograms; lHistograms != nullptr; lHistograms = lHistograms->mNext)
+    {
+        for (size_t lBase = 0; lBase < kBaseClasses; lBase++)
+        {
+            if ((aBaseClass != SIZE_MAX) && (aBaseClass != lBase))
+                continue;
+
+            for (size_t lLength = 0; lLength < kLengthBuckets; lLength++)
+            {
+                if ((aLengthBucket != SIZE_MAX) && (aLengthBucket != lLength))
+                    continue;
+
+                for (size_t i = 0; i < kBuckets; i++)
+                {
+                    const uint64_t lCount = lHistograms->mCounts[lBase][lLength][i].load(std::memory_order_relaxed);
+
+                    aCounts[i] += lCount;
+                    lRetval    += lCount;
+                }
+            }
+        }
+    }
+
+    return (lRetval);
+}
+
+/**
+ *  Return the latency at or below which the fraction @a aQuantile of
+ *  the @a aSamples samples in @a aCounts fell.
+ *
+ */
+static uint64_t
+Quantile(const uint64_t (&aCounts)[kBuckets], const uint64_t &aSamples, const double &aQuantile)
+{
+    uint64_t lRank = static_cast<uint64_t>(aQuantile * static_cast<double>(aSamples));
+    uint64_t lSeen = 0;
+
+    if (lRank < aSamples)
+    {
+        lRank++;
+    }
+
+    for (size_t i = 0; i < kBuckets; i++)
+    {
+        lSeen += aCounts[i];
+
+        if ((lSeen >= lRank) && (lSeen > 0))
+        {
+            return (BucketHighest(i));
+        }
+    }
+
+    return (0);
+}
+
+static int
+Dump(FILE *aStream)
+{
+    uint64_t lCounts[kBuckets];
+
+    fprintf(aStream,
+            "strntoul latency, in %s, sampling 1 in %u calls\n"
+            "%-6s %-6s %12s %10s %10s %10s %10s %10s\n",
+            (STRNTOUL_LATENCY_USE_TSC ? "ticks" : "nanoseconds"),
+            sInterval.load(std::memory_order_relaxed),
+            "base", "length", "samples", "p50", "p90", "p99", "p99.9", "max");
+
+    for (size_t lBase = 0; lBase <= kBaseClasses; lBase++)
+    {
+        for (size_t lLength = 0; lLength < kLengthBuckets; lLength++)
+        {
+            const bool     lTotal   = (lBase == kBaseClasses);
+            const uint64_t lSamples = Collect((lTotal ? SIZE_MAX : lBase),
+                                              (lTotal ? SIZE_MAX : lLength),
+                                              lCounts);
+
+            if (lSamples > 0)
+            {
+                fprintf(aStream,
+                        "%-6s %-6s %12llu %10llu %10llu %10llu %10llu %10llu\n",
+                        (lTotal ? "all" : kBaseNames[lBase]),
+                        (lTotal ? "all" : kLengthNames[lLength]),
+                        static_cast<unsigned long long>(lSamples),
+                        static_cast<unsigned long long>(Quantile(lCounts, lSamples, 0.5)),
+                        static_cast<unsigned long long>(Quantile(lCounts, lSamples, 0.9)),
+                        static_cast<unsigned long long>(Quantile(lCounts, lSamples, 0.99)),
+                        static_cast<unsigned long long>(Quantile(lCounts, lSamples, 0.999)),
+                        static_cast<unsigned long long>(Quantile(lCounts, lSamples, 1.0)));
+            }
+
+            if (lTotal)
+                break;
+        }
+    }
+
+    return ((ferror(aStream) != 0) ? -EIO : 0);
+}
+
+static void
+Report(void)
+{
+    const char * lPath = getenv("STRNTOUL_LATENCY_REPORT");
+    FILE *       lStream;
+
+    if ((lPath == nullptr) || (*lPath == '\0'))
+    {
+        return;
+    }
+
+    if ((lPath[0] == '-') && (lPath[1] == '\0'))
+    {
+        Dump(stderr);
+    }
+    else if ((lStream = fopen(lPath, "w")) != nullptr)
+    {
+        Dump(lStream);
+
+        fclose(lStream);
+    }
+}
+
+/**
+ *  Apply the environment, once, before the first sample or the first
+ *  explicit change to the sampling interval.
+ *
+ */
+static bool
+Initialize(void)
+{
+    const char * lInterval = getenv("STRNTOUL_LATENCY_INTERVAL");
+    const char * lReport   = getenv("STRNTOUL_LATENCY_REPORT");
+
+    if ((lInterval != nullptr) && (*lInterval != '\0'))
+    {
+        char *              lEnd;
+        const unsigned long lValue = strtoul(lInterval, &lEnd, 10);
+
+        if ((*lEnd == '\0') && (lValue <= UINT_MAX))
+        {
+            sInterval.store(static_cast<unsigned int>(lValue), std::memory_order_relaxed);
+        }
+    }
+
+    if ((lReport != nullptr) && (*lReport != '\0'))
+    {
+        atexit(Report);
+    }
+
+    return (true);
+}
+
+static void
+EnsureInitialized(void)
+{
+    static const bool sInitialized = Initialize();
+
+    (void)sInitialized;
+}
+
+/**
+ *  @brief
+ *    Rearm the calling thread's countdown and decide whether to
+ *    sample the current call.
+ *
+ *  A thread's first call, which is likely to be cold, is never
+ *  sampled. While sampling is disabled, the countdown is still
+ *  rearmed at the default interval, so that a later change to the
+ *  interval takes effect.
+ *
+ *  @returns
+ *    True if the current call should be sampled; otherwise, false.
+ *
+ */
+bool
+Begin(void)
+{
+    unsigned int lInterval;
+    bool         lRetval;
+
+    EnsureInitialized();
+
+    lInterval  = sInterval.load(std::memory_order_relaxed);
+    lRetval    = (tStarted && (lInterval != 0));
+    tStarted   = true;
+    tCountdown = ((lInterval == 0) ? kDefaultInterval : lInterval);
+
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    Record a sampled latency in the calling thread's histograms.
+ *
+ *  @param[in]  aLength  The length of the sampled conversion.
+ *  @param[in]  aBase    The base of the sampled conversion.
+ *  @param[in]  aTicks   The latency of the sampled conversion.
+ *
+ */
+void
+End(size_t aLength, int aBase, uint64_t aTicks)
+{
+    Histograms * lHistograms = tHistograms;
+
+    if (lHistograms == nullptr)
+    {
+        lHistograms = new (std::nothrow) Histograms();
+
+        if (lHistograms == nullptr)
+        {
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lGuard(sLock);
+
+            lHistograms->mNext = sHistograms;
+            sHistograms        = lHistograms;
+        }
+
+        tHistograms = lHistograms;
+    }
+
+    {
+        std::atomic<uint64_t> &lCount = lHistograms->mCounts[BaseClass(aBase)][LengthBucket(aLength)][TickBucket(aTicks)];
+
+        // Only this thread increments the count, so it need not be
+        // an atomic read-modify-write.
+
+        lCount.store(lCount.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+}
+
+}; // namespace Latency
+
+}; // namespace StrNToUL
+
+using namespace StrNToUL::Latency;
+
+#endif // STRNTOUL_USE_LATENCY_HISTOGRAMS
+
+/**
+ *  @brief
+ *    Set the sampling interval.
+ *
+ *  Each thread samples one in every @a aInterval calls to strntoul
+ *  and strntol, taking effect in a thread at its next sample.
+ *
+ *  @param[in]  aInterval  The sampling interval, or zero (0) to stop
+ *                         sampling.
+ *
+ *  @retval  0         If successful.
+ *  @retval  -ENOTSUP  If latency histograms were not configured.
+ *
+ */
+int
+strntoul_latency_set_interval(unsigned int aInterval)
+{
+#if STRNTOUL_USE_LATENCY_HISTOGRAMS
+    EnsureInitialized();
+
+    sInterval.store(aInterval, std::memory_order_relaxed);
+
+    return (0);
+#else
+    (void)aInterval;
+
+    return (-ENOTSUP);
+#endif
+}
+
+/**
+ *  @brief
+ *    Discard all samples recorded so far, in all threads.
+ *
+ *  A sample recorded concurrently with the reset may be lost.
+ *
+ *  @retval  0         If successful.
+ *  @retval  -ENOTSUP  If latency histograms were not configured.
+ *
+ */
+int
+strntoul_latency_reset(void)
+{
+#if STRNTOUL_USE_LATENCY_HISTOGRAMS
+    std::lock_guard<std::mutex> lGuard(sLock);
+
+    for (Histograms *lHistograms = sHistograms; lHistograms != nullptr; lHistograms = lHistograms->mNext)
+    {
+        for (auto &lByLength : lHistograms->mCounts)
+        {
+            for (auto &lByTicks : lByLength)
+            {
+                for (auto &lCount : lByTicks)
+                {
+                    lCount.store(0, std::memory_order_relaxed);
+                }
+            }
+        }
+    }
+
+    return (0);
+#else
+    return (-ENOTSUP);
+#endif
+}
+
+/**
+ *  @brief
+ *    Return a quantile of the sampled latencies.
+ *
+ *  @param[in]   aBase      The base whose samples to consider, which
+ *                          selects the histograms for its class: 0,
+ *                          2, 8, 10, 16, or any other; or -1 for all
+ *                          bases.
+ *  @param[in]   aLength    A length whose power-of-two bucket of
+ *                          samples to consider, or SIZE_MAX for all
+ *                          lengths.
+ *  @param[in]   aQuantile  The quantile, from 0.0 to 1.0, inclusive.
+ *  @param[out]  aTicks     A pointer to storage for the greatest
+ *                          latency equivalent, within the histogram
+ *                          precision, to the quantile, or zero (0)
+ *                          if there were no samples.
+ *  @param[out]  aSamples   An optional pointer to storage for the
+ *                          number of samples considered.
+ *
+ *  @retval  0         If successful.
+ *  @retval  -EINVAL   If @a aBase, @a aQuantile, or @a aTicks was
+ *                     invalid.
+ *  @retval  -ENOTSUP  If latency histograms were not configured.
+ *
+ */
+int
+strntoul_latency_quantile(int aBase, size_t aLength, double aQuantile, uint64_t *aTicks, uint64_t *aSamples)
+{
+#if STRNTOUL_USE_LATENCY_HISTOGRAMS
+    uint64_t lCounts[kBuckets];
+    uint64_t lSamples;
+
+    if (((aBase != -1) && (aBase != 0) && ((aBase < 2) || (aBase > 36))) ||
+        !((aQuantile >= 0.0) && (aQuantile <= 1.0)) ||
+        (aTicks == nullptr))
+    {
+        return (-EINVAL);
+    }
+
+    lSamples = Collect(((aBase == -1) ? SIZE_MAX : BaseClass(aBase)),
+                       ((aLength == SIZE_MAX) ? SIZE_MAX : LengthBucket(aLength)),
+                       lCounts);
+
+    *aTicks = Quantile(lCounts, lSamples, aQuantile);
+
+    if (aSamples != nullptr)
+    {
+        *aSamples = lSamples;
+    }
+
+    return (0);
+#else
+    (void)aBase;
+    (void)aLength;
+    (void)aQuantile;
+    (void)aTicks;
+    (void)aSamples;
+
+    return (-ENOTSUP);
+#endif
+}
+
+/**
+ *  @brief
+ *    Write a report of the sampled latencies.
+ *
+ *  The report has one line for each base class and length bucket
+ *  with samples, giving the number of samples and their median,
+ *  90th, 99th, and 99.9th percentile, and maximum latencies, and a
+ *  final line summarizing all of them.
+ *
+ *  @param[in]  aStream  The stream to which to write the report.
+ *
+ *  @retval  0         If successful.
+ *  @retval  -EINVAL   If @a aStream was null.
+ *  @retval  -EIO      If the report could not be written.
+ *  @retval  -ENOTSUP  If latency histograms were not configured.
+ *
+ */
+int
+strntoul_latency_dump(FILE *aStream)
+{
+#if STRNTOUL_USE_LATENCY_HISTOGRAMS
+    if (aStream == nullptr)
+    {
+        return (-EINVAL);
+    }
+
+    return (Dump(aStream));
+#else
+    (void)aStream;
+
+    return (-ENOTSUP);
+#endif
+}
@@ -0,0 +1,60 @@
+/*
+ *    Copyright (c) 2024 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+
+/**
+ *    @file
+ *      This file defines interfaces for inspecting the sampled
+ *      latency of strntoul and strntol calls, when the package is
+ *      configured with --enable-latency-histograms.
+ *
+ *      One in every N calls, by default 1024, is timed into a
+ *      log-linear histogram, owned by the calling thread, and keyed
+ *      by the class of its base (0, 2, 8, 10, 16, or any other) and
+ *      by its length, in power-of-two buckets. Latencies are in
+ *      time-stamp counter ticks on x86 targets and in nanoseconds
+ *      elsewhere.
+ *
+ *      The environment variable STRNTOUL_LATENCY_INTERVAL, if set,
+ *      overrides the default sampling interval and, if
+ *      STRNTOUL_LATENCY_REPORT is set, a report is written at exit
+ *      to the file that it names or, if it is "-", to standard error.
+ *
+ */
+
+#ifndef STRNTOUL_LATENCY_H
+#define STRNTOUL_LATENCY_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern int strntoul_latency_set_interval(unsigned int aInterval);
+extern int strntoul_latency_reset(void);
+extern int strntoul_latency_quantile(int aBase, size_t aLength, double aQuantile, uint64_t *aTicks, uint64_t *aSamples);
+extern int strntoul_latency_dump(FILE *aStream);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STRNTOUL_LATENCY_H */
@@ -0,0 +1,257 @@
+/*
+ *    Copyright (c) 2024 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *    @file
+ *      This file implements interfaces for reusable, pre-configured
+ *      strntoul parsers.
+ *
+ *      At creation, the base and flags are validated and resolved into
+ *      an instantiation of the conversion core that strntoul itself
+ *      uses, specialized at compile time for the common bases 0, 2, 8,
+ *      10, and 16 and for each combination of options, such that the
+ *      base handling, the choice of conversion loop, and the overflow
+ *      sentinel are constants. Each conversion is then an indirect
+ *      call to that instantiation, followed only by the strictness
+ *      check.
+ *
+ */
+
+#include "strntoul_parser.h"
+
+#include <errno.h>
+#include <limits.h>
+#include <stdlib.h>
+
+#include "strntoul/strntoul-core.h"
+
+using StrNToUL::Core::kAnyBase;
+using StrNToUL::Core::kNoPrefix;
+using StrNToUL::Core::kNoSign;
+using StrNToUL::Core::kNoWhitespace;
+
+/**
+ *  Convert a string, as strntoul would, with the base either fixed by
+ *  the instantiation or, for kAnyBase, @a aBase.
+ *
+ */
+typedef unsigned long (*Converter)(const char *aString,
+                                   const size_t &aLength,
+                                   char **aEnd,
+                                   const int &aBase);
+
+struct strntoul_parser
+{
+    Converter mConverter;
+    int       mBase;
+    bool      mStrict;
+};
+
+static constexpr unsigned int kParserFlags = (STRNTOUL_PARSER_NO_WHITESPACE |
+                                              STRNTOUL_PARSER_NO_SIGN       |
+                                              STRNTOUL_PARSER_NO_PREFIX     |
+                                              STRNTOUL_PARSER_STRICT);
+
+/**
+ *  Return the conversion core instantiated for @a kBase and for the
+ *  white space and sign options in @a aOptions, along with @a kPrefix,
+ *  which is either zero (0) or kNoPrefix.
+ *
+ */
+template <int kBase, unsigned int kPrefix = 0>
+static Converter
+SelectConverter(const unsigned int &aOptions)
+{
+    static const Converter kConverters[] = {
+        StrNToUL::Core::ConvertUnsigned<unsigned long, kBase, kPrefix>,
+        StrNToUL::Core::ConvertUnsigned<unsigned long, kBase, kPrefix | kNoWhitespace>,
+        StrNToUL::Core::ConvertUnsigned<unsigned long, kBase, kPrefix | kNoSign>,
+        StrNToUL::Core::ConvertUnsigned<unsigned long, kBase, kPrefix | kNoWhitespace | kNoSign>
+    };
+
+    return (kConverters[aOptions & (kNoWhitespace | kNoSign)]);
+}
+
+/**
+ *  @brief
+ *    Create a reusable, pre-configured parser.
+ *
+ *  This validates @a aBase and resolves it, along with @a aFlags, into
+ *  an immutable parser that converts exactly as strntoul would with @a
+ *  aBase, except as narrowed by @a aFlags, without validating either
+ *  on every conversion.
+ *
+ *  @param[in]   aBase    The base to use for each conversion, in the
+ *                        range 2 to 36, inclusive, or zero (0) to
+ *                        deduce it from the content, as for strntoul.
+ *  @param[in]   aFlags   A bitwise combination of zero or more
+ *                        STRNTOUL_PARSER_* flags.
+ *  @param[out]  aParser  A pointer to storage for the parser, which the
+ *                        caller must destroy with
+ *                        strntoul_parser_destroy.
+ *
+ *  @retval  0        If successful.
+ *  @retval  -EINVAL  If @a aParser was null, if @a aBase was
+ *                    unsupported, if @a aFlags included an unknown
+ *                    flag, or if STRNTOUL_PARSER_NO_PREFIX was used
+ *                    with a deduced base, which relies upon one.
+ *  @retval  -ENOMEM  If memory could not be allocated.
+ *
+ *  @sa strntoul_parser_parse
+ *  @sa strntoul_parser_destroy
+ *
+ */
+int
+strntoul_parser_create(int aBase, unsigned int aFlags, strntoul_parser_t **aParser)
+{
+    strntoul_parser_t * lParser;
+    unsigned int        lOptions;
+
+    if ((aParser == nullptr) ||
+        ((aBase != 0) && ((aBase < 2) || (aBase > 36))) ||
+        ((aFlags & ~kParserFlags) != 0) ||
+        ((aBase == 0) && ((aFlags & STRNTOUL_PARSER_NO_PREFIX) != 0)))
+    {
+        return (-EINVAL);
+    }
+
+    lParser = static_cast<strntoul_parser_t *>(calloc(1, sizeof (strntoul_parser_t)));
+
+    if (lParser == nullptr)
+    {
+        return (-ENOMEM);
+    }
+
+    lOptions = ((((aFlags & STRNTOUL_PARSER_NO_WHITESPACE) != 0) ? kNoWhitespace : 0) |
+                (((aFlags & STRNTOUL_PARSER_NO_SIGN)       != 0) ? kNoSign       : 0));
+
+    lParser->mBase   = aBase;
+    lParser->mStrict = ((aFlags & STRNTOUL_PARSER_STRICT) != 0);
+
+    switch (aBase)
+    {
+
+    case 0:
+        lParser->mConverter = SelectConverter<0>(lOptions);
+        break;
+
+    case 2:
+        lParser->mConverter = SelectConverter<2>(lOptions);
+        break;
+
+    case 8:
+        lParser->mConverter = SelectConverter<8>(lOptions);
+        break;
+
+    case 10:
+        lParser->mConverter = SelectConverter<10>(lOptions);
+        break;
+
+    case 16:
+        lParser->mConverter = (((aFlags & STRNTOUL_PARSER_NO_PREFIX) != 0) ?
+                               SelectConverter<16, kNoPrefix>(lOptions) :
+                               SelectConverter<16>(lOptions));
+        break;
+
+    default:
+        lParser->mConverter = SelectConverter<kAnyBase>(lOptions);
+        break;
+
+    }
+
+    *aParser = lParser;
+
+    return (0);
+}
+
+/**
+ *  @brief
+ *    Destroy a parser.
+ *
+ *  @param[in]  aParser  A pointer to the parser to destroy. A null
+ *                       pointer is ignored.
+ *
+ */
+void
+strntoul_parser_destroy(strntoul_parser_t *aParser)
+{
+    free(aParser);
+}
+
+/**
+ *  @brief
+ *    Convert a string to an unsigned long integer with a parser.
+ *
+ *  This is identical to strntoul with the parser's base, except as
+ *  narrowed by its flags: without leading white space, without a
+ *  sign, without a "0x" prefix, or, when strict, converting nothing
+ *  unless the entire @a aLength bytes are a number.
+ *
+ *  On error, @a errno may be set as follows:
+ *
+ *    - EINVAL   @a aParser was null or, for a strict parser, @a
+ *               aString was not entirely a number, in which case this
+ *               returns 0 and stores @a aString in *@a aEnd.
+ *    - ERANGE   The resulting conversion was out of range.
+ *
+ *  @param[in]   aParser  A pointer to the parser to use.
+ *  @param[in]   aString  A pointer to the string to convert.
+ *  @param[in]   aLength  The maximum number of characters, in bytes,
+ *                        of @a aString to process.
+ *  @param[out]  aEnd     A pointer to storage for the first invalid
+ *                        or the last valid character in @a aString.
+ *
+ *  @returns
+ *    The result of the conversion, as for strntoul.
+ *
+ *  @sa strntoul
+ *  @sa strntoul_parser_create
+ *
+ */
+unsigned long
+strntoul_parser_parse(const strntoul_parser_t *aParser, const char *aString, size_t aLength, char **aEnd)
+{
+    char *        lEnd    = const_cast<char *>(aString);
+    unsigned long lRetval = 0;
+
+    if (aParser == nullptr)
+    {
+        errno = EINVAL;
+        goto done;
+    }
+
+    lRetval = aParser->mConverter(aString, aLength, &lEnd, aParser->mBase);
+
+    // Nothing is converted, exactly as when there are no digits, when
+    // a strict parser stops short of the end.
+
+    if (aParser->mStrict && ((lEnd == aString) || (lEnd != (aString + aLength))))
+    {
+        errno   = EINVAL;
+        lEnd    = const_cast<char *>(aString);
+        lRetval = 0;
+    }
+
+ done:
+    if (aEnd != nullptr)
+    {
+        *aEnd = lEnd;
+    }
+
+    return (lRetval);
+}
@@ -0,0 +1,68 @@
+/*
+ *    Copyright (c) 2024 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *    @file
+ *      This file defines interfaces for reusable, pre-configured
+ *      strntoul parsers, whose base and conversion options are
+ *      resolved once, at creation, rather than on every conversion.
+ *
+ */
+
+#ifndef STRNTOUL_PARSER_H
+#define STRNTOUL_PARSER_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ *  Flags for strntoul_parser_create, each of which narrows what
+ *  strntoul would otherwise accept.
+ *
+ */
+enum
+{
+    STRNTOUL_PARSER_NO_WHITESPACE = 0x01,  //!< Do not skip leading
+                                           //!< white space.
+    STRNTOUL_PARSER_NO_SIGN       = 0x02,  //!< Do not accept a leading
+                                           //!< '+' or '-' sign.
+    STRNTOUL_PARSER_NO_PREFIX     = 0x04,  //!< Do not skip a "0x" or
+                                           //!< "0X" prefix in base 16.
+    STRNTOUL_PARSER_STRICT        = 0x08   //!< Require that the entire
+                                           //!< length be converted.
+};
+
+/**
+ *  An immutable, pre-configured parser, which may be shared among
+ *  threads.
+ *
+ */
+typedef struct strntoul_parser strntoul_parser_t;
+
+extern int strntoul_parser_create(int aBase, unsigned int aFlags, strntoul_parser_t **aParser);
+extern void strntoul_parser_destroy(strntoul_parser_t *aParser);
+extern unsigned long strntoul_parser_parse(const strntoul_parser_t *aParser, const char *aString, size_t aLength, char **aEnd);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STRNTOUL_PARSER_H */
@@ -0,0 +1,747 @@
+/*
+ *    Copyright (c) 2024 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *    @file
+ *      This file implements interfaces for reading Linux procfs and
+ *      sysfs files into caller-owned, reusable buffers and for parsing
+ *      their common formats, in place, into fixed structures.
+ *
+ *      Files are read with pread from offset zero, so a descriptor may
+ *      be kept open and polled repeatedly without seeking. Every field
+ *      is converted directly from the buffer, bounded by its length,
+ *      with strntoul or strntol, so the buffer need not be
+ *      null-terminated and nothing is copied or allocated.
+ *
+ */
+
+#include "strntoul_proc.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stddef.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "strntol.h"
+#include "strntoul.h"
+#include "strntoul/strntoul-kernel.h"
+
+namespace
+{
+
+/**
+ *  A numeric field of /proc/[pid]/stat, by its offset in
+ *  strntoul_proc_stat_t.
+ *
+ */
+struct StatField
+{
+    size_t mOffset;
+    bool   mSigned;
+};
+
+/**
+ *  The numeric fields, in order, from ppid through rsslim.
+ *
+ */
+const StatField kStatFields[] = {
+    { offsetof(strntoul_proc_stat_t, ppid),        true  },
+    { offsetof(strntoul_proc_stat_t, pgrp),        true  },
+    { offsetof(strntoul_proc_stat_t, session),     true  },
+    { offsetof(strntoul_proc_stat_t, tty_nr),      true  },
+    { offsetof(strntoul_proc_stat_t, tpgid),       true  },
+    { offsetof(strntoul_proc_stat_t, flags),       false },
+    { offsetof(strntoul_proc_stat_t, minflt),      false },
+    { offsetof(strntoul_proc_stat_t, cminflt),     false },
+    { offsetof(strntoul_proc_stat_t, majflt),      false },
+    { offsetof(strntoul_proc_stat_t, cmajflt),     false },
+    { offsetof(strntoul_proc_stat_t, utime),       false },
+    { offsetof(strntoul_proc_stat_t, stime),       false },
+    { offsetof(strntoul_proc_stat_t, cutime),      true  },
+    { offsetof(strntoul_proc_stat_t, cstime),      true  },
+    { offsetof(strntoul_proc_stat_t, priority),    true  },
+    { offsetof(strntoul_proc_stat_t, nice),        true  },
+    { offsetof(strntoul_proc_stat_t, num_threads), true  },
+    { offsetof(strntoul_proc_stat_t, itrealvalue), true  },
+    { offsetof(strntoul_proc_stat_t, starttime),   false },
+    { offsetof(strntoul_proc_stat_t, vsize),       false },
+    { offsetof(strntoul_proc_stat_t, rss),         true  },
+    { offsetof(strntoul_proc_stat_t, rsslim),      false }
+};
+
+/**
+ *  The number of fields, following rsslim, up to processor.
+ *
+ */
+const size_t kStatFieldsToProcessor = 13;
+
+/**
+ *  A field of /proc/meminfo, by its key and its offset in
+ *  strntoul_proc_meminfo_t.
+ *
+ */
+struct MeminfoField
+{
+    const char * mKey;
+    size_t       mLength;
+    size_t       mOffset;
+};
+
+#define MEMINFO_FIELD(aKey, aMember) \
+    { aKey, sizeof (aKey) - 1, offsetof(strntoul_proc_meminfo_t, aMember) }
+
+/**
+ *  The fields, in the order in which the kernel reports them, which
+ *  allows most lookups to succeed on the first comparison.
+ *
+ */
+const MeminfoField kMeminfoFields[] = {
+    MEMINFO_FIELD("MemTotal",        mem_total),
+    MEMINFO_FIELD("MemFree",         mem_free),
+    MEMINFO_FIELD("MemAvailable",    mem_available),
+    MEMINFO_FIELD("Buffers",         buffers),
+    MEMINFO_FIELD("Cached",          cached),
+    MEMINFO_FIELD("SwapCached",      swap_cached),
+    MEMINFO_FIELD("Active",          active),
+    MEMINFO_FIELD("Inactive",        inactive),
+    MEMINFO_FIELD("SwapTotal",       swap_total),
+    MEMINFO_FIELD("SwapFree",        swap_free),
+    MEMINFO_FIELD("Dirty",           dirty),
+    MEMINFO_FIELD("Writeback",       writeback),
+    MEMINFO_FIELD("AnonPages",       anon_pages),
+    MEMINFO_FIELD("Mapped",          mapped),
+    MEMINFO_FIELD("Shmem",           shmem),
+    MEMINFO_FIELD("Slab",            slab),
+    MEMINFO_FIELD("SReclaimable",    s_reclaimable),
+    MEMINFO_FIELD("SUnreclaim",      s_unreclaim),
+    MEMINFO_FIELD("KernelStack",     kernel_stack),
+    MEMINFO_FIELD("PageTables",      page_tables),
+    MEMINFO_FIELD("CommitLimit",     commit_limit),
+    MEMINFO_FIELD("Committed_AS",    committed_as),
+    MEMINFO_FIELD("HugePages_Total", huge_pages_total),
+    MEMINFO_FIELD("HugePages_Free",  huge_pages_free),
+    MEMINFO_FIELD("Hugepagesize",    hugepagesize)
+};
+
+#undef MEMINFO_FIELD
+
+const size_t kMeminfoFieldCount = sizeof (kMeminfoFields) / sizeof (kMeminfoFields[0]);
+
+}; // namespace
+
+/**
+ *  Convert an unsigned field, which must start with a digit in @a
+ *  aBase, at @a aCurrent, advancing it past the field.
+ *
+ *  @retval  0        If successful.
+ *  @retval  -EINVAL  If there was no field at @a aCurrent.
+ *  @retval  -ERANGE  If the field was out of range.
+ *
+ */
+static int
+ConvertUnsigned(const char *&aCurrent, const char *aLast, const int &aBase, unsigned long &aValue)
+{
+    const unsigned int lLimit = ((aBase == 0) ? 10 : static_cast<unsigned int>(aBase));
+    char *             lEnd;
+
+    // Unlike strntoul, do not skip white space or accept a sign; the
+    // formats are exact.
+
+    if ((aCurrent >= aLast) || (StrNToUL::Kernel::DigitValue(*aCurrent) >= lLimit))
+    {
+        return (-EINVAL);
+    }
+
+    errno = 0;
+
+    aValue = strntoul(aCurrent, static_cast<size_t>(aLast - aCurrent), &lEnd, aBase);
+
+    if (errno == ERANGE)
+    {
+        return (-ERANGE);
+    }
+
+    aCurrent = lEnd;
+
+    return (0);
+}
+
+/**
+ *  Convert a decimal field, which must start with a digit or a minus
+ *  sign, at @a aCurrent, advancing it past the field.
+ *
+ *  @retval  0        If successful.
+ *  @retval  -EINVAL  If there was no field at @a aCurrent.
+ *  @retval  -ERANGE  If the field was out of range.
+ *
+ */
+static int
+ConvertSigned(const char *&aCurrent, const char *aLast, long &aValue)
+{
+    const char * lDigit = aCurrent;
+    char *       lEnd;
+
+    if ((lDigit < aLast) && (*lDigit == '-'))
+    {
+        lDigit++;
+    }
+
+    if ((lDigit >= aLast) || (StrNToUL::Kernel::DigitValue(*lDigit) >= 10))
+    {
+        return (-EINVAL);
+    }
+
+    errno = 0;
+
+    aValue = strntol(aCurrent, static_cast<size_t>(aLast - aCurrent), &lEnd, 10);
+
+    if (errno == ERANGE)
+    {
+        return (-ERANGE);
+    }
+
+    aCurrent = lEnd;
+
+    return (0);
+}
+
+/**
+ *  Advance @a aCurrent past @a aCharacter, if it is there.
+ *
+ */
+static bool
+Expect(const char *&aCurrent, const char *aLast, const char &aCharacter)
+{
+    if ((aCurrent < aLast) && (*aCurrent == aCharacter))
+    {
+        aCurrent++;
+
+        return (true);
+    }
+
+    return (false);
+}
+
+static int
+ParseStat(const char *aBuffer, const size_t &aLength, strntoul_proc_stat_t &aStat)
+{
+    const char * const lLast  = aBuffer + aLength;
+    const char *       p      = aBuffer;
+    const char *       lClose = lLast;
+    size_t             lCommLength;
+    int                lStatus;
+
+    lStatus = ConvertSigned(p, lLast, aStat.pid);
+
+    if (lStatus != 0)
+    {
+        return (lStatus);
+    }
+
+    if (!Expect(p, lLast, ' ') || !Expect(p, lLast, '('))
+    {
+        return (-EINVAL);
+    }
+
+    // The command name may itself contain spaces and parentheses, so
+    // it extends to the last closing parenthesis.
+
+    while ((lClose > p) && (*(lClose - 1) != ')'))
+    {
+        lClose--;
+    }
+
+    if (lClose == p)
+    {
+        return (-EINVAL);
+    }
+
+    lClose--;
+
+    lCommLength = static_cast<size_t>(lClose - p);
+
+    if (lCommLength >= sizeof (aStat.comm))
+    {
+        lCommLength = sizeof (aStat.comm) - 1;
+    }
+
+    memcpy(&aStat.comm[0], p, lCommLength);
+
+    aStat.comm[lCommLength] = '\0';
+
+    p = lClose + 1;
+
+    if (!Expect(p, lLast, ' ') || (p >= lLast))
+    {
+        return (-EINVAL);
+    }
+
+    aStat.state = *p++;
+
+    for (const StatField &lField : kStatFields)
+    {
+        char * const lMember = reinterpret_cast<char *>(&aStat) + lField.mOffset;
+
+        if (!Expect(p, lLast, ' '))
+        {
+            return (-EINVAL);
+        }
+
+        if (lField.mSigned)
+        {
+            lStatus = ConvertSigned(p, lLast, *reinterpret_cast<long *>(lMember));
+        }
+        else
+        {
+            lStatus = ConvertUnsigned(p, lLast, 10, *reinterpret_cast<unsigned long *>(lMember));
+        }
+
+        if (lStatus != 0)
+        {
+            return (lStatus);
+        }
+    }
+
+    // Skip to processor, which older kernels do not report.
+
+    aStat.processor = -1;
+
+    for (size_t i = 0; i < kStatFieldsToProcessor; i++)
+    {
+        if (!Expect(p, lLast, ' '))
+        {
+            return (0);
+        }
+
+        while ((p < lLast) && (*p != ' ') && (*p != '\n'))
+        {
+            p++;
+        }
+    }
+
+    if (Expect(p, lLast, ' ') && (ConvertSigned(p, lLast, aStat.processor) != 0))
+    {
+        aStat.processor = -1;
+    }
+
+    return (0);
+}
+
+static int
+ParseMeminfo(const char *aBuffer, const size_t &aLength, strntoul_proc_meminfo_t &aMeminfo)
+{
+    const char * const lLast   = aBuffer + aLength;
+    const char *       p       = aBuffer;
+    size_t             lCursor = 0;
+
+    memset(&aMeminfo, 0, sizeof (aMeminfo));
+
+    while (p < lLast)
+    {
+        const char * lNewline = static_cast<const char *>(memchr(p, '\n', static_cast<size_t>(lLast - p)));
+        const char * lEnd     = (lNewline != nullptr) ? lNewline : lLast;
+        const char * lColon   = static_cast<const char *>(memchr(p, ':', static_cast<size_t>(lEnd - p)));
+        size_t       lKeyLength;
+
+        if (lColon == nullptr)
+        {
+            return (-EINVAL);
+        }
+
+        lKeyLength = static_cast<size_t>(lColon - p);
+
+        // Search from just past the last match, wrapping around.
+
+        for (size_t i = 0; i < kMeminfoFieldCount; i++)
+        {
+            const size_t         lIndex = (lCursor + i) % kMeminfoFieldCount;
+            const MeminfoField & lField = kMeminfoFields[lIndex];
+
+            if ((lField.mLength == lKeyLength) && (memcmp(lField.mKey, p, lKeyLength) == 0))
+            {
+                const char * lValue = lColon + 1;
+                int          lStatus;
+
+                while ((lValue < lEnd) && (*lValue == ' '))
+                {
+                    lValue++;
+                }
+
+                lStatus = ConvertUnsigned(lValue,
+                                          lEnd,
+                                          10,
+                                          *reinterpret_cast<unsigned long *>(reinterpret_cast<char *>(&aMeminfo) + lField.mOffset));
+
+                if (lStatus != 0)
+                {
+                    return (lStatus);
+                }
+
+                lCursor = lIndex + 1;
+                break;
+            }
+        }
+
+        p = (lNewline != nullptr) ? (lNewline + 1) : lLast;
+    }
+
+    return (0);
+}
+
+static int
+ParseMap(const char *&aCurrent, const char *aLast, strntoul_proc_map_t &aMap)
+{
+    const char * p = aCurrent;
+    const char * lEnd;
+    int          lStatus;
+
+    if (((lStatus = ConvertUnsigned(p, aLast, 16, aMap.start)) != 0) ||
+        !Expect(p, aLast, '-') ||
+        ((lStatus = ConvertUnsigned(p, aLast, 16, aMap.end)) != 0) ||
+        !Expect(p, aLast, ' '))
+    {
+        return ((lStatus != 0) ? lStatus : -EINVAL);
+    }
+
+    if ((aLast - p) < 5)
+    {
+        return (-EINVAL);
+    }
+
+    memcpy(&aMap.perms[0], p, 4);
+
+    aMap.perms[4] = '\0';
+
+    p += 4;
+
+    if (!Expect(p, aLast, ' ') ||
+        ((lStatus = ConvertUnsigned(p, aLast, 16, aMap.offset)) != 0) ||
+        !Expect(p, aLast, ' ') ||
+        ((lStatus = ConvertUnsigned(p, aLast, 16, aMap.major)) != 0) ||
+        !Expect(p, aLast, ':') ||
+        ((lStatus = ConvertUnsigned(p, aLast, 16, aMap.minor)) != 0) ||
+        !Expect(p, aLast, ' ') ||
+        ((lStatus = ConvertUnsigned(p, aLast, 10, aMap.inode)) != 0))
+    {
+        return ((lStatus != 0) ? lStatus : -EINVAL);
+    }
+
+    while ((p < aLast) && (*p == ' '))
+    {
+        p++;
+    }
+
+    lEnd = static_cast<const char *>(memchr(p, '\n', static_cast<size_t>(aLast - p)));
+
+    if (lEnd == nullptr)
+    {
+        lEnd = aLast;
+    }
+
+    aMap.path        = p;
+    aMap.path_length = static_cast<size_t>(lEnd - p);
+
+    aCurrent = (lEnd < aLast) ? (lEnd + 1) : aLast;
+
+    return (0);
+}
+
+/**
+ *  @brief
+ *    Read a procfs or sysfs file into a buffer.
+ *
+ *  This reads the file open on @a aDescriptor from its start, with
+ *  pread, irrespective of the descriptor's file offset, such that the
+ *  same descriptor and buffer may be reused for each poll.
+ *
+ *  @param[in]   aDescriptor  The open file descriptor to read.
+ *  @param[out]  aBuffer      A pointer to the buffer to read into,
+ *                            which will not be null-terminated.
+ *  @param[in]   aSize        The size, in bytes, of @a aBuffer.
+ *  @param[out]  aLength      A pointer to storage for the number of
+ *                            bytes read.
+ *
+ *  @retval  0           If successful.
+ *  @retval  -EINVAL     If @a aBuffer or @a aLength was null or if @a
+ *                       aSize was zero.
+ *  @retval  -EOVERFLOW  If the file filled @a aBuffer and so may have
+ *                       been truncated; @a aLength is still set.
+ *  @retval  -errno      If the file could not be read.
+ *
+ */
+int
+strntoul_proc_read(int aDescriptor, char *aBuffer, size_t aSize, size_t *aLength)
+{
+    size_t lLength = 0;
+
+    if ((aBuffer == nullptr) || (aLength == nullptr) || (aSize == 0))
+    {
+        return (-EINVAL);
+    }
+
+    while (lLength < aSize)
+    {
+        const ssize_t lRead = pread(aDescriptor,
+                                    aBuffer + lLength,
+                                    aSize - lLength,
+                                    static_cast<off_t>(lLength));
+
+        if (lRead < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            return (-errno);
+        }
+        else if (lRead == 0)
+        {
+            break;
+        }
+
+        lLength += static_cast<size_t>(lRead);
+    }
+
+    *aLength = lLength;
+
+    return ((lLength == aSize) ? -EOVERFLOW : 0);
+}
+
+/**
+ *  @brief
+ *    Open, read, and close a procfs or sysfs file.
+ *
+ *  @param[in]   aPath    A pointer to the path of the file to read.
+ *  @param[out]  aBuffer  A pointer to the buffer to read into, which
+ *                        will not be null-terminated.
+ *  @param[in]   aSize    The size, in bytes, of @a aBuffer.
+ *  @param[out]  aLength  A pointer to storage for the number of bytes
+ *                        read.
+ *
+ *  @retval  0           If successful.
+ *  @retval  -EINVAL     If an argument was null or if @a aSize was
+ *                       zero.
+ *  @retval  -EOVERFLOW  If the file filled @a aBuffer and so may have
+ *                       been truncated; @a aLength is still set.
+ *  @retval  -errno      If the file could not be opened or read.
+ *
+ *  @sa strntoul_proc_read
+ *
+ */
+int
+strntoul_proc_read_path(const char *aPath, char *aBuffer, size_t aSize, size_t *aLength)
+{
+    int lDescriptor;
+    int lStatus;
+
+    if (aPath == nullptr)
+    {
+        return (-EINVAL);
+    }
+
+    lDescriptor = open(aPath, O_RDONLY | O_CLOEXEC);
+
+    if (lDescriptor < 0)
+    {
+        return (-errno);
+    }
+
+    lStatus = strntoul_proc_read(lDescriptor, aBuffer, aSize, aLength);
+
+    close(lDescriptor);
+
+    return (lStatus);
+}
+
+/**
+ *  @brief
+ *    Parse the contents of /proc/[pid]/stat.
+ *
+ *  @param[in]   aBuffer  A pointer to the contents, which need not be
+ *                        null-terminated.
+ *  @param[in]   aLength  The length, in bytes, of @a aBuffer.
+ *  @param[out]  aStat    A pointer to storage for the fields.
+ *
+ *  @retval  0        If successful.
+ *  @retval  -EINVAL  If an argument was null or if the contents were
+ *                    malformed or ended before rsslim.
+ *  @retval  -ERANGE  If a field was out of range.
+ *
+ */
+int
+strntoul_proc_parse_stat(const char *aBuffer, size_t aLength, strntoul_proc_stat_t *aStat)
+{
+    const int lSavedErrno = errno;
+    int       lStatus;
+
+    if ((aBuffer == nullptr) || (aStat == nullptr))
+    {
+        return (-EINVAL);
+    }
+
+    lStatus = ParseStat(aBuffer, aLength, *aStat);
+
+    errno = lSavedErrno;
+
+    return (lStatus);
+}
+
+/**
+ *  @brief
+ *    Parse the contents of /proc/meminfo.
+ *
+ *  Keys not represented in strntoul_proc_meminfo_t are skipped
+ *  without converting their values.
+ *
+ *  @param[in]   aBuffer   A pointer to the contents, which need not
+ *                         be null-terminated.
+ *  @param[in]   aLength   The length, in bytes, of @a aBuffer.
+ *  @param[out]  aMeminfo  A pointer to storage for the fields.
+ *
+ *  @retval  0        If successful.
+ *  @retval  -EINVAL  If an argument was null or if the contents were
+ *                    malformed.
+ *  @retval  -ERANGE  If a field was out of range.
+ *
+ */
+int
+strntoul_proc_parse_meminfo(const char *aBuffer, size_t aLength, strntoul_proc_meminfo_t *aMeminfo)
+{
+    const int lSavedErrno = errno;
+    int       lStatus;
+
+    if ((aBuffer == nullptr) || (aMeminfo == nullptr))
+    {
+        return (-EINVAL);
+    }
+
+    lStatus = ParseMeminfo(aBuffer, aLength, *aMeminfo);
+
+    errno = lSavedErrno;
+
+    return (lStatus);
+}
+
+/**
+ *  @brief
+ *    Parse the next mapping from the contents of /proc/[pid]/maps.
+ *
+ *  @param[in]      aBuffer  A pointer to the contents, which need not
+ *                           be null-terminated.
+ *  @param[in]      aLength  The length, in bytes, of @a aBuffer.
+ *  @param[in,out]  aOffset  A pointer to the offset of the next line
+ *                           in @a aBuffer, which should initially be
+ *                           zero and which is advanced past it.
+ *  @param[out]     aMap     A pointer to storage for the mapping,
+ *                           whose path refers into @a aBuffer.
+ *
+ *  @retval  1        If a mapping was parsed.
+ *  @retval  0        If there were no more mappings.
+ *  @retval  -EINVAL  If an argument was null or if the line was
+ *                    malformed.
+ *  @retval  -ERANGE  If a field was out of range.
+ *
+ */
+int
+strntoul_proc_maps_next(const char *aBuffer, size_t aLength, size_t *aOffset, strntoul_proc_map_t *aMap)
+{
+    const int    lSavedErrno = errno;
+    const char * p;
+    int          lStatus;
+
+    if ((aBuffer == nullptr) || (aOffset == nullptr) || (aMap == nullptr))
+    {
+        return (-EINVAL);
+    }
+
+    if (*aOffset >= aLength)
+    {
+        return (0);
+    }
+
+    p = aBuffer + *aOffset;
+
+    lStatus = ParseMap(p, aBuffer + aLength, *aMap);
+
+    if (lStatus == 0)
+    {
+        *aOffset = static_cast<size_t>(p - aBuffer);
+
+        lStatus = 1;
+    }
+
+    errno = lSavedErrno;
+
+    return (lStatus);
+}
+
+/**
+ *  @brief
+ *    Parse a single-valued sysfs or procfs counter.
+ *
+ *  The contents must be exactly one unsigned value in @a aBase,
+ *  optionally followed by a newline.
+ *
+ *  @param[in]   aBuffer  A pointer to the contents, which need not be
+ *                        null-terminated.
+ *  @param[in]   aLength  The length, in bytes, of @a aBuffer.
+ *  @param[in]   aBase    The base to use to interpret the value, as
+ *                        for strntoul.
+ *  @param[out]  aValue   A pointer to storage for the value.
+ *
+ *  @retval  0        If successful.
+ *  @retval  -EINVAL  If an argument was null, if @a aBase was
+ *                    unsupported, or if the contents were not a
+ *                    single value.
+ *  @retval  -ERANGE  If the value was out of range.
+ *
+ */
+int
+strntoul_proc_parse_counter(const char *aBuffer, size_t aLength, int aBase, unsigned long *aValue)
+{
+    const int    lSavedErrno = errno;
+    const char * p           = aBuffer;
+    const char * lLast;
+    int          lStatus;
+
+    if ((aBuffer == nullptr) || (aValue == nullptr) ||
+        ((aBase != 0) && ((aBase < 2) || (aBase > 36))))
+    {
+        return (-EINVAL);
+    }
+
+    if ((aLength > 0) && (aBuffer[aLength - 1] == '\n'))
+    {
+        aLength--;
+    }
+
+    lLast = aBuffer + aLength;
+
+    lStatus = ConvertUnsigned(p, lLast, aBase, *aValue);
+
+    if ((lStatus == 0) && (p != lLast))
+    {
+        lStatus = -EINVAL;
+    }
+
+    errno = lSavedErrno;
+
+    return (lStatus);
+}
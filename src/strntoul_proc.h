@@ -0,0 +1,141 @@
+/*
+ *    Copyright (c) 2024 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *    @file
+ *      This file defines interfaces for reading Linux procfs and sysfs
+ *      files into caller-owned, reusable buffers and for parsing their
+ *      common formats, in place, into fixed structures, without any
+ *      allocation or copying.
+ *
+ */
+
+#ifndef STRNTOUL_PROC_H
+#define STRNTOUL_PROC_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ *  The capacity, including a null terminator, of the command name in
+ *  strntoul_proc_stat_t. Longer names are truncated.
+ *
+ */
+#define STRNTOUL_PROC_COMM_MAX 64
+
+/**
+ *  The leading fields of /proc/[pid]/stat, as documented in proc(5).
+ *
+ */
+typedef struct strntoul_proc_stat
+{
+    long          pid;
+    char          comm[STRNTOUL_PROC_COMM_MAX];
+    char          state;
+    long          ppid;
+    long          pgrp;
+    long          session;
+    long          tty_nr;
+    long          tpgid;
+    unsigned long flags;
+    unsigned long minflt;
+    unsigned long cminflt;
+    unsigned long majflt;
+    unsigned long cmajflt;
+    unsigned long utime;
+    unsigned long stime;
+    long          cutime;
+    long          cstime;
+    long          priority;
+    long          nice;
+    long          num_threads;
+    long          itrealvalue;
+    unsigned long starttime;
+    unsigned long vsize;
+    long          rss;
+    unsigned long rsslim;
+    long          processor;     //!< -1 if not reported.
+} strntoul_proc_stat_t;
+
+/**
+ *  Commonly-used fields of /proc/meminfo, in kibibytes, except for the
+ *  huge page counts. Fields the kernel does not report are zero.
+ *
+ */
+typedef struct strntoul_proc_meminfo
+{
+    unsigned long mem_total;
+    unsigned long mem_free;
+    unsigned long mem_available;
+    unsigned long buffers;
+    unsigned long cached;
+    unsigned long swap_cached;
+    unsigned long active;
+    unsigned long inactive;
+    unsigned long swap_total;
+    unsigned long swap_free;
+    unsigned long dirty;
+    unsigned long writeback;
+    unsigned long anon_pages;
+    unsigned long mapped;
+    unsigned long shmem;
+    unsigned long slab;
+    unsigned long s_reclaimable;
+    unsigned long s_unreclaim;
+    unsigned long kernel_stack;
+    unsigned long page_tables;
+    unsigned long commit_limit;
+    unsigned long committed_as;
+    unsigned long huge_pages_total;
+    unsigned long huge_pages_free;
+    unsigned long hugepagesize;
+} strntoul_proc_meminfo_t;
+
+/**
+ *  One mapping from /proc/[pid]/maps.
+ *
+ */
+typedef struct strntoul_proc_map
+{
+    unsigned long start;
+    unsigned long end;
+    char          perms[5];      //!< For example, "r-xp".
+    unsigned long offset;
+    unsigned long major;
+    unsigned long minor;
+    unsigned long inode;
+    const char *  path;          //!< Within the parsed buffer and not
+                                 //!< null-terminated; may be empty.
+    size_t        path_length;
+} strntoul_proc_map_t;
+
+extern int strntoul_proc_read(int aDescriptor, char *aBuffer, size_t aSize, size_t *aLength);
+extern int strntoul_proc_read_path(const char *aPath, char *aBuffer, size_t aSize, size_t *aLength);
+extern int strntoul_proc_parse_stat(const char *aBuffer, size_t aLength, strntoul_proc_stat_t *aStat);
+extern int strntoul_proc_parse_meminfo(const char *aBuffer, size_t aLength, strntoul_proc_meminfo_t *aMeminfo);
+extern int strntoul_proc_maps_next(const char *aBuffer, size_t aLength, size_t *aOffset, strntoul_proc_map_t *aMap);
+extern int strntoul_proc_parse_counter(const char *aBuffer, size_t aLength, int aBase, unsigned long *aValue);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STRNTOUL_PROC_H */
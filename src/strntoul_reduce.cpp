@@ -0,0 +1,182 @@
+/*
+ *    Copyright (c) 2024 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *    @file
+ *      This file implements an interface for converting a delimited
+ *      buffer of unsigned long integers and reducing them to
+ *      aggregates in a single pass, without storing the values.
+ *
+ */
+
+#include "strntoul_reduce.h"
+
+#include <errno.h>
+#include <limits.h>
+#include <string.h>
+
+#include "strntoul-fields.h"
+
+/**
+ *  @brief
+ *    Convert a delimited buffer of unsigned long integers and reduce
+ *    them to aggregates.
+ *
+ *  This splits the @a aLength bytes at @a aBuffer into fields at each
+ *  @a aDelimiter, converts each non-empty field as strntoul would with
+ *  @a aBase, and folds the value into the reductions requested by @a
+ *  aOperations as it goes, such that no value is ever stored.
+ *
+ *  A field must consist of a value, optionally surrounded by white
+ *  space; any other non-empty field is counted as invalid and does
+ *  not contribute to the reductions.
+ *
+ *  On error, @a errno may be set as follows:
+ *
+ *    - ERANGE   At least one field was out of range. Such fields are
+ *               counted as invalid.
+ *
+ *  @param[in]      aBuffer      A pointer to the buffer to convert.
+ *  @param[in]      aLength      The number of bytes of @a aBuffer to
+ *                               process.
+ *  @param[in]      aDelimiter   The character separating fields.
+ *  @param[in]      aBase        The base to use to interpret each
+ *                               field, as for strntoul.
+ *  @param[in]      aOperations  The reductions to perform, as a
+ *                               bitwise OR of STRNTOUL_REDUCE_*
+ *                               values.
+ *  @param[in,out]  aResult      A pointer to the histogram
+ *                               configuration, if requested, and to
+ *                               storage for the results.
+ *
+ *  @retval  0        If successful.
+ *  @retval  -EINVAL  If @a aResult was null, if @a aBase or @a
+ *                    aOperations were unsupported, or if a
+ *                    histogram was requested with a zero bucket
+ *                    width.
+ *
+ *  @sa strntoul
+ *
+ */
+int
+strntoul_reduce(const char *aBuffer, size_t aLength, char aDelimiter, int aBase, unsigned int aOperations, strntoul_reduce_result_t *aResult)
+{
+    const bool    lWantSum       = ((aOperations & STRNTOUL_REDUCE_SUM) != 0);
+    const bool    lWantMinimum   = ((aOperations & STRNTOUL_REDUCE_MIN) != 0);
+    const bool    lWantMaximum   = ((aOperations & STRNTOUL_REDUCE_MAX) != 0);
+    const bool    lWantHistogram = ((aOperations & STRNTOUL_REDUCE_HISTOGRAM) != 0);
+    unsigned long lSum           = 0;
+    bool          lSumOverflowed = false;
+    unsigned long lMinimum       = ULONG_MAX;
+    unsigned long lMaximum       = 0;
+    size_t        lCount         = 0;
+    size_t        lInvalid       = 0;
+    bool          lOutOfRange    = false;
+    size_t        lHistogram[STRNTOUL_REDUCE_HISTOGRAM_BUCKETS];
+    unsigned long lOrigin;
+    unsigned long lWidth;
+    size_t        lOffset        = 0;
+
+    if ((aResult == nullptr) || ((aOperations & ~static_cast<unsigned int>(STRNTOUL_REDUCE_ALL)) != 0))
+    {
+        return (-EINVAL);
+    }
+
+    if ((aBase != 0) && ((aBase < 2) || (aBase > 36)))
+    {
+        return (-EINVAL);
+    }
+
+    lOrigin = aResult->mHistogramOrigin;
+    lWidth  = aResult->mHistogramWidth;
+
+    if (lWantHistogram && (lWidth == 0))
+    {
+        return (-EINVAL);
+    }
+
+    memset(lHistogram, 0, sizeof (lHistogram));
+
+    while (lOffset < aLength)
+    {
+        const char *  lField       = aBuffer + lOffset;
+        const void *  lDelimiter   = memchr(lField, aDelimiter, aLength - lOffset);
+        const size_t  lFieldLength = ((lDelimiter != nullptr) ?
+                                      static_cast<size_t>(static_cast<const char *>(lDelimiter) - lField) :
+                                      (aLength - lOffset));
+        unsigned long lValue;
+
+        lOffset += lFieldLength + 1;
+
+        if (lFieldLength == 0)
+        {
+            continue;
+        }
+
+        if (!StrNToUL::Fields::ConvertField(lField, lFieldLength, aBase, lValue, lOutOfRange))
+        {
+            lInvalid++;
+            continue;
+        }
+
+        lCount++;
+
+        if (lWantSum)
+        {
+            lSumOverflowed |= __builtin_add_overflow(lSum, lValue, &lSum);
+        }
+
+        if (lWantMinimum && (lValue < lMinimum))
+        {
+            lMinimum = lValue;
+        }
+
+        if (lWantMaximum && (lValue > lMaximum))
+        {
+            lMaximum = lValue;
+        }
+
+        if (lWantHistogram)
+        {
+            unsigned long lBucket = ((lValue < lOrigin) ? 0 : ((lValue - lOrigin) / lWidth));
+
+            if (lBucket >= STRNTOUL_REDUCE_HISTOGRAM_BUCKETS)
+            {
+                lBucket = STRNTOUL_REDUCE_HISTOGRAM_BUCKETS - 1;
+            }
+
+            lHistogram[lBucket]++;
+        }
+    }
+
+    aResult->mSum           = lSum;
+    aResult->mSumOverflowed = lSumOverflowed;
+    aResult->mMinimum       = lMinimum;
+    aResult->mMaximum       = lMaximum;
+    aResult->mCount         = lCount;
+    aResult->mInvalid       = lInvalid;
+
+    memcpy(aResult->mHistogram, lHistogram, sizeof (lHistogram));
+
+    if (lOutOfRange)
+    {
+        errno = ERANGE;
+    }
+
+    return (0);
+}
@@ -0,0 +1,100 @@
+/*
+ *    Copyright (c) 2024 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *    @file
+ *      This file defines an interface for converting a delimited
+ *      buffer of unsigned long integers and reducing them to
+ *      aggregates in a single pass, without storing the values.
+ *
+ */
+
+#ifndef STRNTOUL_REDUCE_H
+#define STRNTOUL_REDUCE_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ *  The reductions that may be requested of strntoul_reduce.
+ *
+ */
+enum
+{
+    STRNTOUL_REDUCE_SUM       = 0x01, //!< Sum, with overflow detection.
+    STRNTOUL_REDUCE_MIN       = 0x02, //!< Minimum.
+    STRNTOUL_REDUCE_MAX       = 0x04, //!< Maximum.
+    STRNTOUL_REDUCE_COUNT     = 0x08, //!< Count of valid values.
+    STRNTOUL_REDUCE_HISTOGRAM = 0x10, //!< Fixed-bucket histogram.
+
+    STRNTOUL_REDUCE_ALL       = (STRNTOUL_REDUCE_SUM   |
+                                 STRNTOUL_REDUCE_MIN   |
+                                 STRNTOUL_REDUCE_MAX   |
+                                 STRNTOUL_REDUCE_COUNT |
+                                 STRNTOUL_REDUCE_HISTOGRAM)
+};
+
+/**
+ *  The number of buckets in a strntoul_reduce histogram.
+ *
+ */
+#define STRNTOUL_REDUCE_HISTOGRAM_BUCKETS 16
+
+/**
+ *  The configuration for and results of strntoul_reduce.
+ *
+ *  Only those results whose reductions were requested are
+ *  meaningful.
+ *
+ */
+typedef struct strntoul_reduce_result
+{
+    unsigned long mHistogramOrigin;  //!< [in] The lower bound of the
+                                     //!< first histogram bucket.
+    unsigned long mHistogramWidth;   //!< [in] The width of each
+                                     //!< histogram bucket. Must be
+                                     //!< non-zero for a histogram.
+
+    unsigned long mSum;              //!< The sum of all valid values,
+                                     //!< modulo ULONG_MAX + 1.
+    int           mSumOverflowed;    //!< Non-zero if the sum overflowed.
+    unsigned long mMinimum;          //!< The smallest valid value, or
+                                     //!< ULONG_MAX if there were none.
+    unsigned long mMaximum;          //!< The largest valid value, or
+                                     //!< zero if there were none.
+    size_t        mCount;            //!< The number of valid values.
+    size_t        mInvalid;          //!< The number of non-empty fields
+                                     //!< that did not fully convert
+                                     //!< or were out of range.
+    size_t        mHistogram[STRNTOUL_REDUCE_HISTOGRAM_BUCKETS];
+                                     //!< The number of valid values in
+                                     //!< each bucket, with values
+                                     //!< outside the buckets counted
+                                     //!< in the first or last.
+} strntoul_reduce_result_t;
+
+extern int strntoul_reduce(const char *aBuffer, size_t aLength, char aDelimiter, int aBase, unsigned int aOperations, strntoul_reduce_result_t *aResult);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STRNTOUL_REDUCE_H */
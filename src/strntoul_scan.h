@@ -0,0 +1,752 @@
+/*
+ *    Copyright (c) 2024 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *    @file
+ *      This file defines a bounded, typed, sscanf-like scanner for
+ *      potentially non-null-terminated strings, whose format strings
+ *      may be compiled either at compile time, into a matcher
+ *      specialized for the format, or at run time.
+ *
+ *      A format consists of:
+ *
+ *        - Literal characters, which must match exactly.
+ *        - White space, which matches zero or more white space
+ *          characters.
+ *        - "%%", which matches a literal '%'.
+ *        - Conversions, each of which stores one value:
+ *
+ *            %u  An unsigned decimal value, as for strntoul.
+ *            %d  A signed decimal value, as for strntol.
+ *            %x  An unsigned hexadecimal value, as for strntoul.
+ *            %o  An unsigned octal value, as for strntoul.
+ *            %i  A signed value of any base, as for strntol.
+ *
+ *      For example:
+ *
+ *        unsigned int lTimestamp, lLatency, lCode;
+ *
+ *        lFields = StrNToUL::Scan::Scan(STRNTOUL_SCAN_FORMAT("ts=%u lat=%u code=%x"),
+ *                                       lLine, lLength, &lEnd,
+ *                                       &lTimestamp, &lLatency, &lCode);
+ *
+ *      Each value must fit its output, which may be of any integral
+ *      type; one that does not ends the scan as a mismatch would.
+ *
+ *      Since formats are compiled by constexpr functions with loops,
+ *      this requires C++14 or later.
+ *
+ */
+
+#ifndef STRNTOUL_SCAN_H
+#define STRNTOUL_SCAN_H
+
+#if !defined(__cplusplus) || (__cplusplus < 201402L)
+#error "strntoul_scan.h requires C++14 or later."
+#endif
+
+#include <limits>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include <errno.h>
+#include <limits.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "strntol.h"
+#include "strntoul.h"
+
+/**
+ *  Compile @a aFormat, which must be a string literal, at compile time
+ *  into a format for StrNToUL::Scan::Scan. An invalid format fails to
+ *  compile.
+ *
+ */
+#define STRNTOUL_SCAN_FORMAT(aFormat)                                     \
+    ([]() {                                                               \
+        struct Literal                                                    \
+        {                                                                 \
+            static constexpr const char *Value(void) { return (aFormat); } \
+        };                                                                \
+        return StrNToUL::Scan::Format<Literal>();                         \
+    }())
+
+namespace StrNToUL
+{
+
+namespace Scan
+{
+
+/**
+ *  The kinds of format directives.
+ *
+ */
+enum class Kind : uint8_t
+{
+    kLiteral,       //!< Characters that must match exactly.
+    kSpace,         //!< Zero or more white space characters.
+    kUnsigned,      //!< %u
+    kSigned,        //!< %d
+    kHexadecimal,   //!< %x
+    kOctal,         //!< %o
+    kInteger        //!< %i
+};
+
+/**
+ *  A single compiled format directive.
+ *
+ */
+struct Directive
+{
+    Kind   mKind;   //!< The kind of the directive.
+    size_t mOffset; //!< For a literal, its offset in the format.
+    size_t mLength; //!< For a literal, its length.
+};
+
+namespace Detail
+{
+
+constexpr bool
+IsSpace(const char &aCharacter)
+{
+    return ((aCharacter == ' ')  || (aCharacter == '\t') || (aCharacter == '\n') ||
+            (aCharacter == '\r') || (aCharacter == '\f') || (aCharacter == '\v'));
+}
+
+constexpr bool
+IsField(const Kind &aKind)
+{
+    return (aKind >= Kind::kUnsigned);
+}
+
+constexpr size_t
+Length(const char *aFormat)
+{
+    size_t lRetval = 0;
+
+    while (aFormat[lRetval] != '\0')
+    {
+        lRetval++;
+    }
+
+    return (lRetval);
+}
+
+/**
+ *  Compile the directive at @a aOffset of @a aFormat, advancing @a
+ *  aOffset past it.
+ *
+ *  @returns
+ *    True if the directive was valid; otherwise, false.
+ *
+ */
+constexpr bool
+Next(const char *aFormat, const size_t &aLength, size_t &aOffset, Directive &aDirective)
+{
+    if (IsSpace(aFormat[aOffset]))
+    {
+        aDirective = Directive{ Kind::kSpace, aOffset, 0 };
+
+        while ((aOffset < aLength) && IsSpace(aFormat[aOffset]))
+        {
+            aOffset++;
+        }
+    }
+    else if (aFormat[aOffset] == '%')
+    {
+        if ((aOffset + 1) == aLength)
+        {
+            return (false);
+        }
+
+        switch (aFormat[aOffset + 1])
+        {
+
+        case '%':
+            aDirective = Directive{ Kind::kLiteral, aOffset + 1, 1 };
+            break;
+
+        case 'u':
+            aDirective = Directive{ Kind::kUnsigned, aOffset, 0 };
+            break;
+
+        case 'd':
+            aDirective = Directive{ Kind::kSigned, aOffset, 0 };
+            break;
+
+        case 'x':
+            aDirective = Directive{ Kind::kHexadecimal, aOffset, 0 };
+            break;
+
+        case 'o':
+            aDirective = Directive{ Kind::kOctal, aOffset, 0 };
+            break;
+
+        case 'i':
+            aDirective = Directive{ Kind::kInteger, aOffset, 0 };
+            break;
+
+        default:
+            return (false);
+
+        }
+
+        aOffset += 2;
+    }
+    else
+    {
+        const size_t lStart = aOffset;
+
+        while ((aOffset < aLength) && (aFormat[aOffset] != '%') && !IsSpace(aFormat[aOffset]))
+        {
+            aOffset++;
+        }
+
+        aDirective = Directive{ Kind::kLiteral, lStart, aOffset - lStart };
+    }
+
+    return (true);
+}
+
+/**
+ *  Count the directives of @a aFormat, or the fields among them if @a
+ *  aFieldsOnly.
+ *
+ *  @returns
+ *    The count, or SIZE_MAX if the format was invalid.
+ *
+ */
+constexpr size_t
+Count(const char *aFormat, const size_t &aLength, const bool &aFieldsOnly)
+{
+    Directive lDirective{ Kind::kLiteral, 0, 0 };
+    size_t    lOffset = 0;
+    size_t    lRetval = 0;
+
+    while (lOffset < aLength)
+    {
+        if (!Next(aFormat, aLength, lOffset, lDirective))
+        {
+            return (SIZE_MAX);
+        }
+
+        lRetval += ((!aFieldsOnly || IsField(lDirective.mKind)) ? 1 : 0);
+    }
+
+    return (lRetval);
+}
+
+constexpr Directive
+At(const char *aFormat, const size_t &aLength, const size_t &aIndex)
+{
+    Directive lDirective{ Kind::kLiteral, 0, 0 };
+    size_t    lOffset = 0;
+
+    for (size_t i = 0; i <= aIndex; i++)
+    {
+        Next(aFormat, aLength, lOffset, lDirective);
+    }
+
+    return (lDirective);
+}
+
+/**
+ *  Match a literal or white space directive at @a aCursor, advancing
+ *  it past the match.
+ *
+ */
+inline bool
+Match(const Directive &aDirective, const char *aFormat, const char *&aCursor, const char *aLimit)
+{
+    if (aDirective.mKind == Kind::kSpace)
+    {
+        while ((aCursor < aLimit) && IsSpace(*aCursor))
+        {
+            aCursor++;
+        }
+    }
+    else
+    {
+        if ((static_cast<size_t>(aLimit - aCursor) < aDirective.mLength) ||
+            (memcmp(aCursor, aFormat + aDirective.mOffset, aDirective.mLength) != 0))
+        {
+            return (false);
+        }
+
+        aCursor += aDirective.mLength;
+    }
+
+    return (true);
+}
+
+template <typename T>
+inline bool
+Store(const unsigned long &aValue, T &aOutput)
+{
+    typedef typename std::make_unsigned<T>::type Unsigned;
+
+    if (aValue > static_cast<Unsigned>(std::numeric_limits<T>::max()))
+    {
+        return (false);
+    }
+
+    aOutput = static_cast<T>(aValue);
+
+    return (true);
+}
+
+template <typename T>
+inline bool
+Store(const long &aValue, T &aOutput)
+{
+    if (std::is_unsigned<T>::value)
+    {
+        if ((aValue < 0) || (static_cast<unsigned long>(aValue) > static_cast<unsigned long>(std::numeric_limits<T>::max())))
+        {
+            return (false);
+        }
+    }
+    else if ((aValue < static_cast<long>(std::numeric_limits<T>::min())) ||
+             (aValue > static_cast<long>(std::numeric_limits<T>::max())))
+    {
+        return (false);
+    }
+
+    aOutput = static_cast<T>(aValue);
+
+    return (true);
+}
+
+inline unsigned int
+DigitValue(const char &aCharacter)
+{
+    const unsigned int lCharacter = static_cast<unsigned char>(aCharacter);
+
+    if ((lCharacter - '0') <= 9)
+    {
+        return (lCharacter - '0');
+    }
+    else if (((lCharacter | 0x20) - 'a') <= ('z' - 'a'))
+    {
+        return ((lCharacter | 0x20) - 'a' + 10);
+    }
+
+    return (UINT_MAX);
+}
+
+/**
+ *  Convert a run of digits starting right at @a aCursor, short enough
+ *  that it cannot overflow, without any of the set up of a full
+ *  conversion. This is the overwhelmingly common case for log fields.
+ *
+ *  @returns
+ *    True if the run was converted; otherwise, false, if the field
+ *    does not start with a digit, may have a prefix, or is too long,
+ *    and must be fully converted instead.
+ *
+ */
+inline bool
+ConvertShort(const unsigned int &aBase, const char *aCursor, const char *aLimit, unsigned long &aValue, const char *&aEnd)
+{
+    const size_t  lSafeDigits = ((aBase == 10) ? std::numeric_limits<long>::digits10 :
+                                 static_cast<size_t>(std::numeric_limits<unsigned long>::digits) / ((aBase == 16) ? 4 : 3));
+    const char *  p           = aCursor;
+    unsigned long lValue      = 0;
+    unsigned int  lDigit;
+
+    while ((p < aLimit) && ((lDigit = DigitValue(*p)) < aBase))
+    {
+        if (static_cast<size_t>(p - aCursor) == lSafeDigits)
+        {
+            return (false);
+        }
+
+        lValue = (lValue * aBase) + lDigit;
+        p++;
+    }
+
+    if ((p == aCursor) ||
+        ((aBase == 16) && (p == (aCursor + 1)) && (*aCursor == '0') && (p < aLimit) && ((*p | 0x20) == 'x')))
+    {
+        return (false);
+    }
+
+    aValue = lValue;
+    aEnd   = p;
+
+    return (true);
+}
+
+/**
+ *  Convert the field at @a aCursor per @a aKind into @a aOutput,
+ *  advancing @a aCursor past it.
+ *
+ *  @returns
+ *    True if a value was converted, in range both for the conversion
+ *    and for @a aOutput; otherwise, false.
+ *
+ */
+template <typename T>
+inline bool
+Convert(const Kind &aKind, const char *&aCursor, const char *aLimit, T &aOutput)
+{
+    const size_t  lLength     = static_cast<size_t>(aLimit - aCursor);
+    int           lSavedErrno;
+    const char *  lShortEnd;
+    unsigned long lShort;
+    char *        lEnd;
+    bool          lRetval;
+
+    if (aKind == Kind::kSigned)
+    {
+        const bool lNegative = ((aCursor < aLimit) && (*aCursor == '-'));
+
+        if (ConvertShort(10, aCursor + lNegative, aLimit, lShort, lShortEnd))
+        {
+            const long lValue = (lNegative ? -static_cast<long>(lShort) : static_cast<long>(lShort));
+
+            lRetval = Store(lValue, aOutput);
+
+            aCursor = (lRetval ? lShortEnd : aCursor);
+
+            return (lRetval);
+        }
+    }
+    else if (aKind != Kind::kInteger)
+    {
+        const unsigned int lBase = ((aKind == Kind::kUnsigned) ? 10 : ((aKind == Kind::kHexadecimal) ? 16 : 8));
+
+        if (ConvertShort(lBase, aCursor, aLimit, lShort, lShortEnd))
+        {
+            lRetval = Store(lShort, aOutput);
+
+            aCursor = (lRetval ? lShortEnd : aCursor);
+
+            return (lRetval);
+        }
+    }
+
+    lSavedErrno = errno;
+
+    errno = 0;
+
+    if ((aKind == Kind::kSigned) || (aKind == Kind::kInteger))
+    {
+        const long lValue = strntol(aCursor, lLength, &lEnd, ((aKind == Kind::kSigned) ? 10 : 0));
+
+        lRetval = ((lEnd != aCursor) && (errno != ERANGE) && Store(lValue, aOutput));
+    }
+    else
+    {
+        const int           lBase  = ((aKind == Kind::kUnsigned) ? 10 : ((aKind == Kind::kHexadecimal) ? 16 : 8));
+        const unsigned long lValue = strntoul(aCursor, lLength, &lEnd, lBase);
+
+        lRetval = ((lEnd != aCursor) && (errno != ERANGE) && Store(lValue, aOutput));
+    }
+
+    errno = lSavedErrno;
+
+    if (lRetval)
+    {
+        aCursor = lEnd;
+    }
+
+    return (lRetval);
+}
+
+/**
+ *  A type-erased output, for formats whose fields are only known at
+ *  run time.
+ *
+ */
+struct Output
+{
+    void * mOutput;
+    bool (*mConvert)(const Kind &aKind, const char *&aCursor, const char *aLimit, void *aOutput);
+};
+
+template <typename T>
+inline bool
+ConvertErased(const Kind &aKind, const char *&aCursor, const char *aLimit, void *aOutput)
+{
+    return (Convert(aKind, aCursor, aLimit, *static_cast<T *>(aOutput)));
+}
+
+template <typename T>
+inline Output
+Erase(T *aOutput)
+{
+    return (Output{ aOutput, &ConvertErased<T> });
+}
+
+template <typename... Ts>
+struct AreIntegral;
+
+template <>
+struct AreIntegral<> : std::true_type { };
+
+template <typename T, typename... Ts>
+struct AreIntegral<T, Ts...> :
+    std::integral_constant<bool, std::is_integral<T>::value && !std::is_same<T, bool>::value && AreIntegral<Ts...>::value> { };
+
+/**
+ *  The matcher for a compile-time format, unrolled into one step per
+ *  directive, where @a I is the index of the directive and @a F that
+ *  of its field, if any.
+ *
+ */
+template <typename Format, size_t I, size_t F, size_t N = Format::Directives()>
+struct Step
+{
+    template <typename Outputs>
+    static int Run(const char *&aCursor, const char *aLimit, Outputs &aOutputs)
+    {
+        return (Run(aCursor, aLimit, aOutputs, std::integral_constant<bool, IsField(Format::At(I).mKind)>()));
+    }
+
+    template <typename Outputs>
+    static int Run(const char *&aCursor, const char *aLimit, Outputs &aOutputs, std::false_type)
+    {
+        static constexpr Directive kDirective = Format::At(I);
+
+        if (!Match(kDirective, Format::String(), aCursor, aLimit))
+        {
+            return (F);
+        }
+
+        return (Step<Format, I + 1, F>::Run(aCursor, aLimit, aOutputs));
+    }
+
+    template <typename Outputs>
+    static int Run(const char *&aCursor, const char *aLimit, Outputs &aOutputs, std::true_type)
+    {
+        static constexpr Directive kDirective = Format::At(I);
+
+        if (!Convert(kDirective.mKind, aCursor, aLimit, *std::get<F>(aOutputs)))
+        {
+            return (F);
+        }
+
+        return (Step<Format, I + 1, F + 1>::Run(aCursor, aLimit, aOutputs));
+    }
+};
+
+template <typename Format, size_t F, size_t N>
+struct Step<Format, N, F, N>
+{
+    template <typename Outputs>
+    static int Run(const char *&, const char *, Outputs &)
+    {
+        return (F);
+    }
+};
+
+}; // namespace Detail
+
+/**
+ *  A format compiled at compile time from the string literal returned
+ *  by @a Literal::Value. Create with STRNTOUL_SCAN_FORMAT.
+ *
+ */
+template <typename Literal>
+struct Format
+{
+    static constexpr const char *String(void) { return (Literal::Value()); }
+    static constexpr size_t Length(void) { return (Detail::Length(String())); }
+    static constexpr size_t Directives(void) { return (Detail::Count(String(), Length(), false)); }
+    static constexpr size_t Fields(void) { return (Detail::Count(String(), Length(), true)); }
+    static constexpr Directive At(size_t aIndex) { return (Detail::At(String(), Length(), aIndex)); }
+};
+
+/**
+ *  A format compiled at run time, for example from configuration.
+ *
+ */
+class RuntimeFormat
+{
+public:
+    /**
+     *  @brief
+     *    Compile a format.
+     *
+     *  @param[in]  aFormat  A pointer to the format to compile, which
+     *                       is copied.
+     *  @param[in]  aLength  The length, in bytes, of @a aFormat.
+     *
+     *  @retval  0        If successful.
+     *  @retval  -EINVAL  If the format was invalid.
+     *
+     */
+    int Init(const char *aFormat, size_t aLength)
+    {
+        Directive lDirective{ Kind::kLiteral, 0, 0 };
+        size_t    lOffset = 0;
+
+        mFormat.assign(aFormat, aLength);
+        mDirectives.clear();
+        mFields = 0;
+
+        while (lOffset < aLength)
+        {
+            if (!Detail::Next(mFormat.data(), aLength, lOffset, lDirective))
+            {
+                mDirectives.clear();
+                return (-EINVAL);
+            }
+
+            mFields += (Detail::IsField(lDirective.mKind) ? 1 : 0);
+
+            mDirectives.push_back(lDirective);
+        }
+
+        return (0);
+    }
+
+    /**
+     *  @brief
+     *    Return the number of fields, and so outputs, of the format.
+     *
+     */
+    size_t Fields(void) const { return (mFields); }
+
+    /**
+     *  Scan with outputs erased to @a aOutputs, of which there must be
+     *  Fields().
+     *
+     */
+    int Run(const char *&aCursor, const char *aLimit, const Detail::Output *aOutputs) const
+    {
+        int lRetval = 0;
+
+        for (const Directive &lDirective : mDirectives)
+        {
+            if (Detail::IsField(lDirective.mKind))
+            {
+                if (!aOutputs[lRetval].mConvert(lDirective.mKind, aCursor, aLimit, aOutputs[lRetval].mOutput))
+                {
+                    break;
+                }
+
+                lRetval++;
+            }
+            else if (!Detail::Match(lDirective, mFormat.data(), aCursor, aLimit))
+            {
+                break;
+            }
+        }
+
+        return (lRetval);
+    }
+
+private:
+    std::string            mFormat;
+    std::vector<Directive> mDirectives;
+    size_t                 mFields = 0;
+};
+
+/**
+ *  @brief
+ *    Scan a bounded string against a compile-time format.
+ *
+ *  This matches the format's directives against @a aString in order,
+ *  converting each field into the next of @a aOutputs, and stops at
+ *  the first mismatch or at @a aLength, never reading beyond it.
+ *
+ *  The number and types of @a aOutputs are checked at compile time.
+ *  Unlike strntoul, this never modifies errno.
+ *
+ *  @param[in]   aFormat   The compiled format.
+ *  @param[in]   aString   A pointer to the string to scan.
+ *  @param[in]   aLength   The maximum number of characters, in bytes,
+ *                         of @a aString to process.
+ *  @param[out]  aEnd      An optional pointer to storage for the
+ *                         character following the last one matched.
+ *  @param[out]  aOutputs  Pointers to storage for each field.
+ *
+ *  @returns
+ *    The number of fields converted and stored.
+ *
+ */
+template <typename Literal, typename... Ts>
+inline int
+Scan(const Format<Literal> &aFormat __attribute__((unused)), const char *aString, size_t aLength, char **aEnd, Ts *... aOutputs)
+{
+    static_assert(Format<Literal>::Fields() != SIZE_MAX, "invalid scan format");
+    static_assert(sizeof...(Ts) == Format<Literal>::Fields(), "scan outputs do not match the format fields");
+    static_assert(Detail::AreIntegral<Ts...>::value, "scan outputs must be integral");
+
+    std::tuple<Ts *...> lOutputs(aOutputs...);
+    const char *        lCursor = aString;
+    int                 lRetval;
+
+    lRetval = Detail::Step<Format<Literal>, 0, 0>::Run(lCursor, aString + aLength, lOutputs);
+
+    if (aEnd != nullptr)
+    {
+        *aEnd = const_cast<char *>(lCursor);
+    }
+
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    Scan a bounded string against a run-time format.
+ *
+ *  This behaves as the compile-time variant, except that the number of
+ *  @a aOutputs is checked at run time.
+ *
+ *  @returns
+ *    The number of fields converted and stored, or -EINVAL if the
+ *    number of @a aOutputs did not match the format.
+ *
+ */
+template <typename... Ts>
+inline int
+Scan(const RuntimeFormat &aFormat, const char *aString, size_t aLength, char **aEnd, Ts *... aOutputs)
+{
+    static_assert(Detail::AreIntegral<Ts...>::value, "scan outputs must be integral");
+
+    const Detail::Output lOutputs[sizeof...(Ts) + 1] = { Detail::Erase(aOutputs)..., Detail::Output{ nullptr, nullptr } };
+    const char *         lCursor = aString;
+    int                  lRetval;
+
+    if (sizeof...(Ts) != aFormat.Fields())
+    {
+        return (-EINVAL);
+    }
+
+    lRetval = aFormat.Run(lCursor, aString + aLength, lOutputs);
+
+    if (aEnd != nullptr)
+    {
+        *aEnd = const_cast<char *>(lCursor);
+    }
+
+    return (lRetval);
+}
+
+}; // namespace Scan
+
+}; // namespace StrNToUL
+
+#endif /* STRNTOUL_SCAN_H */
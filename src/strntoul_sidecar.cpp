@@ -0,0 +1,875 @@
+/*
+ *    Copyright (c) 2024 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *    @file
+ *      This file implements interfaces for building and reading compact,
+ *      memory-mappable binary "sidecar" caches of the integer columns
+ *      of a delimited text file.
+ *
+ *      A sidecar consists of a fixed header, recording the size,
+ *      modification time, and FNV-1a hash of the source it was built
+ *      from, followed by a table of column descriptors and then the
+ *      column data, each column starting on an eight-byte boundary.
+ *      All fields are in host byte order; a byte order marker in the
+ *      header rejects sidecars built on a host of the other order.
+ *
+ */
+
+#include "strntoul_sidecar.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <string>
+#include <vector>
+
+#include "strntoll.h"
+
+namespace
+{
+
+const char     kMagic[8]   = { 's', 't', 'r', 'n', 't', 'o', 'u', 'l' };
+const uint32_t kVersion    = 1;
+const uint32_t kByteOrder  = 0x01020304;
+const uint64_t kHashOffset = 0xcbf29ce484222325ULL;
+const uint64_t kHashPrime  = 0x00000100000001b3ULL;
+
+struct Header
+{
+    char     mMagic[8];
+    uint32_t mVersion;
+    uint32_t mByteOrder;
+    uint32_t mEncoding;
+    uint32_t mColumns;
+    uint64_t mRows;
+    uint64_t mSourceSize;
+    int64_t  mSourceSeconds;
+    int64_t  mSourceNanoseconds;
+    uint64_t mSourceHash;
+};
+
+struct Column
+{
+    uint64_t mOffset;
+    uint64_t mLength;
+};
+
+/**
+ *  A read-only mapping of an entire file.
+ *
+ */
+struct Mapping
+{
+    Mapping(void) : mData(nullptr), mSize(0) { return; }
+    ~Mapping(void) { if (mData != nullptr) { munmap(mData, mSize); } }
+
+    void * mData;
+    size_t mSize;
+};
+
+}; // namespace
+
+struct strntoul_sidecar
+{
+    void *         mData;
+    size_t         mSize;
+    const Header * mHeader;
+    const Column * mColumns;
+};
+
+static int
+Map(const int &aDescriptor, const size_t &aSize, Mapping &aMapping)
+{
+    if (aSize == 0)
+    {
+        return (0);
+    }
+
+    aMapping.mData = mmap(nullptr, aSize, PROT_READ, MAP_PRIVATE, aDescriptor, 0);
+
+    if (aMapping.mData == MAP_FAILED)
+    {
+        aMapping.mData = nullptr;
+
+        return (-errno);
+    }
+
+    aMapping.mSize = aSize;
+
+    return (0);
+}
+
+static void
+ModificationTime(const struct stat &aStat, int64_t &aSeconds, int64_t &aNanoseconds)
+{
+#if defined(__APPLE__)
+    aSeconds     = aStat.st_mtimespec.tv_sec;
+    aNanoseconds = aStat.st_mtimespec.tv_nsec;
+#else
+    aSeconds     = aStat.st_mtim.tv_sec;
+    aNanoseconds = aStat.st_mtim.tv_nsec;
+#endif
+}
+
+static uint64_t
+Hash(const void *aData, const size_t &aSize)
+{
+    const uint8_t * p       = static_cast<const uint8_t *>(aData);
+    uint64_t        lRetval = kHashOffset;
+
+    for (size_t i = 0; i < aSize; i++)
+    {
+        lRetval ^= p[i];
+        lRetval *= kHashPrime;
+    }
+
+    return (lRetval);
+}
+
+/**
+ *  Convert the source into columns. The first non-empty line
+ *  establishes the number of columns; fields missing from, or not
+ *  convertible in, subsequent lines are stored as zero and any extra
+ *  fields are ignored.
+ *
+ */
+static void
+Parse(const char *aBuffer, const size_t &aLength, const char &aDelimiter, const int &aBase, std::vector<std::vector<int64_t> > &aColumns)
+{
+    const int lSavedErrno = errno;
+    size_t    lOffset     = 0;
+
+    while (lOffset < aLength)
+    {
+        const char *   lLine       = aBuffer + lOffset;
+        const void *   lNewline    = memchr(lLine, '\n', aLength - lOffset);
+        const size_t   lLineLength = ((lNewline != nullptr) ?
+                                      static_cast<size_t>(static_cast<const char *>(lNewline) - lLine) :
+                                      (aLength - lOffset));
+        size_t         lFieldOffset = 0;
+        size_t         lColumn      = 0;
+
+        lOffset += lLineLength + 1;
+
+        if ((lLineLength == 0) || ((lLineLength == 1) && (lLine[0] == '\r')))
+        {
+            continue;
+        }
+
+        if (aColumns.empty())
+        {
+            size_t lFields = 1;
+
+            for (size_t i = 0; i < lLineLength; i++)
+            {
+                lFields += (lLine[i] == aDelimiter);
+            }
+
+            aColumns.resize(lFields);
+        }
+
+        while ((lColumn < aColumns.size()) && (lFieldOffset <= lLineLength))
+        {
+            const char *   lField       = lLine + lFieldOffset;
+            const void *   lDelimiter   = memchr(lField, aDelimiter, lLineLength - lFieldOffset);
+            const size_t   lFieldLength = ((lDelimiter != nullptr) ?
+                                           static_cast<size_t>(static_cast<const char *>(lDelimiter) - lField) :
+                                           (lLineLength - lFieldOffset));
+            char *         lEnd;
+            long long      lValue;
+
+            lValue = strntoll(lField, lFieldLength, &lEnd, aBase);
+
+            aColumns[lColumn++].push_back((lEnd == lField) ? 0 : static_cast<int64_t>(lValue));
+
+            lFieldOffset += lFieldLength + 1;
+        }
+
+        while (lColumn < aColumns.size())
+        {
+            aColumns[lColumn++].push_back(0);
+        }
+    }
+
+    errno = lSavedErrno;
+}
+
+static void
+Encode(const std::vector<int64_t> &aValues, const strntoul_sidecar_encoding_t &aEncoding, std::vector<uint8_t> &aData)
+{
+    if (aEncoding == STRNTOUL_SIDECAR_ENCODING_FIXED)
+    {
+        aData.resize(aValues.size() * sizeof (int64_t));
+
+        if (!aValues.empty())
+        {
+            memcpy(aData.data(), aValues.data(), aData.size());
+        }
+    }
+    else
+    {
+        uint64_t lPrevious = 0;
+
+        for (const int64_t &lValue : aValues)
+        {
+            const uint64_t lDelta  = static_cast<uint64_t>(lValue) - lPrevious;
+            uint64_t       lZigzag = ((lDelta << 1) ^ (0 - (lDelta >> 63)));
+
+            while (lZigzag >= 0x80)
+            {
+                aData.push_back(static_cast<uint8_t>(lZigzag | 0x80));
+
+                lZigzag >>= 7;
+            }
+
+            aData.push_back(static_cast<uint8_t>(lZigzag));
+
+            lPrevious = static_cast<uint64_t>(lValue);
+        }
+    }
+}
+
+static int
+WriteAll(const int &aDescriptor, const void *aData, size_t aSize)
+{
+    const uint8_t * p = static_cast<const uint8_t *>(aData);
+
+    while (aSize > 0)
+    {
+        const ssize_t lWritten = write(aDescriptor, p, aSize);
+
+        if (lWritten < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            return (-errno);
+        }
+
+        p     += lWritten;
+        aSize -= static_cast<size_t>(lWritten);
+    }
+
+    return (0);
+}
+
+/**
+ *  Synchronize the directory containing @a aPath, such that a rename
+ *  into it survives a crash.
+ *
+ */
+static int
+SyncDirectory(const std::string &aPath)
+{
+    const size_t lSlash = aPath.rfind('/');
+    std::string  lDirectory;
+    int          lDescriptor;
+    int          lRetval = 0;
+
+    if (lSlash == std::string::npos)
+    {
+        lDirectory = ".";
+    }
+    else if (lSlash == 0)
+    {
+        lDirectory = "/";
+    }
+    else
+    {
+        lDirectory = aPath.substr(0, lSlash);
+    }
+
+    lDescriptor = open(lDirectory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+
+    if (lDescriptor < 0)
+    {
+        return (-errno);
+    }
+
+    if (fsync(lDescriptor) != 0)
+    {
+        lRetval = -errno;
+    }
+
+    close(lDescriptor);
+
+    return (lRetval);
+}
+
+static int
+Write(const char *aSidecarPath, const Header &aHeader, const std::vector<std::vector<uint8_t> > &aData)
+{
+    std::string         lPath(aSidecarPath);
+    std::vector<Column> lColumns(aData.size());
+    uint64_t            lOffset;
+    int                 lDescriptor;
+    int                 lStatus;
+
+    lOffset = sizeof (Header) + (lColumns.size() * sizeof (Column));
+
+    for (size_t i = 0; i < lColumns.size(); i++)
+    {
+        lOffset = (lOffset + 7) & ~static_cast<uint64_t>(7);
+
+        lColumns[i].mOffset = lOffset;
+        lColumns[i].mLength = aData[i].size();
+
+        lOffset += lColumns[i].mLength;
+    }
+
+    // Write to a temporary file alongside the sidecar and rename it into
+    // place, such that a reader never observes a partial sidecar, and
+    // synchronize both, such that a crash leaves either the old or the
+    // new sidecar in place.
+
+    lPath += ".XXXXXX";
+
+    lDescriptor = mkstemp(&lPath[0]);
+
+    if (lDescriptor < 0)
+    {
+        return (-errno);
+    }
+
+    lStatus = WriteAll(lDescriptor, &aHeader, sizeof (aHeader));
+
+    if ((lStatus == 0) && !lColumns.empty())
+    {
+        lStatus = WriteAll(lDescriptor, lColumns.data(), lColumns.size() * sizeof (Column));
+    }
+
+    lOffset = sizeof (Header) + (lColumns.size() * sizeof (Column));
+
+    for (size_t i = 0; (lStatus == 0) && (i < lColumns.size()); i++)
+    {
+        static const uint8_t kPadding[8] = { 0 };
+
+        lStatus = WriteAll(lDescriptor, kPadding, static_cast<size_t>(lColumns[i].mOffset - lOffset));
+
+        if ((lStatus == 0) && !aData[i].empty())
+        {
+            lStatus = WriteAll(lDescriptor, aData[i].data(), aData[i].size());
+        }
+
+        lOffset = lColumns[i].mOffset + lColumns[i].mLength;
+    }
+
+    if ((lStatus == 0) && (fsync(lDescriptor) != 0))
+    {
+        lStatus = -errno;
+    }
+
+    if ((close(lDescriptor) != 0) && (lStatus == 0))
+    {
+        lStatus = -errno;
+    }
+
+    if ((lStatus == 0) && (rename(lPath.c_str(), aSidecarPath) != 0))
+    {
+        lStatus = -errno;
+    }
+
+    if (lStatus != 0)
+    {
+        unlink(lPath.c_str());
+
+        return (lStatus);
+    }
+
+    return (SyncDirectory(aSidecarPath));
+}
+
+/**
+ *  Determine whether the mapped sidecar is well-formed, such that every
+ *  column lies entirely within it.
+ *
+ */
+static bool
+IsValid(const void *aData, const size_t &aSize)
+{
+    const Header * lHeader = static_cast<const Header *>(aData);
+    const Column * lColumns;
+
+    if ((aSize < sizeof (Header))                         ||
+        (memcmp(lHeader->mMagic, kMagic, sizeof (kMagic)) != 0) ||
+        (lHeader->mVersion != kVersion)                   ||
+        (lHeader->mByteOrder != kByteOrder)               ||
+        (lHeader->mEncoding > STRNTOUL_SIDECAR_ENCODING_DELTA))
+    {
+        return (false);
+    }
+
+    if (lHeader->mColumns > ((aSize - sizeof (Header)) / sizeof (Column)))
+    {
+        return (false);
+    }
+
+    lColumns = reinterpret_cast<const Column *>(lHeader + 1);
+
+    for (uint32_t i = 0; i < lHeader->mColumns; i++)
+    {
+        if ((lColumns[i].mOffset > aSize) || (lColumns[i].mLength > (aSize - lColumns[i].mOffset)))
+        {
+            return (false);
+        }
+
+        if ((lHeader->mEncoding == STRNTOUL_SIDECAR_ENCODING_FIXED) &&
+            (((lColumns[i].mOffset % sizeof (int64_t)) != 0) ||
+             ((lColumns[i].mLength / sizeof (int64_t)) != lHeader->mRows) ||
+             ((lColumns[i].mLength % sizeof (int64_t)) != 0)))
+        {
+            return (false);
+        }
+    }
+
+    return (true);
+}
+
+/**
+ *  Determine whether the source is the one the sidecar was built from.
+ *
+ *  @retval  0        If the source is unchanged.
+ *  @retval  -ESTALE  If the source has changed.
+ *  @retval  -errno   If the source could not be examined.
+ *
+ */
+static int
+Validate(const Header &aHeader, const char *aSourcePath, const unsigned int &aFlags)
+{
+    struct stat lStat;
+    int64_t     lSeconds;
+    int64_t     lNanoseconds;
+    Mapping     lMapping;
+    int         lDescriptor;
+    int         lStatus;
+
+    lDescriptor = open(aSourcePath, O_RDONLY);
+
+    if (lDescriptor < 0)
+    {
+        return (-errno);
+    }
+
+    if (fstat(lDescriptor, &lStat) != 0)
+    {
+        lStatus = -errno;
+        goto done;
+    }
+
+    ModificationTime(lStat, lSeconds, lNanoseconds);
+
+    if ((static_cast<uint64_t>(lStat.st_size) != aHeader.mSourceSize) ||
+        (lSeconds != aHeader.mSourceSeconds)                          ||
+        (lNanoseconds != aHeader.mSourceNanoseconds))
+    {
+        lStatus = -ESTALE;
+        goto done;
+    }
+
+    if ((aFlags & STRNTOUL_SIDECAR_VERIFY_HASH) != 0)
+    {
+        lStatus = Map(lDescriptor, static_cast<size_t>(lStat.st_size), lMapping);
+
+        if (lStatus != 0)
+        {
+            goto done;
+        }
+
+        if (Hash(lMapping.mData, lMapping.mSize) != aHeader.mSourceHash)
+        {
+            lStatus = -ESTALE;
+            goto done;
+        }
+    }
+
+    lStatus = 0;
+
+ done:
+    close(lDescriptor);
+
+    return (lStatus);
+}
+
+/**
+ *  @brief
+ *    Build a sidecar of the integer columns of a delimited text file.
+ *
+ *  This converts each @a aDelimiter-separated field of each line of the
+ *  file at @a aSourcePath, as strntoll would with @a aBase, and writes
+ *  the resulting columns, encoded per @a aEncoding, to @a
+ *  aSidecarPath, atomically and durably replacing any existing
+ *  sidecar there.
+ *
+ *  The first non-empty line establishes the number of columns. Fields
+ *  missing from, or not convertible in, subsequent lines are stored as
+ *  zero and any extra fields are ignored.
+ *
+ *  Columns are signed 64-bit integers. As with strntoll, a field out
+ *  of their range, such as an unsigned value of 2^63 or more, is
+ *  stored as INT64_MAX or, if negative, INT64_MIN.
+ *
+ *  @param[in]  aSourcePath   A pointer to the path of the source.
+ *  @param[in]  aSidecarPath  A pointer to the path of the sidecar to
+ *                            build.
+ *  @param[in]  aDelimiter    The character separating fields.
+ *  @param[in]  aBase         The base to use to interpret each field,
+ *                            as for strntoll.
+ *  @param[in]  aEncoding     The encoding of the column data.
+ *
+ *  @retval  0        If successful.
+ *  @retval  -EINVAL  If a path was null or if @a aBase or @a aEncoding
+ *                    was unsupported.
+ *  @retval  -errno   If the source could not be read or the sidecar
+ *                    could not be written.
+ *
+ *  @sa strntoul_sidecar_open
+ *
+ */
+int
+strntoul_sidecar_build(const char *aSourcePath, const char *aSidecarPath, char aDelimiter, int aBase, strntoul_sidecar_encoding_t aEncoding)
+{
+    std::vector<std::vector<int64_t> > lColumns;
+    std::vector<std::vector<uint8_t> > lData;
+    Header                             lHeader;
+    struct stat                        lStat;
+    Mapping                            lMapping;
+    int                                lDescriptor;
+    int                                lStatus;
+
+    if ((aSourcePath == nullptr) || (aSidecarPath == nullptr))
+    {
+        return (-EINVAL);
+    }
+
+    if (((aBase != 0) && ((aBase < 2) || (aBase > 36))) ||
+        ((aEncoding != STRNTOUL_SIDECAR_ENCODING_FIXED) && (aEncoding != STRNTOUL_SIDECAR_ENCODING_DELTA)))
+    {
+        return (-EINVAL);
+    }
+
+    lDescriptor = open(aSourcePath, O_RDONLY);
+
+    if (lDescriptor < 0)
+    {
+        return (-errno);
+    }
+
+    if (fstat(lDescriptor, &lStat) != 0)
+    {
+        lStatus = -errno;
+    }
+    else
+    {
+        lStatus = Map(lDescriptor, static_cast<size_t>(lStat.st_size), lMapping);
+    }
+
+    close(lDescriptor);
+
+    if (lStatus != 0)
+    {
+        return (lStatus);
+    }
+
+    Parse(static_cast<const char *>(lMapping.mData), lMapping.mSize, aDelimiter, aBase, lColumns);
+
+    lData.resize(lColumns.size());
+
+    for (size_t i = 0; i < lColumns.size(); i++)
+    {
+        Encode(lColumns[i], aEncoding, lData[i]);
+    }
+
+    memset(&lHeader, 0, sizeof (lHeader));
+    memcpy(lHeader.mMagic, kMagic, sizeof (kMagic));
+
+    lHeader.mVersion    = kVersion;
+    lHeader.mByteOrder  = kByteOrder;
+    lHeader.mEncoding   = static_cast<uint32_t>(aEncoding);
+    lHeader.mColumns    = static_cast<uint32_t>(lColumns.size());
+    lHeader.mRows       = (lColumns.empty() ? 0 : lColumns[0].size());
+    lHeader.mSourceSize = static_cast<uint64_t>(lStat.st_size);
+    lHeader.mSourceHash = Hash(lMapping.mData, lMapping.mSize);
+
+    ModificationTime(lStat, lHeader.mSourceSeconds, lHeader.mSourceNanoseconds);
+
+    return (Write(aSidecarPath, lHeader, lData));
+}
+
+/**
+ *  @brief
+ *    Open and map a sidecar.
+ *
+ *  If @a aSourcePath is non-null, the source's size and modification
+ *  time, and, if @a aFlags includes STRNTOUL_SIDECAR_VERIFY_HASH, its
+ *  content hash, must match those recorded when the sidecar was built.
+ *
+ *  @param[in]   aSidecarPath  A pointer to the path of the sidecar.
+ *  @param[in]   aSourcePath   An optional pointer to the path of the
+ *                             source to validate the sidecar against.
+ *  @param[in]   aFlags        A bitwise OR of STRNTOUL_SIDECAR_*
+ *                             flags.
+ *  @param[out]  aSidecar      A pointer to storage for the open
+ *                             sidecar, which the caller must close
+ *                             with strntoul_sidecar_close.
+ *
+ *  @retval  0        If successful.
+ *  @retval  -EINVAL  If @a aSidecarPath or @a aSidecar was null or if
+ *                    the sidecar was malformed.
+ *  @retval  -ESTALE  If the source has changed since the sidecar was
+ *                    built.
+ *  @retval  -ENOMEM  If memory could not be allocated.
+ *  @retval  -errno   If the sidecar or the source could not be read.
+ *
+ *  @sa strntoul_sidecar_build
+ *  @sa strntoul_sidecar_close
+ *
+ */
+int
+strntoul_sidecar_open(const char *aSidecarPath, const char *aSourcePath, unsigned int aFlags, strntoul_sidecar_t **aSidecar)
+{
+    struct stat          lStat;
+    Mapping              lMapping;
+    strntoul_sidecar_t * lSidecar;
+    int                  lDescriptor;
+    int                  lStatus;
+
+    if ((aSidecarPath == nullptr) || (aSidecar == nullptr))
+    {
+        return (-EINVAL);
+    }
+
+    lDescriptor = open(aSidecarPath, O_RDONLY);
+
+    if (lDescriptor < 0)
+    {
+        return (-errno);
+    }
+
+    if (fstat(lDescriptor, &lStat) != 0)
+    {
+        lStatus = -errno;
+    }
+    else
+    {
+        lStatus = Map(lDescriptor, static_cast<size_t>(lStat.st_size), lMapping);
+    }
+
+    close(lDescriptor);
+
+    if (lStatus != 0)
+    {
+        return (lStatus);
+    }
+
+    if (!IsValid(lMapping.mData, lMapping.mSize))
+    {
+        return (-EINVAL);
+    }
+
+    if (aSourcePath != nullptr)
+    {
+        lStatus = Validate(*static_cast<const Header *>(lMapping.mData), aSourcePath, aFlags);
+
+        if (lStatus != 0)
+        {
+            return (lStatus);
+        }
+    }
+
+    lSidecar = static_cast<strntoul_sidecar_t *>(malloc(sizeof (strntoul_sidecar_t)));
+
+    if (lSidecar == nullptr)
+    {
+        return (-ENOMEM);
+    }
+
+    lSidecar->mData    = lMapping.mData;
+    lSidecar->mSize    = lMapping.mSize;
+    lSidecar->mHeader  = static_cast<const Header *>(lMapping.mData);
+    lSidecar->mColumns = reinterpret_cast<const Column *>(lSidecar->mHeader + 1);
+
+    lMapping.mData = nullptr;
+
+    *aSidecar = lSidecar;
+
+    return (0);
+}
+
+/**
+ *  @brief
+ *    Unmap and close a sidecar.
+ *
+ *  @param[in]  aSidecar  A pointer to the open sidecar to close. A null
+ *                        pointer is ignored.
+ *
+ */
+void
+strntoul_sidecar_close(strntoul_sidecar_t *aSidecar)
+{
+    if (aSidecar != nullptr)
+    {
+        munmap(aSidecar->mData, aSidecar->mSize);
+
+        free(aSidecar);
+    }
+}
+
+/**
+ *  @brief
+ *    Return the number of rows in a sidecar.
+ *
+ *  @param[in]  aSidecar  A pointer to the open sidecar.
+ *
+ */
+size_t
+strntoul_sidecar_rows(const strntoul_sidecar_t *aSidecar)
+{
+    return (static_cast<size_t>(aSidecar->mHeader->mRows));
+}
+
+/**
+ *  @brief
+ *    Return the number of columns in a sidecar.
+ *
+ *  @param[in]  aSidecar  A pointer to the open sidecar.
+ *
+ */
+size_t
+strntoul_sidecar_columns(const strntoul_sidecar_t *aSidecar)
+{
+    return (aSidecar->mHeader->mColumns);
+}
+
+/**
+ *  @brief
+ *    Return the encoding of the column data in a sidecar.
+ *
+ *  @param[in]  aSidecar  A pointer to the open sidecar.
+ *
+ */
+strntoul_sidecar_encoding_t
+strntoul_sidecar_encoding(const strntoul_sidecar_t *aSidecar)
+{
+    return (static_cast<strntoul_sidecar_encoding_t>(aSidecar->mHeader->mEncoding));
+}
+
+/**
+ *  @brief
+ *    Return the values of a column directly from the mapping.
+ *
+ *  @param[in]  aSidecar  A pointer to the open sidecar.
+ *  @param[in]  aColumn   The zero-based index of the column.
+ *
+ *  @returns
+ *    A pointer to the strntoul_sidecar_rows values of the column, valid
+ *    until the sidecar is closed, or null if the column does not exist
+ *    or the sidecar is not STRNTOUL_SIDECAR_ENCODING_FIXED, in which
+ *    case strntoul_sidecar_decode must be used instead.
+ *
+ *  @sa strntoul_sidecar_decode
+ *
+ */
+const int64_t *
+strntoul_sidecar_column(const strntoul_sidecar_t *aSidecar, size_t aColumn)
+{
+    if ((aColumn >= aSidecar->mHeader->mColumns) ||
+        (aSidecar->mHeader->mEncoding != STRNTOUL_SIDECAR_ENCODING_FIXED))
+    {
+        return (nullptr);
+    }
+
+    return (reinterpret_cast<const int64_t *>(static_cast<const uint8_t *>(aSidecar->mData) + aSidecar->mColumns[aColumn].mOffset));
+}
+
+/**
+ *  @brief
+ *    Decode the values of a column, in any encoding.
+ *
+ *  @param[in]   aSidecar  A pointer to the open sidecar.
+ *  @param[in]   aColumn   The zero-based index of the column.
+ *  @param[out]  aValues   A pointer to storage for at least @a aCount
+ *                         values.
+ *  @param[in]   aCount    The maximum number of values, from the first
+ *                         row on, to decode.
+ *
+ *  @retval  0        If successful.
+ *  @retval  -EINVAL  If the column does not exist or its data was
+ *                    malformed.
+ *
+ *  @sa strntoul_sidecar_column
+ *
+ */
+int
+strntoul_sidecar_decode(const strntoul_sidecar_t *aSidecar, size_t aColumn, int64_t *aValues, size_t aCount)
+{
+    const uint8_t * p;
+    const uint8_t * lLimit;
+    uint64_t        lPrevious = 0;
+
+    if (aColumn >= aSidecar->mHeader->mColumns)
+    {
+        return (-EINVAL);
+    }
+
+    if (aCount > aSidecar->mHeader->mRows)
+    {
+        aCount = static_cast<size_t>(aSidecar->mHeader->mRows);
+    }
+
+    p      = static_cast<const uint8_t *>(aSidecar->mData) + aSidecar->mColumns[aColumn].mOffset;
+    lLimit = p + aSidecar->mColumns[aColumn].mLength;
+
+    if (aSidecar->mHeader->mEncoding == STRNTOUL_SIDECAR_ENCODING_FIXED)
+    {
+        memcpy(aValues, p, aCount * sizeof (int64_t));
+
+        return (0);
+    }
+
+    for (size_t i = 0; i < aCount; i++)
+    {
+        uint64_t lZigzag = 0;
+        unsigned lShift  = 0;
+
+        do
+        {
+            if ((p == lLimit) || (lShift > 63))
+            {
+                return (-EINVAL);
+            }
+
+            lZigzag |= (static_cast<uint64_t>(*p & 0x7F) << lShift);
+            lShift  += 7;
+        } while ((*p++ & 0x80) != 0);
+
+        lPrevious += ((lZigzag >> 1) ^ (0 - (lZigzag & 1)));
+
+        aValues[i] = static_cast<int64_t>(lPrevious);
+    }
+
+    return (0);
+}
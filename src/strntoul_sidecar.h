@@ -0,0 +1,83 @@
+/*
+ *    Copyright (c) 2024 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *    @file
+ *      This file defines interfaces for building and reading compact,
+ *      memory-mappable binary "sidecar" caches of the integer columns
+ *      of a delimited text file, such that repeated scans of an
+ *      immutable file need only parse it once.
+ *
+ */
+
+#ifndef STRNTOUL_SIDECAR_H
+#define STRNTOUL_SIDECAR_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ *  The encodings of sidecar column data.
+ *
+ */
+typedef enum strntoul_sidecar_encoding
+{
+    STRNTOUL_SIDECAR_ENCODING_FIXED = 0, //!< Native 64-bit values,
+                                         //!< directly addressable
+                                         //!< in the mapping.
+    STRNTOUL_SIDECAR_ENCODING_DELTA = 1  //!< Zigzag-encoded deltas
+                                         //!< between successive
+                                         //!< values, as varints.
+} strntoul_sidecar_encoding_t;
+
+/**
+ *  Flags for strntoul_sidecar_open.
+ *
+ */
+enum
+{
+    STRNTOUL_SIDECAR_VERIFY_HASH = 0x01  //!< In addition to the source
+                                         //!< size and modification
+                                         //!< time, verify its content
+                                         //!< hash.
+};
+
+/**
+ *  An open, memory-mapped sidecar.
+ *
+ */
+typedef struct strntoul_sidecar strntoul_sidecar_t;
+
+extern int strntoul_sidecar_build(const char *aSourcePath, const char *aSidecarPath, char aDelimiter, int aBase, strntoul_sidecar_encoding_t aEncoding);
+extern int strntoul_sidecar_open(const char *aSidecarPath, const char *aSourcePath, unsigned int aFlags, strntoul_sidecar_t **aSidecar);
+extern void strntoul_sidecar_close(strntoul_sidecar_t *aSidecar);
+extern size_t strntoul_sidecar_rows(const strntoul_sidecar_t *aSidecar);
+extern size_t strntoul_sidecar_columns(const strntoul_sidecar_t *aSidecar);
+extern strntoul_sidecar_encoding_t strntoul_sidecar_encoding(const strntoul_sidecar_t *aSidecar);
+extern const int64_t *strntoul_sidecar_column(const strntoul_sidecar_t *aSidecar, size_t aColumn);
+extern int strntoul_sidecar_decode(const strntoul_sidecar_t *aSidecar, size_t aColumn, int64_t *aValues, size_t aCount);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STRNTOUL_SIDECAR_H */
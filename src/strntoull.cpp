@@ -0,0 +1,62 @@
+/*
+ *    Copyright (c) 2024 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *    @file
+ *      This file implements a "missing" C99 interface for strntoull
+ *      which adds a length parameter to the standard strtoull.
+ *
+ */
+
+#include "strntoull.h"
+
+#include "strntoul/strntoul-core.h"
+
+/**
+ *  @brief
+ *    Convert a string to an unsigned long long integer.
+ *
+ *  This function is identical to strntoul, except that the result is
+ *  an unsigned long long, which is at least 64 bits wide on every
+ *  target, including those on which unsigned long is 32 bits wide.
+ *
+ *  @param[in]   aString  A pointer to the string to convert.
+ *  @param[in]   aLength  The maximum number of characters, in bytes,
+ *                        of @a aString to process.
+ *  @param[out]  aEnd     A pointer to storage for the first invalid
+ *                        or the last valid character in @a aString.
+ *  @param[in]   aBase    The base to use to interpret @a aString for
+ *                        the conversion in the range 2 to 36,
+ *                        inclusive.
+ *
+ *  @returns
+ *    Either the result of the conversion or, if there was a leading
+ *    minus sign, the negation of the result of the conversion
+ *    represented as an unsigned value, unless the original
+ *    (nonnegated) value would overflow; in the latter case, this
+ *    returns ULLONG_MAX and sets @a errno to ERANGE.
+ *
+ *  @sa strtoull
+ *  @sa strntoul
+ *
+ */
+unsigned long long
+strntoull(const char *aString, size_t aLength, char **aEnd, int aBase)
+{
+    return (StrNToUL::Core::ConvertUnsigned<unsigned long long>(aString, aLength, aEnd, aBase));
+}
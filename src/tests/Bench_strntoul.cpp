@@ -0,0 +1,551 @@
+/*
+ *    Copyright (c) 2024 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+
+/**
+ *    @file
+ *      This file implements a benchmark for strntoul which, around
+ *      each run over a generated corpus, counts cycles, instructions,
+ *      branches, and branch misses with perf_event_open, reporting
+ *      cycles per byte, instructions per cycle, and the branch miss
+ *      rate for each base and digit length.
+ *
+ *      Where hardware counters are unavailable or not permitted, as
+ *      in many containers and virtual machines, it falls back to
+ *      clock_gettime and reports nanoseconds alone.
+ *
+ *      This is not a unit test and is not run by the 'check' target.
+ *      Build and run it with the 'benchmark' target.
+ *
+ */
+
+#include <errno.h>
+#include <getopt.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+
+#include <strntoul.h>
+
+
+namespace
+{
+
+// The counters, in group order. The first is the group leader.
+
+enum
+{
+    kCycles,
+    kInstructions,
+    kBranches,
+    kBranchMisses,
+
+    kCounters
+};
+
+struct Counts
+{
+    uint64_t mNanoseconds;
+    uint64_t mCounters[kCounters];
+};
+
+/**
+ *  The hardware counters, when available, and the clock otherwise.
+ *
+ */
+class Counters
+{
+public:
+    Counters(void);
+    ~Counters(void);
+
+    bool IsAvailable(void) const { return (mDescriptors[kCycles] >= 0); }
+
+    void Start(void);
+    void Stop(Counts &aCounts);
+
+private:
+    int      mDescriptors[kCounters];
+    uint64_t mStart;
+};
+
+/**
+ *  A corpus of numbers, stored back to back, with the offset and
+ *  length of each.
+ *
+ */
+struct Corpus
+{
+    std::string         mText;
+    std::vector<size_t> mOffsets;
+    std::vector<size_t> mLengths;
+    size_t              mDigits;
+};
+
+static const char kDigits[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+
+static uint64_t
+Now(void)
+{
+    struct timespec lNow;
+
+    clock_gettime(CLOCK_MONOTONIC, &lNow);
+
+    return ((static_cast<uint64_t>(lNow.tv_sec) * 1000000000U) + static_cast<uint64_t>(lNow.tv_nsec));
+}
+
+Counters :: Counters(void) :
+    mStart(0)
+{
+    for (int &lDescriptor : mDescriptors)
+    {
+        lDescriptor = -1;
+    }
+
+#if defined(__linux__)
+    static const uint64_t kConfigs[kCounters] = {
+        PERF_COUNT_HW_CPU_CYCLES,
+        PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_BRANCH_INSTRUCTIONS,
+        PERF_COUNT_HW_BRANCH_MISSES
+    };
+
+    for (size_t i = 0; i < kCounters; i++)
+    {
+        struct perf_event_attr lAttributes;
+
+        memset(&lAttributes, 0, sizeof (lAttributes));
+
+        lAttributes.type           = PERF_TYPE_HARDWARE;
+        lAttributes.size           = sizeof (lAttributes);
+        lAttributes.config         = kConfigs[i];
+        lAttributes.disabled       = (i == kCycles);
+        lAttributes.exclude_kernel = 1;
+        lAttributes.exclude_hv     = 1;
+        lAttributes.read_format    = PERF_FORMAT_GROUP;
+
+        mDescriptors[i] = static_cast<int>(syscall(__NR_perf_event_open,
+                                                   &lAttributes,
+                                                   0,
+                                                   -1,
+                                                   mDescriptors[kCycles],
+                                                   0));
+
+        if (mDescriptors[i] < 0)
+        {
+            fprintf(stderr,
+                    "Hardware counters are unavailable (%s); "
+                    "reporting elapsed time only.\n",
+                    strerror(errno));
+
+            for (size_t j = 0; j < i; j++)
+            {
+                close(mDescriptors[j]);
+
+                mDescriptors[j] = -1;
+            }
+
+            break;
+        }
+    }
+#endif // defined(__linux__)
+}
+
+Counters :: ~Counters(void)
+{
+    for (int lDescriptor : mDescriptors)
+    {
+        if (lDescriptor >= 0)
+        {
+            close(lDescriptor);
+        }
+    }
+}
+
+void
+Counters :: Start(void)
+{
+#if defined(__linux__)
+    if (IsAvailable())
+    {
+        ioctl(mDescriptors[kCycles], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(mDescriptors[kCycles], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+#endif
+
+    mStart = Now();
+}
+
+void
+Counters :: Stop(Counts &aCounts)
+{
+    aCounts.mNanoseconds = Now() - mStart;
+
+    memset(aCounts.mCounters, 0, sizeof (aCounts.mCounters));
+
+#if defined(__linux__)
+    if (IsAvailable())
+    {
+        // With PERF_FORMAT_GROUP, a read yields the number of
+        // counters followed by each of their values, in group order.
+
+        uint64_t lValues[kCounters + 1];
+
+        ioctl(mDescriptors[kCycles], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+        if (read(mDescriptors[kCycles], lValues, sizeof (lValues)) == static_cast<ssize_t>(sizeof (lValues)))
+        {
+            memcpy(aCounts.mCounters, &lValues[1], sizeof (aCounts.mCounters));
+        }
+    }
+#endif
+}
+
+static uint64_t
+Random(uint64_t &aState)
+{
+    aState ^= aState << 13;
+    aState ^= aState >> 7;
+    aState ^= aState << 17;
+
+    return (aState);
+}
+
+static void
+Append(Corpus &aCorpus, const char *aNumber, size_t aLength)
+{
+    aCorpus.mOffsets.push_back(aCorpus.mText.size());
+    aCorpus.mLengths.push_back(aLength);
+
+    aCorpus.mText.append(aNumber, aLength);
+
+    // Separate numbers, as in a real record, so that each conversion
+    // stops at a delimiter rather than at its length.
+
+    aCorpus.mText += ',';
+
+    aCorpus.mDigits += aLength;
+}
+
+/**
+ *  Generate @a aCount numbers in @a aBase, each with @a aDigits
+ *  digits or, if @a aDigits is zero (0), with a length drawn
+ *  uniformly from one to @a aMaximum digits.
+ *
+ */
+static void
+Generate(Corpus &aCorpus, int aBase, size_t aDigits, size_t aMaximum, size_t aCount, uint64_t &aState)
+{
+    char lNumber[72];
+
+    for (size_t i = 0; i < aCount; i++)
+    {
+        const size_t lDigits = ((aDigits == 0) ?
+                                (1 + static_cast<size_t>(Random(aState) % aMaximum)) :
+                                aDigits);
+
+        for (size_t j = 0; j < lDigits; j++)
+        {
+            // Avoid a leading zero, which would be taken as a prefix
+            // by a deduced base.
+
+            const uint64_t lDigit = Random(aState) % static_cast<uint64_t>(aBase);
+
+            lNumber[j] = kDigits[((j == 0) && (lDigit == 0) && (lDigits > 1)) ? 1 : lDigit];
+        }
+
+        Append(aCorpus, lNumber, lDigits);
+    }
+}
+
+/**
+ *  Load the numbers in the file at @a aPath, one per line.
+ *
+ */
+static bool
+Load(Corpus &aCorpus, const char *aPath)
+{
+    FILE *  lFile = fopen(aPath, "r");
+    char *  lLine = nullptr;
+    size_t  lSize = 0;
+    ssize_t lLength;
+
+    if (lFile == nullptr)
+    {
+        fprintf(stderr, "Could not open %s: %s\n", aPath, strerror(errno));
+
+        return (false);
+    }
+
+    while ((lLength = getline(&lLine, &lSize, lFile)) > 0)
+    {
+        while ((lLength > 0) && ((lLine[lLength - 1] == '\n') || (lLine[lLength - 1] == '\r')))
+        {
+            lLength--;
+        }
+
+        if (lLength > 0)
+        {
+            Append(aCorpus, lLine, static_cast<size_t>(lLength));
+        }
+    }
+
+    free(lLine);
+    fclose(lFile);
+
+    return (true);
+}
+
+/**
+ *  Convert each number in @a aCorpus @a aRounds times, reporting the
+ *  counts of the fastest round.
+ *
+ */
+static void
+Run(Counters &aCounters, const Corpus &aCorpus, int aBase, unsigned int aRounds, Counts &aBest)
+{
+    const char * const  lText  = aCorpus.mText.data();
+    const size_t        lCount = aCorpus.mOffsets.size();
+    volatile unsigned long lSink = 0;
+
+    aBest.mNanoseconds = UINT64_MAX;
+
+    for (unsigned int lRound = 0; lRound <= aRounds; lRound++)
+    {
+        unsigned long lSum = 0;
+        Counts        lCounts;
+
+        aCounters.Start();
+
+        for (size_t i = 0; i < lCount; i++)
+        {
+            lSum += strntoul(lText + aCorpus.mOffsets[i], aCorpus.mLengths[i] + 1, nullptr, aBase);
+        }
+
+        aCounters.Stop(lCounts);
+
+        lSink = lSink + lSum;
+
+        // The first round only warms the caches and the predictors.
+
+        if ((lRound > 0) && (lCounts.mNanoseconds < aBest.mNanoseconds))
+        {
+            aBest = lCounts;
+        }
+    }
+}
+
+static double
+Ratio(uint64_t aNumerator, uint64_t aDenominator)
+{
+    return ((aDenominator == 0) ? 0.0 : (static_cast<double>(aNumerator) / static_cast<double>(aDenominator)));
+}
+
+static void
+Report(const Counters &aCounters, const Corpus &aCorpus, int aBase, const char *aDigits, const Counts &aCounts)
+{
+    const size_t lCalls = aCorpus.mOffsets.size();
+
+    if (aCounters.IsAvailable())
+    {
+        printf("%4d %8s %8zu %10.2f %10.2f %8.2f %9.2f%%\n",
+               aBase,
+               aDigits,
+               lCalls,
+               Ratio(aCounts.mNanoseconds, lCalls),
+               Ratio(aCounts.mCounters[kCycles], aCorpus.mDigits),
+               Ratio(aCounts.mCounters[kInstructions], aCounts.mCounters[kCycles]),
+               100.0 * Ratio(aCounts.mCounters[kBranchMisses], aCounts.mCounters[kBranches]));
+    }
+    else
+    {
+        printf("%4d %8s %8zu %10.2f %10.3f %8s %10s\n",
+               aBase,
+               aDigits,
+               lCalls,
+               Ratio(aCounts.mNanoseconds, lCalls),
+               Ratio(aCounts.mNanoseconds, aCorpus.mDigits),
+               "-",
+               "-");
+    }
+}
+
+static void
+Usage(const char *aProgram)
+{
+    fprintf(stderr,
+            "Usage: %s [ -b BASE ] [ -f FILE ] [ -n COUNT ] [ -r ROUNDS ]\n"
+            "\n"
+            "  -b BASE    Convert in BASE, 2 to 36, or 0 to deduce it; by\n"
+            "             default, each of 2, 8, 10, and 16.\n"
+            "  -f FILE    Convert the numbers in FILE, one per line, rather\n"
+            "             than generated ones.\n"
+            "  -n COUNT   Generate COUNT numbers for each length (default:\n"
+            "             4096).\n"
+            "  -r ROUNDS  Report the fastest of ROUNDS rounds (default: 16).\n",
+            aProgram);
+}
+
+}; // namespace
+
+int
+main(int argc, char * const argv[])
+{
+    std::vector<int> lBases;
+    const char *     lPath   = nullptr;
+    size_t           lCount  = 4096;
+    unsigned int     lRounds = 16;
+    uint64_t         lState  = 0x9E3779B97F4A7C15ULL;
+    int              lOption;
+
+    while ((lOption = getopt(argc, argv, "b:f:hn:r:")) != -1)
+    {
+        switch (lOption)
+        {
+
+        case 'b':
+            lBases.push_back(atoi(optarg));
+
+            if ((lBases.back() != 0) && ((lBases.back() < 2) || (lBases.back() > 36)))
+            {
+                Usage(argv[0]);
+                return (EXIT_FAILURE);
+            }
+            break;
+
+        case 'f':
+            lPath = optarg;
+            break;
+
+        case 'n':
+            lCount = static_cast<size_t>(strtoul(optarg, nullptr, 10));
+            break;
+
+        case 'r':
+            lRounds = static_cast<unsigned int>(strtoul(optarg, nullptr, 10));
+            break;
+
+        default:
+            Usage(argv[0]);
+            return ((lOption == 'h') ? EXIT_SUCCESS : EXIT_FAILURE);
+
+        }
+    }
+
+    if ((lCount == 0) || (lRounds == 0))
+    {
+        Usage(argv[0]);
+        return (EXIT_FAILURE);
+    }
+
+    if (lBases.empty())
+    {
+        lBases = { 2, 8, 10, 16 };
+    }
+
+    {
+        Counters lCounters;
+
+        if (lCounters.IsAvailable())
+        {
+            printf("%4s %8s %8s %10s %10s %8s %10s\n",
+                   "base", "digits", "calls", "ns/call", "cycles/B", "IPC", "br-miss");
+        }
+        else
+        {
+            printf("%4s %8s %8s %10s %10s %8s %10s\n",
+                   "base", "digits", "calls", "ns/call", "ns/B", "IPC", "br-miss");
+        }
+
+        for (int lBase : lBases)
+        {
+            Counts lCounts;
+
+            if (lPath != nullptr)
+            {
+                Corpus lCorpus = Corpus();
+
+                if (!Load(lCorpus, lPath))
+                {
+                    return (EXIT_FAILURE);
+                }
+
+                if (lCorpus.mOffsets.empty())
+                {
+                    continue;
+                }
+
+                Run(lCounters, lCorpus, lBase, lRounds, lCounts);
+                Report(lCounters, lCorpus, lBase, "file", lCounts);
+
+                continue;
+            }
+
+            // Each length that fits in an unsigned long, then a mix of
+            // all of them, uniformly distributed, which defeats
+            // prediction of the length, and then a mix of small values,
+            // of one to three digits, such as status codes, ports, and
+            // percentages.
+
+            {
+                size_t lMaximum = 0;
+
+                for (unsigned long lValue = ~0UL; lValue != 0; lValue /= static_cast<unsigned long>((lBase == 0) ? 10 : lBase))
+                {
+                    lMaximum++;
+                }
+
+                for (size_t lDigits = 1; lDigits <= lMaximum + 2; lDigits++)
+                {
+                    const size_t lLength = ((lDigits > lMaximum) ? 0 : lDigits);
+                    const size_t lMixed  = ((lDigits > (lMaximum + 1)) ? 3 : (lMaximum - 1));
+                    Corpus       lCorpus = Corpus();
+                    char         lLabel[48];
+
+                    Generate(lCorpus, ((lBase == 0) ? 10 : lBase), lLength, lMixed, lCount, lState);
+
+                    if (lLength == 0)
+                    {
+                        snprintf(lLabel, sizeof (lLabel), "1-%zu", lMixed);
+                    }
+                    else
+                    {
+                        snprintf(lLabel, sizeof (lLabel), "%zu", lLength);
+                    }
+
+                    Run(lCounters, lCorpus, lBase, lRounds, lCounts);
+                    Report(lCounters, lCorpus, lBase, lLabel, lCounts);
+                }
+            }
+        }
+    }
+
+    return (EXIT_SUCCESS);
+}
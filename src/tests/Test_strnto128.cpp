@@ -0,0 +1,223 @@
+/*
+ *    Copyright (c) 2024 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *    @file
+ *      This file implements a unit test for strntou128 and strnto128.
+ *
+ */
+
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <algorithm>
+#include <string>
+
+#include <nlunit-test.h>
+
+#include <strnto128.h>
+
+#if defined(STRNTOUL_HAVE_INT128)
+
+typedef unsigned __int128 uint128_t;
+typedef __int128          int128_t;
+
+static const uint128_t kUInt128Max = ~static_cast<uint128_t>(0);
+static const int128_t  kInt128Max  = static_cast<int128_t>(kUInt128Max >> 1);
+static const int128_t  kInt128Min  = -kInt128Max - 1;
+
+/**
+ *  Format @a aValue in @a aBase, by repeated division, as an
+ *  independent reference for the conversion.
+ *
+ */
+static std::string Format(uint128_t aValue, const unsigned int &aBase)
+{
+    static const char kDigits[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+    std::string       lRetval;
+
+    do
+    {
+        lRetval += kDigits[static_cast<size_t>(aValue % aBase)];
+        aValue  /= aBase;
+    }
+    while (aValue != 0);
+
+    std::reverse(lRetval.begin(), lRetval.end());
+
+    return (lRetval);
+}
+
+static void TestLimits(nlTestSuite *inSuite __attribute__((unused)),
+                       void *inContext __attribute__((unused)))
+{
+    const char * lString;
+    char *       lEnd;
+    uint128_t    lUnsigned;
+    int128_t     lSigned;
+
+    // 1: The largest unsigned value and one more.
+
+    errno   = 0;
+    lString = "340282366920938463463374607431768211455";
+
+    lUnsigned = strntou128(lString, strlen(lString), &lEnd, 10);
+    NL_TEST_ASSERT(inSuite, lUnsigned == kUInt128Max);
+    NL_TEST_ASSERT(inSuite, lEnd == lString + strlen(lString));
+    NL_TEST_ASSERT(inSuite, errno == 0);
+
+    lString = "340282366920938463463374607431768211456";
+
+    lUnsigned = strntou128(lString, strlen(lString), &lEnd, 10);
+    NL_TEST_ASSERT(inSuite, lUnsigned == kUInt128Max);
+    NL_TEST_ASSERT(inSuite, lEnd == lString + strlen(lString));
+    NL_TEST_ASSERT(inSuite, errno == ERANGE);
+
+    errno   = 0;
+    lString = "0xffffffffffffffffffffffffffffffff";
+
+    lUnsigned = strntou128(lString, strlen(lString), &lEnd, 0);
+    NL_TEST_ASSERT(inSuite, lUnsigned == kUInt128Max);
+    NL_TEST_ASSERT(inSuite, errno == 0);
+
+    // 2: The signed extremes and just beyond them.
+
+    lString = "-170141183460469231731687303715884105728";
+
+    lSigned = strnto128(lString, strlen(lString), &lEnd, 10);
+    NL_TEST_ASSERT(inSuite, lSigned == kInt128Min);
+    NL_TEST_ASSERT(inSuite, errno == 0);
+
+    lString = "170141183460469231731687303715884105727";
+
+    lSigned = strnto128(lString, strlen(lString), &lEnd, 10);
+    NL_TEST_ASSERT(inSuite, lSigned == kInt128Max);
+    NL_TEST_ASSERT(inSuite, errno == 0);
+
+    lString = "170141183460469231731687303715884105728";
+
+    lSigned = strnto128(lString, strlen(lString), &lEnd, 10);
+    NL_TEST_ASSERT(inSuite, lSigned == kInt128Max);
+    NL_TEST_ASSERT(inSuite, errno == ERANGE);
+
+    errno   = 0;
+    lString = "-170141183460469231731687303715884105729";
+
+    lSigned = strnto128(lString, strlen(lString), &lEnd, 10);
+    NL_TEST_ASSERT(inSuite, lSigned == kInt128Min);
+    NL_TEST_ASSERT(inSuite, errno == ERANGE);
+
+    // 3: Chunk boundaries, with trailing junk.
+
+    errno   = 0;
+    lString = "10000000000000000000x";
+
+    lUnsigned = strntou128(lString, strlen(lString), &lEnd, 10);
+    NL_TEST_ASSERT(inSuite, lUnsigned == static_cast<uint128_t>(10000000000000000000ULL));
+    NL_TEST_ASSERT(inSuite, lEnd == lString + 20);
+
+    lString = " -12345";
+
+    lSigned = strnto128(lString, strlen(lString), &lEnd, 10);
+    NL_TEST_ASSERT(inSuite, lSigned == -12345);
+    NL_TEST_ASSERT(inSuite, errno == 0);
+}
+
+static void TestRoundTrip(nlTestSuite *inSuite __attribute__((unused)),
+                          void *inContext __attribute__((unused)))
+{
+    static const unsigned int kBases[] = { 2, 3, 7, 8, 10, 16, 36 };
+    uint64_t                  lState   = 0x9E3779B97F4A7C15ULL;
+
+    for (unsigned int lBase : kBases)
+    {
+        for (size_t i = 0; i < 2000; i++)
+        {
+            uint128_t   lExpected;
+            std::string lString;
+            char *      lEnd;
+            uint128_t   lUnsigned;
+            int128_t    lSigned;
+
+            lState ^= lState << 13;
+            lState ^= lState >> 7;
+            lState ^= lState << 17;
+
+            lExpected = (static_cast<uint128_t>(lState) << 64) | (lState * 0x2545F4914F6CDD1DULL);
+
+            // Cover every width, not just the widest.
+
+            lExpected >>= (lState % 128);
+
+            lString = Format(lExpected, lBase);
+
+            errno = 0;
+
+            lUnsigned = strntou128(lString.data(), lString.size(), &lEnd, static_cast<int>(lBase));
+            NL_TEST_ASSERT(inSuite, lUnsigned == lExpected);
+            NL_TEST_ASSERT(inSuite, lEnd == lString.data() + lString.size());
+            NL_TEST_ASSERT(inSuite, errno == 0);
+
+            lString = "-" + Format(lExpected >> 1, lBase);
+
+            lSigned = strnto128(lString.data(), lString.size(), &lEnd, static_cast<int>(lBase));
+            NL_TEST_ASSERT(inSuite, lSigned == -static_cast<int128_t>(lExpected >> 1));
+            NL_TEST_ASSERT(inSuite, errno == 0);
+        }
+    }
+}
+
+#endif // defined(STRNTOUL_HAVE_INT128)
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+static const nlTest sTests[] = {
+#if defined(STRNTOUL_HAVE_INT128)
+    NL_TEST_DEF("Limits",     TestLimits),
+    NL_TEST_DEF("Round Trip", TestRoundTrip),
+#endif
+
+    NL_TEST_SENTINEL()
+};
+
+int main(void)
+{
+    nlTestSuite theSuite = {
+        "strnto128",
+        &sTests[0],
+        nullptr,
+        nullptr,
+        nullptr,
+        nullptr,
+        0,
+        0,
+        0,
+        0,
+        0
+    };
+
+    // Generate human-readable output.
+    nlTestSetOutputStyle(OUTPUT_DEF);
+
+    // Run test suit againt one context.
+    nlTestRunner(&theSuite, nullptr);
+
+    return nlTestRunnerStats(&theSuite);
+}
@@ -0,0 +1,244 @@
+/*
+ *    Copyright (c) 2024 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *    @file
+ *      This file implements a unit test for strntobig.
+ *
+ */
+
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <nlunit-test.h>
+
+#include <strntobig.h>
+
+
+/**
+ *  Format limbs in a base, by repeated division, as an independent
+ *  reference for the conversion.
+ *
+ */
+static std::string Format(std::vector<uint64_t> aLimbs, const unsigned int &aBase)
+{
+    static const char kDigits[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+    std::string       lRetval;
+
+    while (!aLimbs.empty())
+    {
+        unsigned __int128 lRemainder = 0;
+
+        for (size_t i = aLimbs.size(); i > 0; i--)
+        {
+            const unsigned __int128 lDividend = (lRemainder << 64) | aLimbs[i - 1];
+
+            aLimbs[i - 1] = static_cast<uint64_t>(lDividend / aBase);
+            lRemainder    = lDividend % aBase;
+        }
+
+        lRetval += kDigits[static_cast<size_t>(lRemainder)];
+
+        while (!aLimbs.empty() && (aLimbs.back() == 0))
+        {
+            aLimbs.pop_back();
+        }
+    }
+
+    std::reverse(lRetval.begin(), lRetval.end());
+
+    return (lRetval.empty() ? std::string("0") : lRetval);
+}
+
+static void TestSimple(nlTestSuite *inSuite __attribute__((unused)),
+                       void *inContext __attribute__((unused)))
+{
+    const char * lString;
+    uint64_t     lLimbs[4];
+    char *       lEnd;
+    size_t       lCount;
+
+    // 1: A value that fits in one limb.
+
+    lString = "  +18446744073709551615 ";
+
+    lCount = strntobig(lString, strlen(lString), &lEnd, 10, lLimbs, 4);
+    NL_TEST_ASSERT(inSuite, lCount == 1);
+    NL_TEST_ASSERT(inSuite, lLimbs[0] == UINT64_MAX);
+    NL_TEST_ASSERT(inSuite, lEnd == lString + strlen(lString) - 1);
+
+    // 2: One more, which does not.
+
+    lString = "18446744073709551616";
+
+    lCount = strntobig(lString, strlen(lString), &lEnd, 10, lLimbs, 4);
+    NL_TEST_ASSERT(inSuite, lCount == 2);
+    NL_TEST_ASSERT(inSuite, (lLimbs[0] == 0) && (lLimbs[1] == 1));
+
+    // 3: Zero has no significant limbs, but is converted.
+
+    lString = "0000";
+
+    lCount = strntobig(lString, strlen(lString), &lEnd, 10, lLimbs, 4);
+    NL_TEST_ASSERT(inSuite, lCount == 0);
+    NL_TEST_ASSERT(inSuite, lEnd == lString + 4);
+
+    // 4: Prefixes and base deduction.
+
+    lString = "0x1_";
+
+    lCount = strntobig(lString, strlen(lString), &lEnd, 0, lLimbs, 4);
+    NL_TEST_ASSERT(inSuite, (lCount == 1) && (lLimbs[0] == 1));
+    NL_TEST_ASSERT(inSuite, lEnd == lString + 3);
+
+    lString = "0xg";
+
+    lCount = strntobig(lString, strlen(lString), &lEnd, 16, lLimbs, 4);
+    NL_TEST_ASSERT(inSuite, lCount == 0);
+    NL_TEST_ASSERT(inSuite, lEnd == lString + 1);
+
+    lString = "0777777777777777777777777";
+
+    lCount = strntobig(lString, strlen(lString), &lEnd, 0, lLimbs, 4);
+    NL_TEST_ASSERT(inSuite, lCount == 2);
+    NL_TEST_ASSERT(inSuite, (lLimbs[0] == UINT64_MAX) && (lLimbs[1] == 0xFF));
+
+    // 5: The length bounds the conversion.
+
+    lString = "123456";
+
+    lCount = strntobig(lString, 3, &lEnd, 10, lLimbs, 4);
+    NL_TEST_ASSERT(inSuite, (lCount == 1) && (lLimbs[0] == 123));
+    NL_TEST_ASSERT(inSuite, lEnd == lString + 3);
+}
+
+static void TestErrors(nlTestSuite *inSuite __attribute__((unused)),
+                       void *inContext __attribute__((unused)))
+{
+    const char * lString = "340282366920938463463374607431768211456";
+    uint64_t     lLimbs[2];
+    char *       lEnd;
+    size_t       lCount;
+
+    errno = 0;
+
+    lCount = strntobig(lString, strlen(lString), &lEnd, 1, lLimbs, 2);
+    NL_TEST_ASSERT(inSuite, lCount == 0);
+    NL_TEST_ASSERT(inSuite, errno == EINVAL);
+    NL_TEST_ASSERT(inSuite, lEnd == lString);
+
+    // 2^128 needs three limbs; the low two are stored.
+
+    errno = 0;
+
+    lCount = strntobig(lString, strlen(lString), &lEnd, 10, lLimbs, 2);
+    NL_TEST_ASSERT(inSuite, lCount == 3);
+    NL_TEST_ASSERT(inSuite, errno == ERANGE);
+    NL_TEST_ASSERT(inSuite, (lLimbs[0] == 0) && (lLimbs[1] == 0));
+
+    lCount = strntobig("-1", 2, &lEnd, 10, lLimbs, 2);
+    NL_TEST_ASSERT(inSuite, lCount == 0);
+
+    NL_TEST_ASSERT(inSuite, strntobig_limbs(20, 10) == 2);
+    NL_TEST_ASSERT(inSuite, strntobig_limbs(16, 16) == 1);
+    NL_TEST_ASSERT(inSuite, strntobig_limbs(16, 37) == 0);
+}
+
+static void TestRoundTrip(nlTestSuite *inSuite __attribute__((unused)),
+                          void *inContext __attribute__((unused)))
+{
+    static const unsigned int kBases[] = { 10, 16, 8, 2, 36, 7 };
+    static const size_t       kSizes[] = { 1, 2, 3, 17, 64, 65, 130, 400 };
+    uint64_t                  lState   = 0x9E3779B97F4A7C15ULL;
+
+    // Cover the linear, divide-and-conquer, and Karatsuba paths, as
+    // well as packing for power-of-two bases.
+
+    for (size_t lSize : kSizes)
+    {
+        std::vector<uint64_t> lExpected(lSize);
+
+        for (uint64_t &lLimb : lExpected)
+        {
+            lState ^= lState << 13;
+            lState ^= lState >> 7;
+            lState ^= lState << 17;
+
+            lLimb = lState;
+        }
+
+        lExpected.back() |= 1;
+
+        for (unsigned int lBase : kBases)
+        {
+            const std::string     lString = Format(lExpected, lBase);
+            std::vector<uint64_t> lLimbs(strntobig_limbs(lString.size(), static_cast<int>(lBase)));
+            char *                lEnd;
+            size_t                lCount;
+
+            errno = 0;
+
+            lCount = strntobig(lString.data(), lString.size(), &lEnd, static_cast<int>(lBase), lLimbs.data(), lLimbs.size());
+            NL_TEST_ASSERT(inSuite, errno == 0);
+            NL_TEST_ASSERT(inSuite, lCount == lSize);
+            NL_TEST_ASSERT(inSuite, lEnd == lString.data() + lString.size());
+            NL_TEST_ASSERT(inSuite, std::equal(lExpected.begin(), lExpected.end(), lLimbs.begin()));
+        }
+    }
+}
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+static const nlTest sTests[] = {
+    NL_TEST_DEF("Simple",     TestSimple),
+    NL_TEST_DEF("Errors",     TestErrors),
+    NL_TEST_DEF("Round Trip", TestRoundTrip),
+
+    NL_TEST_SENTINEL()
+};
+
+int main(void)
+{
+    nlTestSuite theSuite = {
+        "strntobig",
+        &sTests[0],
+        nullptr,
+        nullptr,
+        nullptr,
+        nullptr,
+        0,
+        0,
+        0,
+        0,
+        0
+    };
+
+    // Generate human-readable output.
+    nlTestSetOutputStyle(OUTPUT_DEF);
+
+    // Run test suit againt one context.
+    nlTestRunner(&theSuite, nullptr);
+
+    return nlTestRunnerStats(&theSuite);
+}
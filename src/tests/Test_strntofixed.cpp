@@ -0,0 +1,352 @@
+/*
+ *    Copyright (c) 2024 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *    @file
+ *      This file implements a unit test for strntofixed.
+ *
+ */
+
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <sys/mman.h>
+
+#include <nlunit-test.h>
+
+#include <strntofixed.h>
+
+
+static void TestSimple(nlTestSuite *inSuite __attribute__((unused)),
+                       void *inContext __attribute__((unused)))
+{
+    const char * lString;
+    char *       lEnd;
+    int64_t      lValue;
+
+    // 1: A price, with white space and sign as for strntol.
+
+    lString = "  -12.345,";
+
+    errno = 0;
+
+    lValue = strntofixed(lString, strlen(lString), &lEnd, 3, STRNTOFIXED_TRUNCATE);
+    NL_TEST_ASSERT(inSuite, lValue == -12345);
+    NL_TEST_ASSERT(inSuite, lEnd == lString + 9);
+    NL_TEST_ASSERT(inSuite, errno == 0);
+
+    // 2: Missing fractional digits are zero.
+
+    lString = "+7.5";
+
+    lValue = strntofixed(lString, strlen(lString), &lEnd, 4, STRNTOFIXED_TRUNCATE);
+    NL_TEST_ASSERT(inSuite, lValue == 75000);
+
+    lString = "42";
+
+    lValue = strntofixed(lString, strlen(lString), &lEnd, 2, STRNTOFIXED_TRUNCATE);
+    NL_TEST_ASSERT(inSuite, lValue == 4200);
+    NL_TEST_ASSERT(inSuite, lEnd == lString + 2);
+
+    // 3: Either side of the radix point may be empty, but not both.
+
+    lString = "42.x";
+
+    lValue = strntofixed(lString, strlen(lString), &lEnd, 2, STRNTOFIXED_TRUNCATE);
+    NL_TEST_ASSERT(inSuite, lValue == 4200);
+    NL_TEST_ASSERT(inSuite, lEnd == lString + 3);
+
+    lString = "-.05";
+
+    lValue = strntofixed(lString, strlen(lString), &lEnd, 2, STRNTOFIXED_TRUNCATE);
+    NL_TEST_ASSERT(inSuite, lValue == -5);
+    NL_TEST_ASSERT(inSuite, lEnd == lString + 4);
+
+    lString = " -.x";
+
+    lValue = strntofixed(lString, strlen(lString), &lEnd, 2, STRNTOFIXED_TRUNCATE);
+    NL_TEST_ASSERT(inSuite, lValue == 0);
+    NL_TEST_ASSERT(inSuite, lEnd == lString);
+
+    // 4: Leading zeroes are not significant, on either side.
+
+    lString = "000000000000000000000000001.000000000000000001";
+
+    lValue = strntofixed(lString, strlen(lString), &lEnd, 18, STRNTOFIXED_TRUNCATE);
+    NL_TEST_ASSERT(inSuite, lValue == INT64_C(1000000000000000001));
+    NL_TEST_ASSERT(inSuite, lEnd == lString + strlen(lString));
+
+    // 5: The length bounds the conversion, even within the fraction.
+
+    lString = "3.14159";
+
+    lValue = strntofixed(lString, 4, &lEnd, 5, STRNTOFIXED_TRUNCATE);
+    NL_TEST_ASSERT(inSuite, lValue == 314000);
+    NL_TEST_ASSERT(inSuite, lEnd == lString + 4);
+}
+
+static void TestPolicies(nlTestSuite *inSuite __attribute__((unused)),
+                         void *inContext __attribute__((unused)))
+{
+    const char * lString = "-2.71828";
+    char *       lEnd;
+    int64_t      lValue;
+
+    lValue = strntofixed(lString, strlen(lString), &lEnd, 2, STRNTOFIXED_TRUNCATE);
+    NL_TEST_ASSERT(inSuite, lValue == -271);
+    NL_TEST_ASSERT(inSuite, lEnd == lString + strlen(lString));
+
+    lValue = strntofixed(lString, strlen(lString), &lEnd, 2, STRNTOFIXED_ROUND);
+    NL_TEST_ASSERT(inSuite, lValue == -272);
+    NL_TEST_ASSERT(inSuite, lEnd == lString + strlen(lString));
+
+    errno = 0;
+
+    lValue = strntofixed(lString, strlen(lString), &lEnd, 2, STRNTOFIXED_REJECT);
+    NL_TEST_ASSERT(inSuite, lValue == 0);
+    NL_TEST_ASSERT(inSuite, lEnd == lString);
+    NL_TEST_ASSERT(inSuite, errno == EINVAL);
+
+    // Excess zeroes lose nothing and are accepted.
+
+    lString = "1.2500";
+
+    errno = 0;
+
+    lValue = strntofixed(lString, strlen(lString), &lEnd, 2, STRNTOFIXED_REJECT);
+    NL_TEST_ASSERT(inSuite, lValue == 125);
+    NL_TEST_ASSERT(inSuite, lEnd == lString + strlen(lString));
+    NL_TEST_ASSERT(inSuite, errno == 0);
+
+    // Half rounds away from zero and may carry into the integer part.
+
+    lValue = strntofixed("0.125", 5, &lEnd, 2, STRNTOFIXED_ROUND);
+    NL_TEST_ASSERT(inSuite, lValue == 13);
+
+    lValue = strntofixed("0.1249", 6, &lEnd, 2, STRNTOFIXED_ROUND);
+    NL_TEST_ASSERT(inSuite, lValue == 12);
+
+    lValue = strntofixed("9.995", 5, &lEnd, 2, STRNTOFIXED_ROUND);
+    NL_TEST_ASSERT(inSuite, lValue == 1000);
+
+    lValue = strntofixed("-0.5", 4, &lEnd, 0, STRNTOFIXED_ROUND);
+    NL_TEST_ASSERT(inSuite, lValue == -1);
+}
+
+static void TestErrors(nlTestSuite *inSuite __attribute__((unused)),
+                       void *inContext __attribute__((unused)))
+{
+    const char * lString;
+    char *       lEnd;
+    int64_t      lValue;
+
+    // 1: Invalid scale or policy.
+
+    lString = "1.5";
+
+    errno = 0;
+
+    lValue = strntofixed(lString, strlen(lString), &lEnd, STRNTOFIXED_SCALE_MAX + 1, STRNTOFIXED_TRUNCATE);
+    NL_TEST_ASSERT(inSuite, (lValue == 0) && (errno == EINVAL) && (lEnd == lString));
+
+    errno = 0;
+
+    lValue = strntofixed(lString, strlen(lString), &lEnd, 1, static_cast<strntofixed_policy_t>(3));
+    NL_TEST_ASSERT(inSuite, (lValue == 0) && (errno == EINVAL) && (lEnd == lString));
+
+    // 2: The extremes are exact.
+
+    lString = "-9223372036.854775808";
+
+    errno = 0;
+
+    lValue = strntofixed(lString, strlen(lString), &lEnd, 9, STRNTOFIXED_TRUNCATE);
+    NL_TEST_ASSERT(inSuite, (lValue == INT64_MIN) && (errno == 0));
+
+    lString = "9223372036.854775807";
+
+    lValue = strntofixed(lString, strlen(lString), &lEnd, 9, STRNTOFIXED_TRUNCATE);
+    NL_TEST_ASSERT(inSuite, (lValue == INT64_MAX) && (errno == 0));
+
+    // 3: Beyond them, or by way of rounding, the conversion saturates.
+
+    lValue = strntofixed(lString, strlen(lString), &lEnd, 8, STRNTOFIXED_ROUND);
+    NL_TEST_ASSERT(inSuite, (lValue == 922337203685477581) && (errno == 0));
+
+    lValue = strntofixed(lString, strlen(lString), &lEnd, 9, STRNTOFIXED_ROUND);
+    NL_TEST_ASSERT(inSuite, (lValue == INT64_MAX) && (errno == 0));
+
+    lString = "9223372036.8547758075";
+
+    lValue = strntofixed(lString, strlen(lString), &lEnd, 9, STRNTOFIXED_ROUND);
+    NL_TEST_ASSERT(inSuite, (lValue == INT64_MAX) && (errno == ERANGE));
+    NL_TEST_ASSERT(inSuite, lEnd == lString + strlen(lString));
+
+    errno = 0;
+
+    lString = "-100000000000000000000 ";
+
+    lValue = strntofixed(lString, strlen(lString), &lEnd, 0, STRNTOFIXED_TRUNCATE);
+    NL_TEST_ASSERT(inSuite, (lValue == INT64_MIN) && (errno == ERANGE));
+    NL_TEST_ASSERT(inSuite, lEnd == lString + strlen(lString) - 1);
+
+    errno = 0;
+
+    lValue = strntofixed("10", 2, &lEnd, 18, STRNTOFIXED_TRUNCATE);
+    NL_TEST_ASSERT(inSuite, (lValue == INT64_MAX) && (errno == ERANGE));
+}
+
+static void TestPageBoundary(nlTestSuite *inSuite __attribute__((unused)),
+                             void *inContext __attribute__((unused)))
+{
+    const size_t lPageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    char *       lPages;
+    char *       lString;
+    char *       lEnd;
+    int64_t      lValue;
+    int          lStatus;
+
+    // Inputs that end, exactly at a guard page, with no fraction
+    // digits to convert.
+
+    lPages = static_cast<char *>(mmap(nullptr,
+                                      lPageSize * 2,
+                                      PROT_READ | PROT_WRITE,
+                                      MAP_PRIVATE | MAP_ANONYMOUS,
+                                      -1,
+                                      0));
+    NL_TEST_ASSERT(inSuite, lPages != MAP_FAILED);
+
+    if (lPages == MAP_FAILED)
+        return;
+
+    lStatus = mprotect(lPages + lPageSize, lPageSize, PROT_NONE);
+    NL_TEST_ASSERT(inSuite, lStatus == 0);
+
+    // 1: A trailing radix point.
+
+    lString = lPages + lPageSize - 3;
+
+    memcpy(lString, "12.", 3);
+
+    lValue = strntofixed(lString, 3, &lEnd, 2, STRNTOFIXED_TRUNCATE);
+    NL_TEST_ASSERT(inSuite, (lValue == 1200) && (lEnd == lString + 3));
+
+    // 2: A lone radix point.
+
+    lString = lPages + lPageSize - 1;
+
+    memcpy(lString, ".", 1);
+
+    lValue = strntofixed(lString, 1, &lEnd, 2, STRNTOFIXED_TRUNCATE);
+    NL_TEST_ASSERT(inSuite, (lValue == 0) && (lEnd == lString));
+
+    // 3: A scale of zero, which converts no fraction digits at all.
+
+    lString = lPages + lPageSize - 4;
+
+    memcpy(lString, "12.5", 4);
+
+    lValue = strntofixed(lString, 4, &lEnd, 0, STRNTOFIXED_TRUNCATE);
+    NL_TEST_ASSERT(inSuite, (lValue == 12) && (lEnd == lString + 4));
+
+    munmap(lPages, lPageSize * 2);
+}
+
+static void TestAgreement(nlTestSuite *inSuite __attribute__((unused)),
+                          void *inContext __attribute__((unused)))
+{
+    char     lString[64];
+    uint64_t lState = 0x9E3779B97F4A7C15ULL;
+
+    // Formatted fixed-point values, of varying widths, convert back
+    // exactly at their own scale.
+
+    for (size_t i = 0; i < 10000; i++)
+    {
+        lState ^= lState << 13;
+        lState ^= lState >> 7;
+        lState ^= lState << 17;
+
+        const unsigned int lScale    = static_cast<unsigned int>(lState % 10);
+        const uint64_t     lDivisor  = UINT64_C(1) << (lState >> 58);
+        const int64_t      lExpected = static_cast<int64_t>((lState >> 1) / lDivisor) * (((lState >> 20) & 1) ? -1 : 1);
+        uint64_t           lPower    = 1;
+        uint64_t           lMagnitude;
+        char *             lEnd;
+        int64_t            lValue;
+
+        for (unsigned int j = 0; j < lScale; j++)
+        {
+            lPower *= 10;
+        }
+
+        lMagnitude = (lExpected < 0) ? (0 - static_cast<uint64_t>(lExpected)) : static_cast<uint64_t>(lExpected);
+
+        snprintf(lString, sizeof (lString), "%s%llu.%0*llu",
+                 ((lExpected < 0) ? "-" : ""),
+                 static_cast<unsigned long long>(lMagnitude / lPower),
+                 static_cast<int>(lScale),
+                 static_cast<unsigned long long>(lMagnitude % lPower));
+
+        lValue = strntofixed(lString, strlen(lString), &lEnd, lScale, STRNTOFIXED_REJECT);
+        NL_TEST_ASSERT(inSuite, lValue == lExpected);
+        NL_TEST_ASSERT(inSuite, lEnd == lString + strlen(lString));
+    }
+}
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+static const nlTest sTests[] = {
+    NL_TEST_DEF("Simple",    TestSimple),
+    NL_TEST_DEF("Policies",  TestPolicies),
+    NL_TEST_DEF("Errors",    TestErrors),
+    NL_TEST_DEF("Agreement", TestAgreement),
+    NL_TEST_DEF("Page Boundary", TestPageBoundary),
+
+    NL_TEST_SENTINEL()
+};
+
+int main(void)
+{
+    nlTestSuite theSuite = {
+        "strntofixed",
+        &sTests[0],
+        nullptr,
+        nullptr,
+        nullptr,
+        nullptr,
+        0,
+        0,
+        0,
+        0,
+        0
+    };
+
+    // Generate human-readable output.
+    nlTestSetOutputStyle(OUTPUT_DEF);
+
+    // Run test suit againt one context.
+    nlTestRunner(&theSuite, nullptr);
+
+    return nlTestRunnerStats(&theSuite);
+}
@@ -0,0 +1,201 @@
+/*
+ *    Copyright (c) 2024 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *    @file
+ *      This file implements a unit test for strntoll.
+ *
+ */
+
+#include <errno.h>
+#include <limits.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <string>
+
+#include <nlunit-test.h>
+
+#include <strntoll.h>
+
+
+/**
+ *  Generate a well-formed, random number in @a aBase, with optional
+ *  leading white space, sign, and prefix, and trailing junk.
+ *
+ */
+static std::string Generate(uint64_t &aState, const int &aBase)
+{
+    static const char kDigits[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+    const int         lBase     = (aBase == 0) ? 10 : aBase;
+    std::string       lRetval;
+    size_t            lDigits;
+
+    aState ^= aState << 13;
+    aState ^= aState >> 7;
+    aState ^= aState << 17;
+
+    lRetval.append(aState & 3, ' ');
+
+    if ((aState >> 2) & 1)
+    {
+        lRetval += ((aState >> 3) & 1) ? '-' : '+';
+    }
+
+    if ((aBase == 16) && ((aState >> 4) & 1))
+    {
+        lRetval += "0x";
+    }
+
+    lDigits = 1 + ((aState >> 8) % 24);
+
+    for (size_t i = 0; i < lDigits; i++)
+    {
+        const char lDigit = kDigits[(aState >> (i % 48)) % static_cast<unsigned int>(lBase)];
+
+        // Avoid a leading zero, which would change a deduced base.
+
+        lRetval += ((i == 0) && (lDigit == '0')) ? '1' : lDigit;
+    }
+
+    if ((aState >> 5) & 1)
+    {
+        lRetval += " z";
+    }
+
+    return (lRetval);
+}
+
+static void TestLimits(nlTestSuite *inSuite __attribute__((unused)),
+                       void *inContext __attribute__((unused)))
+{
+    const char * lString;
+    char *       lEnd;
+    long long    lResult;
+
+    // 1: The extremes.
+
+    errno   = 0;
+    lString = "9223372036854775807";
+
+    lResult = strntoll(lString, strlen(lString), &lEnd, 10);
+    NL_TEST_ASSERT(inSuite, lResult == LLONG_MAX);
+    NL_TEST_ASSERT(inSuite, errno == 0);
+
+    lString = "-9223372036854775808";
+
+    lResult = strntoll(lString, strlen(lString), &lEnd, 10);
+    NL_TEST_ASSERT(inSuite, lResult == LLONG_MIN);
+    NL_TEST_ASSERT(inSuite, lEnd == lString + strlen(lString));
+    NL_TEST_ASSERT(inSuite, errno == 0);
+
+    // 2: Just beyond them, even when the magnitude alone would fit
+    //    the unsigned counterpart.
+
+    lString = "9223372036854775808";
+
+    lResult = strntoll(lString, strlen(lString), &lEnd, 10);
+    NL_TEST_ASSERT(inSuite, lResult == LLONG_MAX);
+    NL_TEST_ASSERT(inSuite, lEnd == lString + strlen(lString));
+    NL_TEST_ASSERT(inSuite, errno == ERANGE);
+
+    errno   = 0;
+    lString = "-0x8000000000000001";
+
+    lResult = strntoll(lString, strlen(lString), &lEnd, 16);
+    NL_TEST_ASSERT(inSuite, lResult == LLONG_MIN);
+    NL_TEST_ASSERT(inSuite, errno == ERANGE);
+
+    // 3: No digits.
+
+    errno   = 0;
+    lString = " -";
+
+    lResult = strntoll(lString, strlen(lString), &lEnd, 10);
+    NL_TEST_ASSERT(inSuite, lResult == 0);
+    NL_TEST_ASSERT(inSuite, lEnd == lString);
+    NL_TEST_ASSERT(inSuite, errno == 0);
+}
+
+static void TestAgreement(nlTestSuite *inSuite __attribute__((unused)),
+                          void *inContext __attribute__((unused)))
+{
+    static const int kBases[] = { 0, 2, 8, 10, 16, 36 };
+    uint64_t         lState   = 0xD1B54A32D192ED03ULL;
+
+    for (int lBase : kBases)
+    {
+        for (size_t i = 0; i < 2000; i++)
+        {
+            const std::string lString = Generate(lState, lBase);
+            char *            lExpectedEnd;
+            char *            lEnd;
+            long long         lExpected;
+            long long         lResult;
+            int               lExpectedErrno;
+
+            errno = 0;
+
+            lExpected      = strtoll(lString.c_str(), &lExpectedEnd, lBase);
+            lExpectedErrno = errno;
+
+            errno = 0;
+
+            lResult = strntoll(lString.data(), lString.size(), &lEnd, lBase);
+            NL_TEST_ASSERT(inSuite, lResult == lExpected);
+            NL_TEST_ASSERT(inSuite, lEnd == lExpectedEnd - lString.c_str() + lString.data());
+            NL_TEST_ASSERT(inSuite, errno == lExpectedErrno);
+        }
+    }
+}
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+static const nlTest sTests[] = {
+    NL_TEST_DEF("Limits",    TestLimits),
+    NL_TEST_DEF("Agreement", TestAgreement),
+
+    NL_TEST_SENTINEL()
+};
+
+int main(void)
+{
+    nlTestSuite theSuite = {
+        "strntoll",
+        &sTests[0],
+        nullptr,
+        nullptr,
+        nullptr,
+        nullptr,
+        0,
+        0,
+        0,
+        0,
+        0
+    };
+
+    // Generate human-readable output.
+    nlTestSetOutputStyle(OUTPUT_DEF);
+
+    // Run test suit againt one context.
+    nlTestRunner(&theSuite, nullptr);
+
+    return nlTestRunnerStats(&theSuite);
+}
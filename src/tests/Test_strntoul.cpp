@@ -26,12 +26,18 @@
 
 #include <errno.h>
 #include <limits.h>
+#include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
+
+#include <sys/mman.h>
 
 #include <nlunit-test.h>
 
 #include <strntoul.h>
 
+#include "strntoul/strntoul-kernel.h"
+
 
 static void TestInvalidBases(nlTestSuite *inSuite __attribute__((unused)),
                              void *inContext __attribute__((unused)))
@@ -346,6 +352,28 @@ static void TestLeadingSpace(nlTestSuite *inSuite __attribute__((unused)),
     NL_TEST_ASSERT(inSuite, lResult == 59);
     NL_TEST_ASSERT(inSuite, lEnd == lString + lLength);
     NL_TEST_ASSERT(inSuite, errno == 0);
+
+    // Space-padded columns, wider than a vector, of each of the C
+    // locale white space characters.
+
+    errno   = 0;
+    lString = "                 \n\v\f\r   \t 4096";
+    lLength = strlen(lString);
+
+    lResult = strntoul(lString, lLength, &lEnd, 10);
+    NL_TEST_ASSERT(inSuite, lResult == 4096);
+    NL_TEST_ASSERT(inSuite, lEnd == lString + lLength);
+    NL_TEST_ASSERT(inSuite, errno == 0);
+
+    // White space up to the length, and beyond it, is not a number.
+
+    lResult = strntoul(lString, 20, &lEnd, 10);
+    NL_TEST_ASSERT(inSuite, lResult == 0);
+    NL_TEST_ASSERT(inSuite, lEnd == lString);
+
+    lResult = strntoul(lString, lLength - 4, &lEnd, 10);
+    NL_TEST_ASSERT(inSuite, lResult == 0);
+    NL_TEST_ASSERT(inSuite, lEnd == lString);
 }
 
 static void TestOverflow(nlTestSuite *inSuite __attribute__((unused)),
@@ -625,6 +653,357 @@ static void TestBadHexLeading(nlTestSuite *inSuite __attribute__((unused)),
     NL_TEST_ASSERT(inSuite, errno == 0);
 }
 
+static void TestDecimalDigitRuns(nlTestSuite *inSuite __attribute__((unused)),
+                                 void *inContext __attribute__((unused)))
+{
+    const char *  lDigits = "12345678909876543210";
+    char          lString[32];
+    unsigned long lResult;
+    unsigned long lExpected;
+    char *        lEnd;
+
+    // Every run length from one to twenty digits, with and without
+    // a trailing non-digit, should agree with strtoul, whether the
+    // run fits in the conversion window or spills out of it.
+
+    for (size_t lLength = 1; lLength <= strlen(lDigits); lLength++)
+    {
+        memcpy(lString, lDigits, lLength);
+        lString[lLength]     = ',';
+        lString[lLength + 1] = '7';
+        lString[lLength + 2] = '\0';
+
+        errno     = 0;
+        lExpected = strtoul(lString, nullptr, 10);
+        NL_TEST_ASSERT(inSuite, errno == 0);
+
+        errno   = 0;
+        lResult = strntoul(lString, lLength, &lEnd, 10);
+        NL_TEST_ASSERT(inSuite, lResult == lExpected);
+        NL_TEST_ASSERT(inSuite, lEnd == lString + lLength);
+        NL_TEST_ASSERT(inSuite, errno == 0);
+
+        errno   = 0;
+        lResult = strntoul(lString, lLength + 2, &lEnd, 10);
+        NL_TEST_ASSERT(inSuite, lResult == lExpected);
+        NL_TEST_ASSERT(inSuite, lEnd == lString + lLength);
+        NL_TEST_ASSERT(inSuite, errno == 0);
+    }
+
+    // Digits beyond the length must never contribute, even when they
+    // are in the same conversion window.
+
+    errno   = 0;
+    lResult = strntoul("1234567890123456789", 3, &lEnd, 10);
+    NL_TEST_ASSERT(inSuite, lResult == 123);
+    NL_TEST_ASSERT(inSuite, errno == 0);
+
+    // Embedded characters adjacent to digits in ASCII must stop the
+    // conversion.
+
+    errno   = 0;
+    lResult = strntoul("12/34", 5, &lEnd, 10);
+    NL_TEST_ASSERT(inSuite, lResult == 12);
+    NL_TEST_ASSERT(inSuite, errno == 0);
+
+    errno   = 0;
+    lResult = strntoul("12:34", 5, &lEnd, 10);
+    NL_TEST_ASSERT(inSuite, lResult == 12);
+    NL_TEST_ASSERT(inSuite, errno == 0);
+
+    errno   = 0;
+    lResult = strntoul("12\xff""34", 5, &lEnd, 10);
+    NL_TEST_ASSERT(inSuite, lResult == 12);
+    NL_TEST_ASSERT(inSuite, errno == 0);
+
+    // Short fields of one to three digits take a direct path, which
+    // must leave signs, white space, and, for a deduced base, octal
+    // and hexadecimal prefixes to the general conversion.
+
+    lString[0] = '4';
+    lString[1] = '0';
+    lString[2] = '4';
+    lString[3] = ' ';
+
+    lResult = strntoul(lString, 4, &lEnd, 0);
+    NL_TEST_ASSERT(inSuite, (lResult == 404) && (lEnd == lString + 3));
+
+    lResult = strntoul(lString, 2, &lEnd, 10);
+    NL_TEST_ASSERT(inSuite, (lResult == 40) && (lEnd == lString + 2));
+
+    lResult = strntoul("017,", 4, &lEnd, 0);
+    NL_TEST_ASSERT(inSuite, lResult == 017);
+
+    lResult = strntoul("0x1f", 4, &lEnd, 0);
+    NL_TEST_ASSERT(inSuite, lResult == 0x1f);
+
+    lResult = strntoul("08", 2, &lEnd, 0);
+    NL_TEST_ASSERT(inSuite, lResult == 0);
+
+    lResult = strntoul("007", 3, &lEnd, 10);
+    NL_TEST_ASSERT(inSuite, lResult == 7);
+
+    lResult = strntoul("-12", 3, &lEnd, 10);
+    NL_TEST_ASSERT(inSuite, lResult == static_cast<unsigned long>(-12L));
+
+    lResult = strntoul(" 12", 3, &lEnd, 10);
+    NL_TEST_ASSERT(inSuite, (lResult == 12) && (*lEnd == '\0'));
+}
+
+static void TestPageBoundary(nlTestSuite *inSuite __attribute__((unused)),
+                             void *inContext __attribute__((unused)))
+{
+    const size_t  lPageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    char *        lPages;
+    char *        lString;
+    unsigned long lResult;
+    unsigned long lExpected;
+    char *        lEnd;
+    int           lStatus;
+
+    // Map two pages and revoke access to the second such that any
+    // read past the end of the first faults.
+
+    lPages = static_cast<char *>(mmap(nullptr,
+                                      lPageSize * 2,
+                                      PROT_READ | PROT_WRITE,
+                                      MAP_PRIVATE | MAP_ANONYMOUS,
+                                      -1,
+                                      0));
+    NL_TEST_ASSERT(inSuite, lPages != MAP_FAILED);
+
+    if (lPages == MAP_FAILED)
+        return;
+
+    lStatus = mprotect(lPages + lPageSize, lPageSize, PROT_NONE);
+    NL_TEST_ASSERT(inSuite, lStatus == 0);
+
+    // 1: Short values flush against the guard page.
+
+    lExpected = 0;
+
+    for (size_t lLength = 1; lLength <= 20; lLength++)
+    {
+        lString = lPages + lPageSize - lLength;
+
+        memset(lString, '9', lLength);
+
+        errno   = 0;
+        lResult = strntoul(lString, lLength, &lEnd, 10);
+        NL_TEST_ASSERT(inSuite, lEnd == lString + lLength);
+
+        if (lLength <= 19)
+        {
+            lExpected = (lExpected * 10) + 9;
+
+            NL_TEST_ASSERT(inSuite, lResult == lExpected);
+            NL_TEST_ASSERT(inSuite, errno == 0);
+        }
+        else
+        {
+            NL_TEST_ASSERT(inSuite, lResult == ULONG_MAX);
+            NL_TEST_ASSERT(inSuite, errno == ERANGE);
+        }
+    }
+
+    // 2: A short value followed, within the same page, by more digits
+    //    past the length.
+
+    lString = lPages + lPageSize - 16;
+
+    memcpy(lString, "4096000000000000", 16);
+
+    errno   = 0;
+    lResult = strntoul(lString, 4, &lEnd, 10);
+    NL_TEST_ASSERT(inSuite, lResult == 4096);
+    NL_TEST_ASSERT(inSuite, lEnd == lString + 4);
+    NL_TEST_ASSERT(inSuite, errno == 0);
+
+    // 3: Inputs that leave nothing to convert by the time they reach
+    //    the guard page.
+
+    static const char * const kNothing[] = { " ", "       ", "                 ", "+", "-", " -", "0x", "0X" };
+
+    for (const char *lNothing : kNothing)
+    {
+        const size_t lLength = strlen(lNothing);
+
+        lString = lPages + lPageSize - lLength;
+
+        memcpy(lString, lNothing, lLength);
+
+        lResult = strntoul(lString, lLength, &lEnd, 0);
+        NL_TEST_ASSERT(inSuite, lResult == 0);
+
+        lResult = strntoul(lString, lLength, &lEnd, 10);
+        NL_TEST_ASSERT(inSuite, lResult == 0);
+    }
+
+    lResult = strntoul(lPages + lPageSize, 0, &lEnd, 10);
+    NL_TEST_ASSERT(inSuite, lResult == 0);
+    NL_TEST_ASSERT(inSuite, lEnd == lPages + lPageSize);
+
+    munmap(lPages, lPageSize * 2);
+}
+
+static void TestRadixPageBoundary(nlTestSuite *inSuite __attribute__((unused)),
+                                  void *inContext __attribute__((unused)))
+{
+    const size_t  lPageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    char *        lPages;
+    char *        lString;
+    unsigned long lResult;
+    char *        lEnd;
+    int           lStatus;
+
+    lPages = static_cast<char *>(mmap(nullptr,
+                                      lPageSize * 2,
+                                      PROT_READ | PROT_WRITE,
+                                      MAP_PRIVATE | MAP_ANONYMOUS,
+                                      -1,
+                                      0));
+    NL_TEST_ASSERT(inSuite, lPages != MAP_FAILED);
+
+    if (lPages == MAP_FAILED)
+        return;
+
+    lStatus = mprotect(lPages + lPageSize, lPageSize, PROT_NONE);
+    NL_TEST_ASSERT(inSuite, lStatus == 0);
+
+    // 1: Binary and octal values flush against the guard page,
+    //    including those that exactly fill one and two windows.
+
+    for (size_t lLength = 1; lLength <= 66; lLength++)
+    {
+        lString = lPages + lPageSize - lLength;
+
+        memset(lString, '1', lLength);
+
+        errno   = 0;
+        lResult = strntoul(lString, lLength, &lEnd, 2);
+        NL_TEST_ASSERT(inSuite, lEnd == lString + lLength);
+        NL_TEST_ASSERT(inSuite, lResult == ((lLength >= 64) ? ULONG_MAX : ((1UL << lLength) - 1)));
+        NL_TEST_ASSERT(inSuite, errno == ((lLength > 64) ? ERANGE : 0));
+
+        memset(lString, '7', lLength);
+
+        errno   = 0;
+        lResult = strntoul(lString, lLength, &lEnd, 8);
+        NL_TEST_ASSERT(inSuite, lEnd == lString + lLength);
+        NL_TEST_ASSERT(inSuite, lResult == ((lLength > 21) ? ULONG_MAX : ((1UL << (lLength * 3)) - 1)));
+        NL_TEST_ASSERT(inSuite, errno == ((lLength > 21) ? ERANGE : 0));
+
+        // With the octal base deduced from a leading zero, followed
+        //    by at least one digit.
+
+        if (lLength > 1)
+        {
+            lString[0] = '0';
+
+            errno   = 0;
+            lResult = strntoul(lString, lLength, &lEnd, 0);
+            NL_TEST_ASSERT(inSuite, lEnd == lString + lLength);
+            NL_TEST_ASSERT(inSuite, lResult == ((lLength > 22) ? ULONG_MAX : ((1UL << ((lLength - 1) * 3)) - 1)));
+            NL_TEST_ASSERT(inSuite, errno == ((lLength > 22) ? ERANGE : 0));
+        }
+    }
+
+    // 2: Mixed octal digits that exactly fill a window.
+
+    lString = lPages + lPageSize - 16;
+
+    memcpy(lString, "0123456701234567", 16);
+
+    errno   = 0;
+    lResult = strntoul(lString, 16, &lEnd, 8);
+    NL_TEST_ASSERT(inSuite, lResult == 0123456701234567UL);
+    NL_TEST_ASSERT(inSuite, lEnd == lString + 16);
+    NL_TEST_ASSERT(inSuite, errno == 0);
+
+    munmap(lPages, lPageSize * 2);
+}
+
+static void TestKernelPageBoundary(nlTestSuite *inSuite __attribute__((unused)),
+                                   void *inContext __attribute__((unused)))
+{
+    const size_t  lPageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    char *        lPages;
+    char *        lLast;
+    int           lStatus;
+
+    lPages = static_cast<char *>(mmap(nullptr,
+                                      lPageSize * 2,
+                                      PROT_READ | PROT_WRITE,
+                                      MAP_PRIVATE | MAP_ANONYMOUS,
+                                      -1,
+                                      0));
+    NL_TEST_ASSERT(inSuite, lPages != MAP_FAILED);
+
+    if (lPages == MAP_FAILED)
+        return;
+
+    lStatus = mprotect(lPages + lPageSize, lPageSize, PROT_NONE);
+    NL_TEST_ASSERT(inSuite, lStatus == 0);
+
+    lLast = lPages + lPageSize;
+
+    // Every kernel entry point, for every length from zero through
+    // more than a window, with the input ending exactly at the guard
+    // page. An empty input lies wholly on the guard page.
+
+    memset(lPages, '7', lPageSize);
+
+    for (size_t lLength = 0; lLength <= (StrNToUL::Kernel::kWindowSize * 2); lLength++)
+    {
+        const char * const lString = lLast - lLength;
+        uint8_t            lWindow[StrNToUL::Kernel::kWindowSize];
+        unsigned long      lValue      = 0;
+        unsigned int       lShortValue = 0;
+        unsigned int       lDigits;
+
+        StrNToUL::Kernel::LoadWindow(lString, lLength, lWindow);
+        NL_TEST_ASSERT(inSuite, (lLength == 0) || (lWindow[0] == '7'));
+        NL_TEST_ASSERT(inSuite, (lLength >= StrNToUL::Kernel::kWindowSize) || (lWindow[lLength] == 0));
+
+        lDigits = StrNToUL::Kernel::ConvertDecimal(lString, lLength, lValue);
+        NL_TEST_ASSERT(inSuite, lDigits == ((lLength < 16) ? lLength : 16));
+
+        lDigits = StrNToUL::Kernel::ConvertShortDecimal(lString, lLength, lShortValue);
+        NL_TEST_ASSERT(inSuite, lDigits == ((lLength <= 3) ? lLength : 0));
+
+        NL_TEST_ASSERT(inSuite, StrNToUL::Kernel::SkipSpace(lString, lLast) == lString);
+    }
+
+    // The binary and octal kernels, which load successive windows,
+    // through and past the most digits either will convert.
+
+    memset(lPages, '1', lPageSize);
+
+    for (size_t lLength = 0; lLength <= (StrNToUL::Kernel::kWindowSize * 5); lLength++)
+    {
+        const char * const lString = lLast - lLength;
+        unsigned long      lValue  = 0;
+        unsigned int       lDigits;
+
+        lDigits = StrNToUL::Kernel::ConvertRadix<2>(lString, lLength, lValue);
+        NL_TEST_ASSERT(inSuite, lDigits == ((lLength < 8) ? 0 : ((lLength < 64) ? lLength : 64)));
+
+        lDigits = StrNToUL::Kernel::ConvertRadix<8>(lString, lLength, lValue);
+        NL_TEST_ASSERT(inSuite, lDigits == ((lLength < 8) ? 0 : ((lLength < 21) ? lLength : 21)));
+    }
+
+    memset(lPages, ' ', lPageSize);
+
+    for (size_t lLength = 0; lLength <= (StrNToUL::Kernel::kWindowSize * 2); lLength++)
+    {
+        const char * const lString = lLast - lLength;
+
+        NL_TEST_ASSERT(inSuite, StrNToUL::Kernel::SkipSpace(lString, lLast) == lLast);
+    }
+
+    munmap(lPages, lPageSize * 2);
+}
+
 /**
  *   Test Suite. It lists all the test functions.
  */
@@ -637,6 +1016,10 @@ static const nlTest sTests[] = {
     NL_TEST_DEF("Overflow",        TestOverflow),
     NL_TEST_DEF("Short Lengths",   TestShortLengths),
     NL_TEST_DEF("Bad Hex Leading", TestBadHexLeading),
+    NL_TEST_DEF("Decimal Digit Runs", TestDecimalDigitRuns),
+    NL_TEST_DEF("Page Boundary",   TestPageBoundary),
+    NL_TEST_DEF("Radix Page Boundary", TestRadixPageBoundary),
+    NL_TEST_DEF("Kernel Page Boundary", TestKernelPageBoundary),
 
     NL_TEST_SENTINEL()
 };
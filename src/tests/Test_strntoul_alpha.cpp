@@ -0,0 +1,327 @@
+/*
+ *    Copyright (c) 2024 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *    @file
+ *      This file implements a unit test for converting strings of
+ *      digits drawn from arbitrary alphabets.
+ *
+ */
+
+#include <errno.h>
+#include <limits.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <string>
+
+#include <nlunit-test.h>
+
+#include <strntoul.h>
+#include <strntoul_alpha.h>
+
+
+static const char kBase58Digits[] = "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
+static const char kBase62Digits[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz";
+
+/**
+ *  Encode @a aValue with the digits @a aDigits.
+ *
+ */
+static std::string Encode(unsigned long aValue, const char *aDigits)
+{
+    const unsigned long lRadix = strlen(aDigits);
+    std::string         lRetval;
+
+    do
+    {
+        lRetval.insert(lRetval.begin(), aDigits[aValue % lRadix]);
+
+        aValue /= lRadix;
+    } while (aValue != 0);
+
+    return (lRetval);
+}
+
+static void TestCreate(nlTestSuite *inSuite __attribute__((unused)),
+                       void *inContext __attribute__((unused)))
+{
+    strntoul_alphabet_t *lAlphabet;
+    std::string          lDigits;
+    char *               lEnd;
+    int                  lStatus;
+
+    lStatus = strntoul_alphabet_create(nullptr, &lAlphabet);
+    NL_TEST_ASSERT(inSuite, lStatus == -EINVAL);
+
+    lStatus = strntoul_alphabet_create("01", nullptr);
+    NL_TEST_ASSERT(inSuite, lStatus == -EINVAL);
+
+    lStatus = strntoul_alphabet_create("0", &lAlphabet);
+    NL_TEST_ASSERT(inSuite, lStatus == -EINVAL);
+
+    lStatus = strntoul_alphabet_create("0120", &lAlphabet);
+    NL_TEST_ASSERT(inSuite, lStatus == -EINVAL);
+
+    for (int i = 1; i <= UCHAR_MAX; i++)
+    {
+        lDigits += static_cast<char>(i);
+    }
+
+    lStatus = strntoul_alphabet_create(lDigits.c_str(), &lAlphabet);
+    NL_TEST_ASSERT(inSuite, lStatus == 0);
+
+    NL_TEST_ASSERT(inSuite, strntoul_alpha("\x02\x03\xff", 3, &lEnd, lAlphabet) == ((((1UL * 255) + 2) * 255) + 254));
+
+    strntoul_alphabet_destroy(lAlphabet);
+    strntoul_alphabet_destroy(nullptr);
+
+    errno = 0;
+
+    NL_TEST_ASSERT(inSuite, strntoul_alpha("1", 1, &lEnd, nullptr) == 0);
+    NL_TEST_ASSERT(inSuite, errno == EINVAL);
+}
+
+static void TestBuiltin(nlTestSuite *inSuite __attribute__((unused)),
+                        void *inContext __attribute__((unused)))
+{
+    static const strntoul_alphabet_t * const kAlphabets[] = {
+        &strntoul_alphabet_base58,
+        &strntoul_alphabet_base62
+    };
+    static const char * const                kDigits[]    = {
+        kBase58Digits,
+        kBase62Digits
+    };
+    const char *                             lString;
+    char *                                   lEnd;
+    unsigned long                            lValue;
+    uint64_t                                 lState       = 0x9E3779B97F4A7C15ULL;
+
+    // 1: Known values.
+
+    lString = "zz";
+
+    lValue = strntoul_alpha(lString, strlen(lString), &lEnd, &strntoul_alphabet_base62);
+    NL_TEST_ASSERT(inSuite, (lValue == ((61UL * 62) + 61)) && (lEnd == lString + 2));
+
+    lString = "21";
+
+    lValue = strntoul_alpha(lString, strlen(lString), &lEnd, &strntoul_alphabet_base58);
+    NL_TEST_ASSERT(inSuite, (lValue == 58) && (lEnd == lString + 2));
+
+    // 2: Bytes outside of base 58 end the conversion.
+
+    lString = "2O";
+
+    lValue = strntoul_alpha(lString, strlen(lString), &lEnd, &strntoul_alphabet_base58);
+    NL_TEST_ASSERT(inSuite, (lValue == 1) && (lEnd == lString + 1));
+
+    lString = "0";
+
+    lValue = strntoul_alpha(lString, strlen(lString), &lEnd, &strntoul_alphabet_base58);
+    NL_TEST_ASSERT(inSuite, (lValue == 0) && (lEnd == lString));
+
+    // 3: Round trips, from the largest value down.
+
+    for (size_t i = 0; i < (sizeof (kAlphabets) / sizeof (kAlphabets[0])); i++)
+    {
+        unsigned long lExpected = ULONG_MAX;
+
+        for (size_t j = 0; j < 2000; j++)
+        {
+            const std::string lEncoded = Encode(lExpected, kDigits[i]);
+
+            errno = 0;
+
+            lValue = strntoul_alpha(lEncoded.data(), lEncoded.size(), &lEnd, kAlphabets[i]);
+            NL_TEST_ASSERT(inSuite, lValue == lExpected);
+            NL_TEST_ASSERT(inSuite, lEnd == lEncoded.data() + lEncoded.size());
+            NL_TEST_ASSERT(inSuite, errno == 0);
+
+            lState ^= lState << 13;
+            lState ^= lState >> 7;
+            lState ^= lState << 17;
+
+            lExpected = static_cast<unsigned long>(lState >> (lState % 64));
+        }
+
+        // 4: One more digit than the largest value overflows, but is
+        // still consumed.
+
+        {
+            const std::string lEncoded = Encode(ULONG_MAX, kDigits[i]) + kDigits[i][1];
+
+            errno = 0;
+
+            lValue = strntoul_alpha(lEncoded.data(), lEncoded.size(), &lEnd, kAlphabets[i]);
+            NL_TEST_ASSERT(inSuite, lValue == ULONG_MAX);
+            NL_TEST_ASSERT(inSuite, lEnd == lEncoded.data() + lEncoded.size());
+            NL_TEST_ASSERT(inSuite, errno == ERANGE);
+        }
+    }
+}
+
+static void TestAgreement(nlTestSuite *inSuite __attribute__((unused)),
+                          void *inContext __attribute__((unused)))
+{
+    static const char    kAlphabet[] = " \t+-0123456789abcdefghijklmnopqrstuvwxyz!";
+    strntoul_alphabet_t *lAlphabet;
+    uint64_t             lState      = 0xD1B54A32D192ED03ULL;
+    int                  lStatus;
+
+    // With the base 36 digits, but only their lowercase letters, a
+    // conversion is exactly that of strntoul.
+
+    lStatus = strntoul_alphabet_create("0123456789abcdefghijklmnopqrstuvwxyz", &lAlphabet);
+    NL_TEST_ASSERT(inSuite, lStatus == 0);
+
+    for (size_t i = 0; i < 20000; i++)
+    {
+        char          lString[32];
+        size_t        lLength;
+        char *        lExpectedEnd;
+        char *        lEnd;
+        unsigned long lExpected;
+        unsigned long lValue;
+        int           lExpectedErrno;
+
+        lState ^= lState << 13;
+        lState ^= lState >> 7;
+        lState ^= lState << 17;
+
+        lLength = static_cast<size_t>(lState % sizeof (lString));
+
+        for (size_t j = 0; j < lLength; j++)
+        {
+            // Favor digits, so that most strings convert.
+
+            const uint64_t lPick = (lState >> ((j % 8) * 8)) ^ (j * 0x9E37U);
+
+            lString[j] = (((lPick & 3) == 0) ?
+                          kAlphabet[lPick % (sizeof (kAlphabet) - 1)] :
+                          kAlphabet[4 + (lPick % 36)]);
+        }
+
+        errno = 0;
+
+        lExpected      = strntoul(lString, lLength, &lExpectedEnd, 36);
+        lExpectedErrno = errno;
+
+        errno = 0;
+
+        lValue = strntoul_alpha(lString, lLength, &lEnd, lAlphabet);
+        NL_TEST_ASSERT(inSuite, lValue == lExpected);
+        NL_TEST_ASSERT(inSuite, lEnd == lExpectedEnd);
+        NL_TEST_ASSERT(inSuite, errno == lExpectedErrno);
+    }
+
+    strntoul_alphabet_destroy(lAlphabet);
+
+    // A sign that is also a digit, as in base64url, is a digit.
+
+    lStatus = strntoul_alphabet_create("-_0123456789", &lAlphabet);
+    NL_TEST_ASSERT(inSuite, lStatus == 0);
+
+    {
+        const char *  lString = "-1";
+        char *        lEnd;
+        unsigned long lValue;
+
+        lValue = strntoul_alpha(lString, strlen(lString), &lEnd, lAlphabet);
+        NL_TEST_ASSERT(inSuite, (lValue == 3) && (lEnd == lString + 2));
+    }
+
+    strntoul_alphabet_destroy(lAlphabet);
+}
+
+static void TestBatch(nlTestSuite *inSuite __attribute__((unused)),
+                      void *inContext __attribute__((unused)))
+{
+    static const char * const kStrings[] = {
+        "1",
+        "4ZXcXo",
+        " -2",
+        "0OIl",
+        "",
+        "3yQ!"
+    };
+    static const size_t       kCount     = sizeof (kStrings) / sizeof (kStrings[0]);
+    strntoul_span_t           lSpans[kCount];
+    unsigned long             lValues[kCount];
+    char *                    lEnds[kCount];
+    size_t                    lConverted;
+
+    for (size_t i = 0; i < kCount; i++)
+    {
+        lSpans[i].mString = kStrings[i];
+        lSpans[i].mLength = strlen(kStrings[i]);
+    }
+
+    lConverted = strntoul_alpha_batch(lSpans, kCount, lValues, lEnds, &strntoul_alphabet_base58);
+    NL_TEST_ASSERT(inSuite, lConverted == 3);
+
+    for (size_t i = 0; i < kCount; i++)
+    {
+        char *              lEnd;
+        const unsigned long lExpected = strntoul_alpha(lSpans[i].mString, lSpans[i].mLength, &lEnd, &strntoul_alphabet_base58);
+
+        NL_TEST_ASSERT(inSuite, lValues[i] == lExpected);
+        NL_TEST_ASSERT(inSuite, lEnds[i] == lEnd);
+    }
+
+    lConverted = strntoul_alpha_batch(lSpans, kCount, lValues, nullptr, nullptr);
+    NL_TEST_ASSERT(inSuite, (lConverted == 0) && (lValues[1] == 0));
+}
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+static const nlTest sTests[] = {
+    NL_TEST_DEF("Create",    TestCreate),
+    NL_TEST_DEF("Builtin",   TestBuiltin),
+    NL_TEST_DEF("Agreement", TestAgreement),
+    NL_TEST_DEF("Batch",     TestBatch),
+
+    NL_TEST_SENTINEL()
+};
+
+int main(void)
+{
+    nlTestSuite theSuite = {
+        "strntoul_alpha",
+        &sTests[0],
+        nullptr,
+        nullptr,
+        nullptr,
+        nullptr,
+        0,
+        0,
+        0,
+        0,
+        0
+    };
+
+    // Generate human-readable output.
+    nlTestSetOutputStyle(OUTPUT_DEF);
+
+    // Run test suit againt one context.
+    nlTestRunner(&theSuite, nullptr);
+
+    return nlTestRunnerStats(&theSuite);
+}
@@ -0,0 +1,215 @@
+/*
+ *    Copyright (c) 2024 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *    @file
+ *      This file implements a unit test for strntoul_batch.
+ *
+ */
+
+#include <errno.h>
+#include <limits.h>
+#include <string.h>
+
+#include <nlunit-test.h>
+
+#include <strntoul.h>
+#include <strntoul_batch.h>
+
+
+// A mix of spans that the vertical kernel converts and spans that it
+// must leave to strntoul.
+
+static const char * const sStrings[] = {
+    "7",
+    "42",
+    "200",
+    "8080",
+    "65535",
+    "100000",
+    "1234567",
+    "98765432",
+    "999999999",
+    "1000000000",
+    "18446744073709551615",
+    "18446744073709551616",
+    "",
+    " 12",
+    "-12",
+    "+12",
+    "12a",
+    "a12",
+    "0",
+    "007",
+    "0x1f",
+    "000000000",
+    "9/",
+    "12:30",
+    "5"
+};
+
+static const size_t sCount = sizeof (sStrings) / sizeof (sStrings[0]);
+
+static void CheckBatch(nlTestSuite *inSuite, const strntoul_span_t *aSpans, const size_t &aCount, const int &aBase)
+{
+    unsigned long lValues[sCount];
+    char *        lEnds[sCount];
+    size_t        lConverted;
+    size_t        lExpectedConverted = 0;
+
+    errno = 0;
+
+    lConverted = strntoul_batch(aSpans, aCount, lValues, lEnds, aBase);
+
+    for (size_t i = 0; i < aCount; i++)
+    {
+        unsigned long lExpected;
+        char *        lExpectedEnd;
+
+        lExpected = strntoul(aSpans[i].mString, aSpans[i].mLength, &lExpectedEnd, aBase);
+
+        NL_TEST_ASSERT(inSuite, lValues[i] == lExpected);
+        NL_TEST_ASSERT(inSuite, lEnds[i] == lExpectedEnd);
+
+        if ((aSpans[i].mLength > 0) && (lExpectedEnd == aSpans[i].mString + aSpans[i].mLength))
+        {
+            lExpectedConverted++;
+        }
+    }
+
+    NL_TEST_ASSERT(inSuite, lConverted == lExpectedConverted);
+}
+
+static void TestAgreesWithStrntoul(nlTestSuite *inSuite __attribute__((unused)),
+                                   void *inContext __attribute__((unused)))
+{
+    strntoul_span_t lSpans[sCount];
+
+    for (size_t i = 0; i < sCount; i++)
+    {
+        lSpans[i].mString = sStrings[i];
+        lSpans[i].mLength = strlen(sStrings[i]);
+    }
+
+    // Every prefix of the span array, such that both full and partial
+    // groups of lanes are exercised, in the bases that use the
+    // vertical kernel and one that does not.
+
+    for (size_t lCount = 0; lCount <= sCount; lCount++)
+    {
+        CheckBatch(inSuite, lSpans, lCount, 10);
+        CheckBatch(inSuite, lSpans, lCount, 0);
+        CheckBatch(inSuite, lSpans, lCount, 16);
+    }
+}
+
+static void TestBoundedSpans(nlTestSuite *inSuite __attribute__((unused)),
+                             void *inContext __attribute__((unused)))
+{
+    const char *    lBuffer = "123456789";
+    strntoul_span_t lSpans[9];
+    unsigned long   lValues[9];
+    char *          lEnds[9];
+    size_t          lConverted;
+
+    // Overlapping spans into one buffer, none of which may see past
+    // its own length.
+
+    for (size_t i = 0; i < 9; i++)
+    {
+        lSpans[i].mString = lBuffer;
+        lSpans[i].mLength = i + 1;
+    }
+
+    errno = 0;
+
+    lConverted = strntoul_batch(lSpans, 9, lValues, lEnds, 10);
+    NL_TEST_ASSERT(inSuite, lConverted == 9);
+    NL_TEST_ASSERT(inSuite, errno == 0);
+
+    NL_TEST_ASSERT(inSuite, lValues[0] == 1);
+    NL_TEST_ASSERT(inSuite, lValues[2] == 123);
+    NL_TEST_ASSERT(inSuite, lValues[5] == 123456);
+    NL_TEST_ASSERT(inSuite, lValues[8] == 123456789);
+
+    for (size_t i = 0; i < 9; i++)
+    {
+        NL_TEST_ASSERT(inSuite, lEnds[i] == lBuffer + i + 1);
+    }
+
+    // A null end pointer array is permitted.
+
+    lConverted = strntoul_batch(lSpans, 9, lValues, nullptr, 10);
+    NL_TEST_ASSERT(inSuite, lConverted == 9);
+    NL_TEST_ASSERT(inSuite, lValues[3] == 1234);
+}
+
+static void TestOverflow(nlTestSuite *inSuite __attribute__((unused)),
+                         void *inContext __attribute__((unused)))
+{
+    strntoul_span_t lSpans[2];
+    unsigned long   lValues[2];
+
+    lSpans[0].mString = "12";
+    lSpans[0].mLength = 2;
+    lSpans[1].mString = "147573952589676412927";
+    lSpans[1].mLength = strlen(lSpans[1].mString);
+
+    errno = 0;
+
+    strntoul_batch(lSpans, 2, lValues, nullptr, 10);
+    NL_TEST_ASSERT(inSuite, lValues[0] == 12);
+    NL_TEST_ASSERT(inSuite, lValues[1] == ULONG_MAX);
+    NL_TEST_ASSERT(inSuite, errno == ERANGE);
+}
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+static const nlTest sTests[] = {
+    NL_TEST_DEF("Agrees With strntoul", TestAgreesWithStrntoul),
+    NL_TEST_DEF("Bounded Spans",        TestBoundedSpans),
+    NL_TEST_DEF("Overflow",             TestOverflow),
+
+    NL_TEST_SENTINEL()
+};
+
+int main(void)
+{
+    nlTestSuite theSuite = {
+        "strntoul_batch",
+        &sTests[0],
+        nullptr,
+        nullptr,
+        nullptr,
+        nullptr,
+        0,
+        0,
+        0,
+        0,
+        0
+    };
+
+    // Generate human-readable output.
+    nlTestSetOutputStyle(OUTPUT_DEF);
+
+    // Run test suit againt one context.
+    nlTestRunner(&theSuite, nullptr);
+
+    return nlTestRunnerStats(&theSuite);
+}
@@ -0,0 +1,211 @@
+/*
+ *    Copyright (c) 2024 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *    @file
+ *      This file implements a unit test for strntoul_compare and
+ *      strntoul_filter.
+ *
+ */
+
+#include <errno.h>
+#include <limits.h>
+#include <string.h>
+
+#include <nlunit-test.h>
+
+#include <strntoul.h>
+#include <strntoul_compare.h>
+
+
+static const char * const sStrings[] = {
+    "",
+    "0",
+    "000",
+    "5",
+    "4999",
+    "5000",
+    "5001",
+    "05000",
+    "  5000",
+    "+5000",
+    "-5000",
+    "50000",
+    "5000ms",
+    "ms",
+    "0x1388",
+    "0x",
+    "1388",
+    "zz",
+    "18446744073709551615",
+    "18446744073709551616",
+    "99999999999999999999999"
+};
+
+static const unsigned long sThresholds[] = {
+    0,
+    5,
+    5000,
+    0x1388,
+    ULONG_MAX
+};
+
+static const int sBases[] = {
+    8,
+    10,
+    16,
+    36
+};
+
+static int Sign(const int &aValue)
+{
+    return ((aValue < 0) ? -1 : ((aValue > 0) ? 1 : 0));
+}
+
+static void TestInvalidThreshold(nlTestSuite *inSuite __attribute__((unused)),
+                                 void *inContext __attribute__((unused)))
+{
+    strntoul_threshold_t lThreshold;
+    int                  lStatus;
+
+    lStatus = strntoul_threshold_init(nullptr, 5000, 10);
+    NL_TEST_ASSERT(inSuite, lStatus == -EINVAL);
+
+    lStatus = strntoul_threshold_init(&lThreshold, 5000, 0);
+    NL_TEST_ASSERT(inSuite, lStatus == -EINVAL);
+
+    lStatus = strntoul_threshold_init(&lThreshold, 5000, 1);
+    NL_TEST_ASSERT(inSuite, lStatus == -EINVAL);
+
+    lStatus = strntoul_threshold_init(&lThreshold, 5000, 37);
+    NL_TEST_ASSERT(inSuite, lStatus == -EINVAL);
+}
+
+static void TestAgreesWithStrntoul(nlTestSuite *inSuite __attribute__((unused)),
+                                   void *inContext __attribute__((unused)))
+{
+    // Every string against every threshold in every base should
+    // compare exactly as the value and end strntoul produces.
+
+    for (const int lBase : sBases)
+    {
+        for (const unsigned long lValue : sThresholds)
+        {
+            strntoul_threshold_t lThreshold;
+            int                  lStatus;
+
+            lStatus = strntoul_threshold_init(&lThreshold, lValue, lBase);
+            NL_TEST_ASSERT(inSuite, lStatus == 0);
+
+            for (const char *lString : sStrings)
+            {
+                const size_t  lLength = strlen(lString);
+                unsigned long lExpected;
+                char *        lExpectedEnd;
+                char *        lEnd;
+                int           lComparison;
+
+                lExpected = strntoul(lString, lLength, &lExpectedEnd, lBase);
+
+                errno = 0;
+
+                lComparison = strntoul_compare(lString, lLength, &lEnd, &lThreshold);
+                NL_TEST_ASSERT(inSuite, Sign(lComparison) == ((lExpected < lValue) ? -1 : ((lExpected > lValue) ? 1 : 0)));
+                NL_TEST_ASSERT(inSuite, lEnd == lExpectedEnd);
+                NL_TEST_ASSERT(inSuite, errno == 0);
+            }
+        }
+    }
+}
+
+static void TestFilter(nlTestSuite *inSuite __attribute__((unused)),
+                       void *inContext __attribute__((unused)))
+{
+    const char *         lBuffer = "120,5000,7200,,4999,x,65000,5001";
+    strntoul_threshold_t lThreshold;
+    unsigned char        lBitmap[2];
+    size_t               lFields;
+
+    strntoul_threshold_init(&lThreshold, 5000, 10);
+
+    // Fields:  0: 120, 1: 5000, 2: 7200, 3: (empty), 4: 4999, 5: x,
+    //          6: 65000, 7: 5001
+
+    memset(lBitmap, 0xFF, sizeof (lBitmap));
+
+    lFields = strntoul_filter(lBuffer, strlen(lBuffer), ',', &lThreshold, STRNTOUL_PREDICATE_GT, lBitmap, 16);
+    NL_TEST_ASSERT(inSuite, lFields == 8);
+    NL_TEST_ASSERT(inSuite, lBitmap[0] == 0xC4);
+    NL_TEST_ASSERT(inSuite, lBitmap[1] == 0xFF);
+
+    lFields = strntoul_filter(lBuffer, strlen(lBuffer), ',', &lThreshold, STRNTOUL_PREDICATE_LE, lBitmap, 16);
+    NL_TEST_ASSERT(inSuite, lFields == 8);
+    NL_TEST_ASSERT(inSuite, lBitmap[0] == 0x13);
+
+    lFields = strntoul_filter(lBuffer, strlen(lBuffer), ',', &lThreshold, STRNTOUL_PREDICATE_EQ, lBitmap, 16);
+    NL_TEST_ASSERT(inSuite, lFields == 8);
+    NL_TEST_ASSERT(inSuite, lBitmap[0] == 0x02);
+
+    lFields = strntoul_filter(lBuffer, strlen(lBuffer), ',', &lThreshold, STRNTOUL_PREDICATE_NE, lBitmap, 16);
+    NL_TEST_ASSERT(inSuite, lFields == 8);
+    NL_TEST_ASSERT(inSuite, lBitmap[0] == 0xD5);
+
+    // The capacity bounds the fields filtered.
+
+    lBitmap[0] = 0;
+
+    lFields = strntoul_filter(lBuffer, strlen(lBuffer), ',', &lThreshold, STRNTOUL_PREDICATE_GE, lBitmap, 3);
+    NL_TEST_ASSERT(inSuite, lFields == 3);
+    NL_TEST_ASSERT(inSuite, lBitmap[0] == 0x06);
+}
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+static const nlTest sTests[] = {
+    NL_TEST_DEF("Invalid Threshold",    TestInvalidThreshold),
+    NL_TEST_DEF("Agrees With strntoul", TestAgreesWithStrntoul),
+    NL_TEST_DEF("Filter",               TestFilter),
+
+    NL_TEST_SENTINEL()
+};
+
+int main(void)
+{
+    nlTestSuite theSuite = {
+        "strntoul_compare",
+        &sTests[0],
+        nullptr,
+        nullptr,
+        nullptr,
+        nullptr,
+        0,
+        0,
+        0,
+        0,
+        0
+    };
+
+    // Generate human-readable output.
+    nlTestSetOutputStyle(OUTPUT_DEF);
+
+    // Run test suit againt one context.
+    nlTestRunner(&theSuite, nullptr);
+
+    return nlTestRunnerStats(&theSuite);
+}
@@ -0,0 +1,335 @@
+/*
+ *    Copyright (c) 2024 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+
+/**
+ *    @file
+ *      This file implements a unit test for the strntoul file follow
+ *      interfaces.
+ *
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <sys/stat.h>
+
+#include <string>
+#include <vector>
+
+#include <nlunit-test.h>
+
+#include <strntoul_follow.h>
+
+
+static char sPath[]           = "/tmp/Test_strntoul_follow.XXXXXX";
+static char sRotatedPath[sizeof (sPath) + 2];
+static char sCheckpointPath[sizeof (sPath) + 4];
+
+static bool Append(const char *aPath, const char *aContents)
+{
+    FILE *lFile = fopen(aPath, "a");
+    bool  lRetval;
+
+    if (lFile == nullptr)
+    {
+        return (false);
+    }
+
+    lRetval = (fwrite(aContents, 1, strlen(aContents), lFile) == strlen(aContents));
+
+    return ((fclose(lFile) == 0) && lRetval);
+}
+
+static int Collect(const unsigned long *aValues, size_t aCount, void *aContext)
+{
+    std::vector<unsigned long> &lValues = *static_cast<std::vector<unsigned long> *>(aContext);
+
+    lValues.insert(lValues.end(), aValues, aValues + aCount);
+
+    return (0);
+}
+
+static int Stop(const unsigned long *aValues, size_t aCount, void *aContext)
+{
+    Collect(aValues, aCount, aContext);
+
+    return (-ECANCELED);
+}
+
+static bool Update(strntoul_follow_t *aFollow, const std::vector<unsigned long> &aExpected, int aEvents = 0)
+{
+    std::vector<unsigned long> lValues;
+    strntoul_ingest_stats_t    lStats;
+
+    return ((strntoul_follow_update(aFollow, Collect, &lValues, &lStats) == aEvents) &&
+            (lValues == aExpected) &&
+            (lStats.mCount == aExpected.size()));
+}
+
+static void TestInvalidArguments(nlTestSuite *inSuite __attribute__((unused)),
+                                 void *inContext __attribute__((unused)))
+{
+    strntoul_ingest_options_t    lOptions = { 0, 0, '\n', 37 };
+    strntoul_follow_checkpoint_t lCheckpoint;
+    strntoul_follow_t *          lFollow;
+
+    NL_TEST_ASSERT(inSuite, strntoul_follow_open(nullptr, nullptr, nullptr, &lFollow) == -EINVAL);
+    NL_TEST_ASSERT(inSuite, strntoul_follow_open(sPath, nullptr, nullptr, nullptr) == -EINVAL);
+    NL_TEST_ASSERT(inSuite, strntoul_follow_open(sPath, &lOptions, nullptr, &lFollow) == -EINVAL);
+    NL_TEST_ASSERT(inSuite, strntoul_follow_open("/nonexistent/strntoul", nullptr, nullptr, &lFollow) == -ENOENT);
+
+    NL_TEST_ASSERT(inSuite, strntoul_follow_update(nullptr, nullptr, nullptr, nullptr) == -EINVAL);
+    NL_TEST_ASSERT(inSuite, strntoul_follow_wait(nullptr, 0) == -EINVAL);
+    NL_TEST_ASSERT(inSuite, strntoul_follow_get_checkpoint(nullptr, &lCheckpoint) == -EINVAL);
+
+    // A file that is not a checkpoint is malformed.
+
+    NL_TEST_ASSERT(inSuite, strntoul_follow_checkpoint_load(sPath, &lCheckpoint) == -EINVAL);
+    NL_TEST_ASSERT(inSuite, strntoul_follow_checkpoint_load(sCheckpointPath, &lCheckpoint) == -ENOENT);
+
+    strntoul_follow_close(nullptr);
+}
+
+static void TestAppend(nlTestSuite *inSuite __attribute__((unused)),
+                       void *inContext __attribute__((unused)))
+{
+    strntoul_follow_checkpoint_t lCheckpoint;
+    strntoul_follow_checkpoint_t lLoaded;
+    strntoul_follow_t *          lFollow;
+    int                          lStatus;
+
+    NL_TEST_ASSERT(inSuite, Append(sPath, "1\n2\n3"));
+
+    lStatus = strntoul_follow_open(sPath, nullptr, nullptr, &lFollow);
+    NL_TEST_ASSERT(inSuite, lStatus == 0);
+
+    if (lStatus != 0)
+    {
+        return;
+    }
+
+    // The last field is incomplete until its delimiter is appended.
+
+    NL_TEST_ASSERT(inSuite, Update(lFollow, { 1, 2 }));
+    NL_TEST_ASSERT(inSuite, strntoul_follow_wait(lFollow, 0) == 0);
+
+    NL_TEST_ASSERT(inSuite, Append(sPath, "4\n5\n6"));
+    NL_TEST_ASSERT(inSuite, strntoul_follow_wait(lFollow, 1000) == 1);
+    NL_TEST_ASSERT(inSuite, Update(lFollow, { 34, 5 }));
+    NL_TEST_ASSERT(inSuite, Update(lFollow, { }));
+
+    // A checkpoint, persisted and loaded, resumes where the follower
+    // left off, incomplete field included.
+
+    NL_TEST_ASSERT(inSuite, strntoul_follow_get_checkpoint(lFollow, &lCheckpoint) == 0);
+    NL_TEST_ASSERT(inSuite, (lCheckpoint.mOffset == 10) && (lCheckpoint.mPartialLength == 1));
+
+    strntoul_follow_close(lFollow);
+
+    NL_TEST_ASSERT(inSuite, strntoul_follow_checkpoint_save(&lCheckpoint, sCheckpointPath) == 0);
+    NL_TEST_ASSERT(inSuite, strntoul_follow_checkpoint_load(sCheckpointPath, &lLoaded) == 0);
+    NL_TEST_ASSERT(inSuite, (lLoaded.mInode == lCheckpoint.mInode) && (lLoaded.mOffset == 10));
+    NL_TEST_ASSERT(inSuite, (lLoaded.mPartialLength == 1) && (lLoaded.mPartial[0] == '6'));
+
+    NL_TEST_ASSERT(inSuite, Append(sPath, "7\n8\n"));
+
+    lStatus = strntoul_follow_open(sPath, nullptr, &lLoaded, &lFollow);
+    NL_TEST_ASSERT(inSuite, lStatus == 0);
+
+    if (lStatus != 0)
+    {
+        return;
+    }
+
+    NL_TEST_ASSERT(inSuite, Update(lFollow, { 67, 8 }));
+
+    strntoul_follow_close(lFollow);
+}
+
+static void TestTruncate(nlTestSuite *inSuite __attribute__((unused)),
+                         void *inContext __attribute__((unused)))
+{
+    strntoul_follow_checkpoint_t lCheckpoint;
+    strntoul_follow_t *          lFollow;
+    int                          lStatus;
+
+    lStatus = strntoul_follow_open(sPath, nullptr, nullptr, &lFollow);
+    NL_TEST_ASSERT(inSuite, lStatus == 0);
+
+    if (lStatus != 0)
+    {
+        return;
+    }
+
+    NL_TEST_ASSERT(inSuite, Update(lFollow, { 1, 2, 34, 5, 67, 8 }));
+    NL_TEST_ASSERT(inSuite, strntoul_follow_get_checkpoint(lFollow, &lCheckpoint) == 0);
+
+    // A file truncated in place is converted again from its start,
+    // whether found by an update or on resuming from a checkpoint.
+
+    NL_TEST_ASSERT(inSuite, truncate(sPath, 0) == 0);
+    NL_TEST_ASSERT(inSuite, Append(sPath, "9\n"));
+    NL_TEST_ASSERT(inSuite, strntoul_follow_wait(lFollow, 1000) == 1);
+    NL_TEST_ASSERT(inSuite, Update(lFollow, { 9 }, STRNTOUL_FOLLOW_TRUNCATED));
+
+    strntoul_follow_close(lFollow);
+
+    lStatus = strntoul_follow_open(sPath, nullptr, &lCheckpoint, &lFollow);
+    NL_TEST_ASSERT(inSuite, lStatus == 0);
+
+    if (lStatus != 0)
+    {
+        return;
+    }
+
+    NL_TEST_ASSERT(inSuite, Update(lFollow, { 9 }, STRNTOUL_FOLLOW_TRUNCATED));
+    NL_TEST_ASSERT(inSuite, Update(lFollow, { }));
+
+    strntoul_follow_close(lFollow);
+}
+
+static void TestRotate(nlTestSuite *inSuite __attribute__((unused)),
+                       void *inContext __attribute__((unused)))
+{
+    strntoul_follow_checkpoint_t lCheckpoint;
+    strntoul_follow_t *          lFollow;
+    std::vector<unsigned long>   lValues;
+    struct stat                  lStat;
+    int                          lStatus;
+
+    lStatus = strntoul_follow_open(sPath, nullptr, nullptr, &lFollow);
+    NL_TEST_ASSERT(inSuite, lStatus == 0);
+
+    if (lStatus != 0)
+    {
+        return;
+    }
+
+    NL_TEST_ASSERT(inSuite, Update(lFollow, { 9 }));
+    NL_TEST_ASSERT(inSuite, strntoul_follow_get_checkpoint(lFollow, &lCheckpoint) == 0);
+
+    // Until a new file is created, anything appended to the rotated
+    // file is still converted. Thereafter, the rotated file is
+    // converted to its end, including its final, undelimited field,
+    // and then the new file from its start.
+
+    NL_TEST_ASSERT(inSuite, rename(sPath, sRotatedPath) == 0);
+    NL_TEST_ASSERT(inSuite, Append(sRotatedPath, "10\n"));
+    NL_TEST_ASSERT(inSuite, Update(lFollow, { 10 }));
+
+    NL_TEST_ASSERT(inSuite, Append(sRotatedPath, "11"));
+    NL_TEST_ASSERT(inSuite, Append(sPath, "12\n13"));
+    NL_TEST_ASSERT(inSuite, strntoul_follow_wait(lFollow, 1000) == 1);
+    NL_TEST_ASSERT(inSuite, Update(lFollow, { 11, 12 }, STRNTOUL_FOLLOW_ROTATED));
+
+    strntoul_follow_close(lFollow);
+
+    // Resuming from a checkpoint of the rotated file follows the new
+    // file from its start.
+
+    lStatus = strntoul_follow_open(sPath, nullptr, &lCheckpoint, &lFollow);
+    NL_TEST_ASSERT(inSuite, lStatus == 0);
+
+    if (lStatus != 0)
+    {
+        return;
+    }
+
+    NL_TEST_ASSERT(inSuite, Update(lFollow, { 12 }, STRNTOUL_FOLLOW_ROTATED));
+
+    // If the callback stops while the rotated file is being finished,
+    // here on its final field, the rotated file is kept until an
+    // update completes it and switches.
+
+    NL_TEST_ASSERT(inSuite, rename(sPath, sRotatedPath) == 0);
+    NL_TEST_ASSERT(inSuite, Append(sPath, "14\n"));
+    NL_TEST_ASSERT(inSuite, stat(sRotatedPath, &lStat) == 0);
+
+    NL_TEST_ASSERT(inSuite, strntoul_follow_update(lFollow, Stop, &lValues, nullptr) == -ECANCELED);
+    NL_TEST_ASSERT(inSuite, lValues == std::vector<unsigned long>({ 13 }));
+    NL_TEST_ASSERT(inSuite, strntoul_follow_get_checkpoint(lFollow, &lCheckpoint) == 0);
+    NL_TEST_ASSERT(inSuite, lCheckpoint.mInode == static_cast<uint64_t>(lStat.st_ino));
+    NL_TEST_ASSERT(inSuite, (lCheckpoint.mOffset == 5) && (lCheckpoint.mPartialLength == 0));
+
+    NL_TEST_ASSERT(inSuite, strntoul_follow_wait(lFollow, 0) == 1);
+    NL_TEST_ASSERT(inSuite, Update(lFollow, { 14 }, STRNTOUL_FOLLOW_ROTATED));
+    NL_TEST_ASSERT(inSuite, Update(lFollow, { }));
+
+    strntoul_follow_close(lFollow);
+
+    unlink(sRotatedPath);
+}
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+static const nlTest sTests[] = {
+    NL_TEST_DEF("Invalid Arguments", TestInvalidArguments),
+    NL_TEST_DEF("Append",            TestAppend),
+    NL_TEST_DEF("Truncate",          TestTruncate),
+    NL_TEST_DEF("Rotate",            TestRotate),
+
+    NL_TEST_SENTINEL()
+};
+
+int main(void)
+{
+    nlTestSuite theSuite = {
+        "strntoul_follow",
+        &sTests[0],
+        nullptr,
+        nullptr,
+        nullptr,
+        nullptr,
+        0,
+        0,
+        0,
+        0,
+        0
+    };
+    int lDescriptor;
+
+    lDescriptor = mkstemp(sPath);
+
+    if (lDescriptor < 0)
+    {
+        return (EXIT_FAILURE);
+    }
+
+    close(lDescriptor);
+
+    snprintf(sRotatedPath, sizeof (sRotatedPath), "%s.1", sPath);
+    snprintf(sCheckpointPath, sizeof (sCheckpointPath), "%s.ckp", sPath);
+
+    // Generate human-readable output.
+    nlTestSetOutputStyle(OUTPUT_DEF);
+
+    // Run test suit againt one context.
+    nlTestRunner(&theSuite, nullptr);
+
+    unlink(sCheckpointPath);
+    unlink(sRotatedPath);
+    unlink(sPath);
+
+    return nlTestRunnerStats(&theSuite);
+}
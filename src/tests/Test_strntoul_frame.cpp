@@ -0,0 +1,427 @@
+/*
+ *    Copyright (c) 2024 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+
+/**
+ *    @file
+ *      This file implements a unit test for the protocol header
+ *      parsers.
+ *
+ */
+
+#include <errno.h>
+#include <limits.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <sys/mman.h>
+
+#include <string>
+
+#include <nlunit-test.h>
+
+#include <strntoul_frame.h>
+
+
+/**
+ *  Return whether every proper prefix of @a aHeader is reported as
+ *  incomplete.
+ *
+ */
+template <typename T, typename Parser>
+static bool
+IsIncrementallyIncomplete(const std::string &aHeader, Parser aParser)
+{
+    for (size_t i = 0; i < aHeader.size(); i++)
+    {
+        T lFrame;
+
+        if (aParser(aHeader.data(), i, &lFrame) != -EAGAIN)
+        {
+            return (false);
+        }
+    }
+
+    return (true);
+}
+
+/**
+ *  Return whether every proper prefix of @a aHeader, each copied such
+ *  that it ends exactly at @a aLast, is reported as incomplete.
+ *
+ */
+template <typename T, typename Parser>
+static bool
+IsIncompleteAt(char *aLast, const std::string &aHeader, Parser aParser)
+{
+    for (size_t i = 0; i < aHeader.size(); i++)
+    {
+        char * const lBuffer = aLast - i;
+        T            lFrame;
+
+        memcpy(lBuffer, aHeader.data(), i);
+
+        if (aParser(lBuffer, i, &lFrame) != -EAGAIN)
+        {
+            return (false);
+        }
+    }
+
+    return (true);
+}
+
+static int
+ParseResp(const char *aBuffer, size_t aLength, strntoul_frame_t *aFrame)
+{
+    return (strntoul_frame_resp(aBuffer, aLength, nullptr, aFrame));
+}
+
+static void TestResp(nlTestSuite *inSuite __attribute__((unused)),
+                     void *inContext __attribute__((unused)))
+{
+    static const char * const kIncomplete[] = {
+        "$5\r\n",
+        "*3\r\n",
+        "$-1\r\n",
+        ":-42\r\n",
+        "+OK\r\n",
+        "$1234567890123456789\r\n"
+    };
+    static const char * const kMalformed[] = {
+        "$5\n",
+        "$\r\n",
+        "$a\r\n",
+        "$5 \r\n",
+        "$+5\r\n",
+        "$-2\r\n",
+        "$-10\r\n",
+        "*5\rx",
+        "?5\r\n",
+        "$000000000000000000000"
+    };
+    strntoul_frame_t lFrame;
+    std::string      lBuffer;
+    char             lType;
+    int              lStatus;
+
+    // A bulk string, whose payload and CRLF are part of the frame.
+
+    lBuffer = "$5\r\nhello\r\n";
+
+    lStatus = strntoul_frame_resp(lBuffer.data(), lBuffer.size(), &lType, &lFrame);
+    NL_TEST_ASSERT(inSuite, lStatus == 0);
+    NL_TEST_ASSERT(inSuite, lType == '$');
+    NL_TEST_ASSERT(inSuite, lFrame.mValue == 5);
+    NL_TEST_ASSERT(inSuite, lFrame.mHeaderLength == 4);
+    NL_TEST_ASSERT(inSuite, lFrame.mFrameLength == lBuffer.size());
+
+    // An array, whose elements follow its frame.
+
+    lBuffer = "*3\r\n$3\r\nSET\r\n";
+
+    lStatus = strntoul_frame_resp(lBuffer.data(), lBuffer.size(), &lType, &lFrame);
+    NL_TEST_ASSERT(inSuite, (lStatus == 0) && (lType == '*'));
+    NL_TEST_ASSERT(inSuite, (lFrame.mValue == 3) && (lFrame.mHeaderLength == 4) && (lFrame.mFrameLength == 4));
+
+    lStatus = strntoul_frame_resp(lBuffer.data() + 4, lBuffer.size() - 4, &lType, &lFrame);
+    NL_TEST_ASSERT(inSuite, (lStatus == 0) && (lType == '$'));
+    NL_TEST_ASSERT(inSuite, (lFrame.mValue == 3) && (lFrame.mFrameLength == 9));
+
+    // Nulls.
+
+    lStatus = strntoul_frame_resp("$-1\r\n", 5, &lType, &lFrame);
+    NL_TEST_ASSERT(inSuite, (lStatus == 0) && (lFrame.mValue == -1) && (lFrame.mFrameLength == 5));
+
+    lStatus = strntoul_frame_resp("*-1\r\n", 5, &lType, &lFrame);
+    NL_TEST_ASSERT(inSuite, (lStatus == 0) && (lFrame.mValue == -1) && (lFrame.mFrameLength == 5));
+
+    // Integers, through the full signed range.
+
+    lStatus = strntoul_frame_resp(":-42\r\n", 6, &lType, &lFrame);
+    NL_TEST_ASSERT(inSuite, (lStatus == 0) && (lType == ':') && (lFrame.mValue == -42));
+
+    lBuffer = ":-9223372036854775808\r\n";
+
+    lStatus = strntoul_frame_resp(lBuffer.data(), lBuffer.size(), &lType, &lFrame);
+    NL_TEST_ASSERT(inSuite, (lStatus == 0) && (lFrame.mValue == LLONG_MIN));
+
+    lBuffer = ":9223372036854775808\r\n";
+
+    lStatus = strntoul_frame_resp(lBuffer.data(), lBuffer.size(), &lType, &lFrame);
+    NL_TEST_ASSERT(inSuite, lStatus == -ERANGE);
+
+    lBuffer = "$99999999999999999999\r\n";
+
+    lStatus = strntoul_frame_resp(lBuffer.data(), lBuffer.size(), &lType, &lFrame);
+    NL_TEST_ASSERT(inSuite, lStatus == -ERANGE);
+
+    // Lines.
+
+    lStatus = strntoul_frame_resp("+OK\r\n", 5, &lType, &lFrame);
+    NL_TEST_ASSERT(inSuite, (lStatus == 0) && (lType == '+') && (lFrame.mFrameLength == 5));
+
+    lStatus = strntoul_frame_resp("-ERR no\r\n", 9, &lType, &lFrame);
+    NL_TEST_ASSERT(inSuite, (lStatus == 0) && (lType == '-') && (lFrame.mFrameLength == 9));
+
+    // Each header, delivered a byte at a time, needs more until it is
+    // complete.
+
+    for (const char *lHeader : kIncomplete)
+    {
+        NL_TEST_ASSERT(inSuite, IsIncrementallyIncomplete<strntoul_frame_t>(lHeader, ParseResp));
+    }
+
+    for (const char *lHeader : kMalformed)
+    {
+        lStatus = strntoul_frame_resp(lHeader, strlen(lHeader), &lType, &lFrame);
+        NL_TEST_ASSERT(inSuite, lStatus == -EBADMSG);
+    }
+
+    lStatus = strntoul_frame_resp(nullptr, 1, &lType, &lFrame);
+    NL_TEST_ASSERT(inSuite, lStatus == -EINVAL);
+
+    lStatus = strntoul_frame_resp("+OK\r\n", 5, &lType, nullptr);
+    NL_TEST_ASSERT(inSuite, lStatus == -EINVAL);
+}
+
+static void TestMemcached(nlTestSuite *inSuite __attribute__((unused)),
+                          void *inContext __attribute__((unused)))
+{
+    static const char * const kMalformed[] = {
+        "VALUE  0 1\r\n",
+        "VALUE foo 0 12x\r\n",
+        "VALUE foo 0 12 \r\n",
+        "VALUE foo  12\r\n",
+        "VALUE foo 0 12\n",
+        "VALUE fo\to 0 12\r\n",
+        "ERROR\r\n",
+        "value foo 0 12\r\n"
+    };
+    strntoul_memcached_value_t lValue;
+    std::string                lBuffer;
+    int                        lStatus;
+
+    lBuffer = "VALUE foo 0 123\r\n";
+
+    lStatus = strntoul_frame_memcached(lBuffer.data(), lBuffer.size(), &lValue);
+    NL_TEST_ASSERT(inSuite, lStatus == 1);
+    NL_TEST_ASSERT(inSuite, (lValue.mKeyLength == 3) && (memcmp(lValue.mKey, "foo", 3) == 0));
+    NL_TEST_ASSERT(inSuite, (lValue.mFlags == 0) && (lValue.mHasCas == 0) && (lValue.mCas == 0));
+    NL_TEST_ASSERT(inSuite, lValue.mFrame.mValue == 123);
+    NL_TEST_ASSERT(inSuite, lValue.mFrame.mHeaderLength == lBuffer.size());
+    NL_TEST_ASSERT(inSuite, lValue.mFrame.mFrameLength == (lBuffer.size() + 123 + 2));
+
+    lBuffer = "VALUE user:42 4294967295 0 18446744073709551615\r\n";
+
+    lStatus = strntoul_frame_memcached(lBuffer.data(), lBuffer.size(), &lValue);
+    NL_TEST_ASSERT(inSuite, lStatus == 1);
+    NL_TEST_ASSERT(inSuite, (lValue.mKeyLength == 7) && (lValue.mFlags == 4294967295UL));
+    NL_TEST_ASSERT(inSuite, (lValue.mHasCas != 0) && (lValue.mCas == 18446744073709551615ULL));
+    NL_TEST_ASSERT(inSuite, (lValue.mFrame.mValue == 0) && (lValue.mFrame.mFrameLength == (lBuffer.size() + 2)));
+
+    NL_TEST_ASSERT(inSuite, IsIncrementallyIncomplete<strntoul_memcached_value_t>(lBuffer, strntoul_frame_memcached));
+
+    lStatus = strntoul_frame_memcached("END\r\n", 5, &lValue);
+    NL_TEST_ASSERT(inSuite, (lStatus == 0) && (lValue.mFrame.mFrameLength == 5));
+
+    NL_TEST_ASSERT(inSuite, IsIncrementallyIncomplete<strntoul_memcached_value_t>("END\r\n", strntoul_frame_memcached));
+
+    // Out of range flags.
+
+    lBuffer = "VALUE foo 4294967296 1\r\n";
+
+    lStatus = strntoul_frame_memcached(lBuffer.data(), lBuffer.size(), &lValue);
+    NL_TEST_ASSERT(inSuite, lStatus == -ERANGE);
+
+    // A key may be no longer than 250 bytes.
+
+    lBuffer = "VALUE " + std::string(250, 'k') + " 0 1\r\n";
+
+    lStatus = strntoul_frame_memcached(lBuffer.data(), lBuffer.size(), &lValue);
+    NL_TEST_ASSERT(inSuite, (lStatus == 1) && (lValue.mKeyLength == 250));
+
+    lBuffer = "VALUE " + std::string(251, 'k');
+
+    lStatus = strntoul_frame_memcached(lBuffer.data(), lBuffer.size(), &lValue);
+    NL_TEST_ASSERT(inSuite, lStatus == -EBADMSG);
+
+    for (const char *lHeader : kMalformed)
+    {
+        lStatus = strntoul_frame_memcached(lHeader, strlen(lHeader), &lValue);
+        NL_TEST_ASSERT(inSuite, lStatus == -EBADMSG);
+    }
+}
+
+static void TestChunk(nlTestSuite *inSuite __attribute__((unused)),
+                      void *inContext __attribute__((unused)))
+{
+    static const char * const kMalformed[] = {
+        "1a\n",
+        "\r\n",
+        "g\r\n",
+        "0x10\r\n",
+        "1a x\r\n",
+        "1a;ext\n\r\n",
+        "1a\r\r",
+        "000000000000000000001\r\n"
+    };
+    strntoul_frame_t lFrame;
+    std::string      lBuffer;
+    int              lStatus;
+
+    lStatus = strntoul_frame_chunk("1a\r\n", 4, &lFrame);
+    NL_TEST_ASSERT(inSuite, lStatus == 0);
+    NL_TEST_ASSERT(inSuite, (lFrame.mValue == 0x1a) && (lFrame.mHeaderLength == 4));
+    NL_TEST_ASSERT(inSuite, lFrame.mFrameLength == (4 + 0x1a + 2));
+
+    // The last chunk, whose trailer section follows its frame.
+
+    lStatus = strntoul_frame_chunk("0\r\n\r\n", 5, &lFrame);
+    NL_TEST_ASSERT(inSuite, (lStatus == 0) && (lFrame.mValue == 0) && (lFrame.mFrameLength == 3));
+
+    // Chunk extensions are skipped.
+
+    lBuffer = "FF ; name=\"value\";other\r\n";
+
+    lStatus = strntoul_frame_chunk(lBuffer.data(), lBuffer.size(), &lFrame);
+    NL_TEST_ASSERT(inSuite, (lStatus == 0) && (lFrame.mValue == 0xff));
+    NL_TEST_ASSERT(inSuite, lFrame.mHeaderLength == lBuffer.size());
+
+    NL_TEST_ASSERT(inSuite, IsIncrementallyIncomplete<strntoul_frame_t>(lBuffer, strntoul_frame_chunk));
+
+    lBuffer = "7fffffffffffffff\r\n";
+
+    lStatus = strntoul_frame_chunk(lBuffer.data(), lBuffer.size(), &lFrame);
+    NL_TEST_ASSERT(inSuite, (sizeof (size_t) > 4) ? ((lStatus == 0) && (lFrame.mValue == LLONG_MAX)) : (lStatus == -ERANGE));
+
+    lBuffer = "8000000000000000\r\n";
+
+    lStatus = strntoul_frame_chunk(lBuffer.data(), lBuffer.size(), &lFrame);
+    NL_TEST_ASSERT(inSuite, lStatus == -ERANGE);
+
+    // The line, with any extensions, is bounded.
+
+    lBuffer = "1;" + std::string(5000, 'x');
+
+    lStatus = strntoul_frame_chunk(lBuffer.data(), lBuffer.size(), &lFrame);
+    NL_TEST_ASSERT(inSuite, lStatus == -EBADMSG);
+
+    for (const char *lHeader : kMalformed)
+    {
+        lStatus = strntoul_frame_chunk(lHeader, strlen(lHeader), &lFrame);
+        NL_TEST_ASSERT(inSuite, lStatus == -EBADMSG);
+    }
+}
+
+static void TestPageBoundary(nlTestSuite *inSuite __attribute__((unused)),
+                             void *inContext __attribute__((unused)))
+{
+    static const char * const kResp[] = {
+        "$5\r\n",
+        "*3\r\n",
+        ":-42\r\n",
+        "$1234567890123456789\r\n"
+    };
+    static const char * const kMemcached[] = {
+        "VALUE k 0 5\r\n",
+        "VALUE k 0 5 7\r\n",
+        "VALUE k 4294967295 18446744073709551615 18446744073709551615\r\n"
+    };
+    static const char * const kChunk[] = {
+        "1a\r\n",
+        "1a;ext=1\r\n"
+    };
+    const size_t lPageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    char *       lPages;
+    char *       lLast;
+    int          lStatus;
+
+    // Partial headers, among them those that end just before a
+    // numeric field, such as "$", "*" and "VALUE k 0 ", that end
+    // exactly at a guard page.
+
+    lPages = static_cast<char *>(mmap(nullptr,
+                                      lPageSize * 2,
+                                      PROT_READ | PROT_WRITE,
+                                      MAP_PRIVATE | MAP_ANONYMOUS,
+                                      -1,
+                                      0));
+    NL_TEST_ASSERT(inSuite, lPages != MAP_FAILED);
+
+    if (lPages == MAP_FAILED)
+        return;
+
+    lStatus = mprotect(lPages + lPageSize, lPageSize, PROT_NONE);
+    NL_TEST_ASSERT(inSuite, lStatus == 0);
+
+    lLast = lPages + lPageSize;
+
+    for (const char *lHeader : kResp)
+    {
+        NL_TEST_ASSERT(inSuite, IsIncompleteAt<strntoul_frame_t>(lLast, lHeader, ParseResp));
+    }
+
+    for (const char *lHeader : kMemcached)
+    {
+        NL_TEST_ASSERT(inSuite, IsIncompleteAt<strntoul_memcached_value_t>(lLast, lHeader, strntoul_frame_memcached));
+    }
+
+    for (const char *lHeader : kChunk)
+    {
+        NL_TEST_ASSERT(inSuite, IsIncompleteAt<strntoul_frame_t>(lLast, lHeader, strntoul_frame_chunk));
+    }
+
+    munmap(lPages, lPageSize * 2);
+}
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+static const nlTest sTests[] = {
+    NL_TEST_DEF("RESP",      TestResp),
+    NL_TEST_DEF("Memcached", TestMemcached),
+    NL_TEST_DEF("Chunk",     TestChunk),
+    NL_TEST_DEF("Page Boundary", TestPageBoundary),
+
+    NL_TEST_SENTINEL()
+};
+
+int main(void)
+{
+    nlTestSuite theSuite = {
+        "strntoul_frame",
+        &sTests[0],
+        nullptr,
+        nullptr,
+        nullptr,
+        nullptr,
+        0,
+        0,
+        0,
+        0,
+        0
+    };
+
+    // Generate human-readable output.
+    nlTestSetOutputStyle(OUTPUT_DEF);
+
+    // Run test suit againt one context.
+    nlTestRunner(&theSuite, nullptr);
+
+    return nlTestRunnerStats(&theSuite);
+}
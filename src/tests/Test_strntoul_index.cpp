@@ -0,0 +1,221 @@
+/*
+ *    Copyright (c) 2024 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *    @file
+ *      This file implements a unit test for the strntoul structural
+ *      index.
+ *
+ */
+
+#include <errno.h>
+#include <limits.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+#include <nlunit-test.h>
+
+#include <strntoul.h>
+#include <strntoul_index.h>
+
+
+static void TestInvalidArguments(nlTestSuite *inSuite __attribute__((unused)),
+                                 void *inContext __attribute__((unused)))
+{
+    strntoul_index_t *lIndex;
+    int               lStatus;
+
+    lStatus = strntoul_index_build("1", 1, nullptr);
+    NL_TEST_ASSERT(inSuite, lStatus == -EINVAL);
+
+    lStatus = strntoul_index_build(nullptr, 1, &lIndex);
+    NL_TEST_ASSERT(inSuite, lStatus == -EINVAL);
+
+    // An empty buffer has neither numbers nor lines.
+
+    lStatus = strntoul_index_build(nullptr, 0, &lIndex);
+    NL_TEST_ASSERT(inSuite, lStatus == 0);
+
+    if (lStatus == 0)
+    {
+        NL_TEST_ASSERT(inSuite, strntoul_index_numbers(lIndex) == 0);
+        NL_TEST_ASSERT(inSuite, strntoul_index_lines(lIndex) == 0);
+        NL_TEST_ASSERT(inSuite, strntoul_index_line_number(lIndex, 0, 0) == STRNTOUL_INDEX_NONE);
+
+        errno = 0;
+        NL_TEST_ASSERT(inSuite, strntoul_index_value(lIndex, 0) == 0);
+        NL_TEST_ASSERT(inSuite, errno == EINVAL);
+
+        strntoul_index_destroy(lIndex);
+    }
+}
+
+static void TestLookups(nlTestSuite *inSuite __attribute__((unused)),
+                        void *inContext __attribute__((unused)))
+{
+    const char *      lBuffer = "GET /a/17 200 5120\nPUT /b 404\n\n99999999999999999999 x7y\n";
+    strntoul_index_t *lIndex;
+    const char *      lNumber;
+    size_t            lLength;
+    int               lStatus;
+
+    lStatus = strntoul_index_build(lBuffer, strlen(lBuffer), &lIndex);
+    NL_TEST_ASSERT(inSuite, lStatus == 0);
+
+    if (lStatus != 0)
+    {
+        return;
+    }
+
+    NL_TEST_ASSERT(inSuite, strntoul_index_numbers(lIndex) == 6);
+    NL_TEST_ASSERT(inSuite, strntoul_index_lines(lIndex) == 4);
+
+    lNumber = strntoul_index_number(lIndex, 2, &lLength);
+    NL_TEST_ASSERT(inSuite, lNumber == lBuffer + 14);
+    NL_TEST_ASSERT(inSuite, lLength == 4);
+    NL_TEST_ASSERT(inSuite, strntoul_index_number(lIndex, 6, &lLength) == nullptr);
+
+    NL_TEST_ASSERT(inSuite, strntoul_index_line_number(lIndex, 0, 0) == 0);
+    NL_TEST_ASSERT(inSuite, strntoul_index_line_number(lIndex, 0, 2) == 2);
+    NL_TEST_ASSERT(inSuite, strntoul_index_line_number(lIndex, 0, 3) == STRNTOUL_INDEX_NONE);
+    NL_TEST_ASSERT(inSuite, strntoul_index_line_number(lIndex, 1, 0) == 3);
+    NL_TEST_ASSERT(inSuite, strntoul_index_line_number(lIndex, 2, 0) == STRNTOUL_INDEX_NONE);
+    NL_TEST_ASSERT(inSuite, strntoul_index_line_number(lIndex, 3, 1) == 5);
+    NL_TEST_ASSERT(inSuite, strntoul_index_line_number(lIndex, 4, 0) == STRNTOUL_INDEX_NONE);
+
+    errno = 0;
+
+    NL_TEST_ASSERT(inSuite, strntoul_index_value(lIndex, strntoul_index_line_number(lIndex, 0, 1)) == 200);
+    NL_TEST_ASSERT(inSuite, strntoul_index_value(lIndex, strntoul_index_line_number(lIndex, 1, 0)) == 404);
+    NL_TEST_ASSERT(inSuite, strntoul_index_value(lIndex, 5) == 7);
+    NL_TEST_ASSERT(inSuite, errno == 0);
+
+    NL_TEST_ASSERT(inSuite, strntoul_index_value(lIndex, 4) == ULONG_MAX);
+    NL_TEST_ASSERT(inSuite, errno == ERANGE);
+
+    strntoul_index_destroy(lIndex);
+}
+
+static void TestBlockBoundaries(nlTestSuite *inSuite __attribute__((unused)),
+                                void *inContext __attribute__((unused)))
+{
+    // Place runs and newlines across, and ending on, every 64-byte
+    // block boundary and compare against a sequential walk.
+
+    for (size_t lPadding = 0; lPadding < 70; lPadding++)
+    {
+        std::string                lBuffer(lPadding, ' ');
+        std::vector<unsigned long> lExpected;
+        std::vector<size_t>        lExpectedLines;
+        strntoul_index_t *         lIndex;
+        int                        lStatus;
+        size_t                     lWords;
+        const uint64_t *           lBitmap;
+
+        for (unsigned long i = 1; lBuffer.size() < 200; i = (i * 7) + 3)
+        {
+            lBuffer += std::to_string(i % 1000000007UL);
+            lBuffer += (((i % 3) == 0) ? '\n' : ',');
+        }
+
+        lBuffer += "12";
+
+        for (size_t i = 0; i < lBuffer.size(); i++)
+        {
+            if ((lBuffer[i] >= '0') && (lBuffer[i] <= '9') && ((i == 0) || (lBuffer[i - 1] < '0') || (lBuffer[i - 1] > '9')))
+            {
+                lExpected.push_back(strntoul(&lBuffer[i], lBuffer.size() - i, nullptr, 10));
+            }
+
+            if ((i == 0) || (lBuffer[i - 1] == '\n'))
+            {
+                lExpectedLines.push_back(i);
+            }
+        }
+
+        lStatus = strntoul_index_build(lBuffer.data(), lBuffer.size(), &lIndex);
+        NL_TEST_ASSERT(inSuite, lStatus == 0);
+
+        if (lStatus != 0)
+        {
+            continue;
+        }
+
+        NL_TEST_ASSERT(inSuite, strntoul_index_numbers(lIndex) == lExpected.size());
+        NL_TEST_ASSERT(inSuite, strntoul_index_lines(lIndex) == lExpectedLines.size());
+
+        for (size_t i = 0; i < lExpected.size(); i++)
+        {
+            NL_TEST_ASSERT(inSuite, strntoul_index_value(lIndex, i) == lExpected[i]);
+        }
+
+        // The bitmaps agree with the offsets.
+
+        lBitmap = strntoul_index_bitmap(lIndex, STRNTOUL_INDEX_BITMAP_LINES, &lWords);
+        NL_TEST_ASSERT(inSuite, lWords == ((lBuffer.size() / 64) + 1));
+
+        for (size_t i = 0; i < lExpectedLines.size(); i++)
+        {
+            NL_TEST_ASSERT(inSuite, ((lBitmap[lExpectedLines[i] / 64] >> (lExpectedLines[i] % 64)) & 1) != 0);
+        }
+
+        lBitmap = strntoul_index_bitmap(lIndex, STRNTOUL_INDEX_BITMAP_ENDS, nullptr);
+        NL_TEST_ASSERT(inSuite, ((lBitmap[lBuffer.size() / 64] >> (lBuffer.size() % 64)) & 1) != 0);
+
+        strntoul_index_destroy(lIndex);
+    }
+}
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+static const nlTest sTests[] = {
+    NL_TEST_DEF("Invalid Arguments", TestInvalidArguments),
+    NL_TEST_DEF("Lookups",           TestLookups),
+    NL_TEST_DEF("Block Boundaries",  TestBlockBoundaries),
+
+    NL_TEST_SENTINEL()
+};
+
+int main(void)
+{
+    nlTestSuite theSuite = {
+        "strntoul_index",
+        &sTests[0],
+        nullptr,
+        nullptr,
+        nullptr,
+        nullptr,
+        0,
+        0,
+        0,
+        0,
+        0
+    };
+
+    // Generate human-readable output.
+    nlTestSetOutputStyle(OUTPUT_DEF);
+
+    // Run test suit againt one context.
+    nlTestRunner(&theSuite, nullptr);
+
+    return nlTestRunnerStats(&theSuite);
+}
@@ -0,0 +1,285 @@
+/*
+ *    Copyright (c) 2024 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+
+/**
+ *    @file
+ *      This file implements a unit test for the strntoul file
+ *      ingestion interfaces.
+ *
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <string>
+
+#include <nlunit-test.h>
+
+#include <strntoul_ingest.h>
+
+
+static char sPath[] = "/tmp/Test_strntoul_ingest.XXXXXX";
+
+struct Totals
+{
+    unsigned long mSum;
+    size_t        mCount;
+    size_t        mCalls;
+    size_t        mStopAfter;
+};
+
+static bool WriteFile(const std::string &aContents)
+{
+    FILE *lFile = fopen(sPath, "w");
+    bool  lRetval;
+
+    if (lFile == nullptr)
+    {
+        return (false);
+    }
+
+    lRetval = (fwrite(aContents.data(), 1, aContents.size(), lFile) == aContents.size());
+
+    return ((fclose(lFile) == 0) && lRetval);
+}
+
+static int Accumulate(const unsigned long *aValues, size_t aCount, void *aContext)
+{
+    Totals &lTotals = *static_cast<Totals *>(aContext);
+
+    for (size_t i = 0; i < aCount; i++)
+    {
+        lTotals.mSum += aValues[i];
+    }
+
+    lTotals.mCount += aCount;
+    lTotals.mCalls++;
+
+    return (((lTotals.mStopAfter != 0) && (lTotals.mCalls == lTotals.mStopAfter)) ? -ECANCELED : 0);
+}
+
+static void TestInvalidArguments(nlTestSuite *inSuite __attribute__((unused)),
+                                 void *inContext __attribute__((unused)))
+{
+    strntoul_ingest_options_t lOptions = { 0, 0, '\n', 1 };
+
+    NL_TEST_ASSERT(inSuite, strntoul_ingest_path(sPath, &lOptions, nullptr, nullptr, nullptr) == -EINVAL);
+
+    lOptions.mBase    = 10;
+    lOptions.mBuffers = 1;
+
+    NL_TEST_ASSERT(inSuite, strntoul_ingest_path(sPath, &lOptions, nullptr, nullptr, nullptr) == -EINVAL);
+
+    NL_TEST_ASSERT(inSuite, strntoul_ingest_path(nullptr, nullptr, nullptr, nullptr, nullptr) == -EINVAL);
+    NL_TEST_ASSERT(inSuite, strntoul_ingest_path("/nonexistent/strntoul", nullptr, nullptr, nullptr, nullptr) == -ENOENT);
+    NL_TEST_ASSERT(inSuite, strntoul_ingest(-1, nullptr, nullptr, nullptr, nullptr) == -EBADF);
+}
+
+static void TestBoundaries(nlTestSuite *inSuite __attribute__((unused)),
+                           void *inContext __attribute__((unused)))
+{
+    strntoul_ingest_options_t lOptions = { 4096, 2, '\n', 10 };
+    strntoul_ingest_stats_t   lStats;
+    Totals                    lTotals  = { 0, 0, 0, 0 };
+    std::string               lContents;
+    unsigned long             lSum     = 0;
+    size_t                    lCount   = 0;
+    unsigned long             lValue   = 1;
+    int                       lStatus;
+
+    // Values of every width, at small buffers, straddle every kind of
+    // boundary: before, within, and after a value and its delimiter.
+
+    for (size_t i = 0; i < 50000; i++)
+    {
+        lValue = (lValue * 6364136223846793005UL) + 1442695040888963407UL;
+
+        const unsigned long lField = lValue >> (i % 64);
+
+        lContents += std::to_string(lField) + "\n";
+        lSum      += lField;
+        lCount++;
+
+        if ((i % 997) == 0)
+        {
+            lContents += "\n  x \n";
+        }
+    }
+
+    // A field too long to carry is invalid, as is one too large.
+
+    lContents += std::string(9000, '7') + "\n";
+    lContents += "99999999999999999999999\n";
+
+    // The last value need not be delimited.
+
+    lContents += " 42";
+    lSum      += 42;
+    lCount++;
+
+    NL_TEST_ASSERT(inSuite, WriteFile(lContents));
+
+    errno = 0;
+
+    lStatus = strntoul_ingest_path(sPath, &lOptions, Accumulate, &lTotals, &lStats);
+    NL_TEST_ASSERT(inSuite, lStatus == 0);
+    NL_TEST_ASSERT(inSuite, errno == ERANGE);
+    NL_TEST_ASSERT(inSuite, lTotals.mSum == lSum);
+    NL_TEST_ASSERT(inSuite, lTotals.mCount == lCount);
+    NL_TEST_ASSERT(inSuite, lStats.mCount == lCount);
+    NL_TEST_ASSERT(inSuite, lStats.mInvalid == ((50000 / 997) + 1 + 2));
+    NL_TEST_ASSERT(inSuite, lStats.mBytes == lContents.size());
+
+    // Other delimiters and bases convert likewise.
+
+    NL_TEST_ASSERT(inSuite, WriteFile("ff,10,x,7f"));
+
+    lOptions.mDelimiter = ',';
+    lOptions.mBase      = 16;
+    lTotals.mSum        = 0;
+
+    lStatus = strntoul_ingest_path(sPath, &lOptions, Accumulate, &lTotals, &lStats);
+    NL_TEST_ASSERT(inSuite, lStatus == 0);
+    NL_TEST_ASSERT(inSuite, lTotals.mSum == (0xff + 0x10 + 0x7f));
+    NL_TEST_ASSERT(inSuite, (lStats.mCount == 3) && (lStats.mInvalid == 1));
+}
+
+static void TestDescriptor(nlTestSuite *inSuite __attribute__((unused)),
+                           void *inContext __attribute__((unused)))
+{
+    strntoul_ingest_options_t lOptions = { 4096, 3, '\n', 10 };
+    strntoul_ingest_stats_t   lStats;
+    Totals                    lTotals  = { 0, 0, 0, 0 };
+    std::string               lContents;
+    int                       lDescriptors[2];
+    int                       lDescriptor;
+    int                       lStatus;
+
+    for (size_t i = 0; i < 10000; i++)
+    {
+        lContents += std::to_string(i) + "\n";
+    }
+
+    NL_TEST_ASSERT(inSuite, WriteFile(lContents));
+
+    // Conversion starts at the current offset, here after the values
+    // zero through four, and, when stopped early, leaves the
+    // descriptor after the last byte converted.
+
+    lDescriptor = open(sPath, O_RDONLY);
+    NL_TEST_ASSERT(inSuite, lDescriptor >= 0);
+
+    if (lDescriptor < 0)
+    {
+        return;
+    }
+
+    NL_TEST_ASSERT(inSuite, lseek(lDescriptor, 10, SEEK_SET) == 10);
+
+    lTotals.mStopAfter = 2;
+
+    lStatus = strntoul_ingest(lDescriptor, &lOptions, Accumulate, &lTotals, &lStats);
+    NL_TEST_ASSERT(inSuite, lStatus == -ECANCELED);
+    NL_TEST_ASSERT(inSuite, lTotals.mCalls == 2);
+    NL_TEST_ASSERT(inSuite, lStats.mBytes == (2 * 4096));
+    NL_TEST_ASSERT(inSuite, lseek(lDescriptor, 0, SEEK_CUR) == (10 + (2 * 4096)));
+
+    lseek(lDescriptor, 10, SEEK_SET);
+
+    lTotals.mSum       = 0;
+    lTotals.mCount     = 0;
+    lTotals.mStopAfter = 0;
+
+    lStatus = strntoul_ingest(lDescriptor, &lOptions, Accumulate, &lTotals, &lStats);
+    NL_TEST_ASSERT(inSuite, lStatus == 0);
+    NL_TEST_ASSERT(inSuite, lTotals.mCount == (10000 - 5));
+    NL_TEST_ASSERT(inSuite, lTotals.mSum == (((9999UL * 10000UL) / 2) - 10));
+    NL_TEST_ASSERT(inSuite, lseek(lDescriptor, 0, SEEK_CUR) == static_cast<off_t>(lContents.size()));
+
+    close(lDescriptor);
+
+    // A pipe is not seekable, so it is read as data arrives.
+
+    NL_TEST_ASSERT(inSuite, pipe(lDescriptors) == 0);
+
+    NL_TEST_ASSERT(inSuite, write(lDescriptors[1], "1\n2\n3", 5) == 5);
+
+    close(lDescriptors[1]);
+
+    lTotals.mSum   = 0;
+    lTotals.mCount = 0;
+
+    lStatus = strntoul_ingest(lDescriptors[0], nullptr, Accumulate, &lTotals, &lStats);
+    NL_TEST_ASSERT(inSuite, lStatus == 0);
+    NL_TEST_ASSERT(inSuite, (lTotals.mSum == 6) && (lTotals.mCount == 3));
+
+    close(lDescriptors[0]);
+}
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+static const nlTest sTests[] = {
+    NL_TEST_DEF("Invalid Arguments", TestInvalidArguments),
+    NL_TEST_DEF("Boundaries",        TestBoundaries),
+    NL_TEST_DEF("Descriptor",        TestDescriptor),
+
+    NL_TEST_SENTINEL()
+};
+
+int main(void)
+{
+    nlTestSuite theSuite = {
+        "strntoul_ingest",
+        &sTests[0],
+        nullptr,
+        nullptr,
+        nullptr,
+        nullptr,
+        0,
+        0,
+        0,
+        0,
+        0
+    };
+    int lDescriptor;
+
+    lDescriptor = mkstemp(sPath);
+
+    if (lDescriptor < 0)
+    {
+        return (EXIT_FAILURE);
+    }
+
+    close(lDescriptor);
+
+    // Generate human-readable output.
+    nlTestSetOutputStyle(OUTPUT_DEF);
+
+    // Run test suit againt one context.
+    nlTestRunner(&theSuite, nullptr);
+
+    unlink(sPath);
+
+    return nlTestRunnerStats(&theSuite);
+}
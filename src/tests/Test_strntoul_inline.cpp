@@ -0,0 +1,169 @@
+/*
+ *    Copyright (c) 2024 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *    @file
+ *      This file implements a unit test for the header-only, inline
+ *      definitions of strntoul and strntol.
+ *
+ */
+
+#include <errno.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <string>
+
+#include <nlunit-test.h>
+
+#include <strntol.h>
+#include <strntoul.h>
+#include <strntoul_inline.h>
+
+static void TestAgreement(nlTestSuite *inSuite __attribute__((unused)),
+                          void *inContext __attribute__((unused)))
+{
+    static const char kAlphabet[] = " \t+-0123456789abcdefxzXZ";
+    static const int  kBases[]    = { 0, 2, 8, 10, 16, 36 };
+    uint64_t          lState      = 0x9E3779B97F4A7C15ULL;
+
+    // The inline definitions, included alongside the library's
+    // declarations, convert exactly as the library's do.
+
+    for (int lBase : kBases)
+    {
+        for (size_t i = 0; i < 4000; i++)
+        {
+            std::string lString;
+            size_t      lLength;
+
+            lState ^= lState << 13;
+            lState ^= lState >> 7;
+            lState ^= lState << 17;
+
+            lLength = static_cast<size_t>(lState % 32);
+
+            for (size_t j = 0; j < lLength; j++)
+            {
+                // Favor digits, so that most strings convert.
+
+                const uint64_t lPick = (lState >> ((j % 8) * 8)) ^ j;
+
+                lString += (((lPick & 3) == 0) ?
+                            kAlphabet[lPick % (sizeof (kAlphabet) - 1)] :
+                            static_cast<char>('0' + (lPick % 10)));
+            }
+
+            {
+                char *        lExpectedEnd;
+                char *        lEnd;
+                unsigned long lExpected;
+                unsigned long lValue;
+                int           lExpectedErrno;
+
+                errno = 0;
+
+                lExpected      = strntoul(lString.data(), lString.size(), &lExpectedEnd, lBase);
+                lExpectedErrno = errno;
+
+                errno = 0;
+
+                lValue = strntoul_inline(lString.data(), lString.size(), &lEnd, lBase);
+                NL_TEST_ASSERT(inSuite, lValue == lExpected);
+                NL_TEST_ASSERT(inSuite, lEnd == lExpectedEnd);
+                NL_TEST_ASSERT(inSuite, errno == lExpectedErrno);
+            }
+
+            {
+                char * lExpectedEnd;
+                char * lEnd;
+                long   lExpected;
+                long   lValue;
+                int    lExpectedErrno;
+
+                errno = 0;
+
+                lExpected      = strntol(lString.data(), lString.size(), &lExpectedEnd, lBase);
+                lExpectedErrno = errno;
+
+                errno = 0;
+
+                lValue = strntol_inline(lString.data(), lString.size(), &lEnd, lBase);
+                NL_TEST_ASSERT(inSuite, lValue == lExpected);
+                NL_TEST_ASSERT(inSuite, lEnd == lExpectedEnd);
+                NL_TEST_ASSERT(inSuite, errno == lExpectedErrno);
+            }
+        }
+    }
+}
+
+static void TestConstant(nlTestSuite *inSuite __attribute__((unused)),
+                         void *inContext __attribute__((unused)))
+{
+    static const char kField[] = "0042,";
+    char *            lEnd;
+
+    // A literal base and length, as in a fixed-width field, may be
+    // specialized into the caller.
+
+    NL_TEST_ASSERT(inSuite, strntoul_inline(kField, 4, &lEnd, 10) == 42);
+    NL_TEST_ASSERT(inSuite, lEnd == kField + 4);
+
+    NL_TEST_ASSERT(inSuite, strntol_inline(kField, 2, nullptr, 10) == 0);
+
+    errno = 0;
+
+    NL_TEST_ASSERT(inSuite, strntol_inline(kField, 4, &lEnd, 37) == 0);
+    NL_TEST_ASSERT(inSuite, (lEnd == kField) && (errno == EINVAL));
+}
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+static const nlTest sTests[] = {
+    NL_TEST_DEF("Agreement", TestAgreement),
+    NL_TEST_DEF("Constant",  TestConstant),
+
+    NL_TEST_SENTINEL()
+};
+
+int main(void)
+{
+    nlTestSuite theSuite = {
+        "strntoul_inline",
+        &sTests[0],
+        nullptr,
+        nullptr,
+        nullptr,
+        nullptr,
+        0,
+        0,
+        0,
+        0,
+        0
+    };
+
+    // Generate human-readable output.
+    nlTestSetOutputStyle(OUTPUT_DEF);
+
+    // Run test suit againt one context.
+    nlTestRunner(&theSuite, nullptr);
+
+    return nlTestRunnerStats(&theSuite);
+}
@@ -0,0 +1,196 @@
+/*
+ *    Copyright (c) 2024 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+
+/**
+ *    @file
+ *      This file implements a unit test for the sampled latency
+ *      histograms of strntoul and strntol.
+ *
+ */
+
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <nlunit-test.h>
+
+#include <strntol.h>
+#include <strntoul.h>
+#include <strntoul_latency.h>
+
+
+static bool
+IsConfigured(void)
+{
+    return (strntoul_latency_set_interval(1024) == 0);
+}
+
+static void TestArguments(nlTestSuite *inSuite __attribute__((unused)),
+                          void *inContext __attribute__((unused)))
+{
+    uint64_t lTicks;
+    int      lStatus;
+
+    // Without the instrumentation, every interface is unsupported.
+
+    if (!IsConfigured())
+    {
+        NL_TEST_ASSERT(inSuite, strntoul_latency_set_interval(1) == -ENOTSUP);
+        NL_TEST_ASSERT(inSuite, strntoul_latency_reset() == -ENOTSUP);
+        NL_TEST_ASSERT(inSuite, strntoul_latency_quantile(-1, SIZE_MAX, 0.5, &lTicks, nullptr) == -ENOTSUP);
+        NL_TEST_ASSERT(inSuite, strntoul_latency_dump(stdout) == -ENOTSUP);
+
+        return;
+    }
+
+    lStatus = strntoul_latency_quantile(1, SIZE_MAX, 0.5, &lTicks, nullptr);
+    NL_TEST_ASSERT(inSuite, lStatus == -EINVAL);
+
+    lStatus = strntoul_latency_quantile(37, SIZE_MAX, 0.5, &lTicks, nullptr);
+    NL_TEST_ASSERT(inSuite, lStatus == -EINVAL);
+
+    lStatus = strntoul_latency_quantile(-1, SIZE_MAX, 1.5, &lTicks, nullptr);
+    NL_TEST_ASSERT(inSuite, lStatus == -EINVAL);
+
+    lStatus = strntoul_latency_quantile(-1, SIZE_MAX, 0.5, nullptr, nullptr);
+    NL_TEST_ASSERT(inSuite, lStatus == -EINVAL);
+
+    lStatus = strntoul_latency_dump(nullptr);
+    NL_TEST_ASSERT(inSuite, lStatus == -EINVAL);
+}
+
+static void TestSampling(nlTestSuite *inSuite __attribute__((unused)),
+                         void *inContext __attribute__((unused)))
+{
+    static const char kShort[] = "12345";
+    static const char kLong[]  = "-7fffffff 0000000000000000000000000000000";
+    const size_t      kCalls   = 4096;
+    uint64_t          lMedian;
+    uint64_t          lTail;
+    uint64_t          lMaximum;
+    uint64_t          lSamples;
+    int               lStatus;
+
+    if (!IsConfigured())
+    {
+        return;
+    }
+
+    // Sample every call. The thread's countdown must first expire at
+    // the default interval, so the earliest calls are not sampled.
+
+    lStatus = strntoul_latency_set_interval(1);
+    NL_TEST_ASSERT(inSuite, lStatus == 0);
+
+    for (size_t i = 0; i < 1024; i++)
+    {
+        strntoul(kShort, strlen(kShort), nullptr, 10);
+    }
+
+    lStatus = strntoul_latency_reset();
+    NL_TEST_ASSERT(inSuite, lStatus == 0);
+
+    for (size_t i = 0; i < kCalls; i++)
+    {
+        NL_TEST_ASSERT(inSuite, strntoul(kShort, strlen(kShort), nullptr, 10) == 12345);
+        NL_TEST_ASSERT(inSuite, strntol(kLong, strlen(kLong), nullptr, 16) == -0x7fffffff);
+    }
+
+    // Each call is recorded by its base and its length.
+
+    lStatus = strntoul_latency_quantile(10, strlen(kShort), 0.5, &lMedian, &lSamples);
+    NL_TEST_ASSERT(inSuite, (lStatus == 0) && (lSamples == kCalls));
+
+    lStatus = strntoul_latency_quantile(16, strlen(kLong), 0.5, &lMedian, &lSamples);
+    NL_TEST_ASSERT(inSuite, (lStatus == 0) && (lSamples == kCalls));
+
+    lStatus = strntoul_latency_quantile(10, strlen(kLong), 0.5, &lMedian, &lSamples);
+    NL_TEST_ASSERT(inSuite, (lStatus == 0) && (lSamples == 0) && (lMedian == 0));
+
+    lStatus = strntoul_latency_quantile(2, SIZE_MAX, 0.5, &lMedian, &lSamples);
+    NL_TEST_ASSERT(inSuite, (lStatus == 0) && (lSamples == 0) && (lMedian == 0));
+
+    // Quantiles are ordered.
+
+    lStatus = strntoul_latency_quantile(-1, SIZE_MAX, 0.5, &lMedian, &lSamples);
+    NL_TEST_ASSERT(inSuite, (lStatus == 0) && (lSamples == (2 * kCalls)));
+
+    lStatus = strntoul_latency_quantile(-1, SIZE_MAX, 0.99, &lTail, nullptr);
+    NL_TEST_ASSERT(inSuite, lStatus == 0);
+
+    lStatus = strntoul_latency_quantile(-1, SIZE_MAX, 1.0, &lMaximum, nullptr);
+    NL_TEST_ASSERT(inSuite, lStatus == 0);
+
+    NL_TEST_ASSERT(inSuite, (lMedian <= lTail) && (lTail <= lMaximum) && (lMaximum > 0));
+
+    lStatus = strntoul_latency_dump(stdout);
+    NL_TEST_ASSERT(inSuite, lStatus == 0);
+
+    // Once sampling stops, nothing more is recorded.
+
+    lStatus = strntoul_latency_set_interval(0);
+    NL_TEST_ASSERT(inSuite, lStatus == 0);
+
+    lStatus = strntoul_latency_reset();
+    NL_TEST_ASSERT(inSuite, lStatus == 0);
+
+    for (size_t i = 0; i < kCalls; i++)
+    {
+        strntoul(kShort, strlen(kShort), nullptr, 10);
+    }
+
+    lStatus = strntoul_latency_quantile(-1, SIZE_MAX, 1.0, &lMaximum, &lSamples);
+    NL_TEST_ASSERT(inSuite, (lStatus == 0) && (lSamples == 0));
+}
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+static const nlTest sTests[] = {
+    NL_TEST_DEF("Arguments", TestArguments),
+    NL_TEST_DEF("Sampling",  TestSampling),
+
+    NL_TEST_SENTINEL()
+};
+
+int main(void)
+{
+    nlTestSuite theSuite = {
+        "strntoul_latency",
+        &sTests[0],
+        nullptr,
+        nullptr,
+        nullptr,
+        nullptr,
+        0,
+        0,
+        0,
+        0,
+        0
+    };
+
+    // Generate human-readable output.
+    nlTestSetOutputStyle(OUTPUT_DEF);
+
+    // Run test suit againt one context.
+    nlTestRunner(&theSuite, nullptr);
+
+    return nlTestRunnerStats(&theSuite);
+}
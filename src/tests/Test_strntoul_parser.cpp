@@ -0,0 +1,355 @@
+/*
+ *    Copyright (c) 2024 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *    @file
+ *      This file implements a unit test for pre-configured strntoul
+ *      parsers.
+ *
+ */
+
+#include <errno.h>
+#include <limits.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <sys/mman.h>
+
+#include <nlunit-test.h>
+
+#include <strntoul.h>
+#include <strntoul_parser.h>
+
+
+static void TestCreate(nlTestSuite *inSuite __attribute__((unused)),
+                       void *inContext __attribute__((unused)))
+{
+    strntoul_parser_t *lParser;
+    char *             lEnd;
+    int                lStatus;
+
+    lStatus = strntoul_parser_create(10, 0, nullptr);
+    NL_TEST_ASSERT(inSuite, lStatus == -EINVAL);
+
+    lStatus = strntoul_parser_create(1, 0, &lParser);
+    NL_TEST_ASSERT(inSuite, lStatus == -EINVAL);
+
+    lStatus = strntoul_parser_create(37, 0, &lParser);
+    NL_TEST_ASSERT(inSuite, lStatus == -EINVAL);
+
+    lStatus = strntoul_parser_create(10, 0x100, &lParser);
+    NL_TEST_ASSERT(inSuite, lStatus == -EINVAL);
+
+    // A deduced base requires a prefix.
+
+    lStatus = strntoul_parser_create(0, STRNTOUL_PARSER_NO_PREFIX, &lParser);
+    NL_TEST_ASSERT(inSuite, lStatus == -EINVAL);
+
+    lStatus = strntoul_parser_create(0, STRNTOUL_PARSER_STRICT, &lParser);
+    NL_TEST_ASSERT(inSuite, lStatus == 0);
+
+    strntoul_parser_destroy(lParser);
+    strntoul_parser_destroy(nullptr);
+
+    errno = 0;
+
+    NL_TEST_ASSERT(inSuite, strntoul_parser_parse(nullptr, "1", 1, &lEnd) == 0);
+    NL_TEST_ASSERT(inSuite, errno == EINVAL);
+}
+
+static void TestAgreement(nlTestSuite *inSuite __attribute__((unused)),
+                          void *inContext __attribute__((unused)))
+{
+    static const char kAlphabet[] = " \t+-0123456789abcdefxzXZ";
+    uint64_t          lState      = 0x9E3779B97F4A7C15ULL;
+
+    // Without flags, a parser converts exactly as strntoul does.
+
+    for (int lBase = 0; lBase <= 36; lBase++)
+    {
+        strntoul_parser_t *lParser;
+        int                lStatus;
+
+        if (lBase == 1)
+        {
+            continue;
+        }
+
+        lStatus = strntoul_parser_create(lBase, 0, &lParser);
+        NL_TEST_ASSERT(inSuite, lStatus == 0);
+
+        for (size_t i = 0; i < 2000; i++)
+        {
+            char   lString[32];
+            size_t lLength;
+
+            lState ^= lState << 13;
+            lState ^= lState >> 7;
+            lState ^= lState << 17;
+
+            lLength = static_cast<size_t>(lState % sizeof (lString));
+
+            for (size_t j = 0; j < lLength; j++)
+            {
+                // Favor digits, so that most strings convert.
+
+                const uint64_t lPick = (lState >> ((j % 8) * 8)) ^ j;
+
+                lString[j] = (((lPick & 3) == 0) ?
+                              kAlphabet[lPick % (sizeof (kAlphabet) - 1)] :
+                              static_cast<char>('0' + (lPick % 10)));
+            }
+
+            {
+                char *        lExpectedEnd;
+                char *        lEnd;
+                unsigned long lExpected;
+                unsigned long lValue;
+                int           lExpectedErrno;
+
+                errno = 0;
+
+                lExpected      = strntoul(lString, lLength, &lExpectedEnd, lBase);
+                lExpectedErrno = errno;
+
+                errno = 0;
+
+                lValue = strntoul_parser_parse(lParser, lString, lLength, &lEnd);
+                NL_TEST_ASSERT(inSuite, lValue == lExpected);
+                NL_TEST_ASSERT(inSuite, lEnd == lExpectedEnd);
+                NL_TEST_ASSERT(inSuite, errno == lExpectedErrno);
+            }
+        }
+
+        strntoul_parser_destroy(lParser);
+    }
+}
+
+static void TestFlags(nlTestSuite *inSuite __attribute__((unused)),
+                      void *inContext __attribute__((unused)))
+{
+    strntoul_parser_t *lParser;
+    const char *       lString;
+    char *             lEnd;
+    unsigned long      lValue;
+    int                lStatus;
+
+    // 1: No white space.
+
+    lStatus = strntoul_parser_create(10, STRNTOUL_PARSER_NO_WHITESPACE, &lParser);
+    NL_TEST_ASSERT(inSuite, lStatus == 0);
+
+    lString = " 42";
+
+    lValue = strntoul_parser_parse(lParser, lString, strlen(lString), &lEnd);
+    NL_TEST_ASSERT(inSuite, (lValue == 0) && (lEnd == lString));
+
+    lValue = strntoul_parser_parse(lParser, lString + 1, strlen(lString) - 1, &lEnd);
+    NL_TEST_ASSERT(inSuite, (lValue == 42) && (lEnd == lString + 3));
+
+    strntoul_parser_destroy(lParser);
+
+    // 2: No sign.
+
+    lStatus = strntoul_parser_create(10, STRNTOUL_PARSER_NO_SIGN, &lParser);
+    NL_TEST_ASSERT(inSuite, lStatus == 0);
+
+    lString = "-42";
+
+    lValue = strntoul_parser_parse(lParser, lString, strlen(lString), &lEnd);
+    NL_TEST_ASSERT(inSuite, (lValue == 0) && (lEnd == lString));
+
+    lString = " 42";
+
+    lValue = strntoul_parser_parse(lParser, lString, strlen(lString), &lEnd);
+    NL_TEST_ASSERT(inSuite, (lValue == 42) && (lEnd == lString + 3));
+
+    strntoul_parser_destroy(lParser);
+
+    // 3: No prefix, in which case "0x" is a zero followed by junk.
+
+    lStatus = strntoul_parser_create(16, STRNTOUL_PARSER_NO_PREFIX, &lParser);
+    NL_TEST_ASSERT(inSuite, lStatus == 0);
+
+    lString = "0x1f";
+
+    lValue = strntoul_parser_parse(lParser, lString, strlen(lString), &lEnd);
+    NL_TEST_ASSERT(inSuite, (lValue == 0) && (lEnd == lString + 1));
+
+    lString = "1f";
+
+    lValue = strntoul_parser_parse(lParser, lString, strlen(lString), &lEnd);
+    NL_TEST_ASSERT(inSuite, (lValue == 0x1f) && (lEnd == lString + 2));
+
+    strntoul_parser_destroy(lParser);
+
+    // 4: Strict, in which case the entire length must convert.
+
+    lStatus = strntoul_parser_create(10, STRNTOUL_PARSER_STRICT, &lParser);
+    NL_TEST_ASSERT(inSuite, lStatus == 0);
+
+    lString = "1234";
+
+    errno = 0;
+
+    lValue = strntoul_parser_parse(lParser, lString, strlen(lString), &lEnd);
+    NL_TEST_ASSERT(inSuite, (lValue == 1234) && (lEnd == lString + 4) && (errno == 0));
+
+    lString = "1234 ";
+
+    lValue = strntoul_parser_parse(lParser, lString, strlen(lString), &lEnd);
+    NL_TEST_ASSERT(inSuite, (lValue == 0) && (lEnd == lString) && (errno == EINVAL));
+
+    errno = 0;
+
+    lValue = strntoul_parser_parse(lParser, lString, 0, &lEnd);
+    NL_TEST_ASSERT(inSuite, (lValue == 0) && (lEnd == lString) && (errno == EINVAL));
+
+    // Out of range, but entirely a number, is still a range error.
+
+    lString = "99999999999999999999999";
+
+    errno = 0;
+
+    lValue = strntoul_parser_parse(lParser, lString, strlen(lString), &lEnd);
+    NL_TEST_ASSERT(inSuite, (lValue == ULONG_MAX) && (errno == ERANGE));
+
+    // Whatever its sign.
+
+    lString = "-99999999999999999999999";
+
+    errno = 0;
+
+    lValue = strntoul_parser_parse(lParser, lString, strlen(lString), &lEnd);
+    NL_TEST_ASSERT(inSuite, (lValue == ULONG_MAX) && (errno == ERANGE));
+    NL_TEST_ASSERT(inSuite, lValue == strntoul(lString, strlen(lString), &lEnd, 10));
+
+    strntoul_parser_destroy(lParser);
+
+    // 5: All of them together.
+
+    lStatus = strntoul_parser_create(16,
+                                     (STRNTOUL_PARSER_NO_WHITESPACE |
+                                      STRNTOUL_PARSER_NO_SIGN       |
+                                      STRNTOUL_PARSER_NO_PREFIX     |
+                                      STRNTOUL_PARSER_STRICT),
+                                     &lParser);
+    NL_TEST_ASSERT(inSuite, lStatus == 0);
+
+    lValue = strntoul_parser_parse(lParser, "deadBEEF", 8, &lEnd);
+    NL_TEST_ASSERT(inSuite, lValue == 0xdeadbeef);
+
+    lValue = strntoul_parser_parse(lParser, "+deadBEEF", 9, nullptr);
+    NL_TEST_ASSERT(inSuite, lValue == 0);
+
+    strntoul_parser_destroy(lParser);
+}
+
+static void TestPageBoundary(nlTestSuite *inSuite __attribute__((unused)),
+                             void *inContext __attribute__((unused)))
+{
+    static const size_t kLengths[] = { 8, 15, 16, 17, 21, 32, 64 };
+    const size_t        lPageSize  = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    char *              lPages;
+    strntoul_parser_t * lBinary;
+    strntoul_parser_t * lOctal;
+    unsigned long       lValue;
+    char *              lEnd;
+    int                 lStatus;
+
+    // Binary and octal values that end exactly at a guard page,
+    // including those that exactly fill one and two windows.
+
+    lPages = static_cast<char *>(mmap(nullptr,
+                                      lPageSize * 2,
+                                      PROT_READ | PROT_WRITE,
+                                      MAP_PRIVATE | MAP_ANONYMOUS,
+                                      -1,
+                                      0));
+    NL_TEST_ASSERT(inSuite, lPages != MAP_FAILED);
+
+    if (lPages == MAP_FAILED)
+        return;
+
+    lStatus = mprotect(lPages + lPageSize, lPageSize, PROT_NONE);
+    NL_TEST_ASSERT(inSuite, lStatus == 0);
+
+    lStatus = strntoul_parser_create(2, 0, &lBinary);
+    NL_TEST_ASSERT(inSuite, lStatus == 0);
+
+    lStatus = strntoul_parser_create(8, 0, &lOctal);
+    NL_TEST_ASSERT(inSuite, lStatus == 0);
+
+    for (size_t lLength : kLengths)
+    {
+        char * const lString = lPages + lPageSize - lLength;
+
+        memset(lString, '1', lLength);
+
+        lValue = strntoul_parser_parse(lBinary, lString, lLength, &lEnd);
+        NL_TEST_ASSERT(inSuite, lValue == strntoul(lString, lLength, nullptr, 2));
+        NL_TEST_ASSERT(inSuite, lEnd == lString + lLength);
+
+        lValue = strntoul_parser_parse(lOctal, lString, lLength, &lEnd);
+        NL_TEST_ASSERT(inSuite, lValue == strntoul(lString, lLength, nullptr, 8));
+        NL_TEST_ASSERT(inSuite, lEnd == lString + lLength);
+    }
+
+    strntoul_parser_destroy(lOctal);
+    strntoul_parser_destroy(lBinary);
+
+    munmap(lPages, lPageSize * 2);
+}
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+static const nlTest sTests[] = {
+    NL_TEST_DEF("Create",    TestCreate),
+    NL_TEST_DEF("Agreement", TestAgreement),
+    NL_TEST_DEF("Flags",     TestFlags),
+    NL_TEST_DEF("Page Boundary", TestPageBoundary),
+
+    NL_TEST_SENTINEL()
+};
+
+int main(void)
+{
+    nlTestSuite theSuite = {
+        "strntoul_parser",
+        &sTests[0],
+        nullptr,
+        nullptr,
+        nullptr,
+        nullptr,
+        0,
+        0,
+        0,
+        0,
+        0
+    };
+
+    // Generate human-readable output.
+    nlTestSetOutputStyle(OUTPUT_DEF);
+
+    // Run test suit againt one context.
+    nlTestRunner(&theSuite, nullptr);
+
+    return nlTestRunnerStats(&theSuite);
+}
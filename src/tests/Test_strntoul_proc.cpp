@@ -0,0 +1,321 @@
+/*
+ *    Copyright (c) 2024 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *    @file
+ *      This file implements a unit test for the strntoul procfs and
+ *      sysfs readers.
+ *
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <nlunit-test.h>
+
+#include <strntoul_proc.h>
+
+
+// Fixtures, as captured from a running system.
+
+static const char kStat[] =
+    "4242 (tmux: server (1)) S 1 4242 4242 0 -1 4194624 1520 0 3 0 "
+    "112 58 0 0 20 0 1 0 877 11632640 1024 18446744073709551615 "
+    "94234051489792 94234052126789 140727866862768 0 0 0 0 4096 "
+    "134433283 1 0 0 17 3 0 0 0 0 0\n";
+
+static const char kMeminfo[] =
+    "MemTotal:       16318480 kB\n"
+    "MemFree:          812344 kB\n"
+    "MemAvailable:   10938720 kB\n"
+    "Buffers:          524288 kB\n"
+    "Cached:          9437184 kB\n"
+    "SwapCached:            0 kB\n"
+    "Active:          5242880 kB\n"
+    "Inactive:        7340032 kB\n"
+    "Active(anon):    2097152 kB\n"
+    "SwapTotal:       2097148 kB\n"
+    "SwapFree:        2097148 kB\n"
+    "Dirty:               128 kB\n"
+    "Slab:             786432 kB\n"
+    "Committed_AS:    8388608 kB\n"
+    "HugePages_Total:       0\n"
+    "HugePages_Free:        0\n"
+    "Hugepagesize:       2048 kB\n";
+
+static const char kMaps[] =
+    "55d0c0a00000-55d0c0a02000 r--p 00000000 08:01 1234567                    /usr/bin/cat\n"
+    "7ffd5e1c3000-7ffd5e1e4000 rw-p 00000000 00:00 0                          [stack]\n"
+    "7f3a2c000000-7f3a2c021000 rw-p 00000000 00:00 0 \n"
+    "ffffffffff600000-ffffffffff601000 --xp 00000000 00:00 0                  [vsyscall]";
+
+static char sFixturePath[] = "/tmp/Test_strntoul_proc.XXXXXX";
+
+static void TestRead(nlTestSuite *inSuite __attribute__((unused)),
+                     void *inContext __attribute__((unused)))
+{
+    char   lBuffer[sizeof (kStat)];
+    size_t lLength;
+    int    lDescriptor;
+    int    lStatus;
+
+    lDescriptor = mkstemp(sFixturePath);
+    NL_TEST_ASSERT(inSuite, lDescriptor >= 0);
+
+    NL_TEST_ASSERT(inSuite, write(lDescriptor, kStat, strlen(kStat)) == static_cast<ssize_t>(strlen(kStat)));
+
+    // Reads start at offset zero, irrespective of the file offset,
+    // so the descriptor may be polled repeatedly.
+
+    for (int i = 0; i < 2; i++)
+    {
+        lStatus = strntoul_proc_read(lDescriptor, lBuffer, sizeof (lBuffer), &lLength);
+        NL_TEST_ASSERT(inSuite, lStatus == 0);
+        NL_TEST_ASSERT(inSuite, lLength == strlen(kStat));
+        NL_TEST_ASSERT(inSuite, memcmp(lBuffer, kStat, lLength) == 0);
+    }
+
+    // A buffer the file fills may have been truncated.
+
+    lStatus = strntoul_proc_read(lDescriptor, lBuffer, strlen(kStat), &lLength);
+    NL_TEST_ASSERT(inSuite, lStatus == -EOVERFLOW);
+    NL_TEST_ASSERT(inSuite, lLength == strlen(kStat));
+
+    close(lDescriptor);
+
+    lStatus = strntoul_proc_read_path(sFixturePath, lBuffer, sizeof (lBuffer), &lLength);
+    NL_TEST_ASSERT(inSuite, (lStatus == 0) && (lLength == strlen(kStat)));
+
+    unlink(sFixturePath);
+
+    lStatus = strntoul_proc_read_path(sFixturePath, lBuffer, sizeof (lBuffer), &lLength);
+    NL_TEST_ASSERT(inSuite, lStatus == -ENOENT);
+
+    lStatus = strntoul_proc_read(0, nullptr, 1, &lLength);
+    NL_TEST_ASSERT(inSuite, lStatus == -EINVAL);
+}
+
+static void TestStat(nlTestSuite *inSuite __attribute__((unused)),
+                     void *inContext __attribute__((unused)))
+{
+    strntoul_proc_stat_t lStat;
+    char                 lBuffer[4096];
+    size_t               lLength;
+    int                  lStatus;
+
+    lStatus = strntoul_proc_parse_stat(kStat, strlen(kStat), &lStat);
+    NL_TEST_ASSERT(inSuite, lStatus == 0);
+    NL_TEST_ASSERT(inSuite, lStat.pid == 4242);
+    NL_TEST_ASSERT(inSuite, strcmp(lStat.comm, "tmux: server (1)") == 0);
+    NL_TEST_ASSERT(inSuite, lStat.state == 'S');
+    NL_TEST_ASSERT(inSuite, lStat.ppid == 1);
+    NL_TEST_ASSERT(inSuite, lStat.tpgid == -1);
+    NL_TEST_ASSERT(inSuite, lStat.flags == 4194624);
+    NL_TEST_ASSERT(inSuite, lStat.majflt == 3);
+    NL_TEST_ASSERT(inSuite, (lStat.utime == 112) && (lStat.stime == 58));
+    NL_TEST_ASSERT(inSuite, (lStat.priority == 20) && (lStat.nice == 0));
+    NL_TEST_ASSERT(inSuite, lStat.starttime == 877);
+    NL_TEST_ASSERT(inSuite, lStat.vsize == 11632640);
+    NL_TEST_ASSERT(inSuite, lStat.rss == 1024);
+    NL_TEST_ASSERT(inSuite, lStat.processor == 3);
+
+    // Older kernels end before processor.
+
+    lLength = static_cast<size_t>(strstr(kStat, " 94234051489792") - kStat);
+
+    lStatus = strntoul_proc_parse_stat(kStat, lLength, &lStat);
+    NL_TEST_ASSERT(inSuite, lStatus == 0);
+    NL_TEST_ASSERT(inSuite, lStat.rsslim == 18446744073709551615UL);
+    NL_TEST_ASSERT(inSuite, lStat.processor == -1);
+
+    // But everything through rsslim is required.
+
+    lStatus = strntoul_proc_parse_stat(kStat, 80, &lStat);
+    NL_TEST_ASSERT(inSuite, lStatus == -EINVAL);
+
+    lStatus = strntoul_proc_parse_stat("1 (init S 0", 11, &lStat);
+    NL_TEST_ASSERT(inSuite, lStatus == -EINVAL);
+
+    // The running process agrees with itself.
+
+    lStatus = strntoul_proc_read_path("/proc/self/stat", lBuffer, sizeof (lBuffer), &lLength);
+
+    if (lStatus == 0)
+    {
+        lStatus = strntoul_proc_parse_stat(lBuffer, lLength, &lStat);
+        NL_TEST_ASSERT(inSuite, lStatus == 0);
+        NL_TEST_ASSERT(inSuite, lStat.pid == getpid());
+        NL_TEST_ASSERT(inSuite, lStat.ppid == getppid());
+    }
+}
+
+static void TestMeminfo(nlTestSuite *inSuite __attribute__((unused)),
+                        void *inContext __attribute__((unused)))
+{
+    strntoul_proc_meminfo_t lMeminfo;
+    char                    lBuffer[8192];
+    size_t                  lLength;
+    int                     lStatus;
+
+    lStatus = strntoul_proc_parse_meminfo(kMeminfo, strlen(kMeminfo), &lMeminfo);
+    NL_TEST_ASSERT(inSuite, lStatus == 0);
+    NL_TEST_ASSERT(inSuite, lMeminfo.mem_total == 16318480);
+    NL_TEST_ASSERT(inSuite, lMeminfo.mem_available == 10938720);
+    NL_TEST_ASSERT(inSuite, lMeminfo.active == 5242880);
+    NL_TEST_ASSERT(inSuite, lMeminfo.swap_free == 2097148);
+    NL_TEST_ASSERT(inSuite, lMeminfo.slab == 786432);
+    NL_TEST_ASSERT(inSuite, lMeminfo.committed_as == 8388608);
+    NL_TEST_ASSERT(inSuite, lMeminfo.hugepagesize == 2048);
+
+    // Fields not reported are zero.
+
+    NL_TEST_ASSERT(inSuite, (lMeminfo.writeback == 0) && (lMeminfo.page_tables == 0));
+
+    lStatus = strntoul_proc_parse_meminfo("MemTotal 1 kB\n", 14, &lMeminfo);
+    NL_TEST_ASSERT(inSuite, lStatus == -EINVAL);
+
+    lStatus = strntoul_proc_parse_meminfo("MemTotal: kB\n", 13, &lMeminfo);
+    NL_TEST_ASSERT(inSuite, lStatus == -EINVAL);
+
+    lStatus = strntoul_proc_read_path("/proc/meminfo", lBuffer, sizeof (lBuffer), &lLength);
+
+    if (lStatus == 0)
+    {
+        lStatus = strntoul_proc_parse_meminfo(lBuffer, lLength, &lMeminfo);
+        NL_TEST_ASSERT(inSuite, lStatus == 0);
+        NL_TEST_ASSERT(inSuite, lMeminfo.mem_total >= lMeminfo.mem_free);
+        NL_TEST_ASSERT(inSuite, lMeminfo.mem_total > 0);
+    }
+}
+
+static void TestMaps(nlTestSuite *inSuite __attribute__((unused)),
+                     void *inContext __attribute__((unused)))
+{
+    strntoul_proc_map_t lMap;
+    size_t              lOffset = 0;
+    int                 lStatus;
+
+    lStatus = strntoul_proc_maps_next(kMaps, strlen(kMaps), &lOffset, &lMap);
+    NL_TEST_ASSERT(inSuite, lStatus == 1);
+    NL_TEST_ASSERT(inSuite, (lMap.start == 0x55d0c0a00000UL) && (lMap.end == 0x55d0c0a02000UL));
+    NL_TEST_ASSERT(inSuite, strcmp(lMap.perms, "r--p") == 0);
+    NL_TEST_ASSERT(inSuite, (lMap.major == 8) && (lMap.minor == 1));
+    NL_TEST_ASSERT(inSuite, lMap.inode == 1234567);
+    NL_TEST_ASSERT(inSuite, (lMap.path_length == 12) && (memcmp(lMap.path, "/usr/bin/cat", 12) == 0));
+
+    lStatus = strntoul_proc_maps_next(kMaps, strlen(kMaps), &lOffset, &lMap);
+    NL_TEST_ASSERT(inSuite, lStatus == 1);
+    NL_TEST_ASSERT(inSuite, (lMap.path_length == 7) && (memcmp(lMap.path, "[stack]", 7) == 0));
+
+    // Anonymous mappings have no path.
+
+    lStatus = strntoul_proc_maps_next(kMaps, strlen(kMaps), &lOffset, &lMap);
+    NL_TEST_ASSERT(inSuite, lStatus == 1);
+    NL_TEST_ASSERT(inSuite, lMap.path_length == 0);
+
+    // The last line need not end in a newline.
+
+    lStatus = strntoul_proc_maps_next(kMaps, strlen(kMaps), &lOffset, &lMap);
+    NL_TEST_ASSERT(inSuite, lStatus == 1);
+    NL_TEST_ASSERT(inSuite, lMap.start == 0xffffffffff600000UL);
+    NL_TEST_ASSERT(inSuite, strcmp(lMap.perms, "--xp") == 0);
+
+    lStatus = strntoul_proc_maps_next(kMaps, strlen(kMaps), &lOffset, &lMap);
+    NL_TEST_ASSERT(inSuite, lStatus == 0);
+
+    lOffset = 0;
+
+    lStatus = strntoul_proc_maps_next("55d0c0a00000 r--p", 17, &lOffset, &lMap);
+    NL_TEST_ASSERT(inSuite, lStatus == -EINVAL);
+    NL_TEST_ASSERT(inSuite, lOffset == 0);
+}
+
+static void TestCounter(nlTestSuite *inSuite __attribute__((unused)),
+                        void *inContext __attribute__((unused)))
+{
+    unsigned long lValue;
+    int           lStatus;
+
+    errno = 0;
+
+    lStatus = strntoul_proc_parse_counter("123456789\n", 10, 10, &lValue);
+    NL_TEST_ASSERT(inSuite, (lStatus == 0) && (lValue == 123456789));
+
+    lStatus = strntoul_proc_parse_counter("0x1f", 4, 0, &lValue);
+    NL_TEST_ASSERT(inSuite, (lStatus == 0) && (lValue == 0x1f));
+
+    lStatus = strntoul_proc_parse_counter("12 34\n", 6, 10, &lValue);
+    NL_TEST_ASSERT(inSuite, lStatus == -EINVAL);
+
+    lStatus = strntoul_proc_parse_counter(" 12\n", 4, 10, &lValue);
+    NL_TEST_ASSERT(inSuite, lStatus == -EINVAL);
+
+    lStatus = strntoul_proc_parse_counter("\n", 1, 10, &lValue);
+    NL_TEST_ASSERT(inSuite, lStatus == -EINVAL);
+
+    lStatus = strntoul_proc_parse_counter("99999999999999999999999\n", 24, 10, &lValue);
+    NL_TEST_ASSERT(inSuite, lStatus == -ERANGE);
+
+    lStatus = strntoul_proc_parse_counter("1", 1, 37, &lValue);
+    NL_TEST_ASSERT(inSuite, lStatus == -EINVAL);
+
+    // Parsing never disturbs errno.
+
+    NL_TEST_ASSERT(inSuite, errno == 0);
+}
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+static const nlTest sTests[] = {
+    NL_TEST_DEF("Read",    TestRead),
+    NL_TEST_DEF("Stat",    TestStat),
+    NL_TEST_DEF("Meminfo", TestMeminfo),
+    NL_TEST_DEF("Maps",    TestMaps),
+    NL_TEST_DEF("Counter", TestCounter),
+
+    NL_TEST_SENTINEL()
+};
+
+int main(void)
+{
+    nlTestSuite theSuite = {
+        "strntoul_proc",
+        &sTests[0],
+        nullptr,
+        nullptr,
+        nullptr,
+        nullptr,
+        0,
+        0,
+        0,
+        0,
+        0
+    };
+
+    // Generate human-readable output.
+    nlTestSetOutputStyle(OUTPUT_DEF);
+
+    // Run test suit againt one context.
+    nlTestRunner(&theSuite, nullptr);
+
+    return nlTestRunnerStats(&theSuite);
+}
@@ -0,0 +1,200 @@
+/*
+ *    Copyright (c) 2024 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *    @file
+ *      This file implements a unit test for strntoul_reduce.
+ *
+ */
+
+#include <errno.h>
+#include <limits.h>
+#include <string.h>
+
+#include <nlunit-test.h>
+
+#include <strntoul_reduce.h>
+
+
+static void TestInvalidArguments(nlTestSuite *inSuite __attribute__((unused)),
+                                 void *inContext __attribute__((unused)))
+{
+    const char *             lBuffer = "1,2,3";
+    strntoul_reduce_result_t lResult;
+    int                      lStatus;
+
+    memset(&lResult, 0, sizeof (lResult));
+
+    lStatus = strntoul_reduce(lBuffer, strlen(lBuffer), ',', 10, STRNTOUL_REDUCE_SUM, nullptr);
+    NL_TEST_ASSERT(inSuite, lStatus == -EINVAL);
+
+    lStatus = strntoul_reduce(lBuffer, strlen(lBuffer), ',', 37, STRNTOUL_REDUCE_SUM, &lResult);
+    NL_TEST_ASSERT(inSuite, lStatus == -EINVAL);
+
+    lStatus = strntoul_reduce(lBuffer, strlen(lBuffer), ',', 10, 0x80, &lResult);
+    NL_TEST_ASSERT(inSuite, lStatus == -EINVAL);
+
+    // A histogram requires a non-zero bucket width.
+
+    lStatus = strntoul_reduce(lBuffer, strlen(lBuffer), ',', 10, STRNTOUL_REDUCE_HISTOGRAM, &lResult);
+    NL_TEST_ASSERT(inSuite, lStatus == -EINVAL);
+}
+
+static void TestReductions(nlTestSuite *inSuite __attribute__((unused)),
+                           void *inContext __attribute__((unused)))
+{
+    const char *             lBuffer = "200,404, 301 ,200,,500,abc,12x,503\n";
+    strntoul_reduce_result_t lResult;
+    int                      lStatus;
+
+    memset(&lResult, 0, sizeof (lResult));
+
+    lResult.mHistogramOrigin = 100;
+    lResult.mHistogramWidth  = 100;
+
+    errno = 0;
+
+    lStatus = strntoul_reduce(lBuffer, strlen(lBuffer), ',', 10, STRNTOUL_REDUCE_ALL, &lResult);
+    NL_TEST_ASSERT(inSuite, lStatus == 0);
+    NL_TEST_ASSERT(inSuite, errno == 0);
+
+    NL_TEST_ASSERT(inSuite, lResult.mSum == 2108);
+    NL_TEST_ASSERT(inSuite, lResult.mSumOverflowed == 0);
+    NL_TEST_ASSERT(inSuite, lResult.mMinimum == 200);
+    NL_TEST_ASSERT(inSuite, lResult.mMaximum == 503);
+    NL_TEST_ASSERT(inSuite, lResult.mCount == 6);
+    NL_TEST_ASSERT(inSuite, lResult.mInvalid == 2);
+
+    NL_TEST_ASSERT(inSuite, lResult.mHistogram[0] == 0);
+    NL_TEST_ASSERT(inSuite, lResult.mHistogram[1] == 2);
+    NL_TEST_ASSERT(inSuite, lResult.mHistogram[2] == 1);
+    NL_TEST_ASSERT(inSuite, lResult.mHistogram[3] == 1);
+    NL_TEST_ASSERT(inSuite, lResult.mHistogram[4] == 2);
+
+    // The buffer length bounds the last field.
+
+    memset(&lResult, 0, sizeof (lResult));
+
+    lStatus = strntoul_reduce(lBuffer, 6, ',', 10, STRNTOUL_REDUCE_SUM | STRNTOUL_REDUCE_COUNT, &lResult);
+    NL_TEST_ASSERT(inSuite, lStatus == 0);
+    NL_TEST_ASSERT(inSuite, lResult.mSum == 240);
+    NL_TEST_ASSERT(inSuite, lResult.mCount == 2);
+
+    // Other bases are converted as strntoul would.
+
+    lBuffer = "0x10 0x20 0x30";
+
+    memset(&lResult, 0, sizeof (lResult));
+
+    lStatus = strntoul_reduce(lBuffer, strlen(lBuffer), ' ', 16, STRNTOUL_REDUCE_SUM | STRNTOUL_REDUCE_MAX, &lResult);
+    NL_TEST_ASSERT(inSuite, lStatus == 0);
+    NL_TEST_ASSERT(inSuite, lResult.mSum == 0x60);
+    NL_TEST_ASSERT(inSuite, lResult.mMaximum == 0x30);
+}
+
+static void TestEmpty(nlTestSuite *inSuite __attribute__((unused)),
+                      void *inContext __attribute__((unused)))
+{
+    strntoul_reduce_result_t lResult;
+    int                      lStatus;
+
+    memset(&lResult, 0, sizeof (lResult));
+
+    lStatus = strntoul_reduce(",,,", 3, ',', 10, STRNTOUL_REDUCE_ALL & ~STRNTOUL_REDUCE_HISTOGRAM, &lResult);
+    NL_TEST_ASSERT(inSuite, lStatus == 0);
+    NL_TEST_ASSERT(inSuite, lResult.mCount == 0);
+    NL_TEST_ASSERT(inSuite, lResult.mInvalid == 0);
+    NL_TEST_ASSERT(inSuite, lResult.mSum == 0);
+    NL_TEST_ASSERT(inSuite, lResult.mMinimum == ULONG_MAX);
+    NL_TEST_ASSERT(inSuite, lResult.mMaximum == 0);
+}
+
+static void TestOverflow(nlTestSuite *inSuite __attribute__((unused)),
+                         void *inContext __attribute__((unused)))
+{
+    const char *             lBuffer;
+    strntoul_reduce_result_t lResult;
+    int                      lStatus;
+
+    // 1: The sum overflows but each value is in range.
+
+    lBuffer = "18446744073709551615,1";
+
+    memset(&lResult, 0, sizeof (lResult));
+
+    errno = 0;
+
+    lStatus = strntoul_reduce(lBuffer, strlen(lBuffer), ',', 10, STRNTOUL_REDUCE_SUM | STRNTOUL_REDUCE_COUNT, &lResult);
+    NL_TEST_ASSERT(inSuite, lStatus == 0);
+    NL_TEST_ASSERT(inSuite, errno == 0);
+    NL_TEST_ASSERT(inSuite, lResult.mSumOverflowed != 0);
+    NL_TEST_ASSERT(inSuite, lResult.mCount == 2);
+
+    // 2: A value itself is out of range.
+
+    lBuffer = "18446744073709551616,1";
+
+    memset(&lResult, 0, sizeof (lResult));
+
+    errno = 0;
+
+    lStatus = strntoul_reduce(lBuffer, strlen(lBuffer), ',', 10, STRNTOUL_REDUCE_SUM | STRNTOUL_REDUCE_COUNT, &lResult);
+    NL_TEST_ASSERT(inSuite, lStatus == 0);
+    NL_TEST_ASSERT(inSuite, errno == ERANGE);
+    NL_TEST_ASSERT(inSuite, lResult.mSumOverflowed == 0);
+    NL_TEST_ASSERT(inSuite, lResult.mSum == 1);
+    NL_TEST_ASSERT(inSuite, lResult.mCount == 1);
+    NL_TEST_ASSERT(inSuite, lResult.mInvalid == 1);
+}
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+static const nlTest sTests[] = {
+    NL_TEST_DEF("Invalid Arguments", TestInvalidArguments),
+    NL_TEST_DEF("Reductions",        TestReductions),
+    NL_TEST_DEF("Empty",             TestEmpty),
+    NL_TEST_DEF("Overflow",          TestOverflow),
+
+    NL_TEST_SENTINEL()
+};
+
+int main(void)
+{
+    nlTestSuite theSuite = {
+        "strntoul_reduce",
+        &sTests[0],
+        nullptr,
+        nullptr,
+        nullptr,
+        nullptr,
+        0,
+        0,
+        0,
+        0,
+        0
+    };
+
+    // Generate human-readable output.
+    nlTestSetOutputStyle(OUTPUT_DEF);
+
+    // Run test suit againt one context.
+    nlTestRunner(&theSuite, nullptr);
+
+    return nlTestRunnerStats(&theSuite);
+}
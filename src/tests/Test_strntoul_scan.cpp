@@ -0,0 +1,217 @@
+/*
+ *    Copyright (c) 2024 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *    @file
+ *      This file implements a unit test for the strntoul format
+ *      scanner.
+ *
+ */
+
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <nlunit-test.h>
+
+#include <strntoul_scan.h>
+
+using namespace StrNToUL::Scan;
+
+
+static void TestCompileTime(nlTestSuite *inSuite __attribute__((unused)),
+                            void *inContext __attribute__((unused)))
+{
+    const char * lLine = "ts=1700000000 lat=250 code=1f4 delta=-12 mode=0755 any=0x10";
+    unsigned int lTimestamp;
+    uint16_t     lLatency;
+    unsigned int lCode;
+    int          lDelta;
+    unsigned int lMode;
+    long         lAny;
+    char *       lEnd;
+    int          lFields;
+
+    lFields = Scan(STRNTOUL_SCAN_FORMAT("ts=%u lat=%u code=%x delta=%d mode=%o any=%i"),
+                   lLine, strlen(lLine), &lEnd,
+                   &lTimestamp, &lLatency, &lCode, &lDelta, &lMode, &lAny);
+    NL_TEST_ASSERT(inSuite, lFields == 6);
+    NL_TEST_ASSERT(inSuite, lEnd == lLine + strlen(lLine));
+    NL_TEST_ASSERT(inSuite, lTimestamp == 1700000000);
+    NL_TEST_ASSERT(inSuite, lLatency == 250);
+    NL_TEST_ASSERT(inSuite, lCode == 0x1f4);
+    NL_TEST_ASSERT(inSuite, lDelta == -12);
+    NL_TEST_ASSERT(inSuite, lMode == 0755);
+    NL_TEST_ASSERT(inSuite, lAny == 16);
+
+    // White space in the format matches any amount, including none,
+    // and "%%" matches a literal percent.
+
+    lLine = "cpu:\t 42%  idle:7%";
+
+    lFields = Scan(STRNTOUL_SCAN_FORMAT("cpu: %u%% idle:%u%%"), lLine, strlen(lLine), &lEnd, &lCode, &lMode);
+    NL_TEST_ASSERT(inSuite, lFields == 2);
+    NL_TEST_ASSERT(inSuite, (lCode == 42) && (lMode == 7));
+    NL_TEST_ASSERT(inSuite, lEnd == lLine + strlen(lLine));
+
+    // Fields are otherwise converted exactly as strntoul would,
+    // including any prefix, sign, or leading white space.
+
+    lLine = "a=0x1f b=+7 c= 12345678901234567890";
+
+    lFields = Scan(STRNTOUL_SCAN_FORMAT("a=%x b=%d c=%u"), lLine, strlen(lLine), &lEnd, &lCode, &lDelta, &lTimestamp);
+    NL_TEST_ASSERT(inSuite, lFields == 2);
+    NL_TEST_ASSERT(inSuite, (lCode == 0x1f) && (lDelta == 7));
+}
+
+static void TestMismatches(nlTestSuite *inSuite __attribute__((unused)),
+                           void *inContext __attribute__((unused)))
+{
+    const char *  lLine = "ts=17 lat=250 code=zz";
+    unsigned int  lTimestamp = 0;
+    unsigned int  lLatency   = 0;
+    unsigned int  lCode      = 0;
+    uint8_t       lSmall     = 0;
+    char *        lEnd;
+    int           lFields;
+
+    // A literal mismatch stops the scan after the fields so far.
+
+    lFields = Scan(STRNTOUL_SCAN_FORMAT("ts=%u lat=%u code=%x"), lLine, strlen(lLine), &lEnd, &lTimestamp, &lLatency, &lCode);
+    NL_TEST_ASSERT(inSuite, lFields == 2);
+    NL_TEST_ASSERT(inSuite, (lTimestamp == 17) && (lLatency == 250) && (lCode == 0));
+    NL_TEST_ASSERT(inSuite, lEnd == lLine + 19);
+
+    // The length bounds the scan, even mid-literal or mid-field.
+
+    lFields = Scan(STRNTOUL_SCAN_FORMAT("ts=%u lat=%u"), lLine, 12, &lEnd, &lTimestamp, &lLatency);
+    NL_TEST_ASSERT(inSuite, lFields == 2);
+    NL_TEST_ASSERT(inSuite, lLatency == 25);
+
+    lFields = Scan(STRNTOUL_SCAN_FORMAT("ts=%u lat=%u"), lLine, 8, &lEnd, &lTimestamp, &lLatency);
+    NL_TEST_ASSERT(inSuite, lFields == 1);
+    NL_TEST_ASSERT(inSuite, lEnd == lLine + 6);
+
+    // A value that does not fit its output is a mismatch.
+
+    lLine = "v=256";
+
+    lFields = Scan(STRNTOUL_SCAN_FORMAT("v=%u"), lLine, strlen(lLine), &lEnd, &lSmall);
+    NL_TEST_ASSERT(inSuite, lFields == 0);
+    NL_TEST_ASSERT(inSuite, lEnd == lLine + 2);
+
+    lLine = "v=-1";
+
+    lFields = Scan(STRNTOUL_SCAN_FORMAT("v=%d"), lLine, strlen(lLine), &lEnd, &lLatency);
+    NL_TEST_ASSERT(inSuite, lFields == 0);
+
+    // As is one out of range for the conversion itself, without
+    // disturbing errno.
+
+    lLine = "v=99999999999999999999";
+
+    errno = 0;
+
+    lFields = Scan(STRNTOUL_SCAN_FORMAT("v=%u"), lLine, strlen(lLine), nullptr, &lTimestamp);
+    NL_TEST_ASSERT(inSuite, lFields == 0);
+    NL_TEST_ASSERT(inSuite, errno == 0);
+}
+
+static void TestRuntime(nlTestSuite *inSuite __attribute__((unused)),
+                        void *inContext __attribute__((unused)))
+{
+    const char *  lFormat = "ts=%u lat=%u code=%x";
+    const char *  lLine   = "ts=1700000000 lat=250 code=1f4";
+    RuntimeFormat lRuntime;
+    unsigned long lTimestamp;
+    unsigned int  lLatency;
+    unsigned int  lCode;
+    int           lSigned;
+    char *        lEnd;
+    int           lStatus;
+
+    lStatus = lRuntime.Init(lFormat, strlen(lFormat));
+    NL_TEST_ASSERT(inSuite, lStatus == 0);
+    NL_TEST_ASSERT(inSuite, lRuntime.Fields() == 3);
+
+    lStatus = Scan(lRuntime, lLine, strlen(lLine), &lEnd, &lTimestamp, &lLatency, &lCode);
+    NL_TEST_ASSERT(inSuite, lStatus == 3);
+    NL_TEST_ASSERT(inSuite, lEnd == lLine + strlen(lLine));
+    NL_TEST_ASSERT(inSuite, (lTimestamp == 1700000000) && (lLatency == 250) && (lCode == 0x1f4));
+
+    // The outputs must match the fields.
+
+    lStatus = Scan(lRuntime, lLine, strlen(lLine), &lEnd, &lTimestamp, &lLatency);
+    NL_TEST_ASSERT(inSuite, lStatus == -EINVAL);
+
+    // Invalid formats are rejected.
+
+    lStatus = lRuntime.Init("v=%q", 4);
+    NL_TEST_ASSERT(inSuite, lStatus == -EINVAL);
+
+    lStatus = lRuntime.Init("v=%", 3);
+    NL_TEST_ASSERT(inSuite, lStatus == -EINVAL);
+
+    // The format need not be null-terminated.
+
+    lStatus = lRuntime.Init("n=%dXYZ", 4);
+    NL_TEST_ASSERT(inSuite, lStatus == 0);
+
+    lStatus = Scan(lRuntime, "n=-5", 4, &lEnd, &lLatency);
+    NL_TEST_ASSERT(inSuite, lStatus == 0);
+
+    lStatus = Scan(lRuntime, "n=-5", 4, &lEnd, &lSigned);
+    NL_TEST_ASSERT(inSuite, lStatus == 1);
+    NL_TEST_ASSERT(inSuite, lSigned == -5);
+}
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+static const nlTest sTests[] = {
+    NL_TEST_DEF("Compile Time", TestCompileTime),
+    NL_TEST_DEF("Mismatches",   TestMismatches),
+    NL_TEST_DEF("Runtime",      TestRuntime),
+
+    NL_TEST_SENTINEL()
+};
+
+int main(void)
+{
+    nlTestSuite theSuite = {
+        "strntoul_scan",
+        &sTests[0],
+        nullptr,
+        nullptr,
+        nullptr,
+        nullptr,
+        0,
+        0,
+        0,
+        0,
+        0
+    };
+
+    // Generate human-readable output.
+    nlTestSetOutputStyle(OUTPUT_DEF);
+
+    // Run test suit againt one context.
+    nlTestRunner(&theSuite, nullptr);
+
+    return nlTestRunnerStats(&theSuite);
+}
@@ -0,0 +1,313 @@
+/*
+ *    Copyright (c) 2024 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *    @file
+ *      This file implements a unit test for the strntoul sidecar
+ *      interfaces.
+ *
+ */
+
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <nlunit-test.h>
+
+#include <strntoul_sidecar.h>
+
+
+static char sSourcePath[]  = "/tmp/Test_strntoul_sidecar.XXXXXX";
+static char sSidecarPath[sizeof (sSourcePath) + 4];
+
+static bool WriteSource(const char *aContents)
+{
+    FILE *lFile = fopen(sSourcePath, "w");
+    bool  lRetval;
+
+    if (lFile == nullptr)
+    {
+        return (false);
+    }
+
+    lRetval = (fwrite(aContents, 1, strlen(aContents), lFile) == strlen(aContents));
+
+    return ((fclose(lFile) == 0) && lRetval);
+}
+
+static void TestInvalidArguments(nlTestSuite *inSuite __attribute__((unused)),
+                                 void *inContext __attribute__((unused)))
+{
+    strntoul_sidecar_t *lSidecar;
+    int                 lStatus;
+
+    lStatus = strntoul_sidecar_build(nullptr, sSidecarPath, ',', 10, STRNTOUL_SIDECAR_ENCODING_FIXED);
+    NL_TEST_ASSERT(inSuite, lStatus == -EINVAL);
+
+    lStatus = strntoul_sidecar_build(sSourcePath, sSidecarPath, ',', 1, STRNTOUL_SIDECAR_ENCODING_FIXED);
+    NL_TEST_ASSERT(inSuite, lStatus == -EINVAL);
+
+    lStatus = strntoul_sidecar_open(sSidecarPath, nullptr, 0, nullptr);
+    NL_TEST_ASSERT(inSuite, lStatus == -EINVAL);
+
+    // A file that is not a sidecar is malformed.
+
+    NL_TEST_ASSERT(inSuite, WriteSource("1,2,3\n"));
+
+    lStatus = strntoul_sidecar_open(sSourcePath, nullptr, 0, &lSidecar);
+    NL_TEST_ASSERT(inSuite, lStatus == -EINVAL);
+}
+
+static void TestFixed(nlTestSuite *inSuite __attribute__((unused)),
+                      void *inContext __attribute__((unused)))
+{
+    strntoul_sidecar_t *lSidecar;
+    const int64_t *     lColumn;
+    int64_t             lValues[4];
+    int                 lStatus;
+
+    NL_TEST_ASSERT(inSuite, WriteSource("1,-2,30\n4,5,x\n\n7,8\n"));
+
+    lStatus = strntoul_sidecar_build(sSourcePath, sSidecarPath, ',', 10, STRNTOUL_SIDECAR_ENCODING_FIXED);
+    NL_TEST_ASSERT(inSuite, lStatus == 0);
+
+    lStatus = strntoul_sidecar_open(sSidecarPath, sSourcePath, STRNTOUL_SIDECAR_VERIFY_HASH, &lSidecar);
+    NL_TEST_ASSERT(inSuite, lStatus == 0);
+
+    if (lStatus != 0)
+    {
+        return;
+    }
+
+    NL_TEST_ASSERT(inSuite, strntoul_sidecar_rows(lSidecar) == 3);
+    NL_TEST_ASSERT(inSuite, strntoul_sidecar_columns(lSidecar) == 3);
+    NL_TEST_ASSERT(inSuite, strntoul_sidecar_encoding(lSidecar) == STRNTOUL_SIDECAR_ENCODING_FIXED);
+
+    // Fixed columns are directly addressable; missing and invalid
+    // fields are zero.
+
+    lColumn = strntoul_sidecar_column(lSidecar, 1);
+    NL_TEST_ASSERT(inSuite, lColumn != nullptr);
+    NL_TEST_ASSERT(inSuite, (lColumn[0] == -2) && (lColumn[1] == 5) && (lColumn[2] == 8));
+
+    lStatus = strntoul_sidecar_decode(lSidecar, 2, lValues, 4);
+    NL_TEST_ASSERT(inSuite, lStatus == 0);
+    NL_TEST_ASSERT(inSuite, (lValues[0] == 30) && (lValues[1] == 0) && (lValues[2] == 0));
+
+    NL_TEST_ASSERT(inSuite, strntoul_sidecar_column(lSidecar, 3) == nullptr);
+    NL_TEST_ASSERT(inSuite, strntoul_sidecar_decode(lSidecar, 3, lValues, 4) == -EINVAL);
+
+    strntoul_sidecar_close(lSidecar);
+}
+
+static void TestDelta(nlTestSuite *inSuite __attribute__((unused)),
+                      void *inContext __attribute__((unused)))
+{
+    strntoul_sidecar_t *lSidecar;
+    int64_t             lValues[5];
+    int                 lStatus;
+
+    NL_TEST_ASSERT(inSuite, WriteSource("1000 0x10\n"
+                                        "1001 -0x7fffffffffffffff\n"
+                                        "1003 0x7fffffffffffffff\n"
+                                        "999 0\n"
+                                        "1000000 1\n"));
+
+    lStatus = strntoul_sidecar_build(sSourcePath, sSidecarPath, ' ', 0, STRNTOUL_SIDECAR_ENCODING_DELTA);
+    NL_TEST_ASSERT(inSuite, lStatus == 0);
+
+    lStatus = strntoul_sidecar_open(sSidecarPath, sSourcePath, 0, &lSidecar);
+    NL_TEST_ASSERT(inSuite, lStatus == 0);
+
+    if (lStatus != 0)
+    {
+        return;
+    }
+
+    NL_TEST_ASSERT(inSuite, strntoul_sidecar_rows(lSidecar) == 5);
+    NL_TEST_ASSERT(inSuite, strntoul_sidecar_encoding(lSidecar) == STRNTOUL_SIDECAR_ENCODING_DELTA);
+
+    // Delta columns must be decoded.
+
+    NL_TEST_ASSERT(inSuite, strntoul_sidecar_column(lSidecar, 0) == nullptr);
+
+    lStatus = strntoul_sidecar_decode(lSidecar, 0, lValues, 5);
+    NL_TEST_ASSERT(inSuite, lStatus == 0);
+    NL_TEST_ASSERT(inSuite, (lValues[0] == 1000) && (lValues[1] == 1001) && (lValues[2] == 1003));
+    NL_TEST_ASSERT(inSuite, (lValues[3] == 999) && (lValues[4] == 1000000));
+
+    // Deltas spanning the whole range round-trip.
+
+    lStatus = strntoul_sidecar_decode(lSidecar, 1, lValues, 5);
+    NL_TEST_ASSERT(inSuite, lStatus == 0);
+    NL_TEST_ASSERT(inSuite, (lValues[0] == 16) && (lValues[1] == -0x7fffffffffffffffLL));
+    NL_TEST_ASSERT(inSuite, (lValues[2] == 0x7fffffffffffffffLL) && (lValues[3] == 0) && (lValues[4] == 1));
+
+    strntoul_sidecar_close(lSidecar);
+}
+
+static void TestRange(nlTestSuite *inSuite __attribute__((unused)),
+                      void *inContext __attribute__((unused)))
+{
+    strntoul_sidecar_t *lSidecar;
+    const int64_t *     lColumn;
+    int                 lStatus;
+
+    NL_TEST_ASSERT(inSuite, WriteSource("9223372036854775807,-9223372036854775808\n"
+                                        "18446744073709551615,-18446744073709551615\n"));
+
+    lStatus = strntoul_sidecar_build(sSourcePath, sSidecarPath, ',', 10, STRNTOUL_SIDECAR_ENCODING_FIXED);
+    NL_TEST_ASSERT(inSuite, lStatus == 0);
+
+    lStatus = strntoul_sidecar_open(sSidecarPath, sSourcePath, 0, &lSidecar);
+    NL_TEST_ASSERT(inSuite, lStatus == 0);
+
+    if (lStatus != 0)
+    {
+        return;
+    }
+
+    // Columns are signed 64-bit integers; fields beyond their range
+    // saturate.
+
+    lColumn = strntoul_sidecar_column(lSidecar, 0);
+    NL_TEST_ASSERT(inSuite, lColumn != nullptr);
+    NL_TEST_ASSERT(inSuite, (lColumn[0] == INT64_MAX) && (lColumn[1] == INT64_MAX));
+
+    lColumn = strntoul_sidecar_column(lSidecar, 1);
+    NL_TEST_ASSERT(inSuite, lColumn != nullptr);
+    NL_TEST_ASSERT(inSuite, (lColumn[0] == INT64_MIN) && (lColumn[1] == INT64_MIN));
+
+    strntoul_sidecar_close(lSidecar);
+}
+
+static void TestStale(nlTestSuite *inSuite __attribute__((unused)),
+                      void *inContext __attribute__((unused)))
+{
+    strntoul_sidecar_t *lSidecar;
+    int                 lStatus;
+
+    NL_TEST_ASSERT(inSuite, WriteSource("1,2\n3,4\n"));
+
+    lStatus = strntoul_sidecar_build(sSourcePath, sSidecarPath, ',', 10, STRNTOUL_SIDECAR_ENCODING_FIXED);
+    NL_TEST_ASSERT(inSuite, lStatus == 0);
+
+    // A source that has changed size is stale.
+
+    NL_TEST_ASSERT(inSuite, WriteSource("1,2\n3,4\n5,6\n"));
+
+    lStatus = strntoul_sidecar_open(sSidecarPath, sSourcePath, 0, &lSidecar);
+    NL_TEST_ASSERT(inSuite, lStatus == -ESTALE);
+
+    // But the sidecar may still be opened without validation.
+
+    lStatus = strntoul_sidecar_open(sSidecarPath, nullptr, 0, &lSidecar);
+    NL_TEST_ASSERT(inSuite, lStatus == 0);
+
+    if (lStatus == 0)
+    {
+        NL_TEST_ASSERT(inSuite, strntoul_sidecar_rows(lSidecar) == 2);
+
+        strntoul_sidecar_close(lSidecar);
+    }
+
+    // A missing source cannot be validated.
+
+    lStatus = strntoul_sidecar_open(sSidecarPath, "/nonexistent/source", 0, &lSidecar);
+    NL_TEST_ASSERT(inSuite, lStatus == -ENOENT);
+}
+
+static void TestEmpty(nlTestSuite *inSuite __attribute__((unused)),
+                      void *inContext __attribute__((unused)))
+{
+    strntoul_sidecar_t *lSidecar;
+    int                 lStatus;
+
+    NL_TEST_ASSERT(inSuite, WriteSource(""));
+
+    lStatus = strntoul_sidecar_build(sSourcePath, sSidecarPath, ',', 10, STRNTOUL_SIDECAR_ENCODING_DELTA);
+    NL_TEST_ASSERT(inSuite, lStatus == 0);
+
+    lStatus = strntoul_sidecar_open(sSidecarPath, sSourcePath, STRNTOUL_SIDECAR_VERIFY_HASH, &lSidecar);
+    NL_TEST_ASSERT(inSuite, lStatus == 0);
+
+    if (lStatus == 0)
+    {
+        NL_TEST_ASSERT(inSuite, strntoul_sidecar_rows(lSidecar) == 0);
+        NL_TEST_ASSERT(inSuite, strntoul_sidecar_columns(lSidecar) == 0);
+
+        strntoul_sidecar_close(lSidecar);
+    }
+}
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+static const nlTest sTests[] = {
+    NL_TEST_DEF("Invalid Arguments", TestInvalidArguments),
+    NL_TEST_DEF("Fixed",             TestFixed),
+    NL_TEST_DEF("Delta",             TestDelta),
+    NL_TEST_DEF("Range",             TestRange),
+    NL_TEST_DEF("Stale",             TestStale),
+    NL_TEST_DEF("Empty",             TestEmpty),
+
+    NL_TEST_SENTINEL()
+};
+
+int main(void)
+{
+    nlTestSuite theSuite = {
+        "strntoul_sidecar",
+        &sTests[0],
+        nullptr,
+        nullptr,
+        nullptr,
+        nullptr,
+        0,
+        0,
+        0,
+        0,
+        0
+    };
+    int lDescriptor;
+
+    lDescriptor = mkstemp(sSourcePath);
+
+    if (lDescriptor < 0)
+    {
+        return (EXIT_FAILURE);
+    }
+
+    close(lDescriptor);
+
+    snprintf(sSidecarPath, sizeof (sSidecarPath), "%s.bin", sSourcePath);
+
+    // Generate human-readable output.
+    nlTestSetOutputStyle(OUTPUT_DEF);
+
+    // Run test suit againt one context.
+    nlTestRunner(&theSuite, nullptr);
+
+    unlink(sSidecarPath);
+    unlink(sSourcePath);
+
+    return nlTestRunnerStats(&theSuite);
+}
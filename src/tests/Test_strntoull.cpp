@@ -0,0 +1,321 @@
+/*
+ *    Copyright (c) 2024 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *    @file
+ *      This file implements a unit test for strntoull.
+ *
+ */
+
+#include <errno.h>
+#include <limits.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <sys/mman.h>
+
+#include <string>
+
+#include <nlunit-test.h>
+
+#include <strntoull.h>
+
+
+/**
+ *  Generate a well-formed, random number in @a aBase, with optional
+ *  leading white space, sign, and prefix, and trailing junk.
+ *
+ */
+static std::string Generate(uint64_t &aState, const int &aBase)
+{
+    static const char kDigits[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+    const int         lBase     = (aBase == 0) ? 10 : aBase;
+    std::string       lRetval;
+    size_t            lDigits;
+
+    aState ^= aState << 13;
+    aState ^= aState >> 7;
+    aState ^= aState << 17;
+
+    lRetval.append(aState & 3, ' ');
+
+    if ((aState >> 2) & 1)
+    {
+        lRetval += ((aState >> 3) & 1) ? '-' : '+';
+    }
+
+    if ((aBase == 16) && ((aState >> 4) & 1))
+    {
+        lRetval += "0x";
+    }
+
+    lDigits = 1 + ((aState >> 8) % 24);
+
+    for (size_t i = 0; i < lDigits; i++)
+    {
+        const char lDigit = kDigits[(aState >> (i % 48)) % static_cast<unsigned int>(lBase)];
+
+        // Avoid a leading zero, which would change a deduced base.
+
+        lRetval += ((i == 0) && (lDigit == '0')) ? '1' : lDigit;
+    }
+
+    if ((aState >> 5) & 1)
+    {
+        lRetval += " z";
+    }
+
+    return (lRetval);
+}
+
+static void TestLimits(nlTestSuite *inSuite __attribute__((unused)),
+                       void *inContext __attribute__((unused)))
+{
+    const char *       lString;
+    char *             lEnd;
+    unsigned long long lResult;
+
+    // 1: The largest value, which needs 64 bits on every target.
+
+    errno   = 0;
+    lString = "18446744073709551615";
+
+    lResult = strntoull(lString, strlen(lString), &lEnd, 10);
+    NL_TEST_ASSERT(inSuite, lResult == ULLONG_MAX);
+    NL_TEST_ASSERT(inSuite, lEnd == lString + strlen(lString));
+    NL_TEST_ASSERT(inSuite, errno == 0);
+
+    lString = "0xffffffffffffffff";
+
+    lResult = strntoull(lString, strlen(lString), &lEnd, 0);
+    NL_TEST_ASSERT(inSuite, lResult == ULLONG_MAX);
+    NL_TEST_ASSERT(inSuite, errno == 0);
+
+    // 2: One more, which overflows.
+
+    lString = "18446744073709551616";
+
+    lResult = strntoull(lString, strlen(lString), &lEnd, 10);
+    NL_TEST_ASSERT(inSuite, lResult == ULLONG_MAX);
+    NL_TEST_ASSERT(inSuite, lEnd == lString + strlen(lString));
+    NL_TEST_ASSERT(inSuite, errno == ERANGE);
+
+    // 3: The length bounds the conversion.
+
+    errno   = 0;
+
+    lResult = strntoull(lString, 19, &lEnd, 10);
+    NL_TEST_ASSERT(inSuite, lResult == 1844674407370955161ULL);
+    NL_TEST_ASSERT(inSuite, errno == 0);
+
+    // 4: An invalid base.
+
+    lResult = strntoull(lString, strlen(lString), &lEnd, 37);
+    NL_TEST_ASSERT(inSuite, lResult == 0);
+    NL_TEST_ASSERT(inSuite, lEnd == lString);
+    NL_TEST_ASSERT(inSuite, errno == EINVAL);
+}
+
+static void TestAgreement(nlTestSuite *inSuite __attribute__((unused)),
+                          void *inContext __attribute__((unused)))
+{
+    static const int kBases[] = { 0, 2, 8, 10, 16, 36 };
+    uint64_t         lState   = 0x9E3779B97F4A7C15ULL;
+
+    for (int lBase : kBases)
+    {
+        for (size_t i = 0; i < 2000; i++)
+        {
+            const std::string  lString = Generate(lState, lBase);
+            char *             lExpectedEnd;
+            char *             lEnd;
+            unsigned long long lExpected;
+            unsigned long long lResult;
+            int                lExpectedErrno;
+
+            errno = 0;
+
+            lExpected      = strtoull(lString.c_str(), &lExpectedEnd, lBase);
+            lExpectedErrno = errno;
+
+            errno = 0;
+
+            lResult = strntoull(lString.data(), lString.size(), &lEnd, lBase);
+            NL_TEST_ASSERT(inSuite, lResult == lExpected);
+            NL_TEST_ASSERT(inSuite, lEnd == lExpectedEnd - lString.c_str() + lString.data());
+            NL_TEST_ASSERT(inSuite, errno == lExpectedErrno);
+        }
+    }
+}
+
+static void TestRadix(nlTestSuite *inSuite __attribute__((unused)),
+                      void *inContext __attribute__((unused)))
+{
+    static const int kBases[] = { 2, 8 };
+    uint64_t         lState   = 0xD1B54A32D192ED03ULL;
+
+    // Binary and octal runs that span, end within, and overrun the
+    // 16-byte kernel windows, with leading zeroes that defer overflow
+    // and with trailing bytes that are only just not digits.
+
+    for (int lBase : kBases)
+    {
+        for (size_t lDigits = 1; lDigits <= 80; lDigits++)
+        {
+            for (size_t i = 0; i < 64; i++)
+            {
+                static const char kJunk[] = { '\0', ' ', '/', ':', '8', '9', 'q', '\xb0' };
+                std::string        lString;
+                char *             lExpectedEnd;
+                char *             lEnd;
+                unsigned long long lExpected;
+                unsigned long long lResult;
+                int                lExpectedErrno;
+
+                lState ^= lState << 13;
+                lState ^= lState >> 7;
+                lState ^= lState << 17;
+
+                for (size_t j = 0; j < lDigits; j++)
+                {
+                    const uint64_t lPick = (lState >> (j % 61)) ^ (j * 0x9E37U);
+
+                    // Favor leading zeroes in a quarter of the strings.
+
+                    lString += ((((lState >> 62) == 0) && (j < (lDigits / 2))) ?
+                                '0' :
+                                static_cast<char>('0' + (lPick % static_cast<unsigned int>(lBase))));
+                }
+
+                lString += kJunk[(lState >> 3) % sizeof (kJunk)];
+
+                errno = 0;
+
+                lExpected      = strtoull(lString.c_str(), &lExpectedEnd, lBase);
+                lExpectedErrno = errno;
+
+                errno = 0;
+
+                lResult = strntoull(lString.data(), lString.size(), &lEnd, lBase);
+                NL_TEST_ASSERT(inSuite, lResult == lExpected);
+                NL_TEST_ASSERT(inSuite, lEnd == lExpectedEnd - lString.c_str() + lString.data());
+                NL_TEST_ASSERT(inSuite, errno == lExpectedErrno);
+
+                // The length, rather than the junk, may also end the
+                // run, in the middle of a window.
+
+                errno = 0;
+
+                lResult = strntoull(lString.data(), lDigits, &lEnd, lBase);
+                NL_TEST_ASSERT(inSuite, lResult == lExpected);
+                NL_TEST_ASSERT(inSuite, lEnd == lString.data() + lDigits);
+                NL_TEST_ASSERT(inSuite, errno == lExpectedErrno);
+            }
+        }
+    }
+}
+
+static void TestPageBoundary(nlTestSuite *inSuite __attribute__((unused)),
+                             void *inContext __attribute__((unused)))
+{
+    static const size_t kLengths[] = { 16, 32 };
+    const size_t        lPageSize  = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    char *              lPages;
+    unsigned long long  lResult;
+    char *              lEnd;
+    int                 lStatus;
+
+    // Binary and octal values that exactly fill one and two windows
+    // and end exactly at a guard page.
+
+    lPages = static_cast<char *>(mmap(nullptr,
+                                      lPageSize * 2,
+                                      PROT_READ | PROT_WRITE,
+                                      MAP_PRIVATE | MAP_ANONYMOUS,
+                                      -1,
+                                      0));
+    NL_TEST_ASSERT(inSuite, lPages != MAP_FAILED);
+
+    if (lPages == MAP_FAILED)
+        return;
+
+    lStatus = mprotect(lPages + lPageSize, lPageSize, PROT_NONE);
+    NL_TEST_ASSERT(inSuite, lStatus == 0);
+
+    for (size_t lLength : kLengths)
+    {
+        char * const lString = lPages + lPageSize - lLength;
+
+        memset(lString, '1', lLength);
+
+        lResult = strntoull(lString, lLength, &lEnd, 2);
+        NL_TEST_ASSERT(inSuite, lResult == ((1ULL << lLength) - 1));
+        NL_TEST_ASSERT(inSuite, lEnd == lString + lLength);
+
+        memset(lString, '7', lLength);
+
+        lResult = strntoull(lString, lLength, &lEnd, 8);
+        NL_TEST_ASSERT(inSuite, lEnd == lString + lLength);
+
+        lString[0] = '0';
+
+        lResult = strntoull(lString, lLength, &lEnd, 0);
+        NL_TEST_ASSERT(inSuite, lEnd == lString + lLength);
+    }
+
+    munmap(lPages, lPageSize * 2);
+}
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+static const nlTest sTests[] = {
+    NL_TEST_DEF("Limits",    TestLimits),
+    NL_TEST_DEF("Agreement", TestAgreement),
+    NL_TEST_DEF("Radix",     TestRadix),
+    NL_TEST_DEF("Page Boundary", TestPageBoundary),
+
+    NL_TEST_SENTINEL()
+};
+
+int main(void)
+{
+    nlTestSuite theSuite = {
+        "strntoull",
+        &sTests[0],
+        nullptr,
+        nullptr,
+        nullptr,
+        nullptr,
+        0,
+        0,
+        0,
+        0,
+        0
+    };
+
+    // Generate human-readable output.
+    nlTestSetOutputStyle(OUTPUT_DEF);
+
+    // Run test suit againt one context.
+    nlTestRunner(&theSuite, nullptr);
+
+    return nlTestRunnerStats(&theSuite);
+}
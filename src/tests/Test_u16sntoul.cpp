@@ -0,0 +1,261 @@
+/*
+ *    Copyright (c) 2024 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *    @file
+ *      This file implements a unit test for u16sntoul and u16sntol.
+ *
+ */
+
+#include <errno.h>
+#include <limits.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <string>
+
+#include <nlunit-test.h>
+
+#include <strntol.h>
+#include <strntoul.h>
+#include <u16sntoul.h>
+
+
+/**
+ *  Generate a random UTF-16 string, favoring digits, along with its
+ *  narrow equivalent, in which each code unit outside of ASCII is
+ *  replaced by an invalid character.
+ *
+ */
+static void Generate(uint64_t &aState, std::u16string &aWide, std::string &aNarrow)
+{
+    static const char16_t kUnits[] = {
+        ' ', '\t', '+', '-', '0', 'x', 'X', 'f', 'z', '!', ',',
+        0x0131,  // Dotless i, whose low byte is '1'.
+        0xFF11,  // Full-width '1'.
+        0x8031,  // Negative as a signed 16-bit unit.
+        0x00A0,  // No-break space.
+        0x0000
+    };
+    size_t                 lLength;
+
+    aState ^= aState << 13;
+    aState ^= aState >> 7;
+    aState ^= aState << 17;
+
+    // Occasionally, go well past the narrowing stack buffer.
+
+    lLength = static_cast<size_t>((aState & 0xF) == 0 ? (aState % 600) : (aState % 48));
+
+    aWide.clear();
+    aNarrow.clear();
+
+    for (size_t j = 0; j < lLength; j++)
+    {
+        const uint64_t lPick = (aState >> ((j % 8) * 8)) ^ (j * 0x9E37U);
+        char16_t       lUnit;
+
+        if ((lPick & 7) == 0)
+        {
+            lUnit = kUnits[lPick % (sizeof (kUnits) / sizeof (kUnits[0]))];
+        }
+        else if ((aState & 0x30) == 0)
+        {
+            // Long runs of leading white space or zeroes.
+
+            lUnit = (((aState >> 6) & 1) ? u' ' : u'0');
+
+            if (j > (lLength / 2))
+            {
+                lUnit = static_cast<char16_t>('0' + (lPick % 10));
+            }
+        }
+        else
+        {
+            lUnit = static_cast<char16_t>('0' + (lPick % 10));
+        }
+
+        aWide   += lUnit;
+        aNarrow += ((lUnit < 0x80) && (lUnit != 0) ? static_cast<char>(lUnit) : '!');
+    }
+}
+
+static void TestUnsigned(nlTestSuite *inSuite __attribute__((unused)),
+                         void *inContext __attribute__((unused)))
+{
+    static const int kBases[] = { 0, 2, 8, 10, 16, 36, 37 };
+    uint64_t         lState   = 0x9E3779B97F4A7C15ULL;
+    std::u16string   lWide;
+    std::string      lNarrow;
+
+    for (int lBase : kBases)
+    {
+        for (size_t i = 0; i < 4000; i++)
+        {
+            char *        lExpectedEnd;
+            char16_t *    lEnd;
+            unsigned long lExpected;
+            unsigned long lValue;
+            int           lExpectedErrno;
+
+            Generate(lState, lWide, lNarrow);
+
+            errno = 0;
+
+            lExpected      = strntoul(lNarrow.data(), lNarrow.size(), &lExpectedEnd, lBase);
+            lExpectedErrno = errno;
+
+            errno = 0;
+
+            lValue = u16sntoul(lWide.data(), lWide.size(), &lEnd, lBase);
+            NL_TEST_ASSERT(inSuite, lValue == lExpected);
+            NL_TEST_ASSERT(inSuite, (lEnd - lWide.data()) == (lExpectedEnd - lNarrow.data()));
+            NL_TEST_ASSERT(inSuite, errno == lExpectedErrno);
+        }
+    }
+}
+
+static void TestSigned(nlTestSuite *inSuite __attribute__((unused)),
+                       void *inContext __attribute__((unused)))
+{
+    static const int kBases[] = { 0, 10, 16 };
+    uint64_t         lState   = 0xD1B54A32D192ED03ULL;
+    std::u16string   lWide;
+    std::string      lNarrow;
+
+    for (int lBase : kBases)
+    {
+        for (size_t i = 0; i < 4000; i++)
+        {
+            char *     lExpectedEnd;
+            char16_t * lEnd;
+            long       lExpected;
+            long       lValue;
+            int        lExpectedErrno;
+
+            Generate(lState, lWide, lNarrow);
+
+            errno = 0;
+
+            lExpected      = strntol(lNarrow.data(), lNarrow.size(), &lExpectedEnd, lBase);
+            lExpectedErrno = errno;
+
+            errno = 0;
+
+            lValue = u16sntol(lWide.data(), lWide.size(), &lEnd, lBase);
+            NL_TEST_ASSERT(inSuite, lValue == lExpected);
+            NL_TEST_ASSERT(inSuite, (lEnd - lWide.data()) == (lExpectedEnd - lNarrow.data()));
+            NL_TEST_ASSERT(inSuite, errno == lExpectedErrno);
+        }
+    }
+}
+
+static void TestBoundaries(nlTestSuite *inSuite __attribute__((unused)),
+                           void *inContext __attribute__((unused)))
+{
+    const char16_t *lString;
+    char16_t *      lEnd;
+    long            lValue;
+
+    // 1: The length bounds the conversion, even mid-block.
+
+    lString = u"-12345678901234567890";
+
+    lValue = u16sntol(lString, 5, &lEnd, 10);
+    NL_TEST_ASSERT(inSuite, (lValue == -1234) && (lEnd == lString + 5));
+
+    // 2: A code unit whose low byte is a digit is not a digit.
+
+    lString = u"12\u0133";
+
+    lValue = u16sntol(lString, 3, &lEnd, 10);
+    NL_TEST_ASSERT(inSuite, (lValue == 12) && (lEnd == lString + 2));
+
+    // 3: Nothing to convert.
+
+    lValue = u16sntol(lString, 0, &lEnd, 10);
+    NL_TEST_ASSERT(inSuite, (lValue == 0) && (lEnd == lString));
+
+    lValue = u16sntol(u"\uFF11", 1, &lEnd, 10);
+    NL_TEST_ASSERT(inSuite, lValue == 0);
+
+    // 4: Runs longer than the narrowing stack buffer.
+
+    {
+        std::u16string lLong = std::u16string(300, u' ') + u"-" + std::u16string(300, u'0') + u"7!";
+
+        lValue = u16sntol(lLong.data(), lLong.size(), &lEnd, 0);
+        NL_TEST_ASSERT(inSuite, (lValue == -07) && (lEnd == lLong.data() + lLong.size() - 1));
+
+        lLong = std::u16string(400, u'9');
+
+        errno  = 0;
+        lValue = u16sntol(lLong.data(), lLong.size(), &lEnd, 10);
+        NL_TEST_ASSERT(inSuite, (lValue == LONG_MAX) && (errno == ERANGE));
+        NL_TEST_ASSERT(inSuite, lEnd == lLong.data() + lLong.size());
+    }
+
+    // 5: The limits.
+
+    lString = u"9223372036854775807";
+
+    errno  = 0;
+    lValue = u16sntol(lString, 19, &lEnd, 10);
+    NL_TEST_ASSERT(inSuite, (lValue == LONG_MAX) && (errno == 0));
+
+    lString = u"-9223372036854775809";
+
+    lValue = u16sntol(lString, 20, &lEnd, 10);
+    NL_TEST_ASSERT(inSuite, (lValue == LONG_MIN) && (errno == ERANGE));
+}
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+static const nlTest sTests[] = {
+    NL_TEST_DEF("Unsigned",   TestUnsigned),
+    NL_TEST_DEF("Signed",     TestSigned),
+    NL_TEST_DEF("Boundaries", TestBoundaries),
+
+    NL_TEST_SENTINEL()
+};
+
+int main(void)
+{
+    nlTestSuite theSuite = {
+        "u16sntoul",
+        &sTests[0],
+        nullptr,
+        nullptr,
+        nullptr,
+        nullptr,
+        0,
+        0,
+        0,
+        0,
+        0
+    };
+
+    // Generate human-readable output.
+    nlTestSetOutputStyle(OUTPUT_DEF);
+
+    // Run test suit againt one context.
+    nlTestRunner(&theSuite, nullptr);
+
+    return nlTestRunnerStats(&theSuite);
+}
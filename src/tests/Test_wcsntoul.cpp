@@ -0,0 +1,223 @@
+/*
+ *    Copyright (c) 2024 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *    @file
+ *      This file implements a unit test for wcsntoul.
+ *
+ */
+
+#include <errno.h>
+#include <limits.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <string>
+
+#include <nlunit-test.h>
+
+#include <strntoul.h>
+#include <wcsntoul.h>
+
+
+static void TestAgreement(nlTestSuite *inSuite __attribute__((unused)),
+                          void *inContext __attribute__((unused)))
+{
+    static const wchar_t kUnits[] = {
+        L' ', L'\t', L'+', L'-', L'0', L'x', L'X', L'f', L'z', L'!', L',',
+        static_cast<wchar_t>(0x10031),     // Beyond 16 bits, low byte '1'.
+        static_cast<wchar_t>(0x80000031),  // Negative if signed.
+        static_cast<wchar_t>(0xFF11),      // Full-width '1'.
+        static_cast<wchar_t>(0x0000)
+    };
+    static const int     kBases[] = { 0, 2, 8, 10, 16, 36 };
+    uint64_t             lState   = 0x9E3779B97F4A7C15ULL;
+
+    // Each wide character outside of ASCII converts as an invalid
+    // narrow character would.
+
+    for (int lBase : kBases)
+    {
+        for (size_t i = 0; i < 4000; i++)
+        {
+            std::wstring  lWide;
+            std::string   lNarrow;
+            size_t        lLength;
+            char *        lExpectedEnd;
+            wchar_t *     lEnd;
+            unsigned long lExpected;
+            unsigned long lValue;
+            int           lExpectedErrno;
+
+            lState ^= lState << 13;
+            lState ^= lState >> 7;
+            lState ^= lState << 17;
+
+            lLength = static_cast<size_t>(((lState & 0xF) == 0) ? (lState % 600) : (lState % 48));
+
+            for (size_t j = 0; j < lLength; j++)
+            {
+                const uint64_t lPick = (lState >> ((j % 8) * 8)) ^ (j * 0x9E37U);
+                const wchar_t  lUnit = (((lPick & 7) == 0) ?
+                                        kUnits[lPick % (sizeof (kUnits) / sizeof (kUnits[0]))] :
+                                        static_cast<wchar_t>(L'0' + static_cast<wchar_t>(lPick % 10)));
+                const uint32_t lCode = static_cast<uint32_t>(lUnit);
+
+                lWide   += lUnit;
+                lNarrow += (((lCode < 0x80) && (lCode != 0)) ? static_cast<char>(lCode) : '!');
+            }
+
+            errno = 0;
+
+            lExpected      = strntoul(lNarrow.data(), lNarrow.size(), &lExpectedEnd, lBase);
+            lExpectedErrno = errno;
+
+            errno = 0;
+
+            lValue = wcsntoul(lWide.data(), lWide.size(), &lEnd, lBase);
+            NL_TEST_ASSERT(inSuite, lValue == lExpected);
+            NL_TEST_ASSERT(inSuite, (lEnd - lWide.data()) == (lExpectedEnd - lNarrow.data()));
+            NL_TEST_ASSERT(inSuite, errno == lExpectedErrno);
+        }
+    }
+}
+
+static void TestBoundaries(nlTestSuite *inSuite __attribute__((unused)),
+                           void *inContext __attribute__((unused)))
+{
+    const wchar_t *lString;
+    wchar_t *      lEnd;
+    unsigned long  lValue;
+
+    // 1: The length bounds the conversion, even mid-block.
+
+    lString = L"0x0123456789abcdef0123";
+
+    lValue = wcsntoul(lString, 7, &lEnd, 0);
+    NL_TEST_ASSERT(inSuite, (lValue == 0x01234) && (lEnd == lString + 7));
+
+    // 2: Runs longer than the narrowing stack buffer.
+
+    {
+        const std::wstring lLong = std::wstring(1000, L'\n') + std::wstring(1000, L'0') + L"18446744073709551615";
+
+        errno  = 0;
+        lValue = wcsntoul(lLong.data(), lLong.size(), &lEnd, 10);
+        NL_TEST_ASSERT(inSuite, (lValue == ULONG_MAX) && (errno == 0));
+        NL_TEST_ASSERT(inSuite, lEnd == lLong.data() + lLong.size());
+    }
+
+    // 3: An invalid base.
+
+    lString = L"1";
+
+    errno  = 0;
+    lValue = wcsntoul(lString, 1, &lEnd, 1);
+    NL_TEST_ASSERT(inSuite, (lValue == 0) && (lEnd == lString) && (errno == EINVAL));
+
+    // 4: A null-terminated string, with more leading white space than
+    //    the narrowing stack buffer holds, bounded only by SIZE_MAX.
+
+    {
+        const std::wstring lLong = std::wstring(300, L' ') + L"42";
+
+        errno  = 0;
+        lValue = wcsntoul(lLong.c_str(), SIZE_MAX, &lEnd, 10);
+        NL_TEST_ASSERT(inSuite, (lValue == 42) && (errno == 0));
+        NL_TEST_ASSERT(inSuite, lEnd == lLong.data() + lLong.size());
+    }
+
+    // 5: Long runs of leading zeroes, around prefixes, and of digits
+    //    convert as their narrow equivalents do.
+
+    {
+        static const int   kBases[] = { 0, 8, 10, 16, 36 };
+        const std::string  kZeroes(1000, '0');
+        const std::string  kNines(1000, '9');
+        const std::string  kNarrows[] = {
+            kZeroes + "17",
+            "-" + kZeroes + "1",
+            "0x" + kZeroes + "ff",
+            "0X" + kZeroes,
+            "00x5",
+            kZeroes + "x5",
+            "0x" + kNines + "g",
+            kNines + "!",
+            "+" + kZeroes + kNines
+        };
+
+        for (const std::string &lNarrow : kNarrows)
+        {
+            const std::wstring lWide(lNarrow.begin(), lNarrow.end());
+
+            for (int lBase : kBases)
+            {
+                char *        lExpectedEnd;
+                unsigned long lExpected;
+                int           lExpectedErrno;
+
+                errno = 0;
+
+                lExpected      = strntoul(lNarrow.data(), lNarrow.size(), &lExpectedEnd, lBase);
+                lExpectedErrno = errno;
+
+                errno = 0;
+
+                lValue = wcsntoul(lWide.data(), lWide.size(), &lEnd, lBase);
+                NL_TEST_ASSERT(inSuite, lValue == lExpected);
+                NL_TEST_ASSERT(inSuite, (lEnd - lWide.data()) == (lExpectedEnd - lNarrow.data()));
+                NL_TEST_ASSERT(inSuite, errno == lExpectedErrno);
+            }
+        }
+    }
+}
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+static const nlTest sTests[] = {
+    NL_TEST_DEF("Agreement",  TestAgreement),
+    NL_TEST_DEF("Boundaries", TestBoundaries),
+
+    NL_TEST_SENTINEL()
+};
+
+int main(void)
+{
+    nlTestSuite theSuite = {
+        "wcsntoul",
+        &sTests[0],
+        nullptr,
+        nullptr,
+        nullptr,
+        nullptr,
+        0,
+        0,
+        0,
+        0,
+        0
+    };
+
+    // Generate human-readable output.
+    nlTestSetOutputStyle(OUTPUT_DEF);
+
+    // Run test suit againt one context.
+    nlTestRunner(&theSuite, nullptr);
+
+    return nlTestRunnerStats(&theSuite);
+}
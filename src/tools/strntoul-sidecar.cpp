@@ -0,0 +1,201 @@
+/*
+ *    Copyright (c) 2024 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *    @file
+ *      This file implements a tool for building, checking, and dumping
+ *      binary sidecar caches of the integer columns of delimited text
+ *      files.
+ *
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <vector>
+
+#include <strntoul_sidecar.h>
+
+enum Mode
+{
+    kModeBuild,
+    kModeCheck,
+    kModeDump
+};
+
+static void
+Usage(const char *aProgram)
+{
+    fprintf(stderr,
+            "Usage: %s [ -b BASE ] [ -d DELIMITER ] [ -e fixed | delta ] SOURCE SIDECAR\n"
+            "       %s -c [ -H ] SOURCE SIDECAR\n"
+            "       %s -p SIDECAR\n"
+            "\n"
+            "  -b BASE       Convert fields in BASE, as for strntoll (default: 10).\n"
+            "  -c            Check that SIDECAR is current with respect to SOURCE.\n"
+            "  -d DELIMITER  Split lines into fields at DELIMITER (default: ',').\n"
+            "  -e ENCODING   Encode columns as 'fixed' or 'delta' (default: fixed).\n"
+            "  -H            When checking, also verify the content hash of SOURCE.\n"
+            "  -p            Print the rows of SIDECAR, delimited by DELIMITER.\n",
+            aProgram, aProgram, aProgram);
+}
+
+static int
+Dump(const strntoul_sidecar_t *aSidecar, const char &aDelimiter)
+{
+    const size_t                       lRows    = strntoul_sidecar_rows(aSidecar);
+    const size_t                       lColumns = strntoul_sidecar_columns(aSidecar);
+    std::vector<std::vector<int64_t> > lValues(lColumns, std::vector<int64_t>(lRows));
+
+    for (size_t i = 0; i < lColumns; i++)
+    {
+        if (strntoul_sidecar_decode(aSidecar, i, lValues[i].data(), lRows) != 0)
+        {
+            return (-EINVAL);
+        }
+    }
+
+    for (size_t lRow = 0; lRow < lRows; lRow++)
+    {
+        for (size_t i = 0; i < lColumns; i++)
+        {
+            if (i != 0)
+            {
+                putchar(aDelimiter);
+            }
+
+            printf("%" PRId64, lValues[i][lRow]);
+        }
+
+        putchar('\n');
+    }
+
+    return (0);
+}
+
+int
+main(int argc, char * const argv[])
+{
+    const char * const          lProgram   = argv[0];
+    Mode                        lMode      = kModeBuild;
+    int                         lBase      = 10;
+    char                        lDelimiter = ',';
+    strntoul_sidecar_encoding_t lEncoding  = STRNTOUL_SIDECAR_ENCODING_FIXED;
+    unsigned int                lFlags     = 0;
+    strntoul_sidecar_t *        lSidecar;
+    int                         lOption;
+    int                         lStatus;
+
+    while ((lOption = getopt(argc, argv, "b:cd:e:Hhp")) != -1)
+    {
+        switch (lOption)
+        {
+
+        case 'b':
+            lBase = atoi(optarg);
+            break;
+
+        case 'c':
+            lMode = kModeCheck;
+            break;
+
+        case 'd':
+            lDelimiter = ((strcmp(optarg, "\\t") == 0) ? '\t' : optarg[0]);
+            break;
+
+        case 'e':
+            if (strcmp(optarg, "fixed") == 0)
+            {
+                lEncoding = STRNTOUL_SIDECAR_ENCODING_FIXED;
+            }
+            else if (strcmp(optarg, "delta") == 0)
+            {
+                lEncoding = STRNTOUL_SIDECAR_ENCODING_DELTA;
+            }
+            else
+            {
+                Usage(lProgram);
+                return (EXIT_FAILURE);
+            }
+            break;
+
+        case 'H':
+            lFlags |= STRNTOUL_SIDECAR_VERIFY_HASH;
+            break;
+
+        case 'p':
+            lMode = kModeDump;
+            break;
+
+        default:
+            Usage(lProgram);
+            return ((lOption == 'h') ? EXIT_SUCCESS : EXIT_FAILURE);
+
+        }
+    }
+
+    argc -= optind;
+    argv += optind;
+
+    if (argc != ((lMode == kModeDump) ? 1 : 2))
+    {
+        Usage(lProgram);
+        return (EXIT_FAILURE);
+    }
+
+    switch (lMode)
+    {
+
+    case kModeBuild:
+        lStatus = strntoul_sidecar_build(argv[0], argv[1], lDelimiter, lBase, lEncoding);
+        break;
+
+    case kModeCheck:
+        lStatus = strntoul_sidecar_open(argv[1], argv[0], lFlags, &lSidecar);
+
+        if (lStatus == 0)
+        {
+            strntoul_sidecar_close(lSidecar);
+        }
+        break;
+
+    case kModeDump:
+        lStatus = strntoul_sidecar_open(argv[0], nullptr, 0, &lSidecar);
+
+        if (lStatus == 0)
+        {
+            lStatus = Dump(lSidecar, lDelimiter);
+
+            strntoul_sidecar_close(lSidecar);
+        }
+        break;
+
+    }
+
+    if (lStatus != 0)
+    {
+        fprintf(stderr, "%s: %s\n", lProgram, strerror(-lStatus));
+        return (EXIT_FAILURE);
+    }
+
+    return (EXIT_SUCCESS);
+}
@@ -0,0 +1,102 @@
+/*
+ *    Copyright (c) 2024 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *    @file
+ *      This file implements interfaces, u16sntoul and u16sntol, for
+ *      converting bounded, potentially non-null-terminated UTF-16
+ *      strings to long integers without first transcoding them.
+ *
+ */
+
+#include "u16sntoul.h"
+
+#include "strntoul/strntoul-core.h"
+#include "strntoul-narrow.h"
+
+/**
+ *  @brief
+ *    Convert a UTF-16 string to an unsigned long integer.
+ *
+ *  This is identical to strntoul, except that @a aString is a string
+ *  of UTF-16 code units and @a aLength and *@a aEnd are in those
+ *  units. Only ASCII white space, signs, and digits are recognized;
+ *  any other code unit, such as a full-width digit, ends the
+ *  conversion as an invalid character would.
+ *
+ *  On error, @a errno may be set as follows:
+ *
+ *    - EINVAL   @a aBase was an unsupported value.
+ *    - ERANGE   The resulting conversion was out of range.
+ *
+ *  @param[in]   aString  A pointer to the string to convert.
+ *  @param[in]   aLength  The maximum number of code units of @a
+ *                        aString to process.
+ *  @param[out]  aEnd     A pointer to storage for the first invalid
+ *                        or the last valid code unit in @a aString.
+ *  @param[in]   aBase    The base to use to interpret @a aString, as
+ *                        for strntoul.
+ *
+ *  @returns
+ *    The result of the conversion, as for strntoul.
+ *
+ *  @sa strntoul
+ *  @sa u16sntol
+ *
+ */
+unsigned long
+u16sntoul(const char16_t *aString, size_t aLength, char16_t **aEnd, int aBase)
+{
+    return (StrNToUL::Narrow::Convert<unsigned long>(aString, aLength, aEnd, aBase,
+                                                     [aBase](const char *aNarrowed, const size_t &aNarrowedLength, char **aNarrowedEnd) {
+                                                         return (StrNToUL::Core::ConvertUnsigned<unsigned long>(aNarrowed, aNarrowedLength, aNarrowedEnd, aBase));
+                                                     }));
+}
+
+/**
+ *  @brief
+ *    Convert a UTF-16 string to a long integer.
+ *
+ *  This is identical to strntol, except that @a aString is a string
+ *  of UTF-16 code units, as for u16sntoul.
+ *
+ *  On error, @a errno may be set as for u16sntoul.
+ *
+ *  @param[in]   aString  A pointer to the string to convert.
+ *  @param[in]   aLength  The maximum number of code units of @a
+ *                        aString to process.
+ *  @param[out]  aEnd     A pointer to storage for the first invalid
+ *                        or the last valid code unit in @a aString.
+ *  @param[in]   aBase    The base to use to interpret @a aString, as
+ *                        for strntol.
+ *
+ *  @returns
+ *    The result of the conversion, as for strntol.
+ *
+ *  @sa strntol
+ *  @sa u16sntoul
+ *
+ */
+long
+u16sntol(const char16_t *aString, size_t aLength, char16_t **aEnd, int aBase)
+{
+    return (StrNToUL::Narrow::Convert<long>(aString, aLength, aEnd, aBase,
+                                            [aBase](const char *aNarrowed, const size_t &aNarrowedLength, char **aNarrowedEnd) {
+                                                return (StrNToUL::Core::ConvertSigned<long, unsigned long>(aNarrowed, aNarrowedLength, aNarrowedEnd, aBase));
+                                            }));
+}
@@ -0,0 +1,47 @@
+/*
+ *    Copyright (c) 2024 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *    @file
+ *      This file defines interfaces, u16sntoul and u16sntol, for
+ *      converting bounded, potentially non-null-terminated UTF-16
+ *      strings to long integers without first transcoding them.
+ *
+ */
+
+#ifndef U16SNTOUL_H
+#define U16SNTOUL_H
+
+#include <stddef.h>
+
+#ifndef __cplusplus
+#include <uchar.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern unsigned long u16sntoul(const char16_t *aString, size_t aLength, char16_t **aEnd, int aBase);
+extern long u16sntol(const char16_t *aString, size_t aLength, char16_t **aEnd, int aBase);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* U16SNTOUL_H */
@@ -0,0 +1,69 @@
+/*
+ *    Copyright (c) 2024 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *    @file
+ *      This file implements an interface, wcsntoul, for converting
+ *      bounded, potentially non-null-terminated wide-character
+ *      strings to unsigned long integers.
+ *
+ */
+
+#include "wcsntoul.h"
+
+#include "strntoul/strntoul-core.h"
+#include "strntoul-narrow.h"
+
+/**
+ *  @brief
+ *    Convert a wide-character string to an unsigned long integer.
+ *
+ *  This is similar to the C99 standard wcstoul and identical to
+ *  strntoul, except that @a aString is a string of wide characters
+ *  and @a aLength and *@a aEnd are in those characters. Only ASCII
+ *  white space, signs, and digits are recognized; any other
+ *  character ends the conversion as an invalid character would.
+ *
+ *  On error, @a errno may be set as follows:
+ *
+ *    - EINVAL   @a aBase was an unsupported value.
+ *    - ERANGE   The resulting conversion was out of range.
+ *
+ *  @param[in]   aString  A pointer to the string to convert.
+ *  @param[in]   aLength  The maximum number of characters of @a
+ *                        aString to process.
+ *  @param[out]  aEnd     A pointer to storage for the first invalid
+ *                        or the last valid character in @a aString.
+ *  @param[in]   aBase    The base to use to interpret @a aString, as
+ *                        for strntoul.
+ *
+ *  @returns
+ *    The result of the conversion, as for strntoul.
+ *
+ *  @sa strntoul
+ *  @sa wcstoul
+ *
+ */
+unsigned long
+wcsntoul(const wchar_t *aString, size_t aLength, wchar_t **aEnd, int aBase)
+{
+    return (StrNToUL::Narrow::Convert<unsigned long>(aString, aLength, aEnd, aBase,
+                                                     [aBase](const char *aNarrowed, const size_t &aNarrowedLength, char **aNarrowedEnd) {
+                                                         return (StrNToUL::Core::ConvertUnsigned<unsigned long>(aNarrowed, aNarrowedLength, aNarrowedEnd, aBase));
+                                                     }));
+}
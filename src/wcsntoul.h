@@ -0,0 +1,43 @@
+/*
+ *    Copyright (c) 2024 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *    @file
+ *      This file defines an interface, wcsntoul, for converting
+ *      bounded, potentially non-null-terminated wide-character
+ *      strings to unsigned long integers.
+ *
+ */
+
+#ifndef WCSNTOUL_H
+#define WCSNTOUL_H
+
+#include <stddef.h>
+#include <wchar.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern unsigned long wcsntoul(const wchar_t *aString, size_t aLength, wchar_t **aEnd, int aBase);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WCSNTOUL_H */